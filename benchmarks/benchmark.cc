@@ -0,0 +1,210 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "benchmark.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iterator>
+
+namespace JaliBenchmarks {
+
+Benchmark_suite::Benchmark_suite(MPI_Comm comm, int const repetitions) :
+    comm_(comm), repetitions_(std::max(repetitions, 1)) {
+  MPI_Comm_rank(comm_, &rank_);
+}
+
+
+void Benchmark_suite::run(std::string const& name, double const items,
+                          std::function<void()> body,
+                          std::function<void()> setup) {
+  // Untimed run to build any lazily computed info the body uses
+
+  if (setup) setup();
+  body();
+
+  std::vector<double> times(repetitions_);
+  for (int r = 0; r < repetitions_; r++) {
+    if (setup) setup();
+    MPI_Barrier(comm_);
+    double start = MPI_Wtime();
+    body();
+    double mytime = MPI_Wtime() - start;
+    MPI_Allreduce(&mytime, &times[r], 1, MPI_DOUBLE, MPI_MAX, comm_);
+  }
+  std::sort(times.begin(), times.end());
+
+  Benchmark_result result;
+  result.name = name;
+  MPI_Allreduce(&items, &result.items, 1, MPI_DOUBLE, MPI_SUM, comm_);
+  result.repetitions = repetitions_;
+  result.min_seconds = times[0];
+  result.median_seconds = times[repetitions_/2];
+  result.throughput = (result.min_seconds > 0.0) ?
+      result.items/result.min_seconds : 0.0;
+  results_.push_back(result);
+}
+
+
+void Benchmark_suite::print(std::ostream& os) const {
+  if (rank_ != 0) return;
+
+  std::ios::fmtflags flags = os.flags();
+  std::streamsize precision = os.precision();
+  os << std::left << std::setw(32) << "benchmark" << std::right <<
+      std::setw(14) << "items" << std::setw(14) << "min (s)" <<
+      std::setw(14) << "median (s)" << std::setw(14) << "items/s" << "\n";
+  os << std::scientific << std::setprecision(4);
+  for (auto const& result : results_)
+    os << std::left << std::setw(32) << result.name << std::right <<
+        std::setw(14) << result.items <<
+        std::setw(14) << result.min_seconds <<
+        std::setw(14) << result.median_seconds <<
+        std::setw(14) << result.throughput << "\n";
+  os.flags(flags);
+  os.precision(precision);
+}
+
+
+void Benchmark_suite::write_json(std::ostream& os,
+                                 std::vector<std::pair<std::string,
+                                 std::string>> const& config) const {
+  if (rank_ != 0) return;
+
+  auto quoted = [](std::string const& str) -> std::string {
+    std::string q = "\"";
+    for (auto const& ch : str) {
+      if (ch == '"' || ch == '\\') q += '\\';
+      q += ch;
+    }
+    return q + "\"";
+  };
+
+  std::ios::fmtflags flags = os.flags();
+  std::streamsize precision = os.precision();
+  os << std::scientific << std::setprecision(6);
+  os << "{\n  \"config\": {";
+  for (int i = 0; i < static_cast<int>(config.size()); i++)
+    os << (i ? ",\n" : "\n") << "    " << quoted(config[i].first) << ": " <<
+        quoted(config[i].second);
+  os << "\n  },\n  \"benchmarks\": [";
+  for (int i = 0; i < static_cast<int>(results_.size()); i++) {
+    Benchmark_result const& result = results_[i];
+    os << (i ? ",\n" : "\n") <<
+        "    {\"name\": " << quoted(result.name) <<
+        ", \"items\": " << result.items <<
+        ", \"repetitions\": " << result.repetitions <<
+        ", \"min_seconds\": " << result.min_seconds <<
+        ", \"median_seconds\": " << result.median_seconds <<
+        ", \"throughput\": " << result.throughput << "}";
+  }
+  os << "\n  ]\n}\n";
+  os.flags(flags);
+  os.precision(precision);
+}
+
+
+int Benchmark_suite::compare(std::map<std::string, double> const& baseline,
+                             double const tolerance, std::ostream& os) const {
+  int nregressed = 0;
+  if (rank_ == 0) {
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::left << std::setw(32) << "benchmark" << std::right <<
+        std::setw(14) << "baseline/s" << std::setw(14) << "current/s" <<
+        std::setw(10) << "ratio" << "\n";
+    for (auto const& result : results_) {
+      auto it = baseline.find(result.name);
+      os << std::left << std::setw(32) << result.name << std::right;
+      if (it == baseline.end() || it->second <= 0.0) {
+        os << std::setw(14) << "-" << std::scientific << std::setprecision(4)
+           << std::setw(14) << result.throughput << "\n";
+        os.flags(flags);
+        continue;
+      }
+      double ratio = result.throughput/it->second;
+      bool regressed = ratio < 1.0 - tolerance;
+      if (regressed) nregressed++;
+      os << std::scientific << std::setprecision(4) <<
+          std::setw(14) << it->second << std::setw(14) << result.throughput <<
+          std::fixed << std::setprecision(3) << std::setw(10) << ratio <<
+          (regressed ? "  REGRESSION" : "") << "\n";
+      os.flags(flags);
+    }
+    os.precision(precision);
+  }
+  MPI_Bcast(&nregressed, 1, MPI_INT, 0, comm_);
+  return nregressed;
+}
+
+
+std::map<std::string, double> read_baseline(std::istream& is) {
+  std::string text((std::istreambuf_iterator<char>(is)),
+                   std::istreambuf_iterator<char>());
+
+  // The file is in the fixed layout written by write_json so it is
+  // enough to pick up each name and the throughput that follows it
+
+  std::map<std::string, double> baseline;
+  std::string const namekey = "\"name\": \"";
+  std::string const valuekey = "\"throughput\": ";
+  std::size_t pos = text.find(namekey);
+  while (pos != std::string::npos) {
+    std::size_t start = pos + namekey.size();
+    std::size_t end = text.find('"', start);
+    std::size_t valuepos = text.find(valuekey, end);
+    if (end == std::string::npos || valuepos == std::string::npos) break;
+    baseline[text.substr(start, end - start)] =
+        std::strtod(text.c_str() + valuepos + valuekey.size(), nullptr);
+    pos = text.find(namekey, valuepos);
+  }
+  return baseline;
+}
+
+}  // end namespace JaliBenchmarks
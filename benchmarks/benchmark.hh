@@ -0,0 +1,134 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _JALI_BENCHMARK_H_
+#define _JALI_BENCHMARK_H_
+
+// Small harness for repeatable microbenchmarks. Every benchmark is
+// run once untimed (so that lazily built mesh info is in place) and
+// then a fixed number of times; a repetition takes as long as the
+// slowest rank. The throughput is the number of items processed on
+// all ranks per second of the fastest repetition. Results are written
+// as JSON and can be compared against a baseline written earlier
+
+#include <mpi.h>
+
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace JaliBenchmarks {
+
+//! Timing of one benchmark
+
+struct Benchmark_result {
+  std::string name;
+  double items = 0.0;            // items per repetition on all ranks
+  int repetitions = 0;
+  double min_seconds = 0.0;      // fastest repetition
+  double median_seconds = 0.0;
+  double throughput = 0.0;       // items per second of fastest repetition
+};
+
+
+//! Runs benchmarks and collects their results. All ranks must run the
+//! same benchmarks in the same order
+
+class Benchmark_suite {
+ public:
+  Benchmark_suite(MPI_Comm comm, int const repetitions);
+
+  //! Time body, which processes items items on this rank. If setup is
+  //! given, it is called untimed before every run of body
+
+  void run(std::string const& name, double const items,
+           std::function<void()> body,
+           std::function<void()> setup = std::function<void()>());
+
+  //! Results of the benchmarks run so far
+
+  std::vector<Benchmark_result> const& results() const { return results_; }
+
+  //! Print a table of the results (on rank 0 only)
+
+  void print(std::ostream& os) const;
+
+  //! Write the configuration of the run and the results as JSON (on
+  //! rank 0 only)
+
+  void write_json(std::ostream& os,
+                  std::vector<std::pair<std::string, std::string>> const&
+                  config) const;
+
+  //! Compare the throughputs with those of a baseline written by
+  //! write_json and print the ratios (on rank 0). A benchmark regresses
+  //! if its throughput is below (1-tolerance) times the baseline's.
+  //! Returns the number of regressions on all ranks
+
+  int compare(std::map<std::string, double> const& baseline,
+              double const tolerance, std::ostream& os) const;
+
+ private:
+  MPI_Comm comm_;
+  int rank_;
+  int const repetitions_;
+  std::vector<Benchmark_result> results_;
+};
+
+
+//! Read the throughput of each benchmark from a file written by
+//! Benchmark_suite::write_json
+
+std::map<std::string, double> read_baseline(std::istream& is);
+
+}  // end namespace JaliBenchmarks
+
+#endif  // _JALI_BENCHMARK_H_
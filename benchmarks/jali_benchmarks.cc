@@ -0,0 +1,364 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+// Microbenchmarks of mesh queries, geometry, sets and state on a
+// generated mesh of configurable size. Every benchmark reports its
+// throughput (items processed per second); the results can be written
+// as JSON and compared against a baseline written by an earlier run
+// so that upgrades can be gated on performance
+//
+// Usage: jali_benchmarks [-n cells_per_dir] [-d dim] [-r repetitions]
+//                        [-t num_tiles] [-f MSTK|Simple] [-o results.json]
+//                        [-b baseline.json] [-tol tolerance]
+//
+// The program exits with a non-zero status if a baseline is given
+// and the throughput of any benchmark is below (1-tolerance) times
+// the baseline's
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mpi.h"
+
+#include "Mesh.hh"
+#include "MeshTile.hh"
+#include "MeshSet.hh"
+#include "MeshFactory.hh"
+#include "BoxRegion.hh"
+#include "GeometricModel.hh"
+#include "JaliStateVector.h"
+#include "JaliState.h"
+
+#include "benchmark.hh"
+
+using namespace Jali;
+using namespace JaliGeometry;
+using namespace JaliBenchmarks;
+
+// Sum of the results of the benchmarked calls - printed at the end
+// so that the compiler cannot drop the calls
+
+double checksum = 0.0;
+
+
+int main(int argc, char *argv[]) {
+  MPI_Init(&argc, &argv);
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int rank, nproc;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &nproc);
+
+  int n = 20, dim = 3, repetitions = 5, num_tiles = 8;
+  MeshFramework_t framework = MSTK;
+  std::string outfile, basefile;
+  double tolerance = 0.1;
+  for (int i = 1; i < argc; i++) {
+    bool has_value = (i+1 < argc);
+    if (!strcmp(argv[i], "-n") && has_value)
+      n = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-d") && has_value)
+      dim = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-r") && has_value)
+      repetitions = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-t") && has_value)
+      num_tiles = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-f") && has_value)
+      framework = strcmp(argv[++i], "Simple") ? MSTK : Simple;
+    else if (!strcmp(argv[i], "-o") && has_value)
+      outfile = argv[++i];
+    else if (!strcmp(argv[i], "-b") && has_value)
+      basefile = argv[++i];
+    else if (!strcmp(argv[i], "-tol") && has_value)
+      tolerance = atof(argv[++i]);
+    else {
+      if (rank == 0)
+        std::cerr << "Usage: " << argv[0] << " [-n cells_per_dir] [-d dim]" <<
+            " [-r repetitions] [-t num_tiles] [-f MSTK|Simple]" <<
+            " [-o results.json] [-b baseline.json] [-tol tolerance]\n";
+      MPI_Finalize();
+      return 1;
+    }
+  }
+
+  if (!framework_available(framework) ||
+      !framework_generates(framework, nproc > 1, dim)) {
+    if (rank == 0)
+      std::cerr << framework_name(framework) << " cannot generate a " <<
+          dim << "D mesh on " << nproc << " ranks\n";
+    MPI_Finalize();
+    return 1;
+  }
+
+
+  // Two boxes covering the lower half of the domain in x and in y -
+  // sets are built from them and combined
+
+  Point lo(dim), hi(dim), xhalf(dim), yhalf(dim);
+  for (int d = 0; d < dim; d++) {
+    lo[d] = -0.01;
+    hi[d] = xhalf[d] = yhalf[d] = 1.01;
+  }
+  xhalf[0] = 0.5;
+  yhalf[1] = 0.5;
+  BoxRegion xbox("xlower", 1, lo, xhalf), ybox("ylower", 2, lo, yhalf);
+  std::vector<RegionPtr> regions = {&xbox, &ybox};
+  GeometricModel gm(dim, regions);
+
+  MeshFactory factory(comm);
+  factory.framework(framework);
+  std::vector<Entity_kind> entities = {Entity_kind::FACE};
+  if (framework == MSTK) entities.push_back(Entity_kind::EDGE);
+  factory.included_entities(entities);
+  factory.geometric_model(&gm);
+
+  auto make_mesh = [&]() -> std::shared_ptr<Mesh> {
+    if (dim == 2)
+      return factory(0.0, 0.0, 1.0, 1.0, n, n);
+    else
+      return factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, n, n, n);
+  };
+  std::shared_ptr<Mesh> mesh = make_mesh();
+
+  int const ncells = mesh->num_cells<Entity_type::ALL>();
+  int const nnodes = mesh->num_nodes<Entity_type::ALL>();
+  int const ncells_owned = mesh->num_cells<Entity_type::PARALLEL_OWNED>();
+
+  Benchmark_suite suite(comm, repetitions);
+
+
+  // Topological queries - the first (untimed) run builds the cached
+  // adjacencies
+
+  suite.run("cell_get_faces_and_dirs", ncells, [&]() {
+      Entity_ID_List faces;
+      std::vector<dir_t> dirs;
+      for (int c = 0; c < ncells; c++) {
+        mesh->cell_get_faces_and_dirs(c, &faces, &dirs);
+        checksum += faces.size() + dirs[0];
+      }
+    });
+
+  suite.run("node_get_cells", nnodes, [&]() {
+      Entity_ID_List cells;
+      for (int nd = 0; nd < nnodes; nd++) {
+        mesh->node_get_cells(nd, Entity_type::ALL, &cells);
+        checksum += cells.size();
+      }
+    });
+
+  suite.run("cell_get_node_adj_cells", ncells, [&]() {
+      Entity_ID_List cells;
+      for (int c = 0; c < ncells; c++) {
+        mesh->cell_get_node_adj_cells(c, Entity_type::ALL, &cells);
+        checksum += cells.size();
+      }
+    });
+
+
+  // Recomputation of the geometry after all the nodes "moved" (to
+  // where they already are)
+
+  std::vector<Point> coords(nnodes);
+  for (int nd = 0; nd < nnodes; nd++)
+    mesh->node_get_coordinates(nd, &coords[nd]);
+  for (int c = 0; c < ncells; c++)
+    checksum += mesh->cell_volume(c);
+  int const nfaces = mesh->num_faces<Entity_type::ALL>();
+  for (int f = 0; f < nfaces; f++)
+    checksum += mesh->face_area(f);
+
+  suite.run("update_geometric_quantities", ncells, [&]() {
+      for (int nd = 0; nd < nnodes; nd++)
+        mesh->node_set_coordinates(nd, coords[nd]);
+      mesh->update_geometric_quantities();
+      checksum += mesh->cell_volume(0);
+    });
+
+
+  // Sets built from regions and combined with boolean operations
+
+  suite.run("build_set_from_region", ncells, [&]() {
+      std::shared_ptr<MeshSet> set =
+          mesh->build_set_from_region("xlower", Entity_kind::CELL);
+      checksum += set->entities<Entity_type::ALL>().size();
+    });
+
+  std::shared_ptr<MeshSet> xset =
+      mesh->build_set_from_region("xlower", Entity_kind::CELL);
+  std::shared_ptr<MeshSet> yset =
+      mesh->build_set_from_region("ylower", Entity_kind::CELL);
+  int const nsetcells = xset->entities<Entity_type::ALL>().size() +
+      yset->entities<Entity_type::ALL>().size();
+
+  suite.run("meshset_merge", nsetcells, [&]() {
+      checksum += merge({xset, yset}, true)->entities<Entity_type::ALL>().size();
+    });
+
+  suite.run("meshset_intersect", nsetcells, [&]() {
+      checksum +=
+          intersect({xset, yset}, true)->entities<Entity_type::ALL>().size();
+    });
+
+  suite.run("meshset_subtract", nsetcells, [&]() {
+      checksum +=
+          subtract(xset, {yset}, true)->entities<Entity_type::ALL>().size();
+    });
+
+
+  // Lookup of state vectors by name among a few dozen vectors
+
+  std::shared_ptr<State> state = State::create(mesh);
+  int const nvectors = 32, nlookups = 100;
+  std::vector<std::string> names;
+  for (int i = 0; i < nvectors; i++) {
+    names.push_back("var" + std::to_string(i));
+    state->add<double, Mesh, UniStateVector>(names.back(), mesh,
+                                             Entity_kind::CELL,
+                                             Entity_type::ALL, 1.0*i);
+  }
+
+  suite.run("state_find", nvectors*nlookups, [&]() {
+      for (int k = 0; k < nlookups; k++)
+        for (auto const& name : names)
+          checksum += (state->find(name, Entity_kind::CELL) != state->end());
+    });
+
+  suite.run("state_get", nvectors*nlookups, [&]() {
+      UniStateVector<double, Mesh> vec;
+      for (int k = 0; k < nlookups; k++)
+        for (auto const& name : names) {
+          state->get(name, mesh, Entity_kind::CELL, Entity_type::ALL, &vec);
+          checksum += vec[0];
+        }
+    });
+
+
+  // Multi-material data accessed by (material, cell) - each of the
+  // three materials is in three quarters of the cells
+
+  int const nmats = 3;
+  for (int m = 0; m < nmats; m++) {
+    std::vector<int> matcells;
+    for (int c = 0; c < ncells; c++)
+      if (c % 4 != m) matcells.push_back(c);
+    state->add_material("mat" + std::to_string(m), matcells);
+  }
+  MultiStateVector<double, Mesh>& matvec =
+      state->add<double, Mesh, MultiStateVector>("matdensity", mesh,
+                                                 Entity_kind::CELL,
+                                                 Entity_type::ALL, 1.0);
+  MultiStateVector<double, Mesh> const& cmatvec = matvec;
+
+  suite.run("multistatevector_access", nmats*ncells, [&]() {
+      for (int m = 0; m < nmats; m++)
+        for (int c = 0; c < ncells; c++)
+          checksum += cmatvec(m, c);
+    });
+
+
+  // Construction of tiles on a fresh mesh
+
+  std::shared_ptr<Mesh> tilemesh;
+  suite.run("make_meshtile", ncells_owned, [&]() {
+      for (int t = 0; t < num_tiles; t++) {
+        std::vector<Entity_ID> cells;
+        for (int c = t*ncells_owned/num_tiles;
+             c < (t+1)*ncells_owned/num_tiles; c++)
+          cells.push_back(c);
+        make_meshtile(*tilemesh, cells, 1, true, false, false, false, false);
+      }
+      checksum += tilemesh->num_tiles();
+    },
+    [&]() { tilemesh = make_mesh(); });
+
+  suite.run("make_meshtiles", ncells_owned, [&]() {
+      std::vector<std::vector<Entity_ID>> cells(num_tiles);
+      for (int t = 0; t < num_tiles; t++)
+        for (int c = t*ncells_owned/num_tiles;
+             c < (t+1)*ncells_owned/num_tiles; c++)
+          cells[t].push_back(c);
+      make_meshtiles(*tilemesh, cells, 1, true, false, false, false, false);
+      checksum += tilemesh->num_tiles();
+    },
+    [&]() { tilemesh = make_mesh(); });
+
+
+  suite.print(std::cout);
+
+  int status = 0;
+  if (!outfile.empty() && rank == 0) {
+    std::ofstream os(outfile);
+    suite.write_json(os, {{"framework", framework_name(framework)},
+            {"dim", std::to_string(dim)},
+            {"cells_per_dir", std::to_string(n)},
+            {"num_tiles", std::to_string(num_tiles)},
+            {"num_ranks", std::to_string(nproc)},
+            {"repetitions", std::to_string(repetitions)}});
+  }
+  if (!basefile.empty()) {
+    std::map<std::string, double> baseline;
+    if (rank == 0) {
+      std::ifstream is(basefile);
+      if (!is)
+        std::cerr << "Could not open baseline file " << basefile << "\n";
+      baseline = read_baseline(is);
+    }
+    if (suite.compare(baseline, tolerance, std::cout)) status = 1;
+  }
+
+  if (rank == 0)
+    std::cout << "checksum " << checksum << std::endl;
+
+  MPI_Finalize();
+  return status;
+}
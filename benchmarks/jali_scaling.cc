@@ -0,0 +1,300 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+// Weak and strong scaling driver for the distributed paths of mesh
+// construction. Run under mpiexec on N ranks, it builds a mesh through
+// MeshFactory on the first 1, 2, 4, ... ranks and finally on all N
+// ranks, and at each rank count times
+//
+//   - the construction of the mesh, broken down into the phases
+//     recorded by the mesh (generation or import, distribution from
+//     rank 0 or weaving of distributed meshes - which also sets up
+//     the ghost layers - renumbering of global IDs, the updates of
+//     attributes on ghost entities, init_* etc.)
+//   - the creation of cell, face and node sets from a box region
+//   - the output of the mesh to an Exodus II file (if requested)
+//
+// The maximum time over the ranks of every phase is printed as a
+// table with one column per rank count; the min, max, mean and
+// imbalance of every phase at every rank count can also be written
+// to a CSV file.
+//
+// Usage: jali_scaling [-c cells_per_rank] [-d dim] [-strong]
+//                     [-p INDEX|BLOCK|METIS|ZOLTAN_GRAPH|ZOLTAN_RCB]
+//                     [-g ghost_layers] [-bg] [-i mesh.exo|mesh.par]
+//                     [-w] [-o table.csv]
+//
+// In weak scaling (the default) the generated mesh has about
+// cells_per_rank cells per rank; with -strong it has about
+// cells_per_rank*N cells at every rank count. A mesh read from an
+// Exodus II file is distributed from rank 0 at every rank count; a
+// partitioned (.par) mesh can only be read on as many ranks as it has
+// partitions, so only the full rank count is measured
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mpi.h"
+
+#include "Mesh.hh"
+#include "MeshFactory.hh"
+#include "BoxRegion.hh"
+#include "GeometricModel.hh"
+#include "phase_profile.hh"
+
+using namespace Jali;
+using namespace JaliGeometry;
+
+
+int main(int argc, char *argv[]) {
+  MPI_Init(&argc, &argv);
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int rank, nproc;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &nproc);
+
+  int cells_per_rank = 10000, dim = 3, ghost_layers = 1;
+  bool strong = false, boundary_ghosts = false, write_mesh = false;
+  Partitioner_type partitioner = Partitioner_type::METIS;
+  std::string infile, outfile;
+  bool ok = true;
+  for (int i = 1; i < argc && ok; i++) {
+    bool has_value = (i+1 < argc);
+    if (!strcmp(argv[i], "-c") && has_value)
+      cells_per_rank = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-d") && has_value)
+      dim = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-strong"))
+      strong = true;
+    else if (!strcmp(argv[i], "-p") && has_value) {
+      std::string name = std::string("Partitioner_type::") + argv[++i];
+      ok = false;
+      for (int p = 0; p < NUM_PARTITIONER_TYPES; p++)
+        if (Partitioner_type_string(static_cast<Partitioner_type>(p)) ==
+            name) {
+          partitioner = static_cast<Partitioner_type>(p);
+          ok = true;
+        }
+    } else if (!strcmp(argv[i], "-g") && has_value)
+      ghost_layers = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-bg"))
+      boundary_ghosts = true;
+    else if (!strcmp(argv[i], "-i") && has_value)
+      infile = argv[++i];
+    else if (!strcmp(argv[i], "-w"))
+      write_mesh = true;
+    else if (!strcmp(argv[i], "-o") && has_value)
+      outfile = argv[++i];
+    else
+      ok = false;
+  }
+  if (!ok || (dim != 2 && dim != 3) || cells_per_rank < 1) {
+    if (rank == 0)
+      std::cerr << "Usage: " << argv[0] << " [-c cells_per_rank] [-d dim]" <<
+          " [-strong] [-p INDEX|BLOCK|METIS|ZOLTAN_GRAPH|ZOLTAN_RCB]" <<
+          " [-g ghost_layers] [-bg] [-i mesh.exo|mesh.par] [-w]" <<
+          " [-o table.csv]\n";
+    MPI_Finalize();
+    return 1;
+  }
+
+  // Rank counts to measure - powers of two and all the ranks
+
+  std::vector<int> rank_counts;
+  bool partitioned_file = infile.find(".par") != std::string::npos;
+  if (!partitioned_file)
+    for (int p = 1; p < nproc; p *= 2)
+      rank_counts.push_back(p);
+  rank_counts.push_back(nproc);
+
+  // Statistics of every phase at every rank count (on rank 0)
+
+  std::vector<std::string> phase_names;
+  std::map<std::string, std::map<int, Phase_statistics>> table;
+  std::map<int, double> total_cells;
+
+  for (int const p : rank_counts) {
+    MPI_Comm subcomm;
+    MPI_Comm_split(comm, rank < p ? 0 : MPI_UNDEFINED, rank, &subcomm);
+    if (subcomm == MPI_COMM_NULL) {
+      MPI_Barrier(comm);
+      continue;
+    }
+
+    // Size of the generated mesh
+
+    int const ncells_global = strong ? cells_per_rank*nproc :
+        cells_per_rank*p;
+    int const n = std::max(1, static_cast<int>(std::round(
+        std::pow(static_cast<double>(ncells_global), 1.0/dim))));
+
+    // Box covering the lower half of the domain in x for the sets
+
+    Point lo(dim), hi(dim);
+    for (int d = 0; d < dim; d++) {
+      lo[d] = -1.0e+10;
+      hi[d] = 1.0e+10;
+    }
+    hi[0] = 0.5;
+    BoxRegion box("xlower", 1, lo, hi);
+    std::vector<RegionPtr> regions = {&box};
+    GeometricModel gm(dim, regions);
+
+    MeshFactory factory(subcomm);
+    factory.framework(MSTK);
+    factory.included_entities({Entity_kind::EDGE, Entity_kind::FACE});
+    factory.partitioner(partitioner);
+    factory.num_ghost_layers_distmesh(ghost_layers);
+    factory.boundary_ghosts_requested(boundary_ghosts);
+    factory.geometric_model(&gm);
+    factory.profile_construction(true);
+
+    Phase_profile profile;
+    std::shared_ptr<Mesh> mesh;
+    {
+      MPI_Barrier(subcomm);
+      Phase_timer timer(&profile, "construction");
+      if (!infile.empty())
+        mesh = factory(infile);
+      else if (dim == 2)
+        mesh = factory(0.0, 0.0, 1.0, 1.0, n, n);
+      else
+        mesh = factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, n, n, n);
+    }
+
+    {
+      MPI_Barrier(subcomm);
+      Phase_timer timer(&profile, "sets");
+      mesh->build_set_from_region("xlower", Entity_kind::CELL, true);
+      mesh->build_set_from_region("xlower", Entity_kind::FACE, true);
+      mesh->build_set_from_region("xlower", Entity_kind::NODE, true);
+    }
+
+    if (write_mesh) {
+      MPI_Barrier(subcomm);
+      Phase_timer timer(&profile, "write_exodus");
+      mesh->write_to_exodus_file("jali_scaling_" + std::to_string(p) + ".exo",
+                                 false);
+    }
+
+    double mycells = mesh->num_cells<Entity_type::PARALLEL_OWNED>();
+    MPI_Reduce(&mycells, &total_cells[p], 1, MPI_DOUBLE, MPI_SUM, 0, subcomm);
+
+    // The phases of the construction recorded by the mesh go right
+    // after the construction phase (the first one)
+
+    std::vector<Phase_statistics> stats = profile.summary(subcomm);
+    std::vector<Phase_statistics> mesh_stats =
+        mesh->construction_profile().summary(subcomm);
+    for (auto& s : mesh_stats)
+      s.name = "construction/" + s.name;
+    stats.insert(stats.begin() + 1, mesh_stats.begin(), mesh_stats.end());
+    if (rank == 0)
+      for (auto const& s : stats) {
+        if (!table.count(s.name)) phase_names.push_back(s.name);
+        table[s.name][p] = s;
+      }
+
+    mesh.reset();
+    MPI_Comm_free(&subcomm);
+    MPI_Barrier(comm);
+  }
+
+  if (rank == 0) {
+    // Maximum time over the ranks of each phase at each rank count
+
+    std::cout << (strong ? "Strong" : "Weak") << " scaling, " <<
+        (infile.empty() ? "generated " + std::to_string(dim) + "D mesh" :
+         infile) << ", partitioner" << partitioner << "\n\n";
+    std::cout << std::left << std::setw(44) << "ranks" << std::right;
+    for (int const p : rank_counts)
+      std::cout << std::setw(12) << p;
+    std::cout << "\n" << std::left << std::setw(44) << "cells" << std::right;
+    for (int const p : rank_counts)
+      std::cout << std::setw(12) << static_cast<long>(total_cells[p]);
+    std::cout << "\n" << std::scientific << std::setprecision(3);
+    for (auto const& name : phase_names) {
+      std::cout << std::left << std::setw(44) << name << std::right;
+      for (int const p : rank_counts) {
+        auto it = table[name].find(p);
+        if (it == table[name].end())
+          std::cout << std::setw(12) << "-";
+        else
+          std::cout << std::setw(12) << it->second.max;
+      }
+      std::cout << "\n";
+    }
+
+    if (!outfile.empty()) {
+      std::ofstream os(outfile);
+      os << "ranks,cells,phase,calls,min,max,mean,imbalance\n";
+      os << std::scientific << std::setprecision(6);
+      for (int const p : rank_counts)
+        for (auto const& name : phase_names) {
+          auto it = table[name].find(p);
+          if (it == table[name].end()) continue;
+          Phase_statistics const& s = it->second;
+          os << p << "," << static_cast<long>(total_cells[p]) << "," <<
+              name << "," << s.calls << "," << s.min << "," << s.max << "," <<
+              s.mean << "," << s.imbalance << "\n";
+        }
+    }
+  }
+
+  MPI_Finalize();
+  return 0;
+}
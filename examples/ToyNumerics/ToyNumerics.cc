@@ -46,30 +46,59 @@
 
 */
 
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
+#include <string>
 #include <vector>
-#include <array>
 
 #include "mpi.h"
 
 #include "errors.hh"
 #include "Mesh.hh"
+#include "MeshTile.hh"
 #include "MeshFactory.hh"
 #include "JaliStateVector.h"
 #include "JaliState.h"
-
-// Code that attempts to _mock_ what may be done in a staggered grid
-// numerical scheme with some fields on cells and others on nodes
-// The "numerics" have no relation to any real numerical algorithm but
-// but illustrate how a real algorithm may be written
+#include "phase_profile.hh"
+
+// Proxy app that _mocks_ what may be done in a staggered grid
+// numerical scheme with some fields on cells and others on nodes. The
+// "numerics" have no relation to any real numerical algorithm but
+// each step goes through the kernels such a scheme spends its time
+// in, using only the public Jali API and the tiles of the mesh:
+//
+//   - cell_to_node_scatter:  nodal masses from the cell densities
+//   - face_flux:             exchange of density across the faces
+//   - corner_force:          nodal forces from the corners of cells
+//   - node_update:           nodal velocities from the forces
+//   - cell_neighbor_average: average of the density of the node
+//                            connected neighbors of each cell
+//
+// Kernels that only write to the entities owned by a tile run the
+// tiles concurrently with Mesh::parallel_for_tiles; the scatters from
+// cells to nodes write to nodes shared by tiles and run one color of
+// tiles at a time with Mesh::parallel_for_tiles_by_color.
+//
+// The time spent in every kernel is reported along with its
+// throughput (entities processed per second, slowest rank)
+//
+// Usage: ToyNumerics [-nx nx] [-ny ny] [-nz nz] [-d dim] [-t num_tiles]
+//                    [-g num_ghost_layers_tile] [-s num_steps]
 
 using namespace Jali;
 using namespace JaliGeometry;
 
-// Define two variable names that will be used to define state data in
+// Define the variable names that will be used to define state data in
 // the "initialize_data" routine and retrieve it in "main"
 
 std::string density_name("rhoMetal");
+std::string pressure_name("pressure");
+std::string mass_name("nodemass");
+std::string force_name("nodeforce");
 std::string velocity_name("nodevel");
 
 // Forward declaration of routine to initialize data - meant to
@@ -89,47 +118,83 @@ int main(int argc, char *argv[]) {
 
   MPI_Init(&argc, &argv);
 
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int rank, nproc;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &nproc);
+
+  // Size of the mesh, tiling and number of steps
+
+  int nx = 10, ny = 5, nz = 5, mesh_dimension = 3;
+  int num_tiles_requested = 10, num_ghost_layers_tile = 1, num_steps = 10;
+  bool ok = true;
+  for (int i = 1; i < argc && ok; i++) {
+    if (i+1 == argc) {
+      ok = false;
+      break;
+    }
+    int value = atoi(argv[i+1]);
+    if (!strcmp(argv[i], "-nx")) nx = value;
+    else if (!strcmp(argv[i], "-ny")) ny = value;
+    else if (!strcmp(argv[i], "-nz")) nz = value;
+    else if (!strcmp(argv[i], "-d")) mesh_dimension = value;
+    else if (!strcmp(argv[i], "-t")) num_tiles_requested = value;
+    else if (!strcmp(argv[i], "-g")) num_ghost_layers_tile = value;
+    else if (!strcmp(argv[i], "-s")) num_steps = value;
+    else ok = false;
+    i++;
+  }
+  if (!ok || (mesh_dimension != 2 && mesh_dimension != 3)) {
+    if (rank == 0)
+      std::cerr << "Usage: " << argv[0] << " [-nx nx] [-ny ny] [-nz nz]" <<
+          " [-d dim] [-t num_tiles] [-g num_ghost_layers_tile]" <<
+          " [-s num_steps]\n";
+    MPI_Finalize();
+    return 1;
+  }
+
+
   // Create a mesh factory object - this object has methods for
   // specifying the preference of mesh frameworks and unified
   // interfaces for instantiating a mesh object of a particular
   // framework type
 
-  MPI_Comm comm = MPI_COMM_WORLD;
   MeshFactory mesh_factory(comm);
 
   // Specify that MSTK is the preferred mesh framework. Currently Jali is
   // compiled only with MSTK support
 
   std::shared_ptr<Mesh> mymesh;  // Pointer to a mesh object
-  bool parallel_mesh = false;
-  int mesh_dimension = 3;
-  if (framework_available(MSTK) &&
-      framework_generates(MSTK, parallel_mesh, mesh_dimension)) {
-
-    mesh_factory.framework(MSTK);
-  
-    // Create a 3D mesh from (0.0,0.0,0.0) to (1.0,1.0,1.0) with 10, 5
-    // and 5 elements in the X, Y and Z directions. Specify that we
-    // want all kinds of entities (faces, edges, wedges and corners)
-    // to be present. Finally, request that the mesh be divided into 10
-    // tiles.
-
-    int num_tiles_requested = 10;
-    mesh_factory.included_entities(Entity_kind::ALL_KIND);
-    mesh_factory.num_tiles(num_tiles_requested);
-    mesh_factory.num_ghost_layers_tile(1);
-    mymesh = mesh_factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 10, 5, 5);
+  bool parallel_mesh = (nproc > 1);
+  if (!framework_available(MSTK) ||
+      !framework_generates(MSTK, parallel_mesh, mesh_dimension)) {
+    std::cerr << "MSTK cannot generate this mesh" << std::endl;
+    MPI_Abort(comm, 1);
   }
 
+  mesh_factory.framework(MSTK);
+
+  // Create a mesh from (0.0,0.0,0.0) to (1.0,1.0,1.0) with nx, ny and
+  // nz elements in the X, Y and Z directions. Specify that we want
+  // all kinds of entities (faces, edges, wedges and corners) to be
+  // present. Finally, request that the mesh be divided into tiles.
+
+  mesh_factory.included_entities(Entity_kind::ALL_KIND);
+  mesh_factory.num_tiles(num_tiles_requested);
+  mesh_factory.num_ghost_layers_tile(num_ghost_layers_tile);
+  if (mesh_dimension == 2)
+    mymesh = mesh_factory(0.0, 0.0, 1.0, 1.0, nx, ny);
+  else
+    mymesh = mesh_factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, nx, ny, nz);
+
 
-  // Spatial dimension of points in the mesh - since this is a 3D
-  // mesh, this should be 3
+  // Spatial dimension of points in the mesh - since we asked for a 2D
+  // or 3D mesh, this should be mesh_dimension
 
   int spdim = mymesh->space_dimension();
 
 
-  // Topological dimension of cells in the mesh - since this is a 3D
-  // mesh, this should be 3
+  // Topological dimension of cells in the mesh
 
   int celldim = mymesh->manifold_dimension();
 
@@ -142,126 +207,221 @@ int main(int argc, char *argv[]) {
 
 
   // Initialize the state manager with some data - see routine at end
-  // of file.  It sets up a scalar array on cells using the string in
-  // density_name and a vector array on nodes using the string in
-  // velocity_name
+  // of file. It sets up scalar arrays on cells and nodes and vector
+  // arrays on nodes using the names defined above
 
   initialize_data(mymesh, mystate);
 
 
-  // Retrieve the density data on cells. This is indirect. The find
-  // routine returns an iterator value and one has to dereference it
-  // to get at the StateVector. This means one needs to know the template
-  // argument for StateVector (in this case it is "double")
-
-  UniStateVector<double> rhovec;
-  bool found = mystate->get(density_name, mymesh, Entity_kind::CELL,
-                            Entity_type::ALL, &rhovec);
+  // Retrieve the data by name. This is indirect - one needs to know
+  // the template arguments of the state vector (the data type and
+  // the domain). The get routine makes an inexpensive shallow copy of
+  // the state vector, so the data is shared with the state manager
+
+  UniStateVector<double> rhovec, pvec, massvec;
+  UniStateVector<std::array<double, 3>, Mesh> forcevec, velvec;
+  bool found =
+      mystate->get(density_name, mymesh, Entity_kind::CELL,
+                   Entity_type::ALL, &rhovec) &&
+      mystate->get(pressure_name, mymesh, Entity_kind::CELL,
+                   Entity_type::ALL, &pvec) &&
+      mystate->get(mass_name, mymesh, Entity_kind::NODE,
+                   Entity_type::ALL, &massvec) &&
+      mystate->get(force_name, mymesh, Entity_kind::NODE,
+                   Entity_type::ALL, &forcevec) &&
+      mystate->get(velocity_name, mymesh, Entity_kind::NODE,
+                   Entity_type::ALL, &velvec);
   if (!found) {
-    std::cerr << "Could not find state vector on cells with name " <<
-        density_name << std::endl;
-    exit(-1);
+    std::cerr << "Could not find state vectors" << std::endl;
+    MPI_Abort(comm, 1);
   }
 
-  // Compute the average density on cells using all node connected neighbors
-
   int nc = mymesh->num_entities(Entity_kind::CELL, Entity_type::ALL);
-  double *ave_density = new double[nc];
-  for (int i = 0; i < nc; ++i) ave_density[i] = 0.0;
-
-  for (auto const& t : mymesh->tiles()) {
-    for (auto const& c : t->cells()) {
+  std::vector<double> drho(nc, 0.0), rhobar(nc, 0.0);
+  double const dt = 1.0e-3;
 
-      // Get all (owned or ghost) node connected/adjacent neighbors of a cell
 
-      Entity_ID_List nbrs;
-      mymesh->cell_get_node_adj_cells(c, Entity_type::ALL, &nbrs);
+  // Number of entities processed by each kernel in one step and the
+  // time spent in each kernel
 
-      for (auto const & cnbr : nbrs)
-        ave_density[c] += rhovec[cnbr];
-      ave_density[c] /= nbrs.size();
-    }
+  int ncells_owned = 0, nnodes_owned = 0;
+  for (auto const& t : mymesh->tiles()) {
+    ncells_owned += t->cells<Entity_type::PARALLEL_OWNED>().size();
+    nnodes_owned += t->nodes<Entity_type::PARALLEL_OWNED>().size();
   }
 
-  // Add the average density data as a new state vector
+  // Geometric quantities and adjacencies are computed on first use -
+  // query them once up front so that the kernels time only their use
 
-  UniStateVector<double>& rhobarvec = mystate->add("rhobar", mymesh,
-                                                Entity_kind::CELL,
-                                                Entity_type::ALL,
-                                                ave_density);
-
-  delete [] ave_density;
-
-
-
-  // Retrieve the vector of velocities
-
-  UniStateVector<std::array<double, 3>, Mesh> vels;
-  found = mystate->get(velocity_name, mymesh, Entity_kind::NODE,
-                       Entity_type::ALL, &vels);
-  if (!found) {
-    std::cerr << "Could not find state vector on nodes with name " <<
-        velocity_name << std::endl;
-    exit(-1);
+  for (auto const c : mymesh->cells<Entity_type::ALL>()) {
+    mymesh->cell_volume(c);
+    mymesh->cell_node_adj_cells(c);
+    for (auto const f : mymesh->cell_faces(c))
+      mymesh->face_area(f);
+    for (auto const cn : mymesh->cell_corners(c))
+      mymesh->corner_volume(cn);
   }
 
-  // Update them to be the average of the centroids of the connected
-  // cells weighted by the average cell density
-
-  for (auto const& t : mymesh->tiles()) {
-    for (auto const n : t->nodes()) {
-
-      // Get the cells using (connected to) this node
-
-      Entity_ID_List nodecells;
-      mymesh->node_get_cells(n, Entity_type::ALL, &nodecells);
-
-      std::array<double, 3> tmpvels;
-      for (int i = 0; i < 3; ++i) tmpvels[i] = 0.0;
-
-      for (auto c : nodecells) {
+  std::vector<std::string> kernels = {"cell_to_node_scatter", "face_flux",
+                                      "corner_force", "node_update",
+                                      "cell_neighbor_average"};
+  std::vector<int> kernel_items = {ncells_owned, ncells_owned, ncells_owned,
+                                   nnodes_owned, ncells_owned};
+  Phase_profile profile;
+
+  for (int step = 0; step < num_steps; step++) {
+
+    // Scatter the mass of each cell equally to its nodes
+
+    {
+      Phase_timer timer(&profile, "cell_to_node_scatter");
+      mymesh->parallel_for_tiles([&](MeshTile& t) {
+          for (auto const n : t.nodes<Entity_type::PARALLEL_OWNED>())
+            massvec[n] = 0.0;
+        });
+      mymesh->parallel_for_tiles_by_color([&](MeshTile& t) {
+          for (auto const c : t.cells<Entity_type::PARALLEL_OWNED>()) {
+            Entity_ID_View cnodes = mymesh->cell_nodes(c);
+            double nodal_mass =
+                rhovec[c]*mymesh->cell_volume(c)/cnodes.size();
+            for (auto const n : cnodes)
+              massvec[n] += nodal_mass;
+          }
+        });
+    }
 
-        // Get cell centroid - this is computed once and cached unless the
-        // mesh changes or the routine is explicitly asked to recompute it
-        // to help understand the effect of a temporary change
 
-        JaliGeometry::Point ccen = mymesh->cell_centroid(c);
-        for (int i = 0; i < 3; ++i) tmpvels[i] += rhobarvec[c]*ccen[i];
+    // Exchange density with the face neighbors of each cell in
+    // proportion to the area of the face and the density difference
+
+    {
+      Phase_timer timer(&profile, "face_flux");
+      mymesh->parallel_for_tiles([&](MeshTile& t) {
+          for (auto const c : t.cells<Entity_type::PARALLEL_OWNED>()) {
+            double flux = 0.0;
+            for (auto const f : mymesh->cell_faces(c)) {
+              Entity_ID_View fcells = mymesh->face_cells(f);
+              if (fcells.size() < 2) continue;  // boundary face
+              Entity_ID cnbr = (fcells[0] == c) ? fcells[1] : fcells[0];
+              flux += mymesh->face_area(f)*(rhovec[cnbr] - rhovec[c]);
+            }
+            drho[c] = dt*flux/mymesh->cell_volume(c);
+          }
+        });
+      mymesh->parallel_for_tiles([&](MeshTile& t) {
+          for (auto const c : t.cells<Entity_type::PARALLEL_OWNED>())
+            rhovec[c] += drho[c];
+        });
+    }
 
-      }
 
-      vels[n] = tmpvels;
+    // Push the nodes of each cell away from the cell center in
+    // proportion to the pressure and the volume of the corner
+
+    {
+      Phase_timer timer(&profile, "corner_force");
+      mymesh->parallel_for_tiles([&](MeshTile& t) {
+          for (auto const n : t.nodes<Entity_type::PARALLEL_OWNED>())
+            forcevec[n] = {0.0, 0.0, 0.0};
+        });
+      mymesh->parallel_for_tiles_by_color([&](MeshTile& t) {
+          for (auto const c : t.cells<Entity_type::PARALLEL_OWNED>()) {
+            Point ccen = mymesh->cell_centroid(c);
+            for (auto const cn : mymesh->cell_corners(c)) {
+              Entity_ID n = mymesh->corner_get_node(cn);
+              Point npnt;
+              mymesh->node_get_coordinates(n, &npnt);
+              double pvol = pvec[c]*mymesh->corner_volume(cn);
+              for (int i = 0; i < spdim; ++i)
+                forcevec[n][i] += pvol*(npnt[i] - ccen[i]);
+            }
+          }
+        });
     }
-  }
 
 
+    // Accelerate the nodes
 
-  // Print out the average densities at cell centers
+    {
+      Phase_timer timer(&profile, "node_update");
+      mymesh->parallel_for_tiles([&](MeshTile& t) {
+          for (auto const n : t.nodes<Entity_type::PARALLEL_OWNED>())
+            if (massvec[n] > 0.0)
+              for (int i = 0; i < spdim; ++i)
+                velvec[n][i] += dt*forcevec[n][i]/massvec[n];
+        });
+    }
 
-  std::cerr << "Average densities at cell centers:" << std::endl;
 
-  for (auto c : mymesh->cells<Entity_type::PARALLEL_OWNED>()) {
-    Point ccen = mymesh->cell_centroid(c);
-    
-    std::cerr << "Cell " << c << "    Centroid (" <<
-        ccen[0] << ", " << ccen[1] << ", " << ccen[2] <<
-        ")    Ave density " << rhobarvec[c] << std::endl;
+    // Compute the average density on cells using all node connected
+    // neighbors (owned or ghost)
+
+    {
+      Phase_timer timer(&profile, "cell_neighbor_average");
+      mymesh->parallel_for_tiles([&](MeshTile& t) {
+          for (auto const c : t.cells<Entity_type::PARALLEL_OWNED>()) {
+            Entity_ID_View nbrs = mymesh->cell_node_adj_cells(c);
+            double sum = 0.0;
+            for (auto const& cnbr : nbrs)
+              sum += rhovec[cnbr];
+            rhobar[c] = sum/nbrs.size();
+          }
+        });
+    }
   }
-  std::cerr << std::endl << std::endl;
-
 
-  // Print out computed velocities at nodes
 
-  std::cerr << "Computed velocities at nodes:" << std::endl;
-
-  for (auto n : mymesh->nodes<Entity_type::PARALLEL_OWNED>()) {
-    Point npnt;
-    mymesh->node_get_coordinates(n, &npnt);
-
-    std::cerr << "Node " << n << "    Coord (" <<
-        npnt[0] << ", " << npnt[1] << ", " << npnt[2] <<
-        ")    Velocity (" << vels[n][0] << ", " << vels[n][1] <<
-        ", " << vels[n][2] << ")" << std::endl << std::endl;
+  // Report the time spent in each kernel (slowest rank) and its
+  // throughput
+
+  std::vector<Phase_statistics> stats = profile.summary(comm);
+  std::vector<int> total_items(kernels.size());
+  MPI_Reduce(kernel_items.data(), total_items.data(), kernels.size(),
+             MPI_INT, MPI_SUM, 0, comm);
+
+  // Total mass and kinetic energy of the owned nodes of each tile,
+  // summed over the tiles and then over the ranks
+
+  typedef std::array<double, 2> Mass_energy;
+  Mass_energy mysums = mymesh->parallel_reduce_tiles(
+      Mass_energy{{0.0, 0.0}},
+      [&](MeshTile& t) -> Mass_energy {
+        Mass_energy sums = {{0.0, 0.0}};
+        for (auto const n : t.nodes<Entity_type::PARALLEL_OWNED>()) {
+          sums[0] += massvec[n];
+          for (int i = 0; i < spdim; ++i)
+            sums[1] += 0.5*massvec[n]*velvec[n][i]*velvec[n][i];
+        }
+        return sums;
+      },
+      [](Mass_energy const& a, Mass_energy const& b) -> Mass_energy {
+        return {{a[0]+b[0], a[1]+b[1]}};
+      });
+  double mass = 0.0, kinetic = 0.0;
+  MPI_Reduce(&mysums[0], &mass, 1, MPI_DOUBLE, MPI_SUM, 0, comm);
+  MPI_Reduce(&mysums[1], &kinetic, 1, MPI_DOUBLE, MPI_SUM, 0, comm);
+
+  if (rank == 0) {
+    std::cout << "Mesh " << nx << "x" << ny;
+    if (mesh_dimension == 3) std::cout << "x" << nz;
+    std::cout << ", " << nproc << " ranks, " << mymesh->num_tiles() <<
+        " tiles, " << num_steps << " steps\n\n";
+    std::cout << std::left << std::setw(24) << "kernel" << std::right <<
+        std::setw(14) << "entities" << std::setw(14) << "time (s)" <<
+        std::setw(14) << "entities/s" << std::setw(12) << "imbalance" <<
+        "\n" << std::scientific << std::setprecision(4);
+    for (int k = 0; k < static_cast<int>(kernels.size()); k++)
+      for (auto const& s : stats)
+        if (s.name == kernels[k])
+          std::cout << std::left << std::setw(24) << s.name << std::right <<
+              std::setw(14) << total_items[k] <<
+              std::setw(14) << s.max <<
+              std::setw(14) << (s.max > 0.0 ?
+                                1.0*total_items[k]*num_steps/s.max : 0.0) <<
+              std::fixed << std::setprecision(3) << std::setw(12) <<
+              s.imbalance << std::scientific << std::setprecision(4) << "\n";
+    std::cout << "\nTotal nodal mass " << mass << ", kinetic energy " <<
+        kinetic << std::endl;
   }
 
 
@@ -279,40 +439,48 @@ int main(int argc, char *argv[]) {
 void initialize_data(const std::shared_ptr<Mesh> mesh,
                      std::shared_ptr<State> state) {
 
-  // Add a state vector, called "rho99", of densities on cells.
-  // This says to create a vector named "rhoMetal" on each cell
-  // initialized to 0.0
+  // Add a state vector, called "rhoMetal", of densities on cells and
+  // one of pressures. This says to create a vector named "rhoMetal"
+  // on each cell initialized to 0.0
 
   UniStateVector<double, Mesh>& density =
       state->add<double, Mesh, UniStateVector>(density_name, mesh,
                                                Entity_kind::CELL,
                                                Entity_type::ALL, 0.0);
+  UniStateVector<double, Mesh>& pressure =
+      state->add<double, Mesh, UniStateVector>(pressure_name, mesh,
+                                               Entity_kind::CELL,
+                                               Entity_type::ALL, 0.0);
 
+  // Initialize the density and pressure from the cell centroids
 
-  // Create a density vector that will be used to initialize a state
-  // variable called 'rho99' on cells
+  int dim = mesh->space_dimension();
 
-  for (auto c : mesh->cells<Entity_type::PARALLEL_OWNED>()) {
+  for (auto c : mesh->cells<Entity_type::ALL>()) {
     Point ccen = mesh->cell_centroid(c);
-    density[c] = ccen[0]+ccen[1]+ccen[2];
+    double sum = 0.0;
+    for (int i = 0; i < dim; ++i) sum += ccen[i];
+    density[c] = 1.0 + sum;
+    pressure[c] = 1.0 + ccen[0];
   }
 
 
-  // Add a state vector for velocities
-
-  int dim = mesh->space_dimension();
+  // Add state vectors for masses, forces and velocities on nodes
 
-  std::array<double, 3> initarray;
-  for (int i = 0; i < dim; ++i) initarray[i] = 0.0;
+  state->add<double, Mesh, UniStateVector>(mass_name, mesh,
+                                           Entity_kind::NODE,
+                                           Entity_type::ALL, 0.0);
 
-  // Note that we did not send in the second template parameter Mesh -
-  // it is the default
+  std::array<double, 3> initarray = {0.0, 0.0, 0.0};
 
-  // UniStateVector<std::array<double, 3>>& velocity =
+  state->add<std::array<double, 3>, Mesh, UniStateVector>(force_name,
+                                                          mesh,
+                                                          Entity_kind::NODE,
+                                                          Entity_type::ALL,
+                                                          initarray);
   state->add<std::array<double, 3>, Mesh, UniStateVector>(velocity_name,
                                                           mesh,
                                                           Entity_kind::NODE,
                                                           Entity_type::ALL,
                                                           initarray);
 }
-
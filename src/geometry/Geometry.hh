@@ -50,6 +50,7 @@
 
 
 // using namespace std;
+#include <iostream>
 #include <vector>
 
 #include "Point.hh"
@@ -84,20 +85,20 @@ enum class Geom_type {
 // volumes of tets created by connecting the polyhedron center to
 // a face center and an edge of the face
 
-void polyhed_get_vol_centroid(const std::vector<Point> ccoords,
+void polyhed_get_vol_centroid(const std::vector<Point>& ccoords,
                               const unsigned int nf,
-                              const std::vector<unsigned int> nfnodes,
-                              const std::vector<Point> fcoords,
+                              const std::vector<unsigned int>& nfnodes,
+                              const std::vector<Point>& fcoords,
                               double *volume,
                               Point *centroid);
 
 // Is point in polyhed
 
-bool point_in_polyhed(const Point testpnt,
-                      const std::vector<Point> ccoords,
+bool point_in_polyhed(const Point& testpnt,
+                      const std::vector<Point>& ccoords,
                       const unsigned int nf,
-                      const std::vector<unsigned int> nfnodes,
-                      const std::vector<Point> fcoords);
+                      const std::vector<unsigned int>& nfnodes,
+                      const std::vector<Point>& fcoords);
 
 // Compute area, centroid and normal of polygon
 
@@ -109,7 +110,7 @@ bool point_in_polyhed(const Point testpnt,
 // The normal of a 3D polygon is computed as the sum of the area
 // weighted normals of the triangular facets
 
-void polygon_get_area_centroid_normal(const std::vector<Point> coords,
+void polygon_get_area_centroid_normal(const std::vector<Point>& coords,
                                       double *area, Point *centroid,
                                       Point *normal);
 
@@ -122,19 +123,305 @@ void polygon_get_area_centroid_normal(const std::vector<Point> coords,
 
 // Is point in polygon
 
-bool point_in_polygon(const Point testpnt,
-                      const std::vector<Point> coords);
+bool point_in_polygon(const Point& testpnt,
+                      const std::vector<Point>& coords);
 
 // Compute volume and centroid of 1d segment, accounting for geometry
-void segment_get_vol_centroid(const std::vector<Point> ccoords,
+void segment_get_vol_centroid(const std::vector<Point>& ccoords,
                               Geom_type my_geom_type,
                               double *volume, Point* centroid);
 
 // Compute the face area in a 1d mesh
-void face1d_get_area(const std::vector<Point> fcoords,
+void face1d_get_area(const std::vector<Point>& fcoords,
                      Geom_type my_geom_type,
                      double *area);
 
+
+// Versions of the polygon and polyhedron routines above that take the
+// coordinates as arrays (np points at coords, etc.) instead of
+// vectors, so that callers can pass views into their own storage
+// without allocating. They are templated on the point type P which
+// may be Point or Point_d<D> - with Point_d, the dimension is fixed at
+// compile time and the arithmetic does not branch on it. The integer
+// type of the face node counts is a template parameter as well. The
+// vector versions above call these with P = Point.
+
+template<class P, class Int>
+void polyhed_get_vol_centroid(const int np, const P *ccoords,
+                              const int nf, const Int *nfnodes,
+                              const P *fcoords,
+                              double *volume, P *centroid);
+
+template<class P, class Int>
+bool point_in_polyhed(const P& testpnt, const int np, const P *ccoords,
+                      const int nf, const Int *nfnodes, const P *fcoords);
+
+template<class P>
+void polygon_get_area_centroid_normal(const int np, const P *coords,
+                                      double *area, P *centroid,
+                                      P *normal);
+
+template<class P>
+bool point_in_polygon(const P& testpnt, const int np, const P *coords);
+
+// Template definitions
+
+template<class P, class Int>
+void polyhed_get_vol_centroid(const int np, const P *ccoords,
+                              const int nf, const Int *nfnodes,
+                              const P *fcoords,
+                              double *volume, P *centroid) {
+  bool negvol = false;
+
+  // Initialize to sane values
+
+  centroid->set(0.0);
+  (*volume) = 0.0;
+
+  if (np < 4) {
+    std::cout << "Not a polyhedron" << std::endl;
+    return;
+  }
+
+  if (np == 4) {  // is a tetrahedron
+
+    *centroid = (ccoords[0]+ccoords[1]+ccoords[2]+ccoords[3])/4.0;
+    P v1 = ccoords[1]-ccoords[0];
+    P v2 = ccoords[2]-ccoords[0];
+    P v3 = ccoords[3]-ccoords[0];
+    *volume = (v1^v2)*v3;
+
+  } else {  // if (np > 4), polyhedron with possibly curved faces
+
+    // Compute the geometric center of all nodes
+
+    P center = ccoords[0];
+    for (int i = 1; i < np; ++i)
+      center += ccoords[i];
+    center /= np;
+
+    int offset = 0;
+    for (int i = 0; i < nf; ++i) {
+      const int nfn = nfnodes[i];
+
+      if (nfn == 3) {
+
+        P tcentroid = (center+fcoords[offset]+fcoords[offset+1]+
+                       fcoords[offset+2])/4.0;
+        P v1 = fcoords[offset]-center;
+        P v2 = fcoords[offset+1]-center;
+        P v3 = fcoords[offset+2]-center;
+        double tvolume = (v1^v2)*v3;
+
+        if (tvolume <= 0.0) negvol = true;
+
+        (*centroid) += tvolume*tcentroid;      // sum up 1st moment
+        (*volume) += tvolume;                  // sum up 0th moment
+
+      } else {
+        // geometric center of all face nodes
+
+        P fcenter = fcoords[offset];
+        for (int j = 1; j < nfn; ++j)
+          fcenter += fcoords[offset+j];
+        fcenter /= nfn;
+
+        for (int j = 0; j < nfn; ++j) {  // for each edge of face
+
+          // form tet from edge of face, face center and cell center
+
+          int k = offset+j;
+          int kp1 = offset+(j+1)%nfn;
+
+          P tcentroid = (center+fcenter+fcoords[k]+fcoords[kp1])/4.0;
+          P v1 = fcoords[k]-center;
+          P v2 = fcoords[kp1]-center;
+          P v3 = fcenter-center;
+          double tvolume = (v1^v2)*v3;
+
+          if (tvolume <= 0.0) negvol = true;
+
+          (*centroid) += tvolume*tcentroid;      // sum up 1st moment
+          (*volume) += tvolume;                  // sum up 0th moment
+
+        }  // for each edge of face
+      }
+
+      offset += nfn;
+
+    }  // for each face
+
+    (*centroid) /= (*volume);  // centroid = 1st moment / 0th moment
+  }  // end if (np > 4)
+
+  (*volume) /= 6;  // Account for multiplier here rather than in
+                   // computation of each tet
+
+  if (negvol) {  // one of the subtets was inverted. Label the volume
+                 // total as negative so that calling applications
+                 // understand that this is an invalid element
+    if (*volume > 0.0)
+      (*volume) = -(*volume);
+  }
+}  // polyhed_get_vol_centroid
+
+
+template<class P, class Int>
+bool point_in_polyhed(const P& testpnt, const int np, const P *,
+                      const int nf, const Int *nfnodes, const P *fcoords) {
+  if (np < 4) {
+    std::cout << "Not a polyhedron" << std::endl;
+    return false;
+  }
+
+  int offset = 0;
+  for (int i = 0; i < nf; i++) {
+    const int nfn = nfnodes[i];
+
+    if (nfn == 3) {
+
+      P v1 = fcoords[offset]-testpnt;
+      P v2 = fcoords[offset+1]-testpnt;
+      P v3 = fcoords[offset+2]-testpnt;
+      double tvolume = (v1^v2)*v3;
+
+      if (tvolume < 0.0)
+        return false;
+    } else {
+
+      // geometric center of all face nodes
+
+      P fcenter = fcoords[offset];
+      for (int j = 1; j < nfn; j++)
+        fcenter += fcoords[offset+j];
+      fcenter /= nfn;
+
+      for (int j = 0; j < nfn; ++j) {  // for each edge of face
+
+        // form tet from edge of face, face center and test point
+
+        int k = offset+j;
+        int kp1 = offset+(j+1)%nfn;
+
+        P v1 = fcoords[k]-testpnt;
+        P v2 = fcoords[kp1]-testpnt;
+        P v3 = fcenter-testpnt;
+        double tvolume = (v1^v2)*v3;
+
+        if (tvolume < 0.0)
+          return false;
+
+      }  // for each edge of face
+    }
+
+    offset += nfn;
+
+  }  // for each face
+
+  return true;
+}  // point_in_polyhed
+
+
+template<class P>
+void polygon_get_area_centroid_normal(const int np, const P *coords,
+                                      double *area, P *centroid,
+                                      P *normal) {
+  bool negvol = false;
+
+  (*area) = 0;
+  centroid->set(0.0);
+  normal->set(0.0);
+
+  if (np < 3) {
+    std::cout << "Degenerate polygon - area is zero" << std::endl;
+    return;
+  }
+
+  int dim = coords[0].dim();
+
+  // Compute a center point
+
+  P center = coords[0];
+  for (int i = 1; i < np; i++)
+    center += coords[i];
+  center /= np;
+
+  if (np == 3) {  // triangle - straightforward
+    P v1 = coords[2]-coords[1];
+    P v2 = coords[0]-coords[1];
+
+    (*normal) = 0.5*v1^v2;
+
+    (*area) = norm(*normal);
+    (*centroid) = center;
+  } else {
+    // Compute the area of each triangle formed by
+    // the center point and each polygon edge
+
+    for (int i = 0; i < np; i++) {
+      P v1 = coords[i]-center;
+      P v2 = coords[(i+1)%np]-center;
+
+      P v3 = 0.5*v1^v2;
+
+      double area_temp = norm(v3);
+
+      // In 2D, if the cross-product is negative, the element is inverted
+      // In 3D, validity is a lot more subtle - a polygon in 3D is
+      // "inverted" if its normal deviates "substantially" from the
+      // average normal of the "surface" in that neighborhood - we won't
+      // deal with that judgement here
+
+      if (dim == 2 && v3[0] <= 0.0)
+        negvol = true;
+
+      (*normal) += v3;
+      (*area) += area_temp;
+      (*centroid) += area_temp*(coords[i]+coords[(i+1)%np]+center)/3.0;
+    }
+
+    (*centroid) /= (*area);
+  }
+
+  if (negvol) {  // one of the subtris was inverted or degenerate.
+                 // Label the volume total as negative so that
+                 // calling applications understand that this is an
+                 // invalid element
+    if (*area > 0.0)
+      (*area) = -(*area);
+  }
+}  // polygon_get_area_centroid_normal
+
+
+// Check if point is in polygon by Jordan's crossing algorithm
+
+template<class P>
+bool point_in_polygon(const P& testpnt, const int np, const P *coords) {
+  int c = 0;
+
+  // Basic test - will work for strictly interior and exterior points
+
+  double x = testpnt.x();
+  double y = testpnt.y();
+
+  for (int i = 0; i < np; i++) {
+    int ip1 = (i+1)%np;
+    if (((coords[i].y() > y && coords[ip1].y() <= y) ||
+         (coords[ip1].y() > y && coords[i].y() <= y)) &&
+        (x <= (coords[i].x() + (y-coords[i].y())
+               *(coords[ip1].x()-coords[i].x())
+               /(coords[ip1].y()-coords[i].y()))))
+      c = !c;
+  }
+
+  // If we don't need consistent classification of points on the
+  // boundary, we can quit here.  If the point is classified as
+  // inside, it is definitely inside or on the boundary - no way it
+  // can be outside and be classified as inside
+
+  return (c == 1);
+}
+
 }  // namespace JaliGeometry
 
 
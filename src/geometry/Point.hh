@@ -58,19 +58,129 @@ Authors: Rao Garimella
 #include <vector>
 #include <cmath>
 #include <cassert>
+#include <type_traits>
 
 namespace JaliGeometry {
 
+//! Point (or vector) in a space whose dimension D is known at compile
+//! time. Unlike Point, it carries no runtime dimension, so its
+//! operators are fixed length loops without branches and it is
+//! trivially copyable. The coordinates are zero unless given
+
+template<int D>
+class Point_d {
+ public:
+  static_assert(D >= 1 && D <= 3, "Point_d must have dimension 1, 2 or 3");
+
+  constexpr Point_d() : xyz{} {}
+  constexpr explicit Point_d(const double& x) : xyz{x} {}
+  constexpr Point_d(const double& x, const double& y) : xyz{x, y} {}
+  constexpr Point_d(const double& x, const double& y, const double& z)
+      : xyz{x, y, z} {}
+
+  void set(const double& val) {
+    for (int i = 0; i < D; i++) xyz[i] = val;
+  }
+  void set(const double *val) {
+    assert(val);
+    for (int i = 0; i < D; i++) xyz[i] = val[i];
+  }
+
+  // access members
+  double& operator[] (const int i) { return xyz[i]; }
+  constexpr const double& operator[] (const int i) const { return xyz[i]; }
+
+  constexpr double x() const { return xyz[0]; }
+  constexpr double y() const { return (D > 1) ? xyz[1] : 0.0; }
+  constexpr double z() const { return (D > 2) ? xyz[2] : 0.0; }
+
+  static constexpr int dim() { return D; }
+
+  // operators
+  Point_d& operator+=(const Point_d& p) {
+    for (int i = 0; i < D; i++) xyz[i] += p[i];
+    return *this;
+  }
+  Point_d& operator-=(const Point_d& p) {
+    for (int i = 0; i < D; i++) xyz[i] -= p[i];
+    return *this;
+  }
+  Point_d& operator*=(const double& c) {
+    for (int i = 0; i < D; i++) xyz[i] *= c;
+    return *this;
+  }
+  Point_d& operator/=(const double& c) {
+    for (int i = 0; i < D; i++) xyz[i] /= c;
+    return *this;
+  }
+
+  friend Point_d operator*(const double& r, const Point_d& p) {
+    Point_d rp;
+    for (int i = 0; i < D; i++) rp[i] = r*p[i];
+    return rp;
+  }
+  friend Point_d operator*(const Point_d& p, const double& r) { return r*p; }
+  friend double operator*(const Point_d& p, const Point_d& q) {
+    double s = 0.0;
+    for (int i = 0; i < D; i++) s += p[i]*q[i];
+    return s;
+  }
+
+  friend Point_d operator/(const Point_d& p, const double& r) {
+    return p * (1.0/r);
+  }
+
+  friend Point_d operator+(const Point_d& p, const Point_d& q) {
+    Point_d pq;
+    for (int i = 0; i < D; i++) pq[i] = p[i]+q[i];
+    return pq;
+  }
+  friend Point_d operator-(const Point_d& p, const Point_d& q) {
+    Point_d pq;
+    for (int i = 0; i < D; i++) pq[i] = p[i]-q[i];
+    return pq;
+  }
+  friend Point_d operator-(const Point_d& p) {
+    Point_d mp;
+    for (int i = 0; i < D; i++) mp[i] = -p[i];
+    return mp;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const Point_d& p) {
+    os << p[0];
+    for (int i = 1; i < D; i++) os << " " << p[i];
+    return os;
+  }
+
+ private:
+  double xyz[D];
+};  // end class Point_d
+
+// Cross products. As for Point, the cross product of two 2D vectors
+// is returned as a 2D point whose first component is the (signed)
+// magnitude of the cross product
+
+constexpr Point_d<2> operator^(const Point_d<2>& p, const Point_d<2>& q) {
+  return Point_d<2>(p[0]*q[1] - q[0]*p[1], 0.0);
+}
+constexpr Point_d<3> operator^(const Point_d<3>& p, const Point_d<3>& q) {
+  return Point_d<3>(p[1]*q[2] - p[2]*q[1],
+                    p[2]*q[0] - p[0]*q[2],
+                    p[0]*q[1] - p[1]*q[0]);
+}
+
+template<int D>
+inline double L22(const Point_d<D>& p) { return p*p; }
+template<int D>
+inline double norm(const Point_d<D>& p) { return sqrt(p*p); }
+
+
 class Point {
  public:
   Point() {
     d = 0;
     xyz[0] = xyz[1] = xyz[2] = 0.0;
   }
-  Point(const Point& p) {
-    d = p.d;
-    std::copy(p.xyz, p.xyz+d, xyz);
-  }
   explicit Point(const int N) {
     d = N;
     xyz[0] = xyz[1] = xyz[2] = 0.0;
@@ -79,6 +189,7 @@ class Point {
     d = 2;
     xyz[0] = x;
     xyz[1] = y;
+    xyz[2] = 0.0;
   }
   Point(const double& x, const double& y, const double& z) {
     d = 3;
@@ -86,7 +197,22 @@ class Point {
     xyz[1] = y;
     xyz[2] = z;
   }
-  ~Point() {}
+
+  // Conversions from and to points of a fixed dimension
+
+  template<int D>
+  Point(const Point_d<D>& p) {  // NOLINT - implicit by design
+    d = D;
+    xyz[0] = xyz[1] = xyz[2] = 0.0;
+    for (int i = 0; i < D; i++) xyz[i] = p[i];
+  }
+  template<int D>
+  explicit operator Point_d<D>() const {
+    assert(d == D);
+    Point_d<D> p;
+    for (int i = 0; i < D; i++) p[i] = xyz[i];
+    return p;
+  }
 
   // main members
 
@@ -142,12 +268,6 @@ class Point {
   int dim() const { return d; }
 
   // operators
-  Point& operator=(const Point& p) {
-    d = p.d;
-    std::copy(p.xyz, p.xyz+d, xyz);
-    return *this;
-  }
-
   Point& operator+=(const Point& p) {
     for (int i = 0; i < d; i++) xyz[i] += p[i];
     return *this;
@@ -249,6 +369,11 @@ inline double norm(const Point& p) { return sqrt(p*p); }
 
 typedef std::vector<Point> Point_List;
 
+static_assert(std::is_trivially_copyable<Point>::value,
+              "Point must be trivially copyable");
+static_assert(std::is_trivially_copyable<Point_d<3>>::value,
+              "Point_d must be trivially copyable");
+
 }  // namespace JaliGeometry
 
 #endif
@@ -144,5 +144,50 @@ TEST(Geometric_Ops)
   CHECK_EQUAL(exp_centroid.y(),centroid.y());
   CHECK_EQUAL(exp_centroid.z(),centroid.z());
 
+
+  // Same computations with fixed dimension points passed as arrays
+
+  JaliGeometry::Point_d<3> ccoords3d[8], fcoords3d[24];
+  for (int i = 0; i < 8; i++)
+    ccoords3d[i].set(hex_ccoords1[i]);
+  for (int i = 0; i < nf; i++)
+    for (int j = 0; j < 4; j++)
+      fcoords3d[4*i+j].set(hex_ccoords1[hex_fnodes[i][j]]);
+
+  for (int i = 0; i < nf; i++) {
+    double farea;
+    JaliGeometry::Point_d<3> normal3d, fcentroid3d;
+    JaliGeometry::polygon_get_area_centroid_normal(4, fcoords3d+4*i, &farea,
+                                                   &fcentroid3d, &normal3d);
+    CHECK_EQUAL(1.0, farea);
+    CHECK_EQUAL(exp_hex_fnormals1[i][0], normal3d.x());
+    CHECK_EQUAL(exp_hex_fnormals1[i][1], normal3d.y());
+    CHECK_EQUAL(exp_hex_fnormals1[i][2], normal3d.z());
+  }
+
+  JaliGeometry::Point_d<3> inpnt3d(0.3, 0.4, 0.6), outpnt3d(2.0, 0.4, 0.6);
+  CHECK_EQUAL(true, JaliGeometry::point_in_polyhed(inpnt3d, 8, ccoords3d,
+                                                   nf, nfnodes.data(),
+                                                   fcoords3d));
+  CHECK_EQUAL(false, JaliGeometry::point_in_polyhed(outpnt3d, 8, ccoords3d,
+                                                    nf, nfnodes.data(),
+                                                    fcoords3d));
+
+  JaliGeometry::Point_d<3> centroid3d;
+  JaliGeometry::polyhed_get_vol_centroid(8, ccoords3d, nf, nfnodes.data(),
+                                         fcoords3d, &volume, &centroid3d);
+  CHECK_EQUAL(exp_volume, volume);
+  CHECK_EQUAL(exp_centroid.x(), centroid3d.x());
+  CHECK_EQUAL(exp_centroid.y(), centroid3d.y());
+  CHECK_EQUAL(exp_centroid.z(), centroid3d.z());
+
+  // Point in a 2D polygon
+
+  JaliGeometry::Point_d<2> quad2d[4] = {{0.0, 0.0}, {1.0, 0.0},
+                                        {1.0, 1.0}, {0.0, 1.0}};
+  CHECK_EQUAL(true, JaliGeometry::point_in_polygon(
+      JaliGeometry::Point_d<2>(0.3, 0.4), 4, quad2d));
+  CHECK_EQUAL(false, JaliGeometry::point_in_polygon(
+      JaliGeometry::Point_d<2>(1.3, 0.4), 4, quad2d));
 }
 
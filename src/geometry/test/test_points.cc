@@ -155,3 +155,45 @@ TEST(Point)
 
 }
 
+
+TEST(Point_d)
+{
+  // Points of a fixed dimension can be built at compile time
+
+  constexpr JaliGeometry::Point_d<3> ex(1.0, 0.0, 0.0), ey(0.0, 1.0, 0.0);
+  constexpr JaliGeometry::Point_d<3> ez = ex^ey;
+  static_assert(ez[2] == 1.0, "cross product of ex and ey must be ez");
+  static_assert(JaliGeometry::Point_d<2>::dim() == 2, "wrong dimension");
+
+  JaliGeometry::Point_d<3> p0;
+  CHECK_EQUAL(0.0, p0.x());
+  CHECK_EQUAL(0.0, p0.y());
+  CHECK_EQUAL(0.0, p0.z());
+
+  JaliGeometry::Point_d<3> p1(0.4, 0.6, 0.8), p2(1.0, 2.0, 3.5);
+
+  // Arithmetic must match that of Point
+
+  JaliGeometry::Point q1(0.4, 0.6, 0.8), q2(1.0, 2.0, 3.5);
+  JaliGeometry::Point_d<3> p3 = 0.5*(p1+p2)-p2/3.0;
+  JaliGeometry::Point q3 = 0.5*(q1+q2)-q2/3.0;
+  for (int i = 0; i < 3; i++)
+    CHECK_EQUAL(q3[i], p3[i]);
+  CHECK_EQUAL(q1*q2, p1*p2);
+  CHECK_EQUAL(norm(q1^q2), norm(p1^p2));
+
+  JaliGeometry::Point_d<2> r1(0.4, 0.6), r2(1.0, 2.0);
+  JaliGeometry::Point s1(0.4, 0.6), s2(1.0, 2.0);
+  CHECK_EQUAL((s1^s2)[0], (r1^r2)[0]);
+  CHECK_EQUAL(L22(s1-s2), L22(r1-r2));
+
+  // Conversions to and from Point
+
+  JaliGeometry::Point q4 = p2;
+  CHECK_EQUAL(3, q4.dim());
+  CHECK_EQUAL(3.5, q4.z());
+
+  JaliGeometry::Point_d<2> r3 = static_cast<JaliGeometry::Point_d<2>>(s2);
+  CHECK_EQUAL(1.0, r3.x());
+  CHECK_EQUAL(2.0, r3.y());
+}
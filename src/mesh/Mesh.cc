@@ -58,7 +58,12 @@
 
 #include <cmath>
 #include <vector>
+#include <array>
+#include <algorithm>
 #include <cassert>
+#include <atomic>
+#include <memory>
+#include <cstdint>
 
 #include "Geometry.hh"
 #include "errors.hh"
@@ -70,9 +75,53 @@
 #include "LogicalRegion.hh"
 #include "MeshTile.hh"
 #include "MeshSet.hh"
+#include "mesh_threads.hh"
+#include "scratch_arena.hh"
+#include "cell_geometry.hh"
 
 namespace Jali {
 
+// Transpose a one-to-many relationship in CSR form (e.g. cells to
+// nodes into nodes to cells) using a counting sort. The entities
+// listed for each target entity come out in ascending order
+
+static void transpose_adjacency(int const ntargets,
+                                std::vector<int> const& offsets,
+                                Entity_ID_List const& ids,
+                                std::vector<int> *toffsets,
+                                Entity_ID_List *tids) {
+  int nsources = offsets.size() - 1;
+
+  toffsets->assign(ntargets+1, 0);
+  for (auto const& id : ids)
+    ++(*toffsets)[id+1];
+  for (int i = 0; i < ntargets; i++)
+    (*toffsets)[i+1] += (*toffsets)[i];
+
+  std::vector<int> next(toffsets->begin(), toffsets->end()-1);
+  tids->resize(ids.size());
+  for (int i = 0; i < nsources; i++)
+    for (int k = offsets[i]; k < offsets[i+1]; k++)
+      (*tids)[next[ids[k]]++] = i;
+}
+
+// Copy the entities of a cached adjacency list that are of parallel
+// type 'ptype' (all of them if ptype is ALL), preserving their order
+
+static void copy_entities_of_type(Entity_ID_View entities,
+                                  Entity_type const ptype,
+                                  std::vector<Entity_type> const& enttypes,
+                                  Entity_ID_List *entids) {
+  if (ptype == Entity_type::ALL) {
+    entids->assign(entities.begin(), entities.end());  // copy operation
+  } else {
+    entids->clear();
+    for (auto const& e : entities)
+      if (enttypes[e] == ptype)
+        entids->push_back(e);
+  }
+}
+
 // Gather and cache type info for cells, faces, edges and nodes.
 // The parallel type for other entities is derived
 
@@ -110,6 +159,67 @@ void Mesh::cache_type_info() const {
   type_info_cached = true;
 }
 
+// Gather and cache the types (TRI, QUAD, HEX, ...) of the cells
+
+void Mesh::cache_celltype_info() const {
+  int ncells = num_cells<Entity_type::ALL>();
+  cell_celltypes_.resize(ncells);
+  for (int c = 0; c < ncells; c++)
+    cell_celltypes_[c] = cell_get_type(c);
+
+  celltype_info_cached = true;
+}
+
+// Gather and cache cell to node connectivity info.
+//
+// Method is declared constant because it is not modifying the mesh
+// itself; rather it is modifying mutable data structures - see
+// declaration of Mesh class for further explanation
+
+void Mesh::cache_cell2node_info() const {
+  int ncells = num_cells<Entity_type::ALL>();
+
+  Entity_ID_List cnodes;
+
+  cell_node_offsets.resize(ncells+1);
+  cell_node_offsets[0] = 0;
+  cell_node_ids.clear();
+  for (int c = 0; c < ncells; c++) {
+    cell_get_nodes_internal(c, &cnodes);
+    cell_node_ids.insert(cell_node_ids.end(), cnodes.begin(), cnodes.end());
+    cell_node_offsets[c+1] = cell_node_ids.size();
+  }
+  cell_node_ids.shrink_to_fit();
+
+  cell2node_info_cached = true;
+}
+
+// Gather and cache face to node connectivity info. The nodes are
+// stored in the order returned by the framework, i.e. with the
+// direction of the face (see face_get_nodes) already accounted for
+//
+// Method is declared constant because it is not modifying the mesh
+// itself; rather it is modifying mutable data structures - see
+// declaration of Mesh class for further explanation
+
+void Mesh::cache_face2node_info() const {
+  int nfaces = num_faces<Entity_type::ALL>();
+
+  Entity_ID_List fnodes;
+
+  face_node_offsets.resize(nfaces+1);
+  face_node_offsets[0] = 0;
+  face_node_ids.clear();
+  for (int f = 0; f < nfaces; f++) {
+    face_get_nodes_internal(f, &fnodes);
+    face_node_ids.insert(face_node_ids.end(), fnodes.begin(), fnodes.end());
+    face_node_offsets[f+1] = face_node_ids.size();
+  }
+  face_node_ids.shrink_to_fit();
+
+  face2node_info_cached = true;
+}
+
 // Gather and cache cell to face connectivity info.
 //
 // Method is declared constant because it is not modifying the mesh
@@ -118,12 +228,26 @@ void Mesh::cache_type_info() const {
 
 void Mesh::cache_cell2face_info() const {
   int ncells = num_cells<Entity_type::ALL>();
-  cell_face_ids.resize(ncells);
-  cell_face_dirs.resize(ncells);
 
-  for (int c = 0; c < ncells; c++)
-    cell_get_faces_and_dirs_internal(c, &(cell_face_ids[c]),
-                                     &(cell_face_dirs[c]), false);
+  // Query the framework once per cell into reusable buffers and
+  // append the results to the contiguous CSR arrays. The offsets are
+  // the running sum of the number of faces of each cell
+
+  Entity_ID_List cfaces;
+  std::vector<dir_t> cfdirs;
+
+  cell_face_offsets.resize(ncells+1);
+  cell_face_offsets[0] = 0;
+  cell_face_ids.clear();
+  cell_face_dirs_.clear();
+  for (int c = 0; c < ncells; c++) {
+    cell_get_faces_and_dirs_internal(c, &cfaces, &cfdirs, false);
+    cell_face_ids.insert(cell_face_ids.end(), cfaces.begin(), cfaces.end());
+    cell_face_dirs_.insert(cell_face_dirs_.end(), cfdirs.begin(), cfdirs.end());
+    cell_face_offsets[c+1] = cell_face_ids.size();
+  }
+  cell_face_ids.shrink_to_fit();
+  cell_face_dirs_.shrink_to_fit();
 
   cell2face_info_cached = true;
 }
@@ -137,19 +261,19 @@ void Mesh::cache_cell2face_info() const {
 
 void Mesh::cache_face2cell_info() const {
   int nfaces = num_faces<Entity_type::ALL>();
-  face_cell_ids.resize(nfaces);
+
+  // Every face has at most two cells, so the cells of face 'f' are
+  // stored in slots 2*f and 2*f+1 with -1 marking a missing cell
+
+  face_cell_ids.assign(2*nfaces, -1);
 
   std::vector<Entity_ID> fcells;
 
   for (int f = 0; f < nfaces; f++) {
     face_get_cells_internal(f, Entity_type::ALL, &fcells);
 
-    face_cell_ids[f].resize(2);
-
     for (int i = 0; i < fcells.size(); ++i)
-      face_cell_ids[f][i] = fcells[i];
-    for (int i = fcells.size(); i < 2; i++)
-      face_cell_ids[f][i] = -1;
+      face_cell_ids[2*f+i] = fcells[i];
   }
 
   face2cell_info_cached = true;
@@ -163,12 +287,22 @@ void Mesh::cache_face2cell_info() const {
 
 void Mesh::cache_face2edge_info() const {
   int nfaces = num_faces<Entity_type::ALL>();
-  face_edge_ids.resize(nfaces);
-  face_edge_dirs.resize(nfaces);
 
-  for (int f = 0; f < nfaces; ++f)
-    face_get_edges_and_dirs_internal(f, &(face_edge_ids[f]),
-                                     &(face_edge_dirs[f]), true);
+  Entity_ID_List fedges;
+  std::vector<dir_t> fedirs;
+
+  face_edge_offsets.resize(nfaces+1);
+  face_edge_offsets[0] = 0;
+  face_edge_ids.clear();
+  face_edge_dirs_.clear();
+  for (int f = 0; f < nfaces; ++f) {
+    face_get_edges_and_dirs_internal(f, &fedges, &fedirs, true);
+    face_edge_ids.insert(face_edge_ids.end(), fedges.begin(), fedges.end());
+    face_edge_dirs_.insert(face_edge_dirs_.end(), fedirs.begin(), fedirs.end());
+    face_edge_offsets[f+1] = face_edge_ids.size();
+  }
+  face_edge_ids.shrink_to_fit();
+  face_edge_dirs_.shrink_to_fit();
 
   face2edge_info_cached = true;
 }
@@ -181,20 +315,29 @@ void Mesh::cache_face2edge_info() const {
 
 void Mesh::cache_cell2edge_info() const {
   int ncells = num_cells<Entity_type::ALL>();
-  cell_edge_ids.resize(ncells);
 
-  if (space_dim_ == 1) {
-    for (auto const& c : cells())
-      cell_get_nodes(c, &(cell_edge_ids[c]));   // edges are same as nodes
-  } else if (space_dim_ == 2) {
-    cell_2D_edge_dirs.resize(ncells);
-    for (auto const& c : cells())
-      cell_2D_get_edges_and_dirs_internal(c, &(cell_edge_ids[c]),
-                                          &(cell_2D_edge_dirs[c]));
-  } else if (space_dim_ == 3) {
-    for (auto const& c : cells())
-      cell_get_edges_internal(c, &(cell_edge_ids[c]));
+  Entity_ID_List cedges;
+  std::vector<dir_t> cedirs;
+
+  cell_edge_offsets.resize(ncells+1);
+  cell_edge_offsets[0] = 0;
+  cell_edge_ids.clear();
+  cell_2D_edge_dirs_.clear();
+  for (int c = 0; c < ncells; c++) {
+    if (space_dim_ == 1)
+      cell_get_nodes_internal(c, &cedges);   // edges are same as nodes
+    else if (space_dim_ == 2) {
+      cell_2D_get_edges_and_dirs_internal(c, &cedges, &cedirs);
+      cell_2D_edge_dirs_.insert(cell_2D_edge_dirs_.end(), cedirs.begin(),
+                               cedirs.end());
+    } else if (space_dim_ == 3)
+      cell_get_edges_internal(c, &cedges);
+
+    cell_edge_ids.insert(cell_edge_ids.end(), cedges.begin(), cedges.end());
+    cell_edge_offsets[c+1] = cell_edge_ids.size();
   }
+  cell_edge_ids.shrink_to_fit();
+  cell_2D_edge_dirs_.shrink_to_fit();
 
   cell2edge_info_cached = true;
 }
@@ -232,72 +375,154 @@ void Mesh::cache_side_info() const {
   int ncells_bndry_ghost = num_cells<Entity_type::BOUNDARY_GHOST>();
   int ncells = ncells_owned + ncells_ghost + ncells_bndry_ghost;
 
-  cell_side_ids.resize(ncells);
+  // Sides are numbered cell by cell in the order of cells(), i.e.
+  // sides of owned cells, then sides of ghost cells and then sides of
+  // boundary ghost cells.
+  //
+  // First pass - count the sides in each cell so that the CSR arrays
+  // can be allocated exactly once. The counts are kept both by cell
+  // ID (cell_side_offsets) and by position of the cell in cells()
+  // (cell_side_start) and turned into offsets by a prefix sum. The
+  // second pass fills in the side info of each cell starting at its
+  // offset. This way the cells can be processed by many threads and
+  // still get the same side IDs as in a serial run
 
+  std::vector<Entity_ID> const& cellids = cells();
 
-  int num_sides_all = 0;
-  int num_sides_owned = 0;
-  int num_sides_ghost = 0;
-  int num_sides_bndry_ghost = 0;
+  cell_side_offsets.assign(ncells+1, 0);
+  std::vector<int> cell_side_start(ncells+1, 0);
 
   if (manifold_dim_ == 1) {  // in 1D there are always 2 sides per cell
-    num_sides_all = 2*ncells;
-    num_sides_owned = 2*ncells_owned;
-    num_sides_ghost = 2*ncells_ghost;
-    num_sides_bndry_ghost = 2*ncells_bndry_ghost;
-
     for (auto const & c : cells())
-      cell_side_ids[c].reserve(2);
+      cell_side_offsets[c+1] = 2;
+    for (int i = 0; i < ncells; ++i)
+      cell_side_start[i+1] = 2;
   } else {
-    for (auto const & c : cells()) {
-      std::vector<Entity_ID> cfaces;
-      cell_get_faces(c, &cfaces);
-      
-      int numsides_in_cell = 0;
-      for (auto const & f : cfaces) {
-        std::vector<Entity_ID> fedges;
-        std::vector<dir_t> fedirs;
-        face_get_edges_and_dirs(f, &fedges, &fedirs);
-        
-        int nfedges = fedges.size();
-        num_sides_all += nfedges;  // In 2D there is 1 edge per face
-        numsides_in_cell += nfedges;
-        
-        if (cell_type[c] == Entity_type::PARALLEL_OWNED)
-          num_sides_owned += nfedges;
-        else if (cell_type[c] == Entity_type::PARALLEL_GHOST)
-          num_sides_ghost += nfedges;
-        else if (cell_type[c] == Entity_type::BOUNDARY_GHOST)
-          num_sides_bndry_ghost += nfedges;
-      }
+    // Build everything the threads need up front - they cannot build
+    // cached info themselves while this thread holds the cache lock
+
+    build_once(cell2face_info_cached, &Mesh::cache_cell2face_info);
+    build_once(face2cell_info_cached, &Mesh::cache_face2cell_info);
+    build_once(face2edge_info_cached, &Mesh::cache_face2edge_info);
+    build_once(edge2node_info_cached, &Mesh::cache_edge2node_info);
+
+    parallel_for(ncells, [&](int i) {
+        Entity_ID c = cellids[i];
+        int numsides_in_cell = 0;
+        for (int j = cell_face_offsets[c]; j < cell_face_offsets[c+1]; ++j) {
+          Entity_ID f = cell_face_ids[j];
+          // In 2D there is 1 edge per face
+          numsides_in_cell += face_edge_offsets[f+1] - face_edge_offsets[f];
+        }
+        cell_side_offsets[c+1] = numsides_in_cell;
+        cell_side_start[i+1] = numsides_in_cell;
+      });
+  }
 
-      cell_side_ids[c].reserve(numsides_in_cell);
-    }
+  // Sides are numbered implicitly if requested. This needs the cells
+  // to be in ID order in cells() so that the sides of a cell c are
+  // cell_side_offsets[c] to cell_side_offsets[c+1]-1, and 1D sides
+  // are always stored. If that is not the case say so and store the
+  // sides explicitly (implicit_subcells() then returns false)
+
+  implicit_sides_ = false;
+  if (implicit_subcells_) {
+    bool in_order = (manifold_dim_ > 1);
+    for (int i = 0; i < ncells && in_order; ++i)
+      if (cellids[i] != i) in_order = false;
+    if (in_order)
+      implicit_sides_ = true;
+    else
+      std::cerr << "Mesh::cache_side_info() - " <<
+          "Cannot number sides and wedges implicitly " <<
+          (manifold_dim_ == 1 ? "in 1D" : "with cells out of ID order") <<
+          " - storing them explicitly\n";
   }
 
-  sideids_owned_.resize(num_sides_owned);
-  sideids_ghost_.resize(num_sides_ghost);
-  sideids_boundary_ghost_.resize(num_sides_bndry_ghost);
+  parallel_partial_sum(&cell_side_offsets);
+  int num_sides_all = parallel_partial_sum(&cell_side_start);
+  nsides_owned_ = cell_side_start[ncells_owned];
+  nsides_ghost_ = cell_side_start[ncells_owned+ncells_ghost] - nsides_owned_;
+  nsides_boundary_ghost_ = num_sides_all - nsides_owned_ - nsides_ghost_;
+
   sideids_all_.resize(num_sides_all);
-  side_edge_id.resize(num_sides_all, -1);
-  side_edge_use.resize(num_sides_all, true);
-  side_face_id.resize(num_sides_all, -1);
-  side_cell_id.resize(num_sides_all, -1);
-  side_opp_side_id.resize(num_sides_all, -1);
-  //  side_node_ids.resize(num_sides_all, {-1, -1});  // intel 15.0.3 does not like this
-  side_node_ids.resize(num_sides_all);
 
-  if (manifold_dim_ == 1) {
+  if (!implicit_sides_) {
+    sideids_owned_.resize(nsides_owned_);
+    sideids_ghost_.resize(nsides_ghost_);
+    sideids_boundary_ghost_.resize(nsides_boundary_ghost_);
+    cell_side_ids.resize(num_sides_all);
+    side_edge_id.resize(num_sides_all, -1);
+    side_edge_use.resize(num_sides_all, true);
+    side_face_id.resize(num_sides_all, -1);
+    side_cell_id.resize(num_sides_all, -1);
+    side_opp_side_id.resize(num_sides_all, -1);
+    //  side_node_ids.resize(num_sides_all, {-1, -1});  // intel 15.0.3 does not like this
+    side_node_ids.resize(num_sides_all);
+  }
+
+  if (implicit_sides_) {
+    // Only the per cell face tables that locate a side are built (see
+    // cell_face_side_offsets). The sides of a cell face follow the
+    // edges of the face in the same order in both cells of the face,
+    // so the opposite side is found from the position of the face in
+    // the other cell
+
+    int ncfaces = cell_face_offsets[ncells];
+    cell_face_side_offsets.assign(ncfaces+1, 0);
+    cell_face_cell_ids.resize(ncfaces);
+    cell_face_opp_pos.resize(ncfaces);
+
+    parallel_for(ncells, [&](int c) {
+        for (int j = cell_face_offsets[c]; j < cell_face_offsets[c+1]; ++j) {
+          Entity_ID f = cell_face_ids[j];
+          cell_face_side_offsets[j+1] =
+              face_edge_offsets[f+1] - face_edge_offsets[f];
+          cell_face_cell_ids[j] = c;
+          cell_face_opp_pos[j] = -1;
+          for (auto const& c2 : face_cells(f)) {
+            if (c2 == c) continue;
+            for (int j2 = cell_face_offsets[c2]; j2 < cell_face_offsets[c2+1];
+                 ++j2)
+              if (cell_face_ids[j2] == f) {
+                cell_face_opp_pos[j] = j2;
+                break;
+              }
+          }
+        }
+        for (Entity_ID s = cell_side_offsets[c]; s < cell_side_offsets[c+1];
+             ++s)
+          sideids_all_[s] = s;
+      });
+
+    // If all faces have the same number of edges (always so in 2D)
+    // the cell face of a side is a division, otherwise it is stored
+
+    nedges_per_face_ = ncfaces ? cell_face_side_offsets[1] : 0;
+    for (int j = 1; j < ncfaces && nedges_per_face_; ++j)
+      if (cell_face_side_offsets[j+1] != nedges_per_face_)
+        nedges_per_face_ = 0;
+
+    parallel_partial_sum(&cell_face_side_offsets);
+
+    if (!nedges_per_face_) {
+      side_cell_face_pos.resize(num_sides_all);
+      parallel_for(ncfaces, [&](int j) {
+          for (int s = cell_face_side_offsets[j];
+               s < cell_face_side_offsets[j+1]; ++s)
+            side_cell_face_pos[s] = j;
+        });
+    }
+  } else if (manifold_dim_ == 1) {
     int iall = 0, iown = 0, ighost = 0, ibndry = 0;
     for (auto const& c : cells()) {
       // always 2 sides per cell
       int sideid = 2*c;
       
-      Entity_ID_List nodeids;
-      cell_get_nodes(c, &nodeids);
+      Entity_ID_View nodeids = cell_nodes(c);
       
-      cell_side_ids[c].push_back(sideid);
-      cell_side_ids[c].push_back(sideid+1);
+      cell_side_ids[cell_side_offsets[c]] = sideid;
+      cell_side_ids[cell_side_offsets[c]+1] = sideid+1;
       sideids_all_[iall++] = sideid;
       sideids_all_[iall++] = sideid+1;
       if (cell_type[c] == Entity_type::PARALLEL_OWNED) {
@@ -332,314 +557,1359 @@ void Mesh::cache_side_info() const {
                                     -1 : sideid+2;
     }
   } else {
-    int nedges = num_edges<Entity_type::ALL>();
-    std::vector<std::vector<Entity_ID>> sides_of_edge(nedges);  // Temp. var.
+    int ghost_start = nsides_owned_;
+    int bndry_ghost_start = nsides_owned_ + nsides_ghost_;
+
+    parallel_for(ncells, [&](int i) {
+        Entity_ID c = cellids[i];
+        Entity_ID sideid = cell_side_start[i];
+        int icside = cell_side_offsets[c];
+        for (int j = cell_face_offsets[c]; j < cell_face_offsets[c+1]; ++j) {
+          Entity_ID f = cell_face_ids[j];
+          int fdir = cell_face_dirs_[j];  // -1/1
+
+          for (int k = face_edge_offsets[f]; k < face_edge_offsets[f+1]; ++k) {
+            Entity_ID e = face_edge_ids[k];
+            int edir = face_edge_dirs_[k];  // -1/1
+
+            Entity_ID enodes[2];
+            edge_get_nodes(e, &(enodes[0]), &(enodes[1]));
+
+            if (manifold_dim_ == 2) {  // 2D
+              side_node_ids[sideid][0] = (fdir == 1) ? enodes[0] : enodes[1];
+              side_node_ids[sideid][1] = (fdir == 1) ? enodes[1] : enodes[0];
+              side_edge_use[sideid] = (fdir == 1) ? true : false;
+            } else {  // 3D
+
+              // In 3D, if the cell uses the face in the +ve dir
+              // (normal pointing out) and the face is using the edge
+              // in the +ve dir, then the side will use the edge in
+              // the -ve dir, because we want the facet formed by side
+              // point 0, side point 1 and face center for the side to
+              // have a normal pointing into the cell
+
+              int fdir01 = (fdir+1)/2;  // convert from -1/1 to 0/1
+              int edir01 = (edir+1)/2;
+              int dir = fdir01^edir01;  // gives 0 if both are same
+              side_node_ids[sideid][0] = dir ? enodes[0] : enodes[1];
+              side_node_ids[sideid][1] = dir ? enodes[1] : enodes[0];
+              side_edge_use[sideid] = dir ? true : false;
+            }
 
-    int sideid = 0;
-    int iall = 0, iown = 0, ighost = 0, ibndry = 0;
-    for (auto const & c : cells()) {
-      std::vector<Entity_ID> cfaces;
-      std::vector<dir_t> cfdirs;
-      cell_get_faces_and_dirs(c, &cfaces, &cfdirs);
-      
-      Entity_ID_List::iterator itf = cfaces.begin();
-      std::vector<dir_t>::iterator itfd = cfdirs.begin();
-      while (itf != cfaces.end()) {
-        Entity_ID f = *itf;
-        int fdir = *itfd;  // -1/1
-        
-        Entity_ID_List fedges;
-        std::vector<dir_t> fedirs;
-        face_get_edges_and_dirs(f, &fedges, &fedirs);
-        
-        Entity_ID_List::iterator ite = fedges.begin();
-        std::vector<dir_t>::iterator ited = fedirs.begin();
-        while (ite != fedges.end()) {
-          Entity_ID e = *ite;
-          int edir = *ited;  // -1/1
-          
-          Entity_ID enodes[2];
-          edge_get_nodes(e, &(enodes[0]), &(enodes[1]));
-
-          if (manifold_dim_ == 2) {  // 2D
-            side_node_ids[sideid][0] = (fdir == 1) ? enodes[0] : enodes[1];
-            side_node_ids[sideid][1] = (fdir == 1) ? enodes[1] : enodes[0];
-            side_edge_use[sideid] = (fdir == 1) ? true : false;
-          } else {  // 3D
-            
-            // In 3D, if the cell uses the face in the +ve dir (normal
-            // pointing out) and the face is using the edge in the +ve
-            // dir, then the side will use the edge in the -ve dir,
-            // because we want the facet formed by side point 0, side
-            // point 1 and face center for the side to have a normal
-            // pointing into the cell
-            
-            int fdir01 = (fdir+1)/2;  // convert from -1/1 to 0/1
-            int edir01 = (edir+1)/2;
-            int dir = fdir01^edir01;  // gives 0 if both are same
-            side_node_ids[sideid][0] = dir ? enodes[0] : enodes[1];
-            side_node_ids[sideid][1] = dir ? enodes[1] : enodes[0];
-            side_edge_use[sideid] = dir ? true : false;
+            side_edge_id[sideid] = e;
+            side_face_id[sideid] = f;
+            side_cell_id[sideid] = c;
+            cell_side_ids[icside++] = sideid;
 
-          }
-            
-          side_edge_id[sideid] = e;
-          side_face_id[sideid] = f;
-          side_cell_id[sideid] = c;
-          cell_side_ids[c].push_back(sideid);
-          
-          sideids_all_[iall++] = sideid;
-          if (cell_type[c] == Entity_type::PARALLEL_OWNED)
-            sideids_owned_[iown++] = sideid;
-          else if (cell_type[c] == Entity_type::BOUNDARY_GHOST)
-            sideids_boundary_ghost_[ibndry++] = sideid;
-          else
-            sideids_ghost_[ighost++] = sideid;
-          
-          // See if any of the other sides attached to the edge
-          // shares the same edge and face but is in the
-          // adjacent cell. This is called the opposite side
-          
-          for (auto const& s2 : sides_of_edge[e]) {
-            if (side_edge_id[s2] == e && side_face_id[s2] == f &&
-                side_cell_id[s2] != c) {
-              side_opp_side_id[sideid] = s2;
-              side_opp_side_id[s2] = sideid;
+            sideids_all_[sideid] = sideid;
+            if (cell_type[c] == Entity_type::PARALLEL_OWNED)
+              sideids_owned_[sideid] = sideid;
+            else if (cell_type[c] == Entity_type::BOUNDARY_GHOST)
+              sideids_boundary_ghost_[sideid-bndry_ghost_start] = sideid;
+            else
+              sideids_ghost_[sideid-ghost_start] = sideid;
+
+            sideid++;
+          }  // for (k : face edges)
+        }  // for (j : cell faces)
+      });
+
+    // The opposite side of a side is the side of the adjacent cell
+    // across the face that shares the same edge and face
+
+    parallel_for(num_sides_all, [&](int s) {
+        Entity_ID c = side_cell_id[s];
+        Entity_ID f = side_face_id[s];
+        Entity_ID e = side_edge_id[s];
+        for (auto const& c2 : face_cells(f)) {
+          if (c2 == c) continue;
+          for (int k = cell_side_offsets[c2]; k < cell_side_offsets[c2+1];
+               ++k) {
+            Entity_ID s2 = cell_side_ids[k];
+            if (side_edge_id[s2] == e && side_face_id[s2] == f) {
+              side_opp_side_id[s] = s2;
               break;
             }
           }
-          sides_of_edge[e].push_back(sideid);
-
-          sideid++;
-
-          ++ite;
-          ++ited;
-        }  // while (ite != fedges.end())
-        
-        ++itf;
-        ++itfd;
-      }  // while (itf != cfaces.end())
-    }  // for (c : cells())
+        }
+      });
   }  // if (manifold_dim_)
 
   side_info_cached = true;
 }  // cache_side_info
 
 
-// Gather and cache wedge information
+// Lists of owned, ghost and boundary ghost sides. They are filled in
+// with the side tables unless the sides are numbered implicitly, in
+// which case they are the consecutive ranges of sideids_all_ and only
+// built if asked for
+
+void Mesh::cache_side_lists() const {
+  build_once(side_info_cached, &Mesh::cache_side_info);
+
+  if (implicit_sides_) {
+    auto first = sideids_all_.begin();
+    sideids_owned_.assign(first, first + nsides_owned_);
+    sideids_ghost_.assign(first + nsides_owned_,
+                          first + nsides_owned_ + nsides_ghost_);
+    sideids_boundary_ghost_.assign(first + nsides_owned_ + nsides_ghost_,
+                                   sideids_all_.end());
+  }
+
+  side_lists_cached = true;
+}  // cache_side_lists
+
+
+// Gather and cache wedge information. The wedges of side s are 2*s
+// and 2*s+1, so the wedge lists follow directly from the side lists
+
+void Mesh::cache_wedge_info() const {
+  build_once(side_lists_cached, &Mesh::cache_side_lists);
+
+  auto wedges_of_sides = [](std::vector<Entity_ID> const& sideids,
+                            std::vector<Entity_ID> *wedgeids) {
+    wedgeids->resize(2*sideids.size());
+    parallel_for(sideids.size(), [&](int i) {
+        (*wedgeids)[2*i] = 2*sideids[i];
+        (*wedgeids)[2*i+1] = 2*sideids[i] + 1;
+      });
+  };
+
+  wedges_of_sides(sideids_owned_, &wedgeids_owned_);
+  wedges_of_sides(sideids_ghost_, &wedgeids_ghost_);
+  wedges_of_sides(sideids_boundary_ghost_, &wedgeids_boundary_ghost_);
+
+  // sideids_all_ lists the owned, ghost and boundary ghost sides in
+  // that order, so wedgeids_all_ does so too
+
+  wedges_of_sides(sideids_all_, &wedgeids_all_);
+
+  // filled when building corners (wedge_cell_node_pos is used instead
+  // if the sides are numbered implicitly)
+  if (!implicit_sides_)
+    wedge_corner_id.assign(wedgeids_all_.size(), -1);
+
+  wedge_info_cached = true;
+}  // cache_wedge_info
+
+
+void Mesh::cache_corner_info() const {
+  build_once(side_info_cached, &Mesh::cache_side_info);
+  if (!implicit_sides_)  // for wedge_corner_id
+    build_once(wedge_info_cached, &Mesh::cache_wedge_info);
+  build_once(cell2node_info_cached, &Mesh::cache_cell2node_info);
+  build_once(edge2node_info_cached, &Mesh::cache_edge2node_info);
+
+  int ncells_owned = num_cells<Entity_type::PARALLEL_OWNED>();
+  int ncells_ghost = num_cells<Entity_type::PARALLEL_GHOST>();
+  int ncells_boundary_ghost = num_cells<Entity_type::BOUNDARY_GHOST>();
+  int ncells = ncells_owned + ncells_ghost + ncells_boundary_ghost;
+
+  int nnodes_owned = num_nodes<Entity_type::PARALLEL_OWNED>();
+  int nnodes_ghost = num_nodes<Entity_type::PARALLEL_GHOST>();
+  int nnodes = nnodes_owned + nnodes_ghost;
+
+  // Corners are numbered cell by cell in the order of cells() (see
+  // cache_side_info) with one corner per node of the cell.
+  //
+  // First pass - count the corners (and the wedges, since every wedge
+  // belongs to exactly one corner) of each cell and the corners of
+  // each node so that the CSR arrays can be allocated exactly
+  // once. As for the sides, prefix sums of the counts give each cell
+  // its starting offsets for the second pass
+
+  std::vector<Entity_ID> const& cellids = cells();
+
+  cell_corner_offsets.assign(ncells+1, 0);
+  node_corner_offsets.assign(nnodes+1, 0);
+  std::vector<int> cell_corner_start(ncells+1, 0);
+  std::vector<int> cell_wedge_start(ncells+1, 0);
+
+  // Number of corners of each node counted/placed so far - updated
+  // atomically because many cells share a node
+
+  std::unique_ptr<std::atomic<int>[]> nnode_corners(
+      new std::atomic<int>[nnodes]);
+  parallel_for(nnodes, [&](int n) { nnode_corners[n] = 0; });
+
+  parallel_for(ncells, [&](int i) {
+      Entity_ID c = cellids[i];
+      Entity_ID_View cnodes = cell_nodes(c);
+      cell_corner_offsets[c+1] = cnodes.size();
+      cell_corner_start[i+1] = cnodes.size();  // as many corners as nodes
+      cell_wedge_start[i+1] = 2*(cell_side_offsets[c+1] -
+                                 cell_side_offsets[c]);
+      for (auto const& n : cnodes)
+        nnode_corners[n].fetch_add(1, std::memory_order_relaxed);
+    });
+
+  parallel_for(nnodes, [&](int n) {
+      node_corner_offsets[n+1] = nnode_corners[n];
+      nnode_corners[n] = 0;
+    });
+
+  parallel_partial_sum(&cell_corner_offsets);
+  parallel_partial_sum(&node_corner_offsets);
+  int num_corners_all = parallel_partial_sum(&cell_corner_start);
+  int num_wedges_all = parallel_partial_sum(&cell_wedge_start);
+  int num_corners_owned = cell_corner_start[ncells_owned];
+  int num_corners_ghost =
+      cell_corner_start[ncells_owned+ncells_ghost] - num_corners_owned;
+  int num_corners_boundary_ghost =
+      num_corners_all - num_corners_owned - num_corners_ghost;
+
+  cornerids_owned_.resize(num_corners_owned);
+  cornerids_ghost_.resize(num_corners_ghost);
+  cornerids_boundary_ghost_.resize(num_corners_boundary_ghost);
+  cornerids_all_.resize(num_corners_all);
+  cell_corner_ids.resize(num_corners_all);
+  node_corner_ids.resize(num_corners_all);
+
+  corner_wedge_offsets.resize(num_corners_all+1);
+  corner_wedge_offsets[0] = 0;
+  corner_wedge_ids.resize(num_wedges_all);
+  if (implicit_sides_)
+    wedge_cell_node_pos.resize(num_wedges_all);
+
+  // Second pass - fill in the CSR arrays
+
+  int ghost_start = num_corners_owned;
+  int boundary_ghost_start = num_corners_owned + num_corners_ghost;
+
+  parallel_for(ncells, [&](int i) {
+      Entity_ID c = cellids[i];
+      Entity_ID_View cnodes = cell_nodes(c);
+      Entity_ID_View csides = cell_sides(c);
+
+      Entity_ID cornerid = cell_corner_start[i];
+      int icwedge = cell_wedge_start[i];
+      int iccorner = cell_corner_offsets[c];
+      int icnode = 0;
+      for (auto const& n : cnodes) {
+        cell_corner_ids[iccorner++] = cornerid;
+
+        int incorner = nnode_corners[n].fetch_add(1,
+                                                  std::memory_order_relaxed);
+        node_corner_ids[node_corner_offsets[n] + incorner] = cornerid;
+
+        cornerids_all_[cornerid] = cornerid;
+        if (cell_type[c] == Entity_type::PARALLEL_OWNED)
+          cornerids_owned_[cornerid] = cornerid;
+        else if (cell_type[c] == Entity_type::PARALLEL_GHOST)
+          cornerids_ghost_[cornerid-ghost_start] = cornerid;
+        else if (cell_type[c] == Entity_type::BOUNDARY_GHOST)
+          cornerids_boundary_ghost_[cornerid-boundary_ghost_start] = cornerid;
+
+        for (auto const& s : csides) {
+          for (Entity_ID w = 2*s; w < 2*s+2; ++w) {
+            Entity_ID n2 = wedge_get_node(w);
+            if (n == n2) {
+              corner_wedge_ids[icwedge++] = w;
+              if (implicit_sides_)
+                wedge_cell_node_pos[w] = icnode;
+              else
+                wedge_corner_id[w] = cornerid;
+            }
+          }
+        }  // for (s : csides)
+        corner_wedge_offsets[cornerid+1] = icwedge;
+
+        ++cornerid;
+        ++icnode;
+      }  // for (n : cnodes)
+    });
+
+  // Threads append the corners of a node in no particular order -
+  // sort them to get the same (ascending) order as a serial run
+
+  parallel_for(nnodes, [&](int n) {
+      std::sort(node_corner_ids.begin() + node_corner_offsets[n],
+                node_corner_ids.begin() + node_corner_offsets[n+1]);
+    });
+
+  corner_info_cached = true;
+}  // cache_corner_info
+
+
+// Gather and cache node to cell connectivity info by transposing the
+// cached cell to node connectivity
+//
+// Method is declared constant because it is not modifying the mesh
+// itself; rather it is modifying mutable data structures - see
+// declaration of Mesh class for further explanation
+
+void Mesh::cache_node2cell_info() const {
+  build_once(cell2node_info_cached, &Mesh::cache_cell2node_info);
+
+  int nnodes = num_nodes<Entity_type::ALL>();
+
+  transpose_adjacency(nnodes, cell_node_offsets, cell_node_ids,
+                      &node_cell_offsets, &node_cell_ids);
+
+  node2cell_info_cached = true;
+}
+
+
+// Gather and cache node to face connectivity info by transposing the
+// cached face to node connectivity
+//
+// Method is declared constant because it is not modifying the mesh
+// itself; rather it is modifying mutable data structures - see
+// declaration of Mesh class for further explanation
+
+void Mesh::cache_node2face_info() const {
+  build_once(face2node_info_cached, &Mesh::cache_face2node_info);
+
+  int nnodes = num_nodes<Entity_type::ALL>();
+
+  transpose_adjacency(nnodes, face_node_offsets, face_node_ids,
+                      &node_face_offsets, &node_face_ids);
+
+  node2face_info_cached = true;
+}
+
+
+// Gather and cache face connected neighbors of cells from the cached
+// cell to face and face to cell info. The neighbors of a cell are
+// listed in the order of the faces of the cell (boundary faces
+// contribute no neighbor)
+//
+// Method is declared constant because it is not modifying the mesh
+// itself; rather it is modifying mutable data structures - see
+// declaration of Mesh class for further explanation
+
+void Mesh::cache_cell_face_adj_info() const {
+  build_once(cell2face_info_cached, &Mesh::cache_cell2face_info);
+  build_once(face2cell_info_cached, &Mesh::cache_face2cell_info);
+
+  int ncells = num_cells<Entity_type::ALL>();
+
+  cell_fadj_offsets.resize(ncells+1);
+  cell_fadj_offsets[0] = 0;
+  cell_fadj_ids.clear();
+  cell_fadj_ids.reserve(cell_face_ids.size());
+  for (int c = 0; c < ncells; c++) {
+    for (auto const& f : cell_faces(c))
+      for (auto const& fc : face_cells(f))
+        if (fc != c)
+          cell_fadj_ids.push_back(fc);
+    cell_fadj_offsets[c+1] = cell_fadj_ids.size();
+  }
+  cell_fadj_ids.shrink_to_fit();
+
+  cell_fadj_info_cached = true;
+}
+
+
+// Gather and cache node connected neighbors of cells from the cached
+// node to cell info. The cells around the nodes of a cell are
+// collected, sorted and made unique instead of searching the list for
+// each candidate, so the cost is O(n log n) rather than O(n^2) in the
+// size of the neighborhood
+//
+// Method is declared constant because it is not modifying the mesh
+// itself; rather it is modifying mutable data structures - see
+// declaration of Mesh class for further explanation
+
+void Mesh::cache_cell_node_adj_info() const {
+  build_once(node2cell_info_cached, &Mesh::cache_node2cell_info);
+
+  int ncells = num_cells<Entity_type::ALL>();
+
+  Entity_ID_List nbrs;
+
+  cell_nadj_offsets.resize(ncells+1);
+  cell_nadj_offsets[0] = 0;
+  cell_nadj_ids.clear();
+  for (int c = 0; c < ncells; c++) {
+    nbrs.clear();
+    for (auto const& n : cell_nodes(c)) {
+      Entity_ID_View nodecells = node_cells(n);
+      nbrs.insert(nbrs.end(), nodecells.begin(), nodecells.end());
+    }
+    std::sort(nbrs.begin(), nbrs.end());
+    nbrs.erase(std::unique(nbrs.begin(), nbrs.end()), nbrs.end());
+
+    auto it = std::lower_bound(nbrs.begin(), nbrs.end(), c);
+    if (it != nbrs.end() && *it == c)
+      nbrs.erase(it);
+
+    cell_nadj_ids.insert(cell_nadj_ids.end(), nbrs.begin(), nbrs.end());
+    cell_nadj_offsets[c+1] = cell_nadj_ids.size();
+  }
+  cell_nadj_ids.shrink_to_fit();
+
+  cell_nadj_info_cached = true;
+}
+
+// Remember that a node moved. The shared flags are only written when
+// they change so that threads moving different nodes do not contend
+// for them
+
+void Mesh::mark_node_moved(const Entity_ID nodeid) {
+  node_moved_[nodeid].store(1, std::memory_order_relaxed);
+  if (!any_node_moved_.load(std::memory_order_relaxed))
+    any_node_moved_.store(true, std::memory_order_relaxed);
+  if (framework_node_coords_current_.load(std::memory_order_relaxed))
+    framework_node_coords_current_.store(false, std::memory_order_relaxed);
+}
+
+// Set the coordinates of a node and remember that it moved
+
+void Mesh::node_set_coordinates(const Entity_ID nodeid,
+                                const JaliGeometry::Point ncoord) {
+  build_once(node_coords_cached, &Mesh::cache_node_coordinates);
+  for (unsigned int d = 0; d < space_dim_; d++)
+    node_coordinates_[d][nodeid] = ncoord[d];
+  mark_node_moved(nodeid);
+}
+
+void Mesh::node_set_coordinates(const Entity_ID nodeid,
+                                const double *ncoord) {
+  build_once(node_coords_cached, &Mesh::cache_node_coordinates);
+  for (unsigned int d = 0; d < space_dim_; d++)
+    node_coordinates_[d][nodeid] = ncoord[d];
+  mark_node_moved(nodeid);
+}
+
+
+// Fraction of the nodes (or of the cells connected to them) that
+// must have moved for update_geometric_quantities to recompute
+// everything with the batched kernels rather than the geometry
+// around each moved node. Recomputing one entity at a time costs
+// about three times as much per entity as the batched kernels
+
+static double const bulk_geometry_update_fraction = 0.25;
+
+// Recompute the geometric quantities of the mesh. By default every
+// quantity of the requested entities is recomputed from the
+// coordinates as the framework has them. With moved_nodes_only, only
+// the quantities computed so far are updated and only for the nodes
+// moved with node_set_coordinates (quantities never queried are left
+// to be computed on first use)
+
+void Mesh::update_geometric_quantities(bool const moved_nodes_only) {
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex_);
+
+  if (!moved_nodes_only) {
+    if (node_coords_cached) {
+      // Reread the coordinates from the framework in place, so that
+      // the arrays handed out by node_coordinates stay valid, after
+      // giving it any moves made through node_set_coordinates
+
+      update_framework_node_coordinates();
+      JaliGeometry::Point xyz(space_dim_);
+      int nnodes = num_nodes<Entity_type::ALL>();
+      for (int n = 0; n < nnodes; n++) {
+        node_get_coordinates_internal(n, &xyz);
+        for (unsigned int d = 0; d < space_dim_; d++)
+          node_coordinates_[d][n] = xyz[d];
+        node_moved_[n].store(0, std::memory_order_relaxed);
+      }
+      any_node_moved_ = false;
+    }
+
+    if (faces_requested || face_geometry_precomputed)
+      compute_face_geometric_quantities();
+    if (edges_requested || edge_geometry_precomputed)
+      compute_edge_geometric_quantities();
+    compute_cell_geometric_quantities();
+    if (sides_requested || wedges_requested || side_geometry_precomputed)
+      compute_side_geometric_quantities();
+    if (corners_requested || corner_geometry_precomputed)
+      compute_corner_geometric_quantities();
+    return;
+  }
+
+  if (!any_node_moved_) return;
+
+  // Gather the moved nodes. Then find the cells connected to them
+  // (unless so many nodes moved that everything will be recomputed
+  // anyway)
+
+  std::vector<Entity_ID> moved_nodes;
+  int nnodes = node_moved_.size();
+  for (int n = 0; n < nnodes; n++)
+    if (node_moved_[n].load(std::memory_order_relaxed))
+      moved_nodes.push_back(n);
+  int nmoved = moved_nodes.size();
+
+  std::vector<Entity_ID> cellids;
+  bool bulk = (nmoved > bulk_geometry_update_fraction*
+               num_nodes<Entity_type::ALL>());
+  if (!bulk) {
+    build_once(node2cell_info_cached, &Mesh::cache_node2cell_info);
+
+    std::vector<char> marked(num_cells<Entity_type::ALL>(), 0);
+    for (auto const& n : moved_nodes)
+      for (auto const& c : node_cells(n))
+        if (!marked[c]) {
+          marked[c] = 1;
+          cellids.push_back(c);
+        }
+    bulk = (cellids.size() > bulk_geometry_update_fraction*marked.size());
+  }
+
+  if (!bulk) {
+    update_geometry_of_moved_nodes(cellids);
+  } else {
+    if (face_geometry_precomputed) compute_face_geometric_quantities();
+    if (edge_geometry_precomputed) compute_edge_geometric_quantities();
+    if (cell_geometry_precomputed) compute_cell_geometric_quantities();
+    if (side_geometry_precomputed) compute_side_geometric_quantities();
+    if (corner_geometry_precomputed) compute_corner_geometric_quantities();
+  }
+
+  for (auto const& n : moved_nodes)
+    node_moved_[n].store(0, std::memory_order_relaxed);
+  any_node_moved_ = false;
+}
+
+
+// Recompute the geometric quantities of the entities connected to
+// the moved nodes, given the cells connected to them. The geometry
+// of a cell and of its sides and corners depends only on the nodes
+// of the cell, and that of a face or edge only on its nodes (or, for
+// faces of surface meshes, on the nodes of the cells of the face). So
+// everything to be recomputed is found among these cells. Boundary
+// ghost cells among them have no geometry of their own but their
+// faces and edges do
+
+void Mesh::update_geometry_of_moved_nodes(std::vector<Entity_ID> const&
+                                          cellids) {
+  std::vector<char> marked;
+
+  // Is any node of a list of nodes one that moved?
+
+  auto moved = [&](Entity_ID_View nodeids) {
+    for (auto const& n : nodeids)
+      if (node_moved_[n]) return true;
+    return false;
+  };
+
+  if (face_geometry_precomputed) {
+    build_once(cell2face_info_cached, &Mesh::cache_cell2face_info);
+    build_once(face2node_info_cached, &Mesh::cache_face2node_info);
+    build_once(face2cell_info_cached, &Mesh::cache_face2cell_info);
+
+    marked.assign(num_faces<Entity_type::ALL>(), 0);
+    std::vector<Entity_ID> faceids;
+    for (auto const& c : cellids)
+      for (auto const& f : cell_faces(c))
+        if (!marked[f]) {
+          marked[f] = 1;
+          if (!batched_geometry() || moved(face_nodes(f)))
+            faceids.push_back(f);
+        }
+
+    parallel_for(faceids.size(), [&](int i) {
+        Entity_ID f = faceids[i];
+        compute_face_geometry(f, &(face_areas[f]), &(face_centroids[f]),
+                              &(face_normal0[f]), &(face_normal1[f]));
+      });
+  }
+
+  if (edge_geometry_precomputed) {
+    build_once(cell2edge_info_cached, &Mesh::cache_cell2edge_info);
+    build_once(edge2node_info_cached, &Mesh::cache_edge2node_info);
+
+    marked.assign(num_edges<Entity_type::ALL>(), 0);
+    std::vector<Entity_ID> edgeids;
+    for (auto const& c : cellids)
+      for (auto const& e : cell_edges(c))
+        if (!marked[e]) {
+          marked[e] = 1;
+          if (node_moved_[edge_node_ids[e][0]] ||
+              node_moved_[edge_node_ids[e][1]])
+            edgeids.push_back(e);
+        }
+
+    parallel_for(edgeids.size(), [&](int i) {
+        Entity_ID e = edgeids[i];
+        JaliGeometry::Point ecenter;
+        compute_edge_geometry(e, &(edge_lengths[e]), &(edge_vectors[e]),
+                              &ecenter);
+      });
+  }
+
+  if (cell_geometry_precomputed) {
+    if (manifold_dim_ == 3) {
+      build_once(cell2face_info_cached, &Mesh::cache_cell2face_info);
+      build_once(face2node_info_cached, &Mesh::cache_face2node_info);
+    }
+
+    // The framework is not thread-safe - query the cell types up front
+
+    std::vector<Cell_type> ctypes(cellids.size(),
+                                  Cell_type::CELLTYPE_UNKNOWN);
+    if (manifold_dim_ > 1)
+      for (std::size_t i = 0; i < cellids.size(); i++)
+        if (cell_type[cellids[i]] != Entity_type::BOUNDARY_GHOST)
+          ctypes[i] = cell_get_type(cellids[i]);
+
+    parallel_for(cellids.size(), [&](int i) {
+        Entity_ID c = cellids[i];
+        if (cell_type[c] != Entity_type::BOUNDARY_GHOST)
+          compute_cell_geometry(c, ctypes[i], &(cell_volumes[c]),
+                                &(cell_centroids[c]));
+      });
+  }
+
+  if (side_geometry_precomputed) {
+    std::vector<Entity_ID> sideids;
+    for (auto const& c : cellids)
+      if (cell_type[c] != Entity_type::BOUNDARY_GHOST)
+        for (auto const& s : cell_sides(c))
+          sideids.push_back(s);
+
+    parallel_for(sideids.size(), [&](int i) {
+        Entity_ID s = sideids[i];
+        compute_side_geometry(s, &(side_volumes[s]),
+                              &(side_outward_facet_normal[s]),
+                              &(side_mid_facet_normal[s]));
+      });
+  }
+
+  if (corner_geometry_precomputed) {
+    std::vector<Entity_ID> cornerids;
+    for (auto const& c : cellids)
+      if (cell_type[c] != Entity_type::BOUNDARY_GHOST)
+        for (auto const& cn : cell_corners(c))
+          cornerids.push_back(cn);
+
+    parallel_for(cornerids.size(), [&](int i) {
+        Entity_ID cn = cornerids[i];
+        compute_corner_geometry(cn, &(corner_volumes[cn]));
+      });
+  }
+}
+
+
+// Group the cells by type for the batched geometry kernels and store
+// their nodes and their faces' nodes in the layout the kernels
+// expect. Cells without a batched kernel or whose topology does not
+// match their type are processed one at a time
+
+void Mesh::cache_cell_batches() const {
+  build_once(cell2node_info_cached, &Mesh::cache_cell2node_info);
+  if (manifold_dim_ == 3) {
+    build_once(cell2face_info_cached, &Mesh::cache_cell2face_info);
+    build_once(face2node_info_cached, &Mesh::cache_face2node_info);
+  }
+
+  int ncells = num_cells<Entity_type::ALL>();
+
+  for (int t = 0; t < 9; t++) {
+    geometry_batches_.cellids[t].clear();
+    geometry_batches_.cellnodes[t].clear();
+    geometry_batches_.cellfacenodes[t].clear();
+  }
+  geometry_batches_.other_cellids.clear();
+
+  for (int c = 0; c < ncells; c++) {
+    Cell_batch_kernel const *kernel = nullptr;
+    Cell_type ctype = Cell_type::CELLTYPE_UNKNOWN;
+    if (cell_type[c] != Entity_type::BOUNDARY_GHOST) {
+      ctype = cell_get_type(c);
+      kernel = cell_batch_kernel(ctype, manifold_dim_, space_dim_);
+    }
+
+    Entity_ID_View cnodes = cell_nodes(c);
+    bool batched = (kernel &&
+                    static_cast<int>(cnodes.size()) == kernel->nnodes);
+
+    if (batched && manifold_dim_ == 3) {
+      int nquads = 0, ntris = 0;
+      for (auto const& f : cell_faces(c)) {
+        int nfn = face_nodes(f).size();
+        if (nfn == 4) nquads++;
+        else if (nfn == 3) ntris++;
+        else batched = false;
+      }
+      if (nquads != kernel->nquads || ntris != kernel->ntris)
+        batched = false;
+    }
+
+    if (!batched) {
+      geometry_batches_.other_cellids.push_back(c);
+      continue;
+    }
+
+    int t = static_cast<int>(ctype);
+    geometry_batches_.cellids[t].push_back(c);
+    std::vector<Entity_ID>& cellnodes = geometry_batches_.cellnodes[t];
+    cellnodes.insert(cellnodes.end(), cnodes.begin(), cnodes.end());
+
+    if (manifold_dim_ == 3) {
+      // Quadrilateral faces first, then the triangular faces, with the
+      // nodes of each face ordered so that its normal points out
+
+      std::vector<Entity_ID>& cfnodes = geometry_batches_.cellfacenodes[t];
+      Entity_ID_View cfaces = cell_faces(c);
+      Dir_View fdirs = cell_face_dirs(c);
+      for (int nfn = 4; nfn >= 3; nfn--) {
+        for (std::size_t j = 0; j < cfaces.size(); j++) {
+          Entity_ID_View fnodes = face_nodes(cfaces[j]);
+          if (static_cast<int>(fnodes.size()) != nfn) continue;
+          if (fdirs[j] == 1)
+            cfnodes.insert(cfnodes.end(), fnodes.begin(), fnodes.end());
+          else
+            for (int k = nfn-1; k >= 0; k--)
+              cfnodes.push_back(fnodes[k]);
+        }
+      }
+    }
+  }
+
+  cell_batches_cached = true;
+}
+
+
+// Group the triangular and quadrilateral faces of a 3D mesh for the
+// batched geometry kernels and record which of the two normals of
+// each face are defined (i.e. in which directions cells use it)
+
+void Mesh::cache_face_batches() const {
+  build_once(face2node_info_cached, &Mesh::cache_face2node_info);
+  build_once(face2cell_info_cached, &Mesh::cache_face2cell_info);
+  build_once(cell2face_info_cached, &Mesh::cache_cell2face_info);
+
+  int nfaces = num_faces<Entity_type::ALL>();
+
+  for (int k = 0; k < 2; k++) {
+    geometry_batches_.faceids[k].clear();
+    geometry_batches_.facenodes[k].clear();
+  }
+  geometry_batches_.other_faceids.clear();
+  geometry_batches_.face_normal_dirs.assign(nfaces, 0);
+
+  for (int f = 0; f < nfaces; f++) {
+    Entity_ID_View fnodes = face_nodes(f);
+    int nfn = fnodes.size();
+    if (manifold_dim_ == 3 && (nfn == 3 || nfn == 4)) {
+      geometry_batches_.faceids[nfn-3].push_back(f);
+      std::vector<Entity_ID>& facenodes = geometry_batches_.facenodes[nfn-3];
+      facenodes.insert(facenodes.end(), fnodes.begin(), fnodes.end());
+    } else if (manifold_dim_ == 3) {
+      geometry_batches_.other_faceids.push_back(f);
+    }
+
+    for (auto const& c : face_cells(f)) {
+      Entity_ID_View cfaces = cell_faces(c);
+      Dir_View fdirs = cell_face_dirs(c);
+      for (std::size_t j = 0; j < cfaces.size(); j++)
+        if (cfaces[j] == f) {
+          geometry_batches_.face_normal_dirs[f] |= (fdirs[j] == 1) ? 1 : 2;
+          break;
+        }
+    }
+  }
+
+  face_batches_cached = true;
+}
+
+
+// Cache the node coordinates of the framework as one array per
+// dimension, each starting on a cache line boundary so that
+// vectorized kernels can load them directly
+
+void Mesh::cache_node_coordinates() const {
+  int nnodes = num_nodes<Entity_type::ALL>();
+
+  int const align = 64/sizeof(double);  // doubles per cache line
+  int stride = ((nnodes + align - 1)/align)*align;
+  node_coords_storage_.assign(space_dim_*stride + align, 0.0);
+
+  std::uintptr_t addr =
+      reinterpret_cast<std::uintptr_t>(node_coords_storage_.data());
+  int offset = ((64 - addr % 64) % 64)/sizeof(double);
+  for (unsigned int d = 0; d < 3; d++)
+    node_coordinates_[d] = (d < space_dim_) ?
+        node_coords_storage_.data() + offset + d*stride : nullptr;
+
+  JaliGeometry::Point xyz(space_dim_);
+  for (int n = 0; n < nnodes; n++) {
+    node_get_coordinates_internal(n, &xyz);
+    for (unsigned int d = 0; d < space_dim_; d++)
+      node_coordinates_[d][n] = xyz[d];
+  }
+  std::vector<std::atomic<char>>(nnodes).swap(node_moved_);
+
+  node_coords_cached = true;
+}
+
+
+// Copy the node coordinates to the framework if any node moved since
+// the framework last got them
+
+void Mesh::update_framework_node_coordinates() const {
+  if (framework_node_coords_current_) return;
+
+  int nnodes = num_nodes<Entity_type::ALL>();
+  double xyz[3] = {0.0, 0.0, 0.0};
+  for (int n = 0; n < nnodes; n++) {
+    for (unsigned int d = 0; d < space_dim_; d++)
+      xyz[d] = node_coordinates_[d][n];
+    node_set_coordinates_internal(n, xyz);
+  }
+
+  framework_node_coords_current_ = true;
+}
+
+
+// Cache the parallel type of entities which almost every query
+// needs. All other connectivity and geometric info is cached on first
+// use (see build_once) so that a run pays, in time and memory, only
+// for the relations and geometric quantities it actually queries
+
+void Mesh::cache_extra_variables() {
+  cache_type_info();
+}
+
+
+// Partition the mesh on this compute node into submeshes or tiles
+
+void Mesh::build_tiles() {
+
+  std::vector<std::vector<int>> partitions;
+  partitions.resize(num_tiles_ini_);
+
+  std::cerr << "Calling partitioner " << partitioner_pref_ << "\n";
+  get_partitioning(num_tiles_ini_, partitioner_pref_, &partitions);
+
+  // Make the tiles - make_meshtiles will also call a routine of this
+  // mesh to add the tiles to the mesh's list of tiles
+
+  make_meshtiles(*this, partitions, num_ghost_layers_tile_, faces_requested,
+                 edges_requested, sides_requested, wedges_requested,
+                 corners_requested);
+}
+
+
+
+// Initialize some arrays for storing master tile ID of entity. On
+// this tile, the entity is OWNED. It can be a GHOST on any number of
+// other entities
+
+void Mesh::init_tiles() {
+  tiles_initialized_ = true;
+  node_master_tile_ID_.resize(num_nodes(), -1);
+  if (edges_requested) edge_master_tile_ID_.resize(num_edges(), -1);
+  if (faces_requested) face_master_tile_ID_.resize(num_faces(), -1);
+  cell_master_tile_ID_.resize(num_cells(), -1);
+}
+
+
+// Add one tile to the mesh. The tile colors and layouts are reset
+// under the cache lock, like every other write to the caches, so that
+// they are not reset while they are being built
+
+void Mesh::add_tile(std::shared_ptr<MeshTile> const tile2add) {
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex_);
+  meshtiles.emplace_back(tile2add);
+  tile_colors_cached = false;  // recolor on next use
+  tile_layouts_cached_ = 0;
+}
+
+
+// Color the tiles so that tiles of the same color do not share any
+// node of their owned cells. Two tiles are neighbors if a node is
+// used by owned cells of both. The tiles are colored greedily in
+// order of decreasing number of neighbors (ties broken by ID), each
+// one getting the smallest color none of its neighbors has
+
+void Mesh::cache_tile_colors() const {
+  int ntiles = meshtiles.size();
+  int nnodes = num_nodes<Entity_type::ALL>();
+
+  // Tiles using each node (in CSR form). The owned cells of a tile
+  // are visited together so a node used by several cells of a tile
+  // is recorded once by remembering the last tile that recorded it
+
+  std::vector<int> node_tile_offsets(nnodes+1, 0), last_tile(nnodes, -1);
+  for (int t = 0; t < ntiles; t++)
+    for (auto const c : meshtiles[t]->cells<Entity_type::PARALLEL_OWNED>())
+      for (auto const n : cell_nodes(c))
+        if (last_tile[n] != t) {
+          last_tile[n] = t;
+          node_tile_offsets[n+1]++;
+        }
+  for (int n = 0; n < nnodes; n++)
+    node_tile_offsets[n+1] += node_tile_offsets[n];
+
+  std::vector<int> node_tile_ids(node_tile_offsets[nnodes]);
+  std::vector<int> pos(node_tile_offsets.begin(), node_tile_offsets.end()-1);
+  std::fill(last_tile.begin(), last_tile.end(), -1);
+  for (int t = 0; t < ntiles; t++)
+    for (auto const c : meshtiles[t]->cells<Entity_type::PARALLEL_OWNED>())
+      for (auto const n : cell_nodes(c))
+        if (last_tile[n] != t) {
+          last_tile[n] = t;
+          node_tile_ids[pos[n]++] = t;
+        }
+
+  // Neighbors of each tile
+
+  std::vector<std::pair<int, int>> tile_pairs;
+  for (int n = 0; n < nnodes; n++)
+    for (int i = node_tile_offsets[n]; i < node_tile_offsets[n+1]; i++)
+      for (int j = node_tile_offsets[n]; j < node_tile_offsets[n+1]; j++)
+        if (i != j)
+          tile_pairs.emplace_back(node_tile_ids[i], node_tile_ids[j]);
+  std::sort(tile_pairs.begin(), tile_pairs.end());
+  tile_pairs.erase(std::unique(tile_pairs.begin(), tile_pairs.end()),
+                   tile_pairs.end());
+
+  std::vector<int> nbr_offsets(ntiles+1, 0);
+  for (auto const& tp : tile_pairs)
+    nbr_offsets[tp.first+1]++;
+  for (int t = 0; t < ntiles; t++)
+    nbr_offsets[t+1] += nbr_offsets[t];
+
+  // Greedy coloring, most constrained tiles first
+
+  std::vector<int> order(ntiles);
+  for (int t = 0; t < ntiles; t++)
+    order[t] = t;
+  std::stable_sort(order.begin(), order.end(), [&](int t1, int t2) {
+      return nbr_offsets[t1+1]-nbr_offsets[t1] >
+          nbr_offsets[t2+1]-nbr_offsets[t2];
+    });
+
+  tile_color_.assign(ntiles, -1);
+  std::vector<int> color_used_by(ntiles+1, -1);
+  int ncolors = 0;
+  for (auto const t : order) {
+    for (int i = nbr_offsets[t]; i < nbr_offsets[t+1]; i++) {
+      int nbrcolor = tile_color_[tile_pairs[i].second];
+      if (nbrcolor >= 0)
+        color_used_by[nbrcolor] = t;
+    }
+    int color = 0;
+    while (color_used_by[color] == t)
+      color++;
+    tile_color_[t] = color;
+    ncolors = std::max(ncolors, color+1);
+  }
+
+  // Tiles of each color in increasing order of ID
+
+  tile_color_offsets_.assign(ncolors+1, 0);
+  for (int t = 0; t < ntiles; t++)
+    tile_color_offsets_[tile_color_[t]+1]++;
+  for (int color = 0; color < ncolors; color++)
+    tile_color_offsets_[color+1] += tile_color_offsets_[color];
+
+  tile_color_ids_.resize(ntiles);
+  pos.assign(tile_color_offsets_.begin(), tile_color_offsets_.end()-1);
+  for (int t = 0; t < ntiles; t++)
+    tile_color_ids_[pos[tile_color_[t]]++] = t;
+
+  tile_colors_cached = true;
+}
+
+
+int Mesh::num_tile_colors() const {
+  build_once(tile_colors_cached, &Mesh::cache_tile_colors);
+  return tile_color_offsets_.empty() ? 0 : tile_color_offsets_.size()-1;
+}
+
+
+int Mesh::tile_color(int const tileid) const {
+  build_once(tile_colors_cached, &Mesh::cache_tile_colors);
+  return tile_color_[tileid];
+}
+
+
+Entity_ID_View Mesh::tiles_of_color(int const color) const {
+  build_once(tile_colors_cached, &Mesh::cache_tile_colors);
+  return Entity_ID_View(tile_color_ids_.data() + tile_color_offsets_[color],
+                        tile_color_ids_.data() +
+                        tile_color_offsets_[color+1]);
+}
+
+
+// Tile blocked layout of the data of a kind of entity. The value of
+// record of an entity is in the block of its master tile, at its
+// tile-local ID there (the owned entities of a tile are numbered
+// first); the entities no tile owns go in the last block in
+// increasing order of ID
+
+std::shared_ptr<Tile_layout const>
+Mesh::tile_layout(Entity_kind const kind) const {
+  int const k = static_cast<int>(kind);
+  assert(k >= 0 && k < NUM_ENTITY_KINDS);
+  unsigned const bit = 1u << k;
+
+  if (!(tile_layouts_cached_.load(std::memory_order_acquire) & bit)) {
+    std::lock_guard<std::recursive_mutex> lock(cache_mutex_);
+    if (!(tile_layouts_cached_.load(std::memory_order_relaxed) & bit)) {
+      // Build a new layout rather than refill the old one, which
+      // vectors made before tiles were added may still be using
+
+      auto newlayout = std::make_shared<Tile_layout>();
+      Tile_layout& layout = *newlayout;
+      int ntiles = meshtiles.size();
+      int nents = num_entities(kind, Entity_type::ALL);
+
+      layout.block_sizes.assign(ntiles+1, 0);
+      layout.entity_block.assign(nents, ntiles);
+      layout.entity_position.assign(nents, -1);
+      for (int t = 0; t < ntiles; t++) {
+        layout.block_sizes[t] = meshtiles[t]->num_entities(kind,
+                                                           Entity_type::ALL);
+        Entity_ID_List const& owned =
+            meshtiles[t]->entities(kind, Entity_type::PARALLEL_OWNED);
+        int nowned = owned.size();
+        for (int i = 0; i < nowned; i++) {
+          layout.entity_block[owned[i]] = t;
+          layout.entity_position[owned[i]] = i;
+        }
+      }
+      for (int i = 0; i < nents; i++)
+        if (layout.entity_block[i] == ntiles)
+          layout.entity_position[i] = layout.block_sizes[ntiles]++;
+
+      // Plan for copying the values of record into the halo entries
+      // of each tile, sorted by source block and position so that
+      // each copy reads its source block in order
+
+      layout.halo_copy_offsets.assign(1, 0);
+      layout.halo_copy_src_blocks.clear();
+      layout.halo_copy_starts.assign(1, 0);
+      layout.halo_src_positions.clear();
+      layout.halo_dst_positions.clear();
+
+      std::vector<std::array<int, 3>> halo;  // src block, src pos, dst pos
+      for (int t = 0; t < ntiles; t++) {
+        Entity_ID_List const& all =
+            meshtiles[t]->entities(kind, Entity_type::ALL);
+        int nall = all.size();
+        int nowned = meshtiles[t]->num_entities(kind,
+                                                Entity_type::PARALLEL_OWNED);
+        halo.clear();
+        for (int j = nowned; j < nall; j++)
+          halo.push_back({layout.entity_block[all[j]],
+                  layout.entity_position[all[j]], j});
+        std::sort(halo.begin(), halo.end());
+
+        int nhalo = halo.size();
+        for (int j = 0; j < nhalo; j++) {
+          if (j == 0 || halo[j][0] != halo[j-1][0]) {
+            if (j > 0)
+              layout.halo_copy_starts.push_back(
+                  layout.halo_src_positions.size());
+            layout.halo_copy_src_blocks.push_back(halo[j][0]);
+          }
+          layout.halo_src_positions.push_back(halo[j][1]);
+          layout.halo_dst_positions.push_back(halo[j][2]);
+        }
+        if (nhalo > 0)
+          layout.halo_copy_starts.push_back(layout.halo_src_positions.size());
+        layout.halo_copy_offsets.push_back(
+            layout.halo_copy_src_blocks.size());
+      }
 
-void Mesh::cache_wedge_info() const {
+      tile_layouts_[k] = newlayout;
+      tile_layouts_cached_.fetch_or(bit, std::memory_order_release);
+    }
+  }
+  return tile_layouts_[k];
+}
 
-  int nsides_owned = num_sides<Entity_type::PARALLEL_OWNED>();
-  int nsides_ghost = num_sides<Entity_type::PARALLEL_GHOST>();
-  int nsides_boundary_ghost = num_sides<Entity_type::BOUNDARY_GHOST>();
-  int nsides_all = nsides_owned + nsides_ghost + nsides_boundary_ghost;
+  
+Entity_ID Mesh::entity_get_parent(const Entity_kind kind,
+                                  const Entity_ID entid) const {
+  Errors::Message mesg("Parent/daughter entities not"
+                       " enabled in this framework.");
+  Exceptions::Jali_throw(mesg);
+  return -1;
+}
 
-  int num_wedges_all = 2*nsides_all;
-  int num_wedges_owned = 2*nsides_owned;
-  int num_wedges_ghost = 2*nsides_ghost;
-  int num_wedges_boundary_ghost = 2*nsides_boundary_ghost;
 
-  wedgeids_owned_.resize(num_wedges_owned);
-  wedgeids_ghost_.resize(num_wedges_ghost);
-  wedgeids_boundary_ghost_.resize(num_wedges_boundary_ghost);
-  wedge_corner_id.resize(num_wedges_all, -1);  // filled when building corners
+// Old to new ID map of renumbered entities
 
-  
-  int iown = 0, ighost = 0, ibndry = 0;
-  for (auto const& s : sides()) {
-    int wedgeid0 = 2*s;
-    int wedgeid1 = 2*s + 1;
-    int c = side_cell_id[s];
-    if (cell_type[c] == Entity_type::PARALLEL_OWNED) {
-      wedgeids_owned_[iown++] = wedgeid0;
-      wedgeids_owned_[iown++] = wedgeid1;
-    } else if (cell_type[c] == Entity_type::PARALLEL_GHOST) {
-      wedgeids_ghost_[ighost++] = wedgeid0;
-      wedgeids_ghost_[ighost++] = wedgeid1;
-    } else if (cell_type[c] == Entity_type::BOUNDARY_GHOST) {
-      wedgeids_boundary_ghost_[ibndry++] = wedgeid0;
-      wedgeids_boundary_ghost_[ibndry++] = wedgeid1;
-    }
-  }
-
-  wedgeids_all_.reserve(num_wedges_all);
-  wedgeids_all_ = wedgeids_owned_;  // copy
-  wedgeids_all_.insert(wedgeids_all_.end(), wedgeids_ghost_.begin(),
-              wedgeids_ghost_.end());
-  wedgeids_all_.insert(wedgeids_all_.end(), wedgeids_boundary_ghost_.begin(),
-              wedgeids_boundary_ghost_.end());
+std::vector<Entity_ID> const&
+Mesh::entity_old_to_new_ids(const Entity_kind kind) const {
+  assert(kind >= Entity_kind::NODE && kind <= Entity_kind::CELL);
+  return old_to_new_ids_[static_cast<int>(kind)];
+}
 
-  wedge_info_cached = true;
-}  // cache_wedge_info
 
+// New to old ID map of renumbered entities
 
-void Mesh::cache_corner_info() const {
-  int ncells_owned = num_cells<Entity_type::PARALLEL_OWNED>();
-  int ncells_ghost = num_cells<Entity_type::PARALLEL_GHOST>();
-  int ncells_boundary_ghost = num_cells<Entity_type::BOUNDARY_GHOST>();
-  int ncells = ncells_owned + ncells_ghost + ncells_boundary_ghost;
+std::vector<Entity_ID> const&
+Mesh::entity_new_to_old_ids(const Entity_kind kind) const {
+  assert(kind >= Entity_kind::NODE && kind <= Entity_kind::CELL);
+  return new_to_old_ids_[static_cast<int>(kind)];
+}
 
-  int nnodes_owned = num_nodes<Entity_type::PARALLEL_OWNED>();
-  int nnodes_ghost = num_nodes<Entity_type::PARALLEL_GHOST>();
-  int nnodes = nnodes_owned + nnodes_ghost;
 
-  cell_corner_ids.resize(ncells);
-  node_corner_ids.resize(nnodes);
+// Record the renumbering of entities of a kind given the old ID of
+// each new ID
 
-  int num_corners_all = 0;
-  int num_corners_owned = 0;
-  int num_corners_ghost = 0;
-  int num_corners_boundary_ghost = 0;
+void Mesh::set_entity_renumbering(const Entity_kind kind,
+                                  std::vector<Entity_ID> const& new_to_old) {
+  assert(kind >= Entity_kind::NODE && kind <= Entity_kind::CELL);
+  int const ikind = static_cast<int>(kind);
+  int const n = new_to_old.size();
 
-  for (auto const& c : cells()) {
-    std::vector<Entity_ID> cnodes;
-    cell_get_nodes(c, &cnodes);
-    cell_corner_ids[c].reserve(cnodes.size());
+  new_to_old_ids_[ikind] = new_to_old;
+  old_to_new_ids_[ikind].assign(n, -1);
+  for (int i = 0; i < n; i++)
+    old_to_new_ids_[ikind][new_to_old[i]] = i;
+}
 
-    num_corners_all += cnodes.size();  // as many corners as nodes in cell
-    if (cell_type[c] == Entity_type::PARALLEL_OWNED)
-      num_corners_owned += cnodes.size();
-    else if (cell_type[c] == Entity_type::PARALLEL_GHOST)
-      num_corners_ghost += cnodes.size();
-    else if (cell_type[c] == Entity_type::BOUNDARY_GHOST)
-      num_corners_boundary_ghost += cnodes.size();
-  }
 
-  cornerids_owned_.resize(num_corners_owned);
-  cornerids_ghost_.resize(num_corners_ghost);
-  cornerids_boundary_ghost_.resize(num_corners_boundary_ghost);
-  corner_wedge_ids.resize(num_corners_all);
-
-  int cornerid = 0;
-  int iown = 0, ighost = 0, ibndry = 0;
-  for (auto const& c : cells()) {
-    std::vector<Entity_ID> cnodes;
-    cell_get_nodes(c, &cnodes);
-
-    std::vector<Entity_ID> cwedges;
-    cell_get_wedges(c, &cwedges);
-
-    for (auto const& n : cnodes) {
-      cell_corner_ids[c].push_back(cornerid);
-      node_corner_ids[n].push_back(cornerid);
-
-      if (cell_type[c] == Entity_type::PARALLEL_OWNED)
-        cornerids_owned_[iown++] = cornerid;
-      else if (cell_type[c] == Entity_type::PARALLEL_GHOST)
-        cornerids_ghost_[ighost++] = cornerid;
-      else if (cell_type[c] == Entity_type::BOUNDARY_GHOST)
-        cornerids_boundary_ghost_[ibndry++] = cornerid;
-
-      for (auto const& w : cwedges) {
-        Entity_ID n2 = wedge_get_node(w);
-        if (n == n2) {
-          corner_wedge_ids[cornerid].push_back(w);
-          wedge_corner_id[w] = cornerid;
-        }
-      }  // for (w : cwedges)
+// Memory held by the mesh. The cache lock is held so that no table is
+// being built (and reallocated) while it is measured
+
+Memory_report Mesh::memory_report() const {
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex_);
+
+  Memory_report report;
+
+  for (auto const *list : {&nodeids_owned_, &nodeids_ghost_, &nodeids_all_,
+          &edgeids_owned_, &edgeids_ghost_, &edgeids_all_,
+          &faceids_owned_, &faceids_ghost_, &faceids_all_,
+          &sideids_owned_, &sideids_ghost_, &sideids_boundary_ghost_,
+          &sideids_all_, &wedgeids_owned_, &wedgeids_ghost_,
+          &wedgeids_boundary_ghost_, &wedgeids_all_, &cornerids_owned_,
+          &cornerids_ghost_, &cornerids_boundary_ghost_, &cornerids_all_,
+          &cellids_owned_, &cellids_ghost_, &cellids_boundary_ghost_,
+          &cellids_all_})
+    report.add("entity_lists", *list);
+
+  for (auto const *types : {&cell_type, &face_type, &edge_type, &node_type})
+    report.add("entity_types", *types);
+  report.add("entity_types", cell_celltypes_);
+
+  // Cached adjacencies
+
+  report.add("adjacency/cell_node", cell_node_offsets);
+  report.add("adjacency/cell_node", cell_node_ids);
+  report.add("adjacency/face_node", face_node_offsets);
+  report.add("adjacency/face_node", face_node_ids);
+  report.add("adjacency/cell_face", cell_face_offsets);
+  report.add("adjacency/cell_face", cell_face_ids);
+  report.add("adjacency/cell_face", cell_face_dirs_);
+  report.add("adjacency/face_cell", face_cell_ids);
+  report.add("adjacency/cell_edge", cell_edge_offsets);
+  report.add("adjacency/cell_edge", cell_edge_ids);
+  report.add("adjacency/cell_edge", cell_2D_edge_dirs_);
+  report.add("adjacency/face_edge", face_edge_offsets);
+  report.add("adjacency/face_edge", face_edge_ids);
+  report.add("adjacency/face_edge", face_edge_dirs_);
+  report.add("adjacency/edge_node", edge_node_ids);
+  report.add("adjacency/node_cell", node_cell_offsets);
+  report.add("adjacency/node_cell", node_cell_ids);
+  report.add("adjacency/node_face", node_face_offsets);
+  report.add("adjacency/node_face", node_face_ids);
+  report.add("adjacency/cell_face_adj", cell_fadj_offsets);
+  report.add("adjacency/cell_face_adj", cell_fadj_ids);
+  report.add("adjacency/cell_node_adj", cell_nadj_offsets);
+  report.add("adjacency/cell_node_adj", cell_nadj_ids);
+
+  // Sides, wedges and corners
+
+  report.add("subcells/sides", side_cell_id);
+  report.add("subcells/sides", side_face_id);
+  report.add("subcells/sides", side_edge_id);
+  report.add("subcells/sides", side_edge_use);
+  report.add("subcells/sides", side_node_ids);
+  report.add("subcells/sides", side_opp_side_id);
+  report.add("subcells/sides", cell_side_offsets);
+  report.add("subcells/sides", cell_side_ids);
+  report.add("subcells/sides", cell_face_side_offsets);
+  report.add("subcells/sides", cell_face_cell_ids);
+  report.add("subcells/sides", cell_face_opp_pos);
+  report.add("subcells/sides", side_cell_face_pos);
+  report.add("subcells/wedges", wedge_corner_id);
+  report.add("subcells/wedges", wedge_cell_node_pos);
+  report.add("subcells/corners", cell_corner_offsets);
+  report.add("subcells/corners", cell_corner_ids);
+  report.add("subcells/corners", node_corner_offsets);
+  report.add("subcells/corners", node_corner_ids);
+  report.add("subcells/corners", corner_wedge_offsets);
+  report.add("subcells/corners", corner_wedge_ids);
+
+  // Geometric quantities
+
+  report.add("geometry/cells", cell_volumes);
+  report.add("geometry/cells", cell_centroids);
+  report.add("geometry/faces", face_areas);
+  report.add("geometry/faces", face_centroids);
+  report.add("geometry/faces", face_normal0);
+  report.add("geometry/faces", face_normal1);
+  report.add("geometry/edges", edge_lengths);
+  report.add("geometry/edges", edge_vectors);
+  report.add("geometry/edges", edge_centroids);
+  report.add("geometry/sides", side_volumes);
+  report.add("geometry/sides", side_outward_facet_normal);
+  report.add("geometry/sides", side_mid_facet_normal);
+  report.add("geometry/corners", corner_volumes);
+  report.add("geometry/node_coordinates", node_coords_storage_);
+  report.add("geometry/moved_nodes", node_moved_);
+
+  Geometry_batches const& batches = geometry_batches_;
+  for (int t = 0; t < 9; t++) {
+    report.add("geometry/batches", batches.cellids[t]);
+    report.add("geometry/batches", batches.cellnodes[t]);
+    report.add("geometry/batches", batches.cellfacenodes[t]);
+  }
+  report.add("geometry/batches", batches.other_cellids);
+  for (int t = 0; t < 2; t++) {
+    report.add("geometry/batches", batches.faceids[t]);
+    report.add("geometry/batches", batches.facenodes[t]);
+  }
+  report.add("geometry/batches", batches.other_faceids);
+  report.add("geometry/batches", batches.face_normal_dirs);
 
-      ++cornerid;
-    }  // for (n : cnodes)
-  }  // for (c : cells())
+  for (int k = 0; k < 4; k++) {
+    report.add("renumbering", old_to_new_ids_[k]);
+    report.add("renumbering", new_to_old_ids_[k]);
+  }
 
-  cornerids_all_.reserve(num_corners_all);
-  cornerids_all_ = cornerids_owned_;  // list copy
-  cornerids_all_.insert(cornerids_all_.end(), cornerids_ghost_.begin(),
-                        cornerids_ghost_.end());
-  cornerids_all_.insert(cornerids_all_.end(), cornerids_boundary_ghost_.begin(),
-                        cornerids_boundary_ghost_.end());
+  // Tiles and sets
+
+  report.add("tiles/master_tile_ids", node_master_tile_ID_);
+  report.add("tiles/master_tile_ids", edge_master_tile_ID_);
+  report.add("tiles/master_tile_ids", face_master_tile_ID_);
+  report.add("tiles/master_tile_ids", cell_master_tile_ID_);
+  report.add("tiles/colors", tile_color_);
+  report.add("tiles/colors", tile_color_offsets_);
+  report.add("tiles/colors", tile_color_ids_);
+  for (auto const& layout : tile_layouts_) {
+    if (!layout) continue;
+    report.add("tiles/layouts", layout->block_sizes);
+    report.add("tiles/layouts", layout->entity_block);
+    report.add("tiles/layouts", layout->entity_position);
+    report.add("tiles/halo_plans", layout->halo_copy_offsets);
+    report.add("tiles/halo_plans", layout->halo_copy_src_blocks);
+    report.add("tiles/halo_plans", layout->halo_copy_starts);
+    report.add("tiles/halo_plans", layout->halo_src_positions);
+    report.add("tiles/halo_plans", layout->halo_dst_positions);
+  }
+  for (auto const& tile : meshtiles)
+    report.merge("tiles/", tile->memory_report());
+  for (auto const& set : meshsets_)
+    report.merge("sets/", set->memory_report());
 
-  corner_info_cached = true;
-}  // cache_corner_info
+  framework_memory_report(&report);
 
-void Mesh::update_geometric_quantities() {
-  if (faces_requested) compute_face_geometric_quantities();
-  if (edges_requested) compute_edge_geometric_quantities();
-  compute_cell_geometric_quantities();
-  if (sides_requested || wedges_requested) compute_side_geometric_quantities();
-  if (corners_requested) compute_corner_geometric_quantities();
+  return report;
 }
 
 
-void Mesh::cache_extra_variables() {
-  // Should be before side, wedge and corner info is processed
-  cache_type_info();
-    
+// Flat view of the cached info for compute kernels
+
+MeshView Mesh::view() const {
+  build_once(node_coords_cached, &Mesh::cache_node_coordinates);
+  build_once(cell2node_info_cached, &Mesh::cache_cell2node_info);
+  build_once(celltype_info_cached, &Mesh::cache_celltype_info);
+  build_once(cell_geometry_precomputed,
+             &Mesh::compute_cell_geometric_quantities);
   if (faces_requested) {
-    cache_cell2face_info();
-    cache_face2cell_info();
+    build_once(face2node_info_cached, &Mesh::cache_face2node_info);
+    build_once(cell2face_info_cached, &Mesh::cache_cell2face_info);
+    build_once(face2cell_info_cached, &Mesh::cache_face2cell_info);
+    build_once(face_geometry_precomputed,
+               &Mesh::compute_face_geometric_quantities);
   }
 
-  if (edges_requested) {
-    cache_face2edge_info();
-    cache_cell2edge_info();
-    cache_edge2node_info();
+  MeshView view;
+  view.manifold_dim = manifold_dim_;
+  view.space_dim = space_dim_;
+  view.num_nodes = num_nodes<Entity_type::ALL>();
+  view.num_cells = num_cells<Entity_type::ALL>();
+  view.num_nodes_owned = num_nodes<Entity_type::PARALLEL_OWNED>();
+  view.num_cells_owned = num_cells<Entity_type::PARALLEL_OWNED>();
+  view.num_faces = faces_requested ? num_faces<Entity_type::ALL>() : 0;
+  view.num_faces_owned = faces_requested ?
+      num_faces<Entity_type::PARALLEL_OWNED>() : 0;
+
+  for (int d = 0; d < 3; d++)
+    view.node_coords[d] = node_coordinates_[d];
+
+  view.cell_node_offsets = cell_node_offsets.data();
+  view.cell_node_ids = cell_node_ids.data();
+  view.cell_types = cell_celltypes_.data();
+  view.cell_volumes = cell_volumes.data();
+  view.cell_centroids = cell_centroids.data();
+
+  view.face_node_offsets = nullptr;
+  view.face_node_ids = nullptr;
+  view.cell_face_offsets = nullptr;
+  view.cell_face_ids = nullptr;
+  view.cell_face_dirs_ = nullptr;
+  view.face_cell_ids = nullptr;
+  view.face_areas = nullptr;
+  view.face_centroids = nullptr;
+  view.face_normal0s = nullptr;
+  view.face_normal1s = nullptr;
+  if (faces_requested) {
+    view.face_node_offsets = face_node_offsets.data();
+    view.face_node_ids = face_node_ids.data();
+    view.cell_face_offsets = cell_face_offsets.data();
+    view.cell_face_ids = cell_face_ids.data();
+    view.cell_face_dirs_ = cell_face_dirs_.data();
+    view.face_cell_ids = face_cell_ids.data();
+    view.face_areas = face_areas.data();
+    view.face_centroids = face_centroids.data();
+    view.face_normal0s = face_normal0.data();
+    view.face_normal1s = face_normal1.data();
   }
+  return view;
+}
 
-  if (sides_requested)
-    cache_side_info();
-  if (wedges_requested) {  // keep this order
-    if (!side_info_cached) cache_side_info();
-    cache_wedge_info();
-  }
-  if (corners_requested) {  // Keep this order
-    if (!side_info_cached) cache_side_info();
-    if (!wedge_info_cached) cache_wedge_info();
-    cache_corner_info();
-  }
 
-  update_geometric_quantities();
-}
+// Nodes of a cell
 
+void Mesh::cell_get_nodes(const Entity_ID cellid,
+                          Entity_ID_List *nodeids) const {
+#if JALI_CACHE_VARS != 0
 
-// Partition the mesh on this compute node into submeshes or tiles
+  //
+  // Cached version - turn off for profiling or to save memory
+  //
 
-void Mesh::build_tiles() {
+  Entity_ID_View cnodes = cell_nodes(cellid);
+  nodeids->assign(cnodes.begin(), cnodes.end());  // copy operation
 
-  std::vector<std::vector<int>> partitions;
-  partitions.resize(num_tiles_ini_);
+#else
 
-  std::cerr << "Calling partitioner " << partitioner_pref_ << "\n";
-  get_partitioning(num_tiles_ini_, partitioner_pref_, &partitions);
+  //
+  // Non-cached version
+  //
 
-  // Make the tiles - make mesh tile will also call a routine of this mesh
-  // to add the tile to the mesh's list of tiles
+  cell_get_nodes_internal(cellid, nodeids);
 
-  for (int i = 0; i < num_tiles_ini_; ++i)
-    make_meshtile(*this, partitions[i], num_ghost_layers_tile_, faces_requested,
-                  edges_requested, sides_requested, wedges_requested,
-                  corners_requested);
+#endif
 }
 
 
+// Nodes of a face in the order consistent with the face normal
 
-// Initialize some arrays for storing master tile ID of entity. On
-// this tile, the entity is OWNED. It can be a GHOST on any number of
-// other entities
+void Mesh::face_get_nodes(const Entity_ID faceid,
+                          Entity_ID_List *nodeids) const {
+#if JALI_CACHE_VARS != 0
 
-void Mesh::init_tiles() {
-  tiles_initialized_ = true;
-  node_master_tile_ID_.resize(num_nodes(), -1);
-  if (edges_requested) edge_master_tile_ID_.resize(num_edges(), -1);
-  if (faces_requested) face_master_tile_ID_.resize(num_faces(), -1);
-  cell_master_tile_ID_.resize(num_cells(), -1);
-}
+  //
+  // Cached version - turn off for profiling or to save memory
+  //
 
+  Entity_ID_View fnodes = face_nodes(faceid);
+  nodeids->assign(fnodes.begin(), fnodes.end());  // copy operation
 
-// Add one tile to the mesh
+#else
 
-void Mesh::add_tile(std::shared_ptr<MeshTile> const tile2add) {
-  meshtiles.emplace_back(tile2add);
-}
+  //
+  // Non-cached version
+  //
 
-  
-Entity_ID Mesh::entity_get_parent(const Entity_kind kind,
-                                  const Entity_ID entid) const {
-  Errors::Message mesg("Parent/daughter entities not"
-                       " enabled in this framework.");
-  Exceptions::Jali_throw(mesg);
-  return -1;
+  face_get_nodes_internal(faceid, nodeids);
+
+#endif
 }
 
 
@@ -649,9 +1919,9 @@ unsigned int Mesh::cell_get_num_faces(const Entity_ID cellid) const {
   //
   // Cached version - turn off for profiling or to save memory
   //
-  assert(cell2face_info_cached);
+  build_once(cell2face_info_cached, &Mesh::cache_cell2face_info);
 
-  return cell_face_ids[cellid].size();
+  return cell_face_offsets[cellid+1] - cell_face_offsets[cellid];
 
 #else
 
@@ -678,18 +1948,17 @@ void Mesh::cell_get_faces_and_dirs(const Entity_ID cellid,
   //
   // Cached version - turn off for profiling or to save memory
   //
-  assert(cell2face_info_cached);
+  build_once(cell2face_info_cached, &Mesh::cache_cell2face_info);
 
   if (ordered) {
     cell_get_faces_and_dirs_internal(cellid, faceids, face_dirs, ordered);
   } else {
-    Entity_ID_List &cfaceids = cell_face_ids[cellid];
-
-    *faceids = cfaceids;  // copy operation
+    Entity_ID_View cfaceids = cell_faces(cellid);
+    faceids->assign(cfaceids.begin(), cfaceids.end());  // copy operation
 
     if (face_dirs) {
-      std::vector<dir_t> &cfacedirs = cell_face_dirs[cellid];
-      *face_dirs = cfacedirs;  // copy operation
+      Dir_View cfacedirs = cell_face_dirs(cellid);
+      face_dirs->assign(cfacedirs.begin(), cfacedirs.end());  // copy operation
     }
   }
 
@@ -717,36 +1986,33 @@ void Mesh::face_get_cells(const Entity_ID faceid, const Entity_type ptype,
   // Cached version - turn off for profiling or to save memory
   //
 
-  assert(face2cell_info_cached);
+  build_once(face2cell_info_cached, &Mesh::cache_face2cell_info);
 
 
-  cellids->clear();
+  Entity_ID_View fcells = face_cells(faceid);
 
   switch (ptype) {
     case Entity_type::ALL: {
-      for (int i = 0; i < 2; i++) {
-        Entity_ID c = face_cell_ids[faceid][i];
-        if (c != -1) cellids->push_back(c);
-      }
+      cellids->assign(fcells.begin(), fcells.end());
       break;
     }
     case Entity_type::PARALLEL_OWNED: {
-      for (int i = 0; i < 2; i++) {
-        Entity_ID c = face_cell_ids[faceid][i];
-        if (c != -1 && cell_type[c] == Entity_type::PARALLEL_OWNED)
+      cellids->clear();
+      for (auto const& c : fcells)
+        if (cell_type[c] == Entity_type::PARALLEL_OWNED)
           cellids->push_back(c);
-      }
       break;
     }
     case Entity_type::PARALLEL_GHOST: {
-      for (int i = 0; i < 2; i++) {
-        Entity_ID c = face_cell_ids[faceid][i];
-        if (c != -1 && cell_type[c] == Entity_type::PARALLEL_GHOST)
+      cellids->clear();
+      for (auto const& c : fcells)
+        if (cell_type[c] == Entity_type::PARALLEL_GHOST)
           cellids->push_back(c);
-      }
       break;
     }
-    default: {}      
+    default: {
+      cellids->clear();
+    }
   }
 
 #else
@@ -796,16 +2062,16 @@ void Mesh::face_get_edges_and_dirs(const Entity_ID faceid,
   // Cached version - turn off for profiling or to save memory
   //
 
-  assert(face2edge_info_cached);
+  build_once(face2edge_info_cached, &Mesh::cache_face2edge_info);
 
-  *edgeids = face_edge_ids[faceid];  // copy operation
+  Entity_ID_View fedgeids = face_edges(faceid);
+  edgeids->assign(fedgeids.begin(), fedgeids.end());  // copy operation
 
   if (edge_dirs) {
-    std::vector<dir_t> &fedgedirs = face_edge_dirs[faceid];
-    *edge_dirs = fedgedirs;  // copy operation
+    Dir_View fedgedirs = face_edge_dirs(faceid);
+    edge_dirs->assign(fedgedirs.begin(), fedgedirs.end());  // copy operation
   }
 
-
 #else
 
   //
@@ -829,14 +2095,20 @@ void Mesh::face_to_cell_edge_map(const Entity_ID faceid,
   // Cached version - turn off for profiling or to save memory
   //
 
-  assert(face2edge_info_cached && cell2edge_info_cached);
+  build_once(face2edge_info_cached, &Mesh::cache_face2edge_info);
+  build_once(cell2edge_info_cached, &Mesh::cache_cell2edge_info);
+
+  Entity_ID_View fedgeids = face_edges(faceid);
+  int nfedges = fedgeids.size();
+  Entity_ID_View cedgeids = cell_edges(cellid);
+  int ncedges = cedgeids.size();
 
-  map->resize(face_edge_ids[faceid].size());
-  for (int f = 0; f < face_edge_ids[faceid].size(); ++f) {
-    Entity_ID fedge = face_edge_ids[faceid][f];
+  map->resize(nfedges);
+  for (int f = 0; f < nfedges; ++f) {
+    Entity_ID fedge = fedgeids[f];
 
-    for (int c = 0; c < cell_edge_ids[cellid].size(); ++c) {
-      if (fedge == cell_edge_ids[cellid][c]) {
+    for (int c = 0; c < ncedges; ++c) {
+      if (fedge == cedgeids[c]) {
         (*map)[f] = c;
         break;
       }
@@ -875,9 +2147,10 @@ void Mesh::cell_get_edges(const Entity_ID cellid,
   // Cached version - turn off for profiling
   //
 
-  assert(cell2edge_info_cached);
+  build_once(cell2edge_info_cached, &Mesh::cache_cell2edge_info);
 
-  *edgeids = cell_edge_ids[cellid];  // copy operation
+  Entity_ID_View cedgeids = cell_edges(cellid);
+  edgeids->assign(cedgeids.begin(), cedgeids.end());  // copy operation
 
 #else
 
@@ -900,10 +2173,12 @@ void Mesh::cell_2D_get_edges_and_dirs(const Entity_ID cellid,
   // Cached version - turn off for profiling
   //
 
-  assert(cell2edge_info_cached);
+  build_once(cell2edge_info_cached, &Mesh::cache_cell2edge_info);
 
-  *edgeids = cell_edge_ids[cellid];  // copy operation
-  *edgedirs = cell_2D_edge_dirs[cellid];
+  Entity_ID_View cedgeids = cell_edges(cellid);
+  Dir_View cedgedirs = cell_2D_edge_dirs(cellid);
+  edgeids->assign(cedgeids.begin(), cedgeids.end());  // copy operation
+  edgedirs->assign(cedgedirs.begin(), cedgedirs.end());  // copy operation
 
 #else
 
@@ -920,21 +2195,19 @@ void Mesh::cell_2D_get_edges_and_dirs(const Entity_ID cellid,
 void Mesh::cell_get_sides(const Entity_ID cellid,
                            Entity_ID_List *sideids) const {
   assert(sides_requested);
-  assert(side_info_cached);
+  build_once(side_info_cached, &Mesh::cache_side_info);
 
-  int nsides = cell_side_ids[cellid].size();
-  sideids->resize(nsides);
-  std::copy(cell_side_ids[cellid].begin(), cell_side_ids[cellid].end(),
-            sideids->begin());
+  Entity_ID_View csides = cell_sides(cellid);
+  sideids->assign(csides.begin(), csides.end());
 }
 
 
 void Mesh::cell_get_wedges(const Entity_ID cellid,
                            Entity_ID_List *wedgeids) const {
   assert(wedges_requested);
-  assert(side_info_cached);
+  build_once(side_info_cached, &Mesh::cache_side_info);
 
-  std::vector<Entity_ID>& csides = cell_side_ids[cellid];
+  Entity_ID_View csides = cell_sides(cellid);
   int nsides = csides.size();
   int nwedges = 2*nsides;
   wedgeids->resize(nwedges);
@@ -948,28 +2221,21 @@ void Mesh::cell_get_wedges(const Entity_ID cellid,
 void Mesh::cell_get_corners(const Entity_ID cellid,
                             Entity_ID_List *cornerids) const {
   assert(corners_requested);
-  assert(corner_info_cached);
+  build_once(corner_info_cached, &Mesh::cache_corner_info);
 
-  int ncorners = cell_corner_ids[cellid].size();
-  cornerids->resize(ncorners);
-  std::copy(cell_corner_ids[cellid].begin(), cell_corner_ids[cellid].end(),
-            cornerids->begin());
+  Entity_ID_View ccorners = cell_corners(cellid);
+  cornerids->assign(ccorners.begin(), ccorners.end());
 }
 
 
 Entity_ID Mesh::cell_get_corner_at_node(const Entity_ID cellid,
                                         const Entity_ID nodeid) const {
   assert(corners_requested);
-  assert(corner_info_cached);
+  build_once(corner_info_cached, &Mesh::cache_corner_info);
 
-  Entity_ID_List::iterator itc = cell_corner_ids[cellid].begin();
-  while (itc != cell_corner_ids[cellid].end()) {
-    int cornerid = *itc;
+  for (auto const& cornerid : cell_corners(cellid))
     if (corner_get_node(cornerid) == nodeid)
       return cornerid;
-    else
-      ++itc;
-  }
   return -1;   // shouldn't come here unless node does not belong to cell
 }
 
@@ -977,14 +2243,13 @@ Entity_ID Mesh::cell_get_corner_at_node(const Entity_ID cellid,
 void Mesh::node_get_wedges(const Entity_ID nodeid, Entity_type ptype,
                            Entity_ID_List *wedgeids) const {
   assert(wedges_requested);
-  assert(wedge_info_cached && corner_info_cached);
+  build_once(corner_info_cached, &Mesh::cache_corner_info);
 
   wedgeids->clear();
-  for (auto const& cn : node_corner_ids[nodeid]) {
-    Entity_ID_List cnwedges = corner_wedge_ids[cn];
-    for (auto const& w : cnwedges) {
+  for (auto const& cn : node_corners(nodeid)) {
+    for (auto const& w : corner_wedges(cn)) {
       Entity_ID s = static_cast<Entity_ID>(w/2);
-      Entity_ID c = side_cell_id[s];
+      Entity_ID c = side_get_cell(s);
       if (ptype == Entity_type::ALL || cell_type[c] == ptype)
         wedgeids->push_back(w);
     }
@@ -995,20 +2260,20 @@ void Mesh::node_get_wedges(const Entity_ID nodeid, Entity_type ptype,
 void Mesh::node_get_corners(const Entity_ID nodeid, Entity_type ptype,
                             Entity_ID_List *cornerids) const {
   assert(corners_requested);
-  assert(corner_info_cached);
+  build_once(corner_info_cached, &Mesh::cache_corner_info);
 
   switch (ptype) {
-    case Entity_type::ALL:
-      cornerids->resize(node_corner_ids[nodeid].size());
-      std::copy(node_corner_ids[nodeid].begin(), node_corner_ids[nodeid].end(),
-                cornerids->begin());
+    case Entity_type::ALL: {
+      Entity_ID_View ncorners = node_corners(nodeid);
+      cornerids->assign(ncorners.begin(), ncorners.end());
       break;
+    }
     default:
       cornerids->clear();
-      for (auto const& cn : node_corner_ids[nodeid]) {
-        Entity_ID w0 = corner_wedge_ids[cn][0];
+      for (auto const& cn : node_corners(nodeid)) {
+        Entity_ID w0 = corner_wedges(cn)[0];
         Entity_ID s = static_cast<Entity_ID>(w0/2);
-        Entity_ID c = side_cell_id[s];
+        Entity_ID c = side_get_cell(s);
         if (cell_type[c] == ptype)
           cornerids->push_back(cn);
       }
@@ -1017,28 +2282,160 @@ void Mesh::node_get_corners(const Entity_ID nodeid, Entity_type ptype,
 }
 
 
+// Cells of type 'ptype' connected to a node - cache the node to cell
+// info the first time this is called and return the cached results
+// subsequently
+
+void Mesh::node_get_cells(const Entity_ID nodeid, const Entity_type ptype,
+                          Entity_ID_List *cellids) const {
+#if JALI_CACHE_VARS != 0
+  copy_entities_of_type(node_cells(nodeid), ptype, cell_type, cellids);
+#else
+  node_get_cells_internal(nodeid, ptype, cellids);
+#endif
+}
+
+
+// Faces of type 'ptype' connected to a node - cache the node to face
+// info the first time this is called and return the cached results
+// subsequently
+
+void Mesh::node_get_faces(const Entity_ID nodeid, const Entity_type ptype,
+                          Entity_ID_List *faceids) const {
+#if JALI_CACHE_VARS != 0
+  copy_entities_of_type(node_faces(nodeid), ptype, face_type, faceids);
+#else
+  node_get_faces_internal(nodeid, ptype, faceids);
+#endif
+}
+
+
+// Face connected neighboring cells of type 'ptype' of a cell - cache
+// the face adjacencies of all cells the first time this is called and
+// return the cached results subsequently
+
+void Mesh::cell_get_face_adj_cells(const Entity_ID cellid,
+                                   const Entity_type ptype,
+                                   Entity_ID_List *fadj_cellids) const {
+#if JALI_CACHE_VARS != 0
+  copy_entities_of_type(cell_face_adj_cells(cellid), ptype, cell_type,
+                        fadj_cellids);
+#else
+  cell_get_face_adj_cells_internal(cellid, ptype, fadj_cellids);
+#endif
+}
+
+
+// Node connected neighboring cells of type 'ptype' of a cell - cache
+// the node adjacencies of all cells the first time this is called and
+// return the cached results subsequently
+
+void Mesh::cell_get_node_adj_cells(const Entity_ID cellid,
+                                   const Entity_type ptype,
+                                   Entity_ID_List *nadj_cellids) const {
+#if JALI_CACHE_VARS != 0
+  copy_entities_of_type(cell_node_adj_cells(cellid), ptype, cell_type,
+                        nadj_cellids);
+#else
+  cell_get_node_adj_cells_internal(cellid, ptype, nadj_cellids);
+#endif
+}
+
+
+// The compute_*_geometric_quantities functions process the entities
+// concurrently (when threading is enabled). The cached info the
+// entities need, including the node coordinates, is built up front
+// on every path because the threads cannot build it themselves while
+// the calling thread holds the cache lock
+
 int Mesh::compute_cell_geometric_quantities() const {
   int ncells = num_cells<Entity_type::ALL>();
 
+  build_once(cell2node_info_cached, &Mesh::cache_cell2node_info);
+  if (manifold_dim_ == 3) {
+    build_once(cell2face_info_cached, &Mesh::cache_cell2face_info);
+    build_once(face2node_info_cached, &Mesh::cache_face2node_info);
+  }
+  build_once(node_coords_cached, &Mesh::cache_node_coordinates);
+
   cell_volumes.resize(ncells);
   cell_centroids.resize(ncells);
   
   std::vector<double> zerovec(space_dim_, 0.0);
-  for (int c = 0; c < ncells; c++) {
-    if (cell_type[c] == Entity_type::BOUNDARY_GHOST) {
-      cell_volumes[c] = 0.0;
-      cell_centroids[c].set(space_dim_, &(zerovec[0]));
-    } else {
-      double volume;
-      JaliGeometry::Point centroid(space_dim_);
-      
-      compute_cell_geometry(c, &volume, &centroid);
-      
-      cell_volumes[c] = volume;
-      cell_centroids[c] = centroid;
+
+  if (batched_geometry()) {
+    build_once(cell_batches_cached, &Mesh::cache_cell_batches);
+    double const *xyz[3] = {node_coordinates_[0], node_coordinates_[1],
+                            node_coordinates_[2]};
+
+    for (int t = 0; t < 9; t++) {
+      std::vector<Entity_ID> const& ids = geometry_batches_.cellids[t];
+      if (ids.empty()) continue;
+
+      Cell_batch_kernel const *kernel =
+          cell_batch_kernel(static_cast<Cell_type>(t), manifold_dim_,
+                            space_dim_);
+      Entity_ID const *cnodes = geometry_batches_.cellnodes[t].data();
+      Entity_ID const *cfnodes = geometry_batches_.cellfacenodes[t].data();
+      int nfn = (manifold_dim_ == 3) ? 4*kernel->nquads + 3*kernel->ntris : 0;
+
+      parallel_for_chunks(ids.size(), [&](int ibegin, int iend, int) {
+          kernel->vol_centroid(iend-ibegin, ids.data()+ibegin,
+                               cnodes + kernel->nnodes*ibegin,
+                               cfnodes + nfn*ibegin, xyz,
+                               cell_volumes.data(), cell_centroids.data());
+        });
     }
+
+    // Everything else goes through the general polygon/polyhedron
+    // kernels one cell at a time
+
+    Cell_type generic_type = (manifold_dim_ == 3) ? Cell_type::POLYHED :
+        Cell_type::POLYGON;
+    std::vector<Entity_ID> const& ids = geometry_batches_.other_cellids;
+    parallel_for(ids.size(), [&](int i) {
+        Entity_ID c = ids[i];
+        if (cell_type[c] == Entity_type::BOUNDARY_GHOST) {
+          cell_volumes[c] = 0.0;
+          cell_centroids[c].set(space_dim_, &(zerovec[0]));
+        } else {
+          JaliGeometry::Point centroid(space_dim_);
+          compute_cell_geometry(c, generic_type, &(cell_volumes[c]),
+                                &centroid);
+          cell_centroids[c] = centroid;
+        }
+      });
+
+    cell_geometry_precomputed = true;
+    return 1;
+  }
+
+  // The cell types pick the geometry kernel of each cell. They are
+  // queried from the framework up front since the framework is not
+  // thread-safe
+
+  std::vector<Cell_type> ctypes(ncells, Cell_type::CELLTYPE_UNKNOWN);
+  if (manifold_dim_ > 1) {
+    for (int c = 0; c < ncells; c++)
+      if (cell_type[c] != Entity_type::BOUNDARY_GHOST)
+        ctypes[c] = cell_get_type(c);
   }
 
+  parallel_for(ncells, [&](int c) {
+      if (cell_type[c] == Entity_type::BOUNDARY_GHOST) {
+        cell_volumes[c] = 0.0;
+        cell_centroids[c].set(space_dim_, &(zerovec[0]));
+      } else {
+        double volume;
+        JaliGeometry::Point centroid(space_dim_);
+
+        compute_cell_geometry(c, ctypes[c], &volume, &centroid);
+
+        cell_volumes[c] = volume;
+        cell_centroids[c] = centroid;
+      }
+    });
+
   cell_geometry_precomputed = true;
   return 1;
 }  // Mesh::compute_cell_geometric_quantities
@@ -1048,29 +2445,92 @@ int Mesh::compute_cell_geometric_quantities() const {
 int Mesh::compute_face_geometric_quantities() const {
   int nfaces = num_faces<Entity_type::ALL>();
 
+  build_once(face2node_info_cached, &Mesh::cache_face2node_info);
+  build_once(face2cell_info_cached, &Mesh::cache_face2cell_info);
+  build_once(cell2face_info_cached, &Mesh::cache_cell2face_info);
+  if (manifold_dim_ == 2 && space_dim_ == 3)  // surface mesh
+    build_once(cell2node_info_cached, &Mesh::cache_cell2node_info);
+  build_once(node_coords_cached, &Mesh::cache_node_coordinates);
+
   face_areas.resize(nfaces);
   face_centroids.resize(nfaces);
   face_normal0.resize(nfaces);
   face_normal1.resize(nfaces);
 
-  for (int i = 0; i < nfaces; i++) {
+  // normal0 and normal1 are outward normals of the face with respect
+  // to the cell0 and cell1 of the face. The natural normal of the
+  // face points out of cell0 and into cell1. If one of these cells do
+  // not exist, then the normal is the null vector.
+
+  auto compute_one_face = [&](int i) {
     double area;
     JaliGeometry::Point centroid(space_dim_), normal0(space_dim_),
         normal1(space_dim_);
 
-    // normal0 and normal1 are outward normals of the face with
-    // respect to the cell0 and cell1 of the face. The natural normal
-    // of the face points out of cell0 and into cell1. If one of these
-    // cells do not exist, then the normal is the null vector.
-
     compute_face_geometry(i, &area, &centroid, &normal0, &normal1);
 
     face_areas[i] = area;
     face_centroids[i] = centroid;
     face_normal0[i] = normal0;
     face_normal1[i] = normal1;
+  };
+
+  if (batched_geometry()) {
+    build_once(face_batches_cached, &Mesh::cache_face_batches);
+    double const *xyz[3] = {node_coordinates_[0], node_coordinates_[1],
+                            node_coordinates_[2]};
+    std::vector<char> const& fdirs = geometry_batches_.face_normal_dirs;
+    JaliGeometry::Point zeropnt(space_dim_);
+
+    // The batched kernels put the natural normal in normal0 - turn it
+    // into the two outward normals
+
+    auto set_face_normals = [&](Entity_ID f) {
+      face_normal1[f] = (fdirs[f] & 2) ? -face_normal0[f] : zeropnt;
+      if (!(fdirs[f] & 1))
+        face_normal0[f] = zeropnt;
+    };
+
+    if (manifold_dim_ == 3) {
+      for (int k = 0; k < 2; k++) {
+        std::vector<Entity_ID> const& ids = geometry_batches_.faceids[k];
+        Entity_ID const *fnodes = geometry_batches_.facenodes[k].data();
+        int np = k+3;
+        parallel_for_chunks(ids.size(), [&](int ibegin, int iend, int) {
+            face_area_centroid_normal_batch(np, iend-ibegin,
+                                            ids.data()+ibegin,
+                                            fnodes + np*ibegin, xyz,
+                                            face_areas.data(),
+                                            face_centroids.data(),
+                                            face_normal0.data());
+            for (int i = ibegin; i < iend; i++)
+              set_face_normals(ids[i]);
+          });
+      }
+
+      std::vector<Entity_ID> const& ids = geometry_batches_.other_faceids;
+      parallel_for(ids.size(), [&](int i) { compute_one_face(ids[i]); });
+    } else {
+      // Faces of a 2D mesh are segments with two nodes each
+
+      assert(face_node_offsets[nfaces] == 2*nfaces);
+      parallel_for_chunks(nfaces, [&](int ibegin, int iend, int) {
+          face2d_area_centroid_normal_batch(iend-ibegin,
+                                            face_node_ids.data() + 2*ibegin,
+                                            xyz, face_areas.data() + ibegin,
+                                            face_centroids.data() + ibegin,
+                                            face_normal0.data() + ibegin);
+          for (int f = ibegin; f < iend; f++)
+            set_face_normals(f);
+        });
+    }
+
+    face_geometry_precomputed = true;
+    return 1;
   }
 
+  parallel_for(nfaces, compute_one_face);
+
   face_geometry_precomputed = true;
   return 1;
 }  // Mesh::compute_face_geometric_quantities
@@ -1080,18 +2540,39 @@ int Mesh::compute_face_geometric_quantities() const {
 int Mesh::compute_edge_geometric_quantities() const {
   int nedges = num_edges<Entity_type::ALL>();
 
+  build_once(edge2node_info_cached, &Mesh::cache_edge2node_info);
+  build_once(node_coords_cached, &Mesh::cache_node_coordinates);
+
   edge_vectors.resize(nedges);
   edge_lengths.resize(nedges);
 
-  for (int i = 0; i < nedges; i++) {
-    double length;
-    JaliGeometry::Point evector(space_dim_), ecenter;
+  if (batched_geometry()) {
+    double const *xyz[3] = {node_coordinates_[0], node_coordinates_[1],
+                            node_coordinates_[2]};
+    static_assert(sizeof(std::array<Entity_ID, 2>) == 2*sizeof(Entity_ID),
+                  "edge/side node pairs must be laid out contiguously");
+    Entity_ID const *enodes =
+        reinterpret_cast<Entity_ID const *>(edge_node_ids.data());
+
+    parallel_for_chunks(nedges, [&](int ibegin, int iend, int) {
+        edge_length_vector_batch(space_dim_, iend-ibegin, enodes + 2*ibegin,
+                                 xyz, edge_lengths.data() + ibegin,
+                                 edge_vectors.data() + ibegin);
+      });
+
+    edge_geometry_precomputed = true;
+    return 1;
+  }
 
-    compute_edge_geometry(i, &length, &evector, &ecenter);
+  parallel_for(nedges, [&](int i) {
+      double length;
+      JaliGeometry::Point evector(space_dim_), ecenter;
 
-    edge_lengths[i] = length;
-    edge_vectors[i] = evector;
-  }
+      compute_edge_geometry(i, &length, &evector, &ecenter);
+
+      edge_lengths[i] = length;
+      edge_vectors[i] = evector;
+    });
 
   edge_geometry_precomputed = true;
   return 1;
@@ -1099,111 +2580,236 @@ int Mesh::compute_edge_geometric_quantities() const {
 
 
 int Mesh::compute_side_geometric_quantities() const {
-  side_volumes.resize(num_sides());
+  std::vector<Entity_ID> const& sideids = sides();
+  int nsides = sideids.size();
+
+  build_once(cell_geometry_precomputed,
+             &Mesh::compute_cell_geometric_quantities);
+  if (manifold_dim_ == 3)
+    build_once(face_geometry_precomputed,
+               &Mesh::compute_face_geometric_quantities);
+  build_once(cell2node_info_cached, &Mesh::cache_cell2node_info);
+  build_once(edge2node_info_cached, &Mesh::cache_edge2node_info);
+  build_once(node_coords_cached, &Mesh::cache_node_coordinates);
+
+  side_volumes.resize(nsides);
+
+  // The facet normals are assigned (rather than resized) so that
+  // they get the right dimensionality; every entry is then
+  // overwritten by the thread handling that side
+
+  JaliGeometry::Point zeropnt(space_dim_);
+  side_outward_facet_normal.assign(nsides, zeropnt);
+  side_mid_facet_normal.assign(nsides, zeropnt);
+
+  if (batched_geometry()) {
+    double const *xyz[3] = {node_coordinates_[0], node_coordinates_[1],
+                            node_coordinates_[2]};
+
+    // Boundary ghost sides have no geometry
+
+    std::vector<Entity_ID> ids;
+    ids.reserve(nsides);
+    for (auto const& s : sideids) {
+      if (entity_get_type(Entity_kind::SIDE, s) ==
+          Entity_type::BOUNDARY_GHOST)
+        side_volumes[s] = 0.0;
+      else
+        ids.push_back(s);
+    }
 
-  // Cannot use resize for the facet normals because we cannot tell
-  // the initialization operator what the dimensionality of the points
-  // will be, unless we can write a statement like this
-  //
-  //  wedge_facet_normals0.resize(nwedges, Point(3));
-  //
-  // It is also unclear that this is good to do because it will cause
-  // a copy operator to be triggered for each element (?)
-
-  side_outward_facet_normal.reserve(num_sides());
-  side_mid_facet_normal.reserve(num_sides());
-
-  JaliGeometry::Point outward_facet_normal(space_dim_);
-  JaliGeometry::Point mid_facet_normal(space_dim_);
-  for (auto const & s : sides()) {
-    if (entity_get_type(Entity_kind::SIDE, s) == Entity_type::BOUNDARY_GHOST) {
-      side_volumes[s] = 0.0;
-      outward_facet_normal.set(0.0);
-      mid_facet_normal.set(0.0);
-    } else {
-      compute_side_geometry(s, &(side_volumes[s]),
-                            &(outward_facet_normal),
-                            &(mid_facet_normal));
+    if (implicit_sides_) {
+      // There are no side tables to hand to the kernel - gather the
+      // nodes, face, cell and edge of each block of sides into small
+      // buffers indexed by position in the block and scatter the
+      // results back
+
+      parallel_for_chunks(ids.size(), [&](int ibegin, int iend, int) {
+          int const B = geometry_batch_size;
+          Entity_ID lids[B], lnodes[2*B], lfaces[B], lcells[B], ledges[B];
+          double lvol[B];
+          Scratch_vector<JaliGeometry::Point> lout, lmid;
+          lout->assign(B, zeropnt);
+          lmid->assign(B, zeropnt);
+
+          for (int i0 = ibegin; i0 < iend; i0 += B) {
+            int nb = std::min(B, iend-i0);
+            for (int i = 0; i < nb; ++i) {
+              Entity_ID s = ids[i0+i];
+              int j = implicit_side_cell_face(s);
+              lids[i] = i;
+              lcells[i] = cell_face_cell_ids[j];
+              lfaces[i] = cell_face_ids[j];
+              ledges[i] = face_edge_ids[implicit_side_face_edge(s, j)];
+              lnodes[2*i] = side_get_node(s, 0);
+              lnodes[2*i+1] = side_get_node(s, 1);
+            }
+
+            side_geometry_batch(
+                manifold_dim_, nb, lids, lnodes, lfaces, lcells, ledges,
+                reinterpret_cast<Entity_ID const *>(edge_node_ids.data()),
+                xyz, face_centroids.data(), cell_centroids.data(),
+                lvol, lout->data(), lmid->data());
+
+            for (int i = 0; i < nb; ++i) {
+              Entity_ID s = ids[i0+i];
+              side_volumes[s] = lvol[i];
+              side_outward_facet_normal[s] = lout[i];
+              side_mid_facet_normal[s] = lmid[i];
+            }
+          }
+        });
+
+      side_geometry_precomputed = true;
+      return 1;
     }
-    side_outward_facet_normal.push_back(outward_facet_normal);
-    side_mid_facet_normal.push_back(mid_facet_normal);
+
+    parallel_for_chunks(ids.size(), [&](int ibegin, int iend, int) {
+        side_geometry_batch(
+            manifold_dim_, iend-ibegin, ids.data()+ibegin,
+            reinterpret_cast<Entity_ID const *>(side_node_ids.data()),
+            side_face_id.data(), side_cell_id.data(), side_edge_id.data(),
+            reinterpret_cast<Entity_ID const *>(edge_node_ids.data()),
+            xyz, face_centroids.data(), cell_centroids.data(),
+            side_volumes.data(), side_outward_facet_normal.data(),
+            side_mid_facet_normal.data());
+      });
+
+    side_geometry_precomputed = true;
+    return 1;
   }
 
+  parallel_for(nsides, [&](int i) {
+      Entity_ID s = sideids[i];
+      if (entity_get_type(Entity_kind::SIDE, s) ==
+          Entity_type::BOUNDARY_GHOST) {
+        side_volumes[s] = 0.0;
+      } else {
+        compute_side_geometry(s, &(side_volumes[s]),
+                              &(side_outward_facet_normal[s]),
+                              &(side_mid_facet_normal[s]));
+      }
+    });
+
   side_geometry_precomputed = true;
   return 1;
 }
 
 int Mesh::compute_corner_geometric_quantities() const {
-  corner_volumes.resize(num_corners());
-  for (auto const & cn : corners())
-    if (entity_get_type(Entity_kind::CORNER, cn) == Entity_type::BOUNDARY_GHOST)
-      corner_volumes[cn] = 0.0;
-    else
-      compute_corner_geometry(cn, &(corner_volumes[cn]));
+  std::vector<Entity_ID> const& cornerids = corners();
+  int ncorners = cornerids.size();
+
+  build_once(side_geometry_precomputed,
+             &Mesh::compute_side_geometric_quantities);
+
+  corner_volumes.resize(ncorners);
+  parallel_for(ncorners, [&](int i) {
+      Entity_ID cn = cornerids[i];
+      if (entity_get_type(Entity_kind::CORNER, cn) ==
+          Entity_type::BOUNDARY_GHOST)
+        corner_volumes[cn] = 0.0;
+      else
+        compute_corner_geometry(cn, &(corner_volumes[cn]));
+    });
   corner_geometry_precomputed = true;
   return 1;
 }
 
 int Mesh::compute_cell_geometry(const Entity_ID cellid, double *volume,
                                 JaliGeometry::Point *centroid) const {
+  Cell_type ctype = (manifold_dim_ == 1) ? Cell_type::CELLTYPE_UNKNOWN :
+      cell_get_type(cellid);
+  return compute_cell_geometry(cellid, ctype, volume, centroid);
+}
+
+
+int Mesh::compute_cell_geometry(const Entity_ID cellid, const Cell_type ctype,
+                                double *volume,
+                                JaliGeometry::Point *centroid) const {
   if (manifold_dim_ == 3) {
 
     // 3D Elements with possibly curved faces
     // We have to build a description of the element topology
-    // and send it into the polyhedron volume and centroid
-    // calculation routine
-
-    // General polyhedra always need to have an explicit face
-    // representation - special elements like hexes can get away
-    // without (but we have yet to put in the code for the standard
-    // node ordering and computation for these special elements)
+    // and send it into the volume and centroid kernel for the cell
+    // type (see cell_geometry.hh). Standard cells are described with
+    // fixed size arrays on the stack; general polyhedra use scratch
+    // vectors of the calling thread
 
-    Entity_ID_List cfaces;
-    std::vector<unsigned int> nfnodes;
-    std::vector<dir_t> fdirs;
-    std::vector<JaliGeometry::Point> ccoords, cfcoords, fcoords;
-
-    cell_get_faces_and_dirs(cellid, &cfaces, &fdirs);
+    Entity_ID_View cnodes = cell_nodes(cellid);
+    Entity_ID_View cfaces = cell_faces(cellid);
+    Dir_View fdirs = cell_face_dirs(cellid);
 
+    int nn = cnodes.size();
     int nf = cfaces.size();
-    nfnodes.resize(nf);
+    int nfn = 0;
+    for (int j = 0; j < nf; j++)
+      nfn += face_nodes(cfaces[j]).size();
+
+    JaliGeometry::Point ccoords_std[max_std_cell_nodes];
+    JaliGeometry::Point fcoords_std[max_std_cell_face_nodes];
+    int nfnodes_std[max_std_cell_faces];
+    Scratch_vector<JaliGeometry::Point> ccoords_gen, fcoords_gen;
+    Scratch_vector<int> nfnodes_gen;
+
+    JaliGeometry::Point *ccoords = ccoords_std;
+    JaliGeometry::Point *fcoords = fcoords_std;
+    int *nfnodes = nfnodes_std;
+    if (nn > max_std_cell_nodes || nf > max_std_cell_faces ||
+        nfn > max_std_cell_face_nodes) {
+      ccoords_gen->resize(nn);
+      fcoords_gen->resize(nfn);
+      nfnodes_gen->resize(nf);
+      ccoords = ccoords_gen->data();
+      fcoords = fcoords_gen->data();
+      nfnodes = nfnodes_gen->data();
+    }
 
-    for (int j = 0; j < nf; j++) {
+    for (int i = 0; i < nn; i++)
+      node_get_coordinates(cnodes[i], &(ccoords[i]));
 
-      face_get_coordinates(cfaces[j], &fcoords);
-      nfnodes[j] = fcoords.size();
+    int offset = 0;
+    for (int j = 0; j < nf; j++) {
+      Entity_ID_View fnodes = face_nodes(cfaces[j]);
+      nfnodes[j] = fnodes.size();
 
       if (fdirs[j] == 1) {
         for (int k = 0; k < nfnodes[j]; k++)
-          cfcoords.push_back(fcoords[k]);
+          node_get_coordinates(fnodes[k], &(fcoords[offset++]));
       } else {
-        for (int k = nfnodes[j]-1; k >=0; k--)
-          cfcoords.push_back(fcoords[k]);
+        for (int k = nfnodes[j]-1; k >= 0; k--)
+          node_get_coordinates(fnodes[k], &(fcoords[offset++]));
       }
     }
 
-    cell_get_coordinates(cellid, &ccoords);
-
-    JaliGeometry::polyhed_get_vol_centroid(ccoords, nf, nfnodes, cfcoords,
-                                           volume, centroid);
+    Cell_geometry_kernel const& kernel =
+        cell_geometry_kernel(ctype, manifold_dim_, nn, nf);
+    kernel.vol_centroid(nn, ccoords, nf, nfnodes, fcoords, volume, centroid);
     return 1;
   } else if (manifold_dim_ == 2) {
-    std::vector<JaliGeometry::Point> ccoords;
-
-    cell_get_coordinates(cellid, &ccoords);
-
-    JaliGeometry::Point normal(space_dim_);
+    Entity_ID_View cnodes = cell_nodes(cellid);
+    int nn = cnodes.size();
+
+    JaliGeometry::Point ccoords_std[max_std_cell_nodes];
+    Scratch_vector<JaliGeometry::Point> ccoords_gen;
+    JaliGeometry::Point *ccoords = ccoords_std;
+    if (nn > max_std_cell_nodes) {
+      ccoords_gen->resize(nn);
+      ccoords = ccoords_gen->data();
+    }
 
-    JaliGeometry::polygon_get_area_centroid_normal(ccoords, volume, centroid,
-                                                   &normal);
+    for (int i = 0; i < nn; i++)
+      node_get_coordinates(cnodes[i], &(ccoords[i]));
 
+    Cell_geometry_kernel const& kernel =
+        cell_geometry_kernel(ctype, manifold_dim_, nn, nn);
+    kernel.vol_centroid(nn, ccoords, 0, nullptr, nullptr, volume, centroid);
     return 1;
   } else if (manifold_dim_ == 1) {
-    std::vector<JaliGeometry::Point> ccoords;
+    Scratch_vector<JaliGeometry::Point> ccoords;
 
-    cell_get_coordinates(cellid, &ccoords);
+    cell_get_coordinates(cellid, ccoords.get());
 
-    JaliGeometry::segment_get_vol_centroid(ccoords, geomtype,
+    JaliGeometry::segment_get_vol_centroid(*ccoords, geomtype,
                                            volume, centroid);
     return 1;
   }
@@ -1216,7 +2822,7 @@ int Mesh::compute_face_geometry(const Entity_ID faceid, double *area,
                                 JaliGeometry::Point *centroid,
                                 JaliGeometry::Point *normal0,
                                 JaliGeometry::Point *normal1) const {
-  JaliGeometry::Point_List fcoords;
+  Scratch_vector<JaliGeometry::Point> fcoords;
 
   (*normal0).set(0.0L);
   (*normal1).set(0.0L);
@@ -1224,26 +2830,32 @@ int Mesh::compute_face_geometry(const Entity_ID faceid, double *area,
   if (manifold_dim_ == 3) {
 
     // 3D Elements with possibly curved faces
-    // We have to build a description of the element topology
-    // and send it into the polyhedron volume and centroid
-    // calculation routine
-
-    face_get_coordinates(faceid, &fcoords);
+    // Triangular and quadrilateral faces are described with fixed
+    // size arrays on the stack and sent to the kernel for their type
+    // (see cell_geometry.hh)
+
+    Entity_ID_View fnodes = face_nodes(faceid);
+    int nn = fnodes.size();
+
+    JaliGeometry::Point fcoords_std[4];
+    JaliGeometry::Point *fcoords_ptr = fcoords_std;
+    if (nn > 4) {
+      fcoords->resize(nn);
+      fcoords_ptr = fcoords->data();
+    }
+    for (int i = 0; i < nn; i++)
+      node_get_coordinates(fnodes[i], &(fcoords_ptr[i]));
 
     JaliGeometry::Point normal(3);
-    JaliGeometry::polygon_get_area_centroid_normal(fcoords, area, centroid,
-                                                   &normal);
+    polygon_geometry_kernel(nn)(nn, fcoords_ptr, area, centroid, &normal);
 
-    Entity_ID_List cellids;
-    face_get_cells(faceid, Entity_type::ALL, &cellids);
+    Entity_ID_View cellids = face_cells(faceid);
 
     for (int i = 0; i < cellids.size(); i++) {
-      Entity_ID_List cellfaceids;
-      std::vector<dir_t> cellfacedirs;
+      Entity_ID_View cellfaceids = cell_faces(cellids[i]);
+      Dir_View cellfacedirs = cell_face_dirs(cellids[i]);
       dir_t dir = 1;
 
-      cell_get_faces_and_dirs(cellids[i], &cellfaceids, &cellfacedirs);
-
       bool found = false;
       for (int j = 0; j < cellfaceids.size(); j++) {
         if (cellfaceids[j] == faceid) {
@@ -1266,7 +2878,7 @@ int Mesh::compute_face_geometry(const Entity_ID faceid, double *area,
 
     if (space_dim_ == 2) {   // 2D mesh
 
-      face_get_coordinates(faceid, &fcoords);
+      face_get_coordinates(faceid, fcoords.get());
 
       JaliGeometry::Point evec = fcoords[1]-fcoords[0];
       *area = sqrt(evec*evec);
@@ -1275,16 +2887,13 @@ int Mesh::compute_face_geometry(const Entity_ID faceid, double *area,
 
       JaliGeometry::Point normal(evec[1], -evec[0]);
 
-      Entity_ID_List cellids;
-      face_get_cells(faceid, Entity_type::ALL, &cellids);
+      Entity_ID_View cellids = face_cells(faceid);
 
       for (int i = 0; i < cellids.size(); i++) {
-        Entity_ID_List cellfaceids;
-        std::vector<dir_t> cellfacedirs;
+        Entity_ID_View cellfaceids = cell_faces(cellids[i]);
+        Dir_View cellfacedirs = cell_face_dirs(cellids[i]);
         dir_t dir = 1;
 
-        cell_get_faces_and_dirs(cellids[i], &cellfaceids, &cellfacedirs);
-
         bool found = false;
         for (int j = 0; j < cellfaceids.size(); j++) {
           if (cellfaceids[j] == faceid) {
@@ -1307,23 +2916,20 @@ int Mesh::compute_face_geometry(const Entity_ID faceid, double *area,
       // edge normals are ambiguous for surface mesh
       // So we won't compute them
 
-      face_get_coordinates(faceid, &fcoords);
+      face_get_coordinates(faceid, fcoords.get());
 
       JaliGeometry::Point evec = fcoords[1]-fcoords[0];
       *area = sqrt(evec*evec);
 
       *centroid = 0.5*(fcoords[0]+fcoords[1]);
 
-      Entity_ID_List cellids;
-      face_get_cells(faceid, Entity_type::ALL, &cellids);
+      Entity_ID_View cellids = face_cells(faceid);
 
       for (int i = 0; i < cellids.size(); i++) {
-        Entity_ID_List cellfaceids;
-        std::vector<dir_t> cellfacedirs;
+        Entity_ID_View cellfaceids = cell_faces(cellids[i]);
+        Dir_View cellfacedirs = cell_face_dirs(cellids[i]);
         dir_t dir = 1;
 
-        cell_get_faces_and_dirs(cellids[i], &cellfaceids, &cellfacedirs);
-
         bool found = false;
         for (int j = 0; j < cellfaceids.size(); j++) {
           if (cellfaceids[j] == faceid) {
@@ -1336,12 +2942,12 @@ int Mesh::compute_face_geometry(const Entity_ID faceid, double *area,
         assert(found);
 
         JaliGeometry::Point cellcen;
-        std::vector<JaliGeometry::Point> ccoords;
-        cell_get_coordinates(cellids[i], &ccoords);
+        Scratch_vector<JaliGeometry::Point> ccoords;
+        cell_get_coordinates(cellids[i], ccoords.get());
 
-        for (int j = 0; j < ccoords.size(); j++)
+        for (std::size_t j = 0; j < ccoords->size(); j++)
           cellcen += ccoords[j];
-        cellcen /= ccoords.size();
+        cellcen /= ccoords->size();
 
         JaliGeometry::Point cvec = fcoords[0]-cellcen;
         JaliGeometry::Point trinormal = cvec^evec;
@@ -1362,22 +2968,19 @@ int Mesh::compute_face_geometry(const Entity_ID faceid, double *area,
     }
 
   } else if (manifold_dim_ == 1) {
-    face_get_coordinates(faceid, &fcoords);
+    face_get_coordinates(faceid, fcoords.get());
 
-    JaliGeometry::face1d_get_area(fcoords, geomtype, area);
+    JaliGeometry::face1d_get_area(*fcoords, geomtype, area);
     JaliGeometry::Point normal(space_dim_);
     normal.set(*area);
 
-    Entity_ID_List cellids;
-    face_get_cells(faceid, Entity_type::ALL, &cellids);
+    Entity_ID_View cellids = face_cells(faceid);
 
     for (int i = 0; i < cellids.size(); i++) {
-      Entity_ID_List cellfaceids;
-      std::vector<dir_t> cellfacedirs;
+      Entity_ID_View cellfaceids = cell_faces(cellids[i]);
+      Dir_View cellfacedirs = cell_face_dirs(cellids[i]);
       dir_t dir = 1;
 
-      cell_get_faces_and_dirs(cellids[i], &cellfaceids, &cellfacedirs);
-
       bool found = false;
       for (int j = 0; j < cellfaceids.size(); j++) {
         if (cellfaceids[j] == faceid) {
@@ -1429,8 +3032,10 @@ void Mesh::compute_side_geometry(Entity_ID const sideid,
                                  double *side_volume,
                                  JaliGeometry::Point *outward_facet_normal,
                                  JaliGeometry::Point *mid_facet_normal) const {
+  build_once(side_info_cached, &Mesh::cache_side_info);
+
   if (manifold_dim_ == 3) {
-    std::vector<JaliGeometry::Point> scoords;
+    Scratch_vector<JaliGeometry::Point> scoords;
 
     // Get vertex coordinates of side
     //
@@ -1439,7 +3044,7 @@ void Mesh::compute_side_geometry(Entity_ID const sideid,
     // node 1, the triangle formed by node 0, node 1 and face center
     // will have a normal point inward.
 
-    side_get_coordinates(sideid, &scoords);
+    side_get_coordinates(sideid, scoords.get());
 
     // vector from node 0 to node 1
     JaliGeometry::Point vec0 = scoords[1] - scoords[0];
@@ -1464,7 +3069,7 @@ void Mesh::compute_side_geometry(Entity_ID const sideid,
     // face center and zone center. This is common (with a sign change)
     // to the two wedges of the side
 
-    JaliGeometry::Point ecen = edge_centroid(side_edge_id[sideid]);
+    JaliGeometry::Point ecen = edge_centroid(side_get_edge(sideid));
     
     JaliGeometry::Point vec3 = scoords[2] - ecen;
     JaliGeometry::Point vec4 = scoords[3] - ecen;
@@ -1472,13 +3077,13 @@ void Mesh::compute_side_geometry(Entity_ID const sideid,
     *mid_facet_normal = 0.5*(vec3^vec4);
 
   } else if (manifold_dim_ == 2) {
-    std::vector<JaliGeometry::Point> scoords;
+    Scratch_vector<JaliGeometry::Point> scoords;
     
     // Get vertex coordinates of side
     //
     // These are always - node coordinate, edge/face center, cell center
 
-    side_get_coordinates(sideid, &scoords);
+    side_get_coordinates(sideid, scoords.get());
 
     // vector from node 0 to node 1
     JaliGeometry::Point vec0 = scoords[1]-scoords[0];
@@ -1495,20 +3100,16 @@ void Mesh::compute_side_geometry(Entity_ID const sideid,
 
     *outward_facet_normal = JaliGeometry::Point(vec0[1], -vec0[0]);
 
-    JaliGeometry::Point ecen = edge_centroid(side_edge_id[sideid]);
-
-    JaliGeometry::Point vec3 = scoords[2] - ecen;
-
     *mid_facet_normal = JaliGeometry::Point(vec1[1], -vec1[0]);
 
   } else if (manifold_dim_ == 1) {
-    std::vector<JaliGeometry::Point> scoords;
+    Scratch_vector<JaliGeometry::Point> scoords;
 
     // Get vertex coordinates of side
     //
     // These are always - node coordinate and cell center
 
-    side_get_coordinates(sideid, &scoords);
+    side_get_coordinates(sideid, scoords.get());
 
     // vector from node to cell center
     JaliGeometry::Point vec0 = scoords[1]-scoords[0];
@@ -1532,8 +3133,7 @@ void Mesh::compute_side_geometry(Entity_ID const sideid,
     Entity_ID nodeid = side_node_ids[sideid][0];
     Entity_ID cellid = side_cell_id[sideid];
 
-    Entity_ID_List cnodes;
-    cell_get_nodes(cellid, &cnodes);
+    Entity_ID_View cnodes = cell_nodes(cellid);
     if (nodeid == cnodes[1]) {  // have to reverse sign of volume and normal
       *side_volume = -(*side_volume);
       *outward_facet_normal = -(*outward_facet_normal);
@@ -1547,21 +3147,18 @@ void Mesh::compute_side_geometry(Entity_ID const sideid,
 
 void Mesh::compute_corner_geometry(const Entity_ID cornerid,
                                    double *volume) const {
-  Entity_ID_List cwedges;
-  corner_get_wedges(cornerid, &cwedges);
-
   *volume = 0;
-  Entity_ID_List::iterator itw = cwedges.begin();
-  while (itw != cwedges.end()) {
-    Entity_ID w = *itw;
+  for (auto const& w : corner_wedges(cornerid))
     *volume += wedge_volume(w);
-    ++itw;
-  }
 }  // compute corner geometry
 
 // Volume/Area of cell
 
 double Mesh::cell_volume(const Entity_ID cellid, const bool recompute) const {
+  if (!recompute)
+    build_once(cell_geometry_precomputed,
+               &Mesh::compute_cell_geometric_quantities);
+
   if (recompute) {
     double volume;
     JaliGeometry::Point centroid(space_dim_);
@@ -1576,7 +3173,9 @@ double Mesh::cell_volume(const Entity_ID cellid, const bool recompute) const {
 
 double Mesh::face_area(const Entity_ID faceid, const bool recompute) const {
   assert(faces_requested);
-  assert(face_geometry_precomputed);
+  if (!recompute)
+    build_once(face_geometry_precomputed,
+               &Mesh::compute_face_geometric_quantities);
 
   if (recompute) {
     double area;
@@ -1593,7 +3192,9 @@ double Mesh::face_area(const Entity_ID faceid, const bool recompute) const {
 
 double Mesh::edge_length(const Entity_ID edgeid, const bool recompute) const {
   assert(edges_requested);
-  assert(edge_geometry_precomputed);
+  if (!recompute)
+    build_once(edge_geometry_precomputed,
+               &Mesh::compute_edge_geometric_quantities);
 
   if (recompute) {
     double length;
@@ -1609,7 +3210,9 @@ double Mesh::edge_length(const Entity_ID edgeid, const bool recompute) const {
 
 double Mesh::side_volume(const Entity_ID sideid, const bool recompute) const {
   assert(sides_requested);
-  assert(side_geometry_precomputed);
+  if (!recompute)
+    build_once(side_geometry_precomputed,
+               &Mesh::compute_side_geometric_quantities);
 
   if (recompute) {
     double side_volume;
@@ -1626,7 +3229,9 @@ double Mesh::side_volume(const Entity_ID sideid, const bool recompute) const {
 
 double Mesh::wedge_volume(const Entity_ID wedgeid, const bool recompute) const {
   assert(wedges_requested);
-  assert(side_geometry_precomputed);
+  if (!recompute)
+    build_once(side_geometry_precomputed,
+               &Mesh::compute_side_geometric_quantities);
 
   Entity_ID sideid = static_cast<Entity_ID>(wedgeid/2);
 
@@ -1646,7 +3251,9 @@ double Mesh::wedge_volume(const Entity_ID wedgeid, const bool recompute) const {
 double Mesh::corner_volume(const Entity_ID cornerid,
                            const bool recompute) const {
   assert(corners_requested);
-  assert(corner_geometry_precomputed);
+  if (!recompute)
+    build_once(corner_geometry_precomputed,
+               &Mesh::compute_corner_geometric_quantities);
 
   if (recompute) {
     double volume;
@@ -1661,7 +3268,9 @@ double Mesh::corner_volume(const Entity_ID cornerid,
 
 JaliGeometry::Point Mesh::cell_centroid(const Entity_ID cellid,
                                         const bool recompute) const {
-  assert(cell_geometry_precomputed);
+  if (!recompute)
+    build_once(cell_geometry_precomputed,
+               &Mesh::compute_cell_geometric_quantities);
 
   if (recompute) {
     double volume;
@@ -1678,7 +3287,9 @@ JaliGeometry::Point Mesh::cell_centroid(const Entity_ID cellid,
 JaliGeometry::Point Mesh::face_centroid(const Entity_ID faceid,
                                         const bool recompute) const {
   assert(faces_requested);
-  assert(face_geometry_precomputed);
+  if (!recompute)
+    build_once(face_geometry_precomputed,
+               &Mesh::compute_face_geometric_quantities);
 
   if (recompute) {
     double area;
@@ -1715,7 +3326,9 @@ JaliGeometry::Point Mesh::face_normal(const Entity_ID faceid,
                                       const Entity_ID cellid,
                                       int *orientation) const {
   assert(faces_requested);
-  assert(face_geometry_precomputed);
+  if (!recompute)
+    build_once(face_geometry_precomputed,
+               &Mesh::compute_face_geometric_quantities);
 
   JaliGeometry::Point normal0(space_dim_);
   JaliGeometry::Point normal1(space_dim_);
@@ -1746,10 +3359,8 @@ JaliGeometry::Point Mesh::face_normal(const Entity_ID faceid,
       return -normal1;
     }
   } else {
-    Entity_ID_List faceids;
-    std::vector<dir_t> face_dirs;
-
-    cell_get_faces_and_dirs(cellid, &faceids, &face_dirs);
+    Entity_ID_View faceids = cell_faces(cellid);
+    Dir_View face_dirs = cell_face_dirs(cellid);
 
     int nf = faceids.size();
     bool found = false;
@@ -1784,7 +3395,9 @@ JaliGeometry::Point Mesh::edge_vector(const Entity_ID edgeid,
                                       const Entity_ID pointid,
                                       int *orientation) const {
   assert(edges_requested);
-  assert(edge_geometry_precomputed);
+  if (!recompute)
+    build_once(edge_geometry_precomputed,
+               &Mesh::compute_edge_geometric_quantities);
 
   JaliGeometry::Point evector(space_dim_), ecenter(space_dim_);
   JaliGeometry::Point& evector_ref = evector;  // to avoid extra copying
@@ -1822,7 +3435,6 @@ JaliGeometry::Point Mesh::edge_centroid(const Entity_ID edgeid) const {
   JaliGeometry::Point xyz0, xyz1;
 
   assert(edges_requested);
-  assert(edge_geometry_precomputed);
 
   edge_get_nodes(edgeid, &p0, &p1);
   node_get_coordinates(p0, &xyz0);
@@ -1831,6 +3443,45 @@ JaliGeometry::Point Mesh::edge_centroid(const Entity_ID edgeid) const {
 }
 
 
+// Face coordinates - conventions same as face_get_nodes. The
+// coordinates are gathered using the cached face to node connectivity
+
+void Mesh::face_get_coordinates(const Entity_ID faceid,
+                                std::vector<JaliGeometry::Point> *fcoords)
+    const {
+#if JALI_CACHE_VARS != 0
+  Entity_ID_View fnodes = face_nodes(faceid);
+#else
+  Entity_ID_List fnodes;
+  face_get_nodes_internal(faceid, &fnodes);
+#endif
+
+  fcoords->resize(fnodes.size());
+  for (std::size_t i = 0; i < fnodes.size(); i++)
+    node_get_coordinates(fnodes[i], &((*fcoords)[i]));
+}  // face_get_coordinates
+
+
+// Coordinates of cells in standard order (Exodus II convention) as
+// given by cell_get_nodes. The coordinates are gathered using the
+// cached cell to node connectivity
+
+void Mesh::cell_get_coordinates(const Entity_ID cellid,
+                                std::vector<JaliGeometry::Point> *ccoords)
+    const {
+#if JALI_CACHE_VARS != 0
+  Entity_ID_View cnodes = cell_nodes(cellid);
+#else
+  Entity_ID_List cnodes;
+  cell_get_nodes_internal(cellid, &cnodes);
+#endif
+
+  ccoords->resize(cnodes.size());
+  for (std::size_t i = 0; i < cnodes.size(); i++)
+    node_get_coordinates(cnodes[i], &((*ccoords)[i]));
+}  // cell_get_coordinates
+
+
 // Coordinates of a side
 //
 // If posvol_order = true, then the coordinates will be returned in an
@@ -1893,8 +3544,7 @@ void Mesh::side_get_coordinates(const Entity_ID sideid,
 
   if (posvol_order && manifold_dim_ == 1) {
     Entity_ID c = side_get_cell(sideid);
-    Entity_ID_List cnodes;
-    cell_get_nodes(c, &cnodes);
+    Entity_ID_View cnodes = cell_nodes(c);
     if (side_get_node(sideid, 0) == cnodes[1])
       std::swap((*scoords)[0], (*scoords)[1]);
   }
@@ -1964,7 +3614,9 @@ void Mesh::wedge_get_coordinates(const Entity_ID wedgeid,
 JaliGeometry::Point Mesh::side_facet_normal(const int sideid,
                                             const bool recompute) const {
   assert(sides_requested);
-  assert(side_geometry_precomputed);
+  if (!recompute)
+    build_once(side_geometry_precomputed,
+               &Mesh::compute_side_geometric_quantities);
 
   JaliGeometry::Point normal(space_dim_);
 
@@ -1996,7 +3648,9 @@ JaliGeometry::Point Mesh::wedge_facet_normal(const int wedgeid,
                                              const unsigned int which_facet,
                                              const bool recompute) const {
   assert(wedges_requested);
-  assert(side_geometry_precomputed);
+  if (!recompute)
+    build_once(side_geometry_precomputed,
+               &Mesh::compute_side_geometric_quantities);
   assert(which_facet == 0 || which_facet == 1);
 
   Entity_ID sideid = static_cast<Entity_ID>(wedgeid/2);
@@ -2031,10 +3685,9 @@ Mesh::corner_get_facetization(const Entity_ID cornerid,
                               std::vector<std::array<Entity_ID, 3>>
                               *facetpoints) const {
   assert(corners_requested);
-  assert(corner_geometry_precomputed);
+  build_once(corner_info_cached, &Mesh::cache_corner_info);
 
-  Entity_ID_List cwedges;
-  corner_get_wedges(cornerid, &cwedges);
+  Entity_ID_View cwedges = corner_wedges(cornerid);
 
   assert(manifold_dim_ == 3);
   pointcoords->clear();
@@ -2045,27 +3698,27 @@ Mesh::corner_get_facetization(const Entity_ID cornerid,
 
   JaliGeometry::Point p(space_dim_);
 
-  std::vector< std::pair<Entity_ID, Entity_kind> > point_entity_list;
+  Scratch_vector< std::pair<Entity_ID, Entity_kind> > point_entity_list;
 
   int n = corner_get_node(cornerid);
   node_get_coordinates(n, &p);
   pointcoords->push_back(p);        // emplace_back when we switch to C++11
-  point_entity_list.push_back(std::pair<Entity_ID, Entity_kind>(n, Entity_kind::NODE));
+  point_entity_list->push_back(std::pair<Entity_ID, Entity_kind>(n, Entity_kind::NODE));
 
   int c = corner_get_cell(cornerid);
   JaliGeometry::Point ccen = cell_centroid(c);
   pointcoords->push_back(ccen);
-  point_entity_list.push_back(std::pair<Entity_ID, Entity_kind>(c, Entity_kind::CELL));
+  point_entity_list->push_back(std::pair<Entity_ID, Entity_kind>(c, Entity_kind::CELL));
   JaliGeometry::Point vec0 = ccen-p;
 
-  Entity_ID_List::iterator itw = cwedges.begin();
+  Entity_ID_View::const_iterator itw = cwedges.begin();
   while (itw != cwedges.end()) {
     Entity_ID w = *itw;
 
     Entity_ID f = wedge_get_face(w);
     int idxe = 0;
     bool found = false;
-    while (!found && idxe < point_entity_list.size()) {
+    while (!found && idxe < static_cast<int>(point_entity_list->size())) {
       if (point_entity_list[idxe] ==
           std::pair<Entity_ID, Entity_kind>(f, Entity_kind::FACE))
         found = true;
@@ -2073,14 +3726,14 @@ Mesh::corner_get_facetization(const Entity_ID cornerid,
         idxe++;
     }
     if (!found) {
-      point_entity_list.push_back(std::pair<Entity_ID, Entity_kind>(f, Entity_kind::FACE));
+      point_entity_list->push_back(std::pair<Entity_ID, Entity_kind>(f, Entity_kind::FACE));
       pointcoords->push_back(face_centroid(f));
     }
 
     Entity_ID e = wedge_get_edge(w);
     int idxf = 0;
     found = false;
-    while (!found && idxf < point_entity_list.size()) {
+    while (!found && idxf < static_cast<int>(point_entity_list->size())) {
       if (point_entity_list[idxf] ==
           std::pair<Entity_ID, Entity_kind>(e, Entity_kind::EDGE))
         found = true;
@@ -2088,7 +3741,7 @@ Mesh::corner_get_facetization(const Entity_ID cornerid,
         idxf++;
     }
     if (!found) {
-      point_entity_list.push_back(std::pair<Entity_ID, Entity_kind>(e, Entity_kind::EDGE));
+      point_entity_list->push_back(std::pair<Entity_ID, Entity_kind>(e, Entity_kind::EDGE));
       pointcoords->push_back(edge_centroid(e));
     }
 
@@ -2132,10 +3785,9 @@ Mesh::corner_get_facetization(const Entity_ID cornerid,
                               std::vector< std::array<Entity_ID, 2> >
                               *facetpoints) const {
   assert(corners_requested);
-  assert(corner_info_cached);
+  build_once(corner_info_cached, &Mesh::cache_corner_info);
 
-  Entity_ID_List cwedges;
-  corner_get_wedges(cornerid, &cwedges);
+  Entity_ID_View cwedges = corner_wedges(cornerid);
 
   assert(manifold_dim_ == 2);
   pointcoords->clear();
@@ -2187,11 +3839,10 @@ Mesh::corner_get_facetization(const Entity_ID cornerid,
                               std::vector< std::array<Entity_ID, 1> >
                               *facetpoints) const {
   assert(corners_requested);
-  assert(corner_info_cached);
+  build_once(corner_info_cached, &Mesh::cache_corner_info);
 
   // corner and wedge are the same in 1d
-  Entity_ID_List cwedges;
-  corner_get_wedges(cornerid, &cwedges);
+  Entity_ID_View cwedges = corner_wedges(cornerid);
   wedge_get_coordinates(cwedges[0], pointcoords);
   // ordering is because wedge_get_coordinates comes back in (node, cell) order
   // and node is the facet external to the zone and cell is the facet between
@@ -2208,10 +3859,9 @@ Mesh::corner_get_coordinates(const Entity_ID cornerid,
                              std::vector<JaliGeometry::Point>
                              *pointcoords) const {
   assert(corners_requested);
-  assert(corner_info_cached);
+  build_once(corner_info_cached, &Mesh::cache_corner_info);
 
-  Entity_ID_List cwedges;
-  corner_get_wedges(cornerid, &cwedges);
+  Entity_ID_View cwedges = corner_wedges(cornerid);
 
   pointcoords->clear();
 
@@ -2230,8 +3880,8 @@ Mesh::corner_get_coordinates(const Entity_ID cornerid,
 
     wedge_get_coordinates(cwedges[0], pointcoords);
 
-    std::vector<JaliGeometry::Point> wpoints;
-    wedge_get_coordinates(cwedges[1], &wpoints);
+    Scratch_vector<JaliGeometry::Point> wpoints;
+    wedge_get_coordinates(cwedges[1], wpoints.get());
 
     pointcoords->push_back(wpoints[1]);
 
@@ -2253,24 +3903,24 @@ Mesh::corner_get_coordinates(const Entity_ID cornerid,
 
     JaliGeometry::Point p(space_dim_);
 
-    std::vector< std::pair<Entity_ID, Entity_kind> > point_entity_list;
+    Scratch_vector< std::pair<Entity_ID, Entity_kind> > point_entity_list;
 
     int n = corner_get_node(cornerid);
     node_get_coordinates(n, &p);
     pointcoords->push_back(p);        // emplace_back when we switch to C++11
-    point_entity_list.push_back(std::pair<Entity_ID, Entity_kind>(n, Entity_kind::NODE));
+    point_entity_list->push_back(std::pair<Entity_ID, Entity_kind>(n, Entity_kind::NODE));
 
     int c = corner_get_cell(cornerid);
     JaliGeometry::Point ccen = cell_centroid(c);
 
-    Entity_ID_List::iterator itw = cwedges.begin();
+    Entity_ID_View::const_iterator itw = cwedges.begin();
     while (itw != cwedges.end()) {
       Entity_ID w = *itw;
 
       Entity_ID f = wedge_get_face(w);
       int idxe = 0;
       bool found = false;
-      while (!found && idxe < point_entity_list.size()) {
+      while (!found && idxe < static_cast<int>(point_entity_list->size())) {
         if (point_entity_list[idxe] ==
             std::pair<Entity_ID, Entity_kind>(f, Entity_kind::FACE))
           found = true;
@@ -2278,14 +3928,14 @@ Mesh::corner_get_coordinates(const Entity_ID cornerid,
           idxe++;
       }
       if (!found) {
-        point_entity_list.push_back(std::pair<Entity_ID, Entity_kind>(f, Entity_kind::FACE));
+        point_entity_list->push_back(std::pair<Entity_ID, Entity_kind>(f, Entity_kind::FACE));
         pointcoords->push_back(face_centroid(f));
       }
 
       Entity_ID e = wedge_get_edge(w);
       int idxf = 0;
       found = false;
-      while (!found && idxf < point_entity_list.size()) {
+      while (!found && idxf < static_cast<int>(point_entity_list->size())) {
         if (point_entity_list[idxf] ==
             std::pair<Entity_ID, Entity_kind>(e, Entity_kind::EDGE))
           found = true;
@@ -2293,7 +3943,7 @@ Mesh::corner_get_coordinates(const Entity_ID cornerid,
           idxf++;
       }
       if (!found) {
-        point_entity_list.push_back(std::pair<Entity_ID, Entity_kind>(e, Entity_kind::EDGE));
+        point_entity_list->push_back(std::pair<Entity_ID, Entity_kind>(e, Entity_kind::EDGE));
         pointcoords->push_back(edge_centroid(e));
       }
 
@@ -2324,7 +3974,7 @@ Entity_type Mesh::entity_get_type(const Entity_kind kind,
       break;
     case Entity_kind::SIDE:
       if (sides_requested) {
-        Entity_ID cellid = side_cell_id[entid];
+        Entity_ID cellid = side_get_cell(entid);
         return cell_type[cellid];
       } else
         return Entity_type::TYPE_UNKNOWN;
@@ -2332,16 +3982,16 @@ Entity_type Mesh::entity_get_type(const Entity_kind kind,
     case Entity_kind::WEDGE:
       if (wedges_requested) {
         Entity_ID sideid = static_cast<int>(entid/2);
-        Entity_ID cellid = side_cell_id[sideid];
+        Entity_ID cellid = side_get_cell(sideid);
         return cell_type[cellid];
       } else
         return Entity_type::TYPE_UNKNOWN;
       break;
     case Entity_kind::CORNER:
       if (corners_requested) {
-        Entity_ID wedgeid = corner_wedge_ids[entid][0];
+        Entity_ID wedgeid = corner_wedges(entid)[0];
         Entity_ID sideid = static_cast<int>(wedgeid/2);
-        Entity_ID cellid = side_cell_id[sideid];
+        Entity_ID cellid = side_get_cell(sideid);
         return cell_type[cellid];
       } else
         return Entity_type::TYPE_UNKNOWN;
@@ -2817,7 +4467,6 @@ std::shared_ptr<MeshSet> Mesh::build_set_from_region(const std::string setname,
                                        Entity_type::ALL);
 
         for (int iface = 0; iface < nface; iface++) {
-          JaliGeometry::Point fcen = face_centroid(iface);
           if (region->inside(face_centroid(iface))) {
             Entity_type ftype = entity_get_type(Entity_kind::FACE, iface);
             if (ftype == Entity_type::PARALLEL_OWNED)
@@ -3025,7 +4674,7 @@ std::shared_ptr<MeshSet> Mesh::build_set_from_region(const std::string setname,
 
 bool Mesh::point_in_cell(const JaliGeometry::Point &p,
                          const Entity_ID cellid) const {
-  std::vector<JaliGeometry::Point> ccoords;
+  Scratch_vector<JaliGeometry::Point> ccoords;
 
   if (manifold_dim_ == 3) {
 
@@ -3034,42 +4683,45 @@ bool Mesh::point_in_cell(const JaliGeometry::Point &p,
     // and send it into the polyhedron volume and centroid
     // calculation routine
 
-    int nf;
-    Entity_ID_List cfaces;
-    std::vector<unsigned int> nfnodes;
-    std::vector<dir_t> fdirs;
-    std::vector<JaliGeometry::Point> cfcoords;
+    Entity_ID_View cfaces = cell_faces(cellid);
+    Dir_View fdirs = cell_face_dirs(cellid);
+    Scratch_vector<int> nfnodes;
+    Scratch_vector<JaliGeometry::Point> cfcoords;
 
-    cell_get_faces_and_dirs(cellid, &cfaces, &fdirs);
-
-    nf = cfaces.size();
-    nfnodes.resize(nf);
+    int nf = cfaces.size();
+    nfnodes->resize(nf);
 
     for (int j = 0; j < nf; j++) {
-      std::vector<JaliGeometry::Point> fcoords;
-
-      face_get_coordinates(cfaces[j], &fcoords);
-      nfnodes[j] = fcoords.size();
+      Entity_ID_View fnodes = face_nodes(cfaces[j]);
+      nfnodes[j] = fnodes.size();
 
+      JaliGeometry::Point xyz;
       if (fdirs[j] == 1) {
-        for (int k = 0; k < nfnodes[j]; k++)
-          cfcoords.push_back(fcoords[k]);
+        for (int k = 0; k < nfnodes[j]; k++) {
+          node_get_coordinates(fnodes[k], &xyz);
+          cfcoords->push_back(xyz);
+        }
       } else {
-        for (int k = nfnodes[j]-1; k >=0; k--)
-          cfcoords.push_back(fcoords[k]);
+        for (int k = nfnodes[j]-1; k >=0; k--) {
+          node_get_coordinates(fnodes[k], &xyz);
+          cfcoords->push_back(xyz);
+        }
       }
     }
 
-    cell_get_coordinates(cellid, &ccoords);
-    return JaliGeometry::point_in_polyhed(p, ccoords, nf, nfnodes, cfcoords);
+    cell_get_coordinates(cellid, ccoords.get());
+    return JaliGeometry::point_in_polyhed(p, ccoords->size(), ccoords->data(),
+                                          nf, nfnodes->data(),
+                                          cfcoords->data());
 
   } else if (manifold_dim_ == 2) {
 
-    cell_get_coordinates(cellid, &ccoords);
-    return JaliGeometry::point_in_polygon(p, ccoords);
+    cell_get_coordinates(cellid, ccoords.get());
+    return JaliGeometry::point_in_polygon(p, ccoords->size(),
+                                          ccoords->data());
 
   } else if (manifold_dim_ == 1) {
-    cell_get_coordinates(cellid, &ccoords);
+    cell_get_coordinates(cellid, ccoords.get());
     if (p[0]-ccoords[0][0] >= 0.0 &&
         ccoords[1][0] - p[0] >= 0.0) return true;
   }
@@ -58,6 +58,8 @@
 #include <string>
 #include <algorithm>
 #include <cassert>
+#include <atomic>
+#include <mutex>
 #include <typeinfo>
 
 #include "MeshDefs.hh"
@@ -68,8 +70,14 @@
 #include "Geometry.hh"
 #include "MeshTile.hh"
 #include "MeshSet.hh"
+#include "MeshView.hh"
 
 #include "block_partition.hh"
+#include "batch_geometry.hh"
+#include "memory_report.hh"
+#include "phase_profile.hh"
+#include "thread_pool.hh"
+#include "tile_layout.hh"
 
 #define JALI_CACHE_VARS 1  // Switch to 0 to turn caching off
 
@@ -136,6 +144,47 @@ namespace Jali {
   //! that modify the mutable data are declared with a constant
   //! qualifier.
   //!
+  //! **** NOTE ABOUT WHEN CACHED DATA IS BUILT ****
+  //! Relations between entities (including sides, wedges and
+  //! corners) and all geometric quantities (volumes, areas,
+  //! centroids, normals) are built when they are first needed rather
+  //! than when the mesh is constructed, once and thread-safely. The
+  //! first query of, e.g., cell_volume therefore pays for computing
+  //! the volumes of all the cells. Codes that time their kernels or
+  //! want this cost outside of threaded regions can call
+  //! update_geometric_quantities() after constructing the mesh to
+  //! compute all the geometry of the requested entities up front.
+  //!
+  //! **** NOTE FOR MESH FRAMEWORK IMPLEMENTERS ****
+  //! The following adjacency queries are no longer virtual. They are
+  //! answered from connectivity cached in this class, and a framework
+  //! provides the data through the protected *_internal functions
+  //! (e.g. cell_get_nodes_internal), as it already did for
+  //! cell_get_faces_and_dirs and face_get_cells:
+  //!  - cell_get_nodes, face_get_nodes
+  //!  - node_get_cells, node_get_faces
+  //!  - cell_get_face_adj_cells, cell_get_node_adj_cells
+  //!
+  //! A class derived from Mesh that overrides one of the functions
+  //! above must rename the override to the *_internal version. An
+  //! override that is not renamed only hides the base class function,
+  //! so calls through a Mesh pointer or reference still use the cache
+  //!
+  //! The node coordinates are likewise kept in arrays owned by this
+  //! class (see node_coordinates) and the functions reading or
+  //! writing them are no longer virtual:
+  //!  - node_get_coordinates (all overloads) reads the arrays. A
+  //!    framework provides the coordinates through
+  //!    node_get_coordinates_internal (Point version only)
+  //!  - node_set_coordinates (both overloads) writes the arrays. The
+  //!    framework's copy is updated later through
+  //!    node_set_coordinates_internal (double * version only)
+  //!  - face_get_coordinates and cell_get_coordinates are computed
+  //!    here from the cached nodes and have no framework hook
+  //!
+  //! Overrides of these functions in classes derived from Mesh must
+  //! be renamed or, for the face and cell coordinates, removed
+  //!
 
 
 class Mesh {
@@ -162,7 +211,10 @@ class Mesh {
        const Partitioner_type partitioner = Partitioner_type::METIS,
        const JaliGeometry::Geom_type geom_type =
        JaliGeometry::Geom_type::CARTESIAN,
-       const MPI_Comm incomm = MPI_COMM_WORLD) :
+       const MPI_Comm incomm = MPI_COMM_WORLD,
+       const Renumbering_type renumbering = Renumbering_type::NONE,
+       const bool implicit_subcells = false,
+       const bool profile_construction = false) :
     space_dim_(3), manifold_dim_(3), mesh_type_(Mesh_type::GENERAL),
     cell_geometry_precomputed(false), face_geometry_precomputed(false),
     edge_geometry_precomputed(false), side_geometry_precomputed(false),
@@ -174,11 +226,20 @@ class Mesh {
     num_ghost_layers_tile_(num_ghost_layers_tile),
     num_ghost_layers_distmesh_(num_ghost_layers_distmesh),
     boundary_ghosts_requested_(request_boundary_ghosts),
-    partitioner_pref_(partitioner),
+    partitioner_pref_(partitioner), renumbering_pref_(renumbering),
+    implicit_subcells_(implicit_subcells),
+    profile_construction_(profile_construction),
+    cell2node_info_cached(false), face2node_info_cached(false),
     cell2face_info_cached(false), face2cell_info_cached(false),
     cell2edge_info_cached(false), face2edge_info_cached(false),
-    side_info_cached(false), wedge_info_cached(false),
+    edge2node_info_cached(false), side_info_cached(false),
+    side_lists_cached(false), wedge_info_cached(false),
     corner_info_cached(false), type_info_cached(false),
+    node_coords_cached(false), celltype_info_cached(false),
+    tile_colors_cached(false), tile_layouts_cached_(0),
+    node2cell_info_cached(false), node2face_info_cached(false),
+    cell_fadj_info_cached(false), cell_nadj_info_cached(false),
+    cell_batches_cached(false), face_batches_cached(false),
     geometric_model_(NULL), comm(incomm),
     geomtype(geom_type) {
     
@@ -275,6 +336,86 @@ class Mesh {
       const;
 
 
+  //! Renumbering of the entities requested at construction
+
+  inline
+  Renumbering_type renumbering() const {
+    return renumbering_pref_;
+  }
+
+  //! Are sides and wedges numbered implicitly? In this mode (2D and
+  //! 3D meshes) the sides of a cell are the consecutive IDs given by
+  //! the prefix sum of the number of edges of the faces of the cells,
+  //! and the cell, face, edge, nodes and opposite side of a side (and
+  //! so of its wedges) are looked up in constant time in small per
+  //! cell face tables instead of being stored per side. Only when the
+  //! faces do not all have the same number of edges is one entry
+  //! (the cell face of the side) stored per side.
+  //!
+  //! The list of all sides is still stored since sides() and
+  //! cell_sides() return it by reference; the lists of owned, ghost
+  //! and boundary ghost sides and the wedge lists are only built if
+  //! asked for. The corner tables are stored as usual.
+  //!
+  //! Implicit numbering needs the cells to be in ID order in cells()
+  //! and is not done in 1D. If it was requested but cannot be done, a
+  //! warning is printed when the sides are first built, they are
+  //! stored explicitly and this returns false
+
+  inline
+  bool implicit_subcells() const {
+    if (!implicit_subcells_ || !sides_requested) return false;
+    build_once(side_info_cached, &Mesh::cache_side_info);
+    return implicit_sides_;
+  }
+
+  //! Map from the IDs that the nodes, edges, faces or cells would
+  //! have had without renumbering (old IDs) to their IDs in this mesh
+  //! (new IDs). Empty if the entities were not renumbered. Sides,
+  //! wedges and corners are numbered cell by cell and so always
+  //! follow the cell order
+
+  std::vector<Entity_ID> const&
+  entity_old_to_new_ids(const Entity_kind kind) const;
+
+  //! Map from the IDs of nodes, edges, faces or cells in this mesh
+  //! (new IDs) to the IDs they would have had without renumbering
+  //! (old IDs). Empty if the entities were not renumbered
+
+  std::vector<Entity_ID> const&
+  entity_new_to_old_ids(const Entity_kind kind) const;
+
+
+  //! Memory held by the mesh by category - entity lists and types,
+  //! cached adjacencies, subcell (side, wedge, corner) info, geometric
+  //! quantities, renumbering maps, the mesh framework (categories
+  //! "framework/...") and the tiles ("tiles/...") and sets
+  //! ("sets/...") of the mesh. Only what has been built so far is
+  //! counted
+
+  Memory_report memory_report() const;
+
+
+  //! Wall clock time of the phases of the construction of the mesh
+  //! on this rank (empty unless profiling of the construction was
+  //! requested, see MeshFactory::profile_construction). Use
+  //! summary() or write_json() of the profile for the times over all
+  //! ranks
+
+  Phase_profile const& construction_profile() const {
+    return construction_profile_;
+  }
+
+
+  //! Flat view of the cached adjacencies, node coordinates, cell
+  //! types and cell and face geometry for compute kernels that should
+  //! not go through virtual calls (see MeshView). Builds whatever of
+  //! these is not cached yet, so it must not be called while other
+  //! threads query the mesh for the first time
+
+  MeshView view() const;
+
+
   //! Get cell type - UNKNOWN, TRI, QUAD, POLYGON, TET, PRISM, PYRAMID, HEX,
   //! POLYHED
   //! See MeshDefs.hh
@@ -347,6 +488,59 @@ class Mesh {
 
   int num_tiles() const {return meshtiles.size();}
 
+  //! Call f(tile) (with tile a MeshTile&) for every tile of the mesh,
+  //! concurrently on the workers of the Thread_pool. Tiles are dealt
+  //! out to the workers in contiguous blocks and idle workers steal
+  //! tiles from busy ones. f must not throw and must only write to
+  //! data that no other tile writes to (e.g. the entities the tile
+  //! owns)
+
+  template<typename F>
+  void parallel_for_tiles(F const& f) const;
+
+  //! Evaluate f(tile) for every tile concurrently (as in
+  //! parallel_for_tiles) and combine the values with reduce,
+  //! i.e. return reduce(...reduce(reduce(init, f(tile0)), f(tile1))...,
+  //! f(tileN)). The values are combined in tile order, so the result
+  //! does not depend on the number of threads. T must be default
+  //! constructible
+
+  template<typename T, typename F, typename R>
+  T parallel_reduce_tiles(T const& init, F const& f, R const& reduce) const;
+
+  //! Number of colors of the tiles. Tiles are colored so that two
+  //! tiles of the same color never share a node (and hence an edge
+  //! or a face) of their owned cells
+
+  int num_tile_colors() const;
+
+  //! Color of a tile
+
+  int tile_color(int const tileid) const;
+
+  //! IDs of the tiles of a color (in increasing order)
+
+  Entity_ID_View tiles_of_color(int const color) const;
+
+  //! Call f(tile) for every tile, one color after the other. Tiles of
+  //! the same color run concurrently (as in parallel_for_tiles), so f
+  //! may accumulate into the nodes, edges, faces, sides, wedges and
+  //! corners of the owned cells of its tile without atomics or
+  //! locks. The accumulation order does not depend on the number of
+  //! threads
+
+  template<typename F>
+  void parallel_for_tiles_by_color(F const& f) const;
+
+  //! Placement of the data of entities of a kind in storage made of
+  //! one block per tile (see tile_layout.hh). Made on first use for
+  //! each kind. A layout is never modified; adding a tile makes a new
+  //! one on next use while holders of the old one (e.g. state
+  //! vectors) keep using it
+
+  std::shared_ptr<Tile_layout const> tile_layout(Entity_kind const kind)
+      const;
+
   //! Nodes of mesh (of a particular parallel type OWNED, GHOST or ALL)
 
   template<Entity_type type = Entity_type::ALL>
@@ -477,9 +671,8 @@ class Mesh {
 
   //! Get nodes of a cell (in no particular order)
 
-  virtual
   void cell_get_nodes(const Entity_ID cellid,
-                      Entity_ID_List *nodeids) const = 0;
+                      Entity_ID_List *nodeids) const;
 
 
   //! Get edges of a face and directions in which the face uses the edges
@@ -519,9 +712,8 @@ class Mesh {
   //! with the face normal
   //! In 2D, nfnodes is 2
 
-  virtual
   void face_get_nodes(const Entity_ID faceid,
-                      Entity_ID_List *nodeids) const = 0;
+                      Entity_ID_List *nodeids) const;
 
 
   //! Get nodes of edge
@@ -615,20 +807,18 @@ class Mesh {
   //! is not guaranteed to be the same for corresponding nodes on
   //! different processors
 
-  virtual
   void node_get_cells(const Entity_ID nodeid,
                       const Entity_type type,
-                      Entity_ID_List *cellids) const = 0;
+                      Entity_ID_List *cellids) const;
 
 
   //! Faces of type 'type' connected to a node - The order of faces
   //! is not guaranteed to be the same for corresponding nodes on
   //! different processors
 
-  virtual
   void node_get_faces(const Entity_ID nodeid,
                       const Entity_type type,
-                      Entity_ID_List *faceids) const = 0;
+                      Entity_ID_List *faceids) const;
 
   //! Wedges connected to a node - The wedges are returned in no
   //! particular order. Also, the order of nodes is not guaranteed to
@@ -686,6 +876,94 @@ class Mesh {
   Entity_ID corner_get_cell(const Entity_ID cornerid) const;
 
 
+  // Views of cached adjacencies
+  //----------------------------
+  //
+  // These return read-only views directly into the adjacency
+  // information cached in the mesh instead of copying it into a
+  // caller supplied list. They do not allocate and are the preferred
+  // way of querying topology in inner loops. The entities are the
+  // same and in the same order as those returned by the corresponding
+  // *_get_* functions with type ALL (and ordered = false). A view
+  // remains valid only as long as the mesh is alive and its cached
+  // topology is not rebuilt
+  //
+  // The upward (node to cell/face) and same level (cell to cell)
+  // adjacencies are not needed by most applications and are gathered
+  // from the framework only the first time one of them is queried
+
+  //! Nodes of a cell (see cell_get_nodes)
+
+  Entity_ID_View cell_nodes(const Entity_ID cellid) const;
+
+  //! Nodes of a face in the order consistent with the face normal
+  //! (see face_get_nodes)
+
+  Entity_ID_View face_nodes(const Entity_ID faceid) const;
+
+  //! Faces of a cell
+
+  Entity_ID_View cell_faces(const Entity_ID cellid) const;
+
+  //! Directions in which a cell uses its faces (see cell_get_faces_and_dirs)
+
+  Dir_View cell_face_dirs(const Entity_ID cellid) const;
+
+  //! Cells connected to a face (OWNED or GHOST)
+
+  Entity_ID_View face_cells(const Entity_ID faceid) const;
+
+  //! Edges of a face
+
+  Entity_ID_View face_edges(const Entity_ID faceid) const;
+
+  //! Directions in which a face uses its edges
+
+  Dir_View face_edge_dirs(const Entity_ID faceid) const;
+
+  //! Edges of a cell
+
+  Entity_ID_View cell_edges(const Entity_ID cellid) const;
+
+  //! Directions of edges of a 2D cell (see cell_2D_get_edges_and_dirs)
+
+  Dir_View cell_2D_edge_dirs(const Entity_ID cellid) const;
+
+  //! Sides of a cell
+
+  Entity_ID_View cell_sides(const Entity_ID cellid) const;
+
+  //! Corners of a cell
+
+  Entity_ID_View cell_corners(const Entity_ID cellid) const;
+
+  //! Corners connected to a node (OWNED or GHOST)
+
+  Entity_ID_View node_corners(const Entity_ID nodeid) const;
+
+  //! Wedges of a corner
+
+  Entity_ID_View corner_wedges(const Entity_ID cornerid) const;
+
+  //! Cells connected to a node (OWNED or GHOST) in ascending order
+
+  Entity_ID_View node_cells(const Entity_ID nodeid) const;
+
+  //! Faces connected to a node (OWNED or GHOST) in ascending order
+
+  Entity_ID_View node_faces(const Entity_ID nodeid) const;
+
+  //! Face connected neighboring cells of a cell (OWNED or GHOST) in
+  //! the order of the faces of the cell
+
+  Entity_ID_View cell_face_adj_cells(const Entity_ID cellid) const;
+
+  //! Node connected neighboring cells of a cell (OWNED or GHOST) in
+  //! ascending order
+
+  Entity_ID_View cell_node_adj_cells(const Entity_ID cellid) const;
+
+
   // Same level adjacencies
   //-----------------------
 
@@ -697,19 +975,17 @@ class Mesh {
   //! the cellids will correcpond to cells across the respective
   //! faces given by cell_get_faces
 
-  virtual
   void cell_get_face_adj_cells(const Entity_ID cellid,
                                const Entity_type type,
-                               Entity_ID_List *fadj_cellids) const = 0;
+                               Entity_ID_List *fadj_cellids) const;
 
   //! Node connected neighboring cells of given cell
   //! (a hex in a structured mesh has 26 node connected neighbors)
   //! The cells are returned in no particular order
 
-  virtual
   void cell_get_node_adj_cells(const Entity_ID cellid,
                                const Entity_type type,
-                               Entity_ID_List *cellids) const = 0;
+                               Entity_ID_List *cellids) const;
 
 
   //! Opposite side in neighboring cell of a side. The two sides share
@@ -744,26 +1020,27 @@ class Mesh {
   //! Node coordinates
 
   // Preferred operator
-  virtual
   void node_get_coordinates(const Entity_ID nodeid,
-                            JaliGeometry::Point *ncoord) const = 0;
+                            JaliGeometry::Point *ncoord) const;
 
-  virtual
   void node_get_coordinates(const Entity_ID nodeid,
                             std::array<double, 3> *ncoord) const;
-  virtual
   void node_get_coordinates(const Entity_ID nodeid,
                             std::array<double, 2> *ncoord) const;
-  virtual
   void node_get_coordinates(const Entity_ID nodeid, double *ncoord) const;
 
+  //! Coordinate dir (0 <= dir < space_dimension()) of all the nodes
+  //! as one contiguous, cache line aligned array indexed by node
+  //! ID. The coordinates are owned by the mesh and the pointer stays
+  //! valid for its lifetime; node_set_coordinates changes the values
+
+  double const * node_coordinates(const int dir) const;
+
   //! Face coordinates - conventions same as face_to_nodes call
   //! Number of nodes is the vector size divided by number of spatial dimensions
 
-  virtual
   void face_get_coordinates(const Entity_ID faceid,
-                            std::vector<JaliGeometry::Point> *fcoords)
-      const = 0;
+                            std::vector<JaliGeometry::Point> *fcoords) const;
 
   //! Coordinates of cells in standard order (Exodus II convention)
   //!
@@ -772,10 +1049,8 @@ class Mesh {
   //! arbitrary order
   //! Number of nodes is vector size divided by number of spatial dimensions
 
-  virtual
   void cell_get_coordinates(const Entity_ID cellid,
-                            std::vector<JaliGeometry::Point> *ccoords)
-      const = 0;
+                            std::vector<JaliGeometry::Point> *ccoords) const;
 
   //! Coordinates of side
   //!
@@ -853,6 +1128,9 @@ class Mesh {
   // Mesh entity geometry
   //--------------
   //
+  // The quantities of each kind are computed for all entities of the
+  // kind on the first query (see update_geometric_quantities to
+  // compute them up front)
 
 
   //! Volume/Area of cell
@@ -990,23 +1268,37 @@ class Mesh {
   // Mesh modification
   //-------------------
 
-  //! Set coordinates of node
+  //! Set coordinates of node. The node is remembered as moved until
+  //! the next call to update_geometric_quantities. The framework's
+  //! copy of the coordinates is only updated when it needs them
+  //! (e.g. to write the mesh to a file). Different nodes may be set
+  //! concurrently (e.g. from parallel_for_tiles)
 
-  virtual
   void node_set_coordinates(const Entity_ID nodeid,
-                             const JaliGeometry::Point ncoord) = 0;
+                            const JaliGeometry::Point ncoord);
 
-
-  virtual
   void node_set_coordinates(const Entity_ID nodeid,
-                             const double *ncoord) = 0;
+                            const double *ncoord);
 
 
   //! Update geometric quantities (volumes, normals, centroids, etc.)
   //! and cache them - called for initial caching or for update after
-  //! mesh modification
-
-  void update_geometric_quantities();
+  //! mesh modification. By default the node coordinates are reread
+  //! from the mesh framework (after giving it the moves made with
+  //! node_set_coordinates) and every quantity of the requested
+  //! entities is recomputed.
+  //!
+  //! With moved_nodes_only = true, the update only accounts for the
+  //! nodes moved with node_set_coordinates since the last update, and
+  //! only quantities that have been queried before are recomputed;
+  //! the rest are computed on first use. If only a small fraction of
+  //! the nodes moved, only the quantities of the edges, faces, cells,
+  //! sides and corners connected to them are recomputed. Coordinates
+  //! changed in any other way (e.g. directly in the mesh framework)
+  //! are not seen. Must not be called while other threads query or
+  //! move the mesh
+
+  void update_geometric_quantities(bool const moved_nodes_only = false);
 
   //
   // Mesh Sets for ICs, BCs, Material Properties and whatever else
@@ -1092,7 +1384,9 @@ class Mesh {
   void write_to_gmv_file(const std::string gmvfilename,
                          const bool with_fields = true) const {}
 
-  //! \brief Precompute and cache corners, wedges, edges, cells
+  //! \brief Cache entity type info needed by most queries
+  //! All other connectivity and geometric info is cached lazily on
+  //! first use
   // WHY IS THIS VIRTUAL?
 
   virtual
@@ -1139,6 +1433,44 @@ class Mesh {
   int compute_side_geometric_quantities() const;
   int compute_corner_geometric_quantities() const;
 
+  // Geometry of standard cells and of triangular/quadrilateral faces,
+  // edges and sides is computed by the batched kernels of
+  // batch_geometry.hh when the mesh is not embedded in a higher
+  // dimensional space
+
+  bool batched_geometry() const {
+    return (manifold_dim_ > 1 && manifold_dim_ == space_dim_);
+  }
+  void cache_cell_batches() const;
+  void cache_face_batches() const;
+
+  // Recompute the geometry of only the entities connected to the
+  // nodes moved since the last update, given the cells connected to
+  // these nodes
+
+  void update_geometry_of_moved_nodes(std::vector<Entity_ID> const&
+                                      cellids);
+
+  // Record the renumbering of the nodes, edges, faces or cells done
+  // by the mesh framework at construction, given the old ID of each
+  // new ID
+
+  void set_entity_renumbering(const Entity_kind kind,
+                              std::vector<Entity_ID> const& new_to_old);
+
+  // Add the memory held by the mesh framework to a report (categories
+  // should start with "framework/")
+
+  virtual
+  void framework_memory_report(Memory_report *) const {}
+
+  // Profile for timing the phases of the construction (nullptr if
+  // the construction is not profiled - see Phase_timer)
+
+  Phase_profile *construction_profiler() {
+    return profile_construction_ ? &construction_profile_ : nullptr;
+  }
+
 
   // get faces of a cell and directions in which it is used - this function
   // is implemented in each mesh framework. The results are cached in
@@ -1158,6 +1490,57 @@ class Mesh {
                                 const Entity_type type,
                                 Entity_ID_List *cellids) const = 0;
 
+  // nodes of a cell - this function is implemented in each mesh
+  // framework. The results are cached in the base class
+
+  virtual
+  void cell_get_nodes_internal(const Entity_ID cellid,
+                               Entity_ID_List *nodeids) const = 0;
+
+  // nodes of a face in the order consistent with the face normal -
+  // this function is implemented in each mesh framework. The results
+  // are cached in the base class
+
+  virtual
+  void face_get_nodes_internal(const Entity_ID faceid,
+                               Entity_ID_List *nodeids) const = 0;
+
+  // Cells connected to a node - this function is implemented in each
+  // mesh framework. The results are cached in the base class on demand
+
+  virtual
+  void node_get_cells_internal(const Entity_ID nodeid,
+                               const Entity_type type,
+                               Entity_ID_List *cellids) const = 0;
+
+  // Faces connected to a node - this function is implemented in each
+  // mesh framework. The results are cached in the base class on demand
+
+  virtual
+  void node_get_faces_internal(const Entity_ID nodeid,
+                               const Entity_type type,
+                               Entity_ID_List *faceids) const = 0;
+
+  // Face connected neighboring cells of a cell - this function is
+  // implemented in each mesh framework. The results are cached in the
+  // base class on demand
+
+  virtual
+  void cell_get_face_adj_cells_internal(const Entity_ID cellid,
+                                        const Entity_type type,
+                                        Entity_ID_List *fadj_cellids)
+      const = 0;
+
+  // Node connected neighboring cells of a cell - this function is
+  // implemented in each mesh framework. The results are cached in the
+  // base class on demand
+
+  virtual
+  void cell_get_node_adj_cells_internal(const Entity_ID cellid,
+                                        const Entity_type type,
+                                        Entity_ID_List *nadj_cellids)
+      const = 0;
+
 
   // edges of a face - this function is implemented in each mesh
   // framework. The results are cached in the base class
@@ -1192,6 +1575,38 @@ class Mesh {
   void edge_get_nodes_internal(const Entity_ID edgeid,
                                Entity_ID *enode0, Entity_ID *enode1) const = 0;
 
+  // coordinates of a node - this function is implemented in each
+  // mesh framework. The results are cached in the base class
+
+  virtual
+  void node_get_coordinates_internal(const Entity_ID nodeid,
+                                     JaliGeometry::Point *ncoord) const = 0;
+
+  // set coordinates of a node in the framework's own copy of the
+  // coordinates - this function is implemented in each mesh
+  // framework. It is const because that copy only mirrors the
+  // coordinates cached in the base class (see
+  // update_framework_node_coordinates)
+
+  virtual
+  void node_set_coordinates_internal(const Entity_ID nodeid,
+                                     const double *ncoord) const = 0;
+
+  // Cache the node coordinates of the framework in the base class
+
+  void cache_node_coordinates() const;
+
+  // Copy the node coordinates to the framework if nodes have moved
+  // since it last got them. Frameworks must call this before using
+  // their own copy of the coordinates (e.g. to write the mesh to a
+  // file)
+
+  void update_framework_node_coordinates() const;
+
+  // Flag a node as moved (thread-safe)
+
+  void mark_node_moved(const Entity_ID nodeid);
+
   //! get labeled set entities
   //
   // Labeled sets are pre-existing mesh sets with a "name" in the mesh
@@ -1274,6 +1689,10 @@ class Mesh {
   int compute_cell_geometry(const Entity_ID cellid,
                             double *volume,
                             JaliGeometry::Point *centroid) const;
+  int compute_cell_geometry(const Entity_ID cellid,
+                            const Cell_type ctype,
+                            double *volume,
+                            JaliGeometry::Point *centroid) const;
   int compute_face_geometry(const Entity_ID faceid,
                             double *area,
                             JaliGeometry::Point *centroid,
@@ -1299,14 +1718,41 @@ class Mesh {
                               double *volume) const;
 
   void cache_type_info() const;
+  void cache_celltype_info() const;
+  void cache_cell2node_info() const;
+  void cache_face2node_info() const;
   void cache_cell2face_info() const;
   void cache_face2cell_info() const;
   void cache_cell2edge_info() const;
   void cache_face2edge_info() const;
   void cache_edge2node_info() const;
   void cache_side_info() const;
+  void cache_side_lists() const;
   void cache_wedge_info() const;
+
+  // Positions of the face of an implicitly numbered side in
+  // cell_face_ids and of its edge in face_edge_ids
+
+  int implicit_side_cell_face(const Entity_ID sideid) const;
+  int implicit_side_face_edge(const Entity_ID sideid, const int icface) const;
+  int implicit_side_edge_use(const int icface, const int ifedge) const;
+
   void cache_corner_info() const;
+  void cache_node2cell_info() const;
+  void cache_node2face_info() const;
+  void cache_cell_face_adj_info() const;
+  void cache_cell_node_adj_info() const;
+  void cache_tile_colors() const;
+
+  // Build a cached table with the builder 'build' unless the flag
+  // 'done' says it is already built. Safe to call concurrently from
+  // many threads - exactly one of them builds the table and the
+  // others wait for it to be complete. The builder must set 'done'
+  // at the very end
+
+  template<typename R>
+  void build_once(std::atomic<bool> const& done,
+                  R (Mesh::*build)() const) const;
 
   void build_tiles();
   void add_tile(std::shared_ptr<MeshTile> tile2add);
@@ -1354,13 +1800,31 @@ class Mesh {
   const int num_ghost_layers_distmesh_;
   const bool boundary_ghosts_requested_;
   const Partitioner_type partitioner_pref_;
+  const Renumbering_type renumbering_pref_;
   bool tiles_initialized_ = false;
   std::vector<std::shared_ptr<MeshTile>> meshtiles;
   std::vector<int> node_master_tile_ID_, edge_master_tile_ID_;
   std::vector<int> face_master_tile_ID_, cell_master_tile_ID_;
 
+  // Coloring of the tiles (built on demand) - color of each tile and
+  // the tiles of each color in CSR form
+
+  mutable std::vector<int> tile_color_;
+  mutable std::vector<int> tile_color_offsets_, tile_color_ids_;
+
+  // Tile blocked layouts of entity data (indexed by Entity_kind and
+  // built on demand, see tile_layouts_cached_)
+
+  mutable std::shared_ptr<Tile_layout const>
+  tile_layouts_[NUM_ENTITY_KINDS];
+
   // MeshSets (collection of entities of a particular kind)
 
+  // Old to new and new to old ID maps of renumbered nodes, edges,
+  // faces and cells (indexed by Entity_kind)
+
+  std::vector<Entity_ID> old_to_new_ids_[4], new_to_old_ids_[4];
+
   bool meshsets_initialized_ = false;
   std::vector<std::shared_ptr<MeshSet>> meshsets_;
 
@@ -1371,6 +1835,26 @@ class Mesh {
   mutable std::vector<JaliGeometry::Point> cell_centroids,
     face_centroids, face_normal0, face_normal1, edge_vectors, edge_centroids;
 
+  // Entities grouped for the batched geometry kernels
+
+  mutable Geometry_batches geometry_batches_;
+
+  // Node coordinates - coordinate d of node n is
+  // node_coordinates_[d][n]. The arrays live in node_coords_storage_,
+  // each one starting on a cache line boundary
+
+  mutable std::vector<double> node_coords_storage_;
+  mutable double *node_coordinates_[3] = {nullptr, nullptr, nullptr};
+  mutable std::atomic<bool> framework_node_coords_current_{true};
+
+  // Nodes moved since the last update of the geometric quantities
+  // (node_moved_ flags them and any_node_moved_ says if any is
+  // flagged). The flags are atomic so that nodes can be moved
+  // concurrently, and are allocated with the coordinate cache
+
+  mutable std::vector<std::atomic<char>> node_moved_;
+  std::atomic<bool> any_node_moved_{false};
+
   // outward facing normal from side to side in adjacent cell
   mutable std::vector<JaliGeometry::Point> side_outward_facet_normal;
   // Normal of the common facet of the two wedges - normal points out
@@ -1400,21 +1884,38 @@ class Mesh {
   mutable std::vector<Entity_type> edge_type;  // if edges requested
   mutable std::vector<Entity_type> node_type;
 
+  // Cell types (TRI, QUAD, HEX, ...) - only cached for mesh views
+
+  mutable std::vector<Cell_type> cell_celltypes_;
+
   // Some standard topological relationships that are cached. The rest
   // are computed on the fly or obtained from the derived class
-
-  mutable std::vector<Entity_ID_List> cell_face_ids;
-  mutable std::vector<std::vector<dir_t>> cell_face_dirs;
-  mutable std::vector<Entity_ID_List> face_cell_ids;
-  mutable std::vector<Entity_ID_List> cell_edge_ids;
-  mutable std::vector<Entity_ID_List> face_edge_ids;
-  mutable std::vector<std::vector<dir_t>> face_edge_dirs;
+  //
+  // One-to-many relationships are stored in compressed row (CSR)
+  // form, i.e. the entities adjacent to entity 'i' are
+  // xxx_ids[xxx_offsets[i]] ... xxx_ids[xxx_offsets[i+1]-1]. Each
+  // offsets array has one more entry than the number of entities
+
+  mutable std::vector<int> cell_node_offsets;
+  mutable Entity_ID_List cell_node_ids;
+  mutable std::vector<int> face_node_offsets;
+  mutable Entity_ID_List face_node_ids;  // ordered as per face normal
+  mutable std::vector<int> cell_face_offsets;
+  mutable Entity_ID_List cell_face_ids;
+  mutable std::vector<dir_t> cell_face_dirs_;
+  mutable Entity_ID_List face_cell_ids;  // 2 per face, -1 if absent
+  mutable std::vector<int> cell_edge_offsets;
+  mutable Entity_ID_List cell_edge_ids;
+  mutable std::vector<int> face_edge_offsets;
+  mutable Entity_ID_List face_edge_ids;
+  mutable std::vector<dir_t> face_edge_dirs_;
   mutable std::vector<std::array<Entity_ID, 2>> edge_node_ids;
 
-  // cell_2D_edge_dirs is an unusual topological relationship
-  // requested by MHD discretization - It has no equivalent in 3D
+  // cell_2D_edge_dirs_ is an unusual topological relationship
+  // requested by MHD discretization - It has no equivalent in 3D. It
+  // is indexed by cell_edge_offsets
 
-  mutable std::vector<std::vector<dir_t>> cell_2D_edge_dirs;
+  mutable std::vector<dir_t> cell_2D_edge_dirs_;
 
 
   // Topological relationships involving standard and non-standard
@@ -1442,19 +1943,71 @@ class Mesh {
   mutable std::vector<Entity_ID> side_cell_id;
   mutable std::vector<Entity_ID> side_face_id;
   mutable std::vector<Entity_ID> side_edge_id;
-  mutable std::vector<bool> side_edge_use;  // true: side, edge - p0, p1 match
+  // true: side, edge - p0, p1 match (char and not bool so that
+  // threads can set the entries of different sides concurrently)
+  mutable std::vector<char> side_edge_use;
   mutable std::vector<std::array<Entity_ID, 2>> side_node_ids;
   mutable std::vector<Entity_ID> side_opp_side_id;
 
   // Wedges - most wedge info is derived from sides
   mutable std::vector<Entity_ID> wedge_corner_id;
 
-  // some other one-many adjacencies
-  mutable std::vector<std::vector<Entity_ID>> cell_side_ids;
-  mutable std::vector<std::vector<Entity_ID>> cell_corner_ids;
-  //  mutable std::vector<std::vector<Entity_ID>> edge_side_ids;
-  mutable std::vector<std::vector<Entity_ID>> node_corner_ids;
-  mutable std::vector<std::vector<Entity_ID>> corner_wedge_ids;
+  // Implicitly numbered sides - none of the side tables above,
+  // cell_side_ids or wedge_corner_id are built. The sides of the j'th
+  // entry of cell_face_ids are cell_face_side_offsets[j] to
+  // cell_face_side_offsets[j+1]-1 (one per edge of the face, in the
+  // order of face_edge_ids), so a side s is located by
+  //
+  //   j = s/nedges_per_face_ if all faces have nedges_per_face_
+  //       edges (always so in 2D), side_cell_face_pos[s] otherwise
+  //   cell = cell_face_cell_ids[j], face = cell_face_ids[j]
+  //   edge = face_edge_ids[face_edge_offsets[face] + s -
+  //                        cell_face_side_offsets[j]]
+  //
+  // cell_face_opp_pos[j] is the entry of the same face in the other
+  // cell of the face (-1 if none) and wedge_cell_node_pos the position
+  // of the node of a wedge in cell_nodes, i.e. of its corner among
+  // the corners of the cell
+
+  const bool implicit_subcells_;
+  mutable bool implicit_sides_ = false;
+  mutable int nedges_per_face_ = 0;
+  mutable std::vector<int> cell_face_side_offsets;
+  mutable std::vector<Entity_ID> cell_face_cell_ids;
+  mutable std::vector<int> cell_face_opp_pos;
+  mutable std::vector<int> side_cell_face_pos;
+  mutable std::vector<unsigned short> wedge_cell_node_pos;
+
+  // Number of sides of each type (the lists of sides of each type
+  // are only built when asked for if the sides are implicit)
+
+  mutable int nsides_owned_ = 0, nsides_ghost_ = 0,
+    nsides_boundary_ghost_ = 0;
+
+  // Times of the phases of the construction (if requested)
+
+  const bool profile_construction_;
+  Phase_profile construction_profile_;
+
+  // some other one-many adjacencies (CSR form, see above)
+  mutable std::vector<int> cell_side_offsets;
+  mutable Entity_ID_List cell_side_ids;
+  mutable std::vector<int> cell_corner_offsets;
+  mutable Entity_ID_List cell_corner_ids;
+  mutable std::vector<int> node_corner_offsets;
+  mutable Entity_ID_List node_corner_ids;
+  mutable std::vector<int> corner_wedge_offsets;
+  mutable Entity_ID_List corner_wedge_ids;
+
+  // Upward and same level adjacencies (CSR form, built on demand)
+  mutable std::vector<int> node_cell_offsets;
+  mutable Entity_ID_List node_cell_ids;
+  mutable std::vector<int> node_face_offsets;
+  mutable Entity_ID_List node_face_ids;
+  mutable std::vector<int> cell_fadj_offsets;
+  mutable Entity_ID_List cell_fadj_ids;
+  mutable std::vector<int> cell_nadj_offsets;
+  mutable Entity_ID_List cell_nadj_ids;
 
   // Rectangular or general
   mutable Mesh_type mesh_type_;
@@ -1463,14 +2016,32 @@ class Mesh {
 
   mutable bool faces_requested, edges_requested, sides_requested,
     wedges_requested, corners_requested;
-  mutable bool type_info_cached;
-  mutable bool cell2face_info_cached, face2cell_info_cached;
-  mutable bool cell2edge_info_cached, face2edge_info_cached;
-  mutable bool edge2node_info_cached;
-  mutable bool side_info_cached, wedge_info_cached, corner_info_cached;
-  mutable bool cell_geometry_precomputed, face_geometry_precomputed,
-    edge_geometry_precomputed, side_geometry_precomputed,
-    corner_geometry_precomputed;
+
+  // The cached tables below are built on first use (see build_once).
+  // A flag is set only after its table is completely built so that a
+  // thread seeing it set can read the table without locking
+
+  mutable std::atomic<bool> type_info_cached, node_coords_cached;
+  mutable std::atomic<bool> celltype_info_cached, tile_colors_cached;
+  mutable std::atomic<unsigned> tile_layouts_cached_;  // bit per kind
+  mutable std::atomic<bool> cell2node_info_cached, face2node_info_cached;
+  mutable std::atomic<bool> cell2face_info_cached, face2cell_info_cached;
+  mutable std::atomic<bool> cell2edge_info_cached, face2edge_info_cached;
+  mutable std::atomic<bool> edge2node_info_cached;
+  mutable std::atomic<bool> side_info_cached, side_lists_cached,
+    wedge_info_cached, corner_info_cached;
+  mutable std::atomic<bool> node2cell_info_cached, node2face_info_cached;
+  mutable std::atomic<bool> cell_fadj_info_cached, cell_nadj_info_cached;
+  mutable std::atomic<bool> cell_batches_cached, face_batches_cached;
+  mutable std::atomic<bool> cell_geometry_precomputed,
+    face_geometry_precomputed, edge_geometry_precomputed,
+    side_geometry_precomputed, corner_geometry_precomputed;
+
+  // Serializes the building of cached tables. It is recursive
+  // because building one table may trigger building the tables it
+  // depends on (e.g. sides need cell to face info)
+
+  mutable std::recursive_mutex cache_mutex_;
 
   // Pointer to geometric model that contains descriptions of
   // geometric regions - These geometric regions are used to define
@@ -1502,6 +2073,20 @@ class Mesh {
                                           bool const request_wedges,
                                           bool const request_corners);
 
+  // Make the make_meshtiles function a friend for the same reason and
+  // so that it can settle the master tile IDs of entities up front
+
+  friend
+  std::vector<std::shared_ptr<MeshTile>>
+  make_meshtiles(Mesh& parent_mesh,
+                 std::vector<std::vector<Entity_ID>> const& cells,
+                 int const num_ghost_layers_tile,
+                 bool const request_faces,
+                 bool const request_edges,
+                 bool const request_sides,
+                 bool const request_wedges,
+                 bool const request_corners);
+
   // Make the make_meshset function a friend so that it can access the
   // protected functions init_sets and add_set
 
@@ -1622,17 +2207,23 @@ unsigned int Mesh::num_sides() const {
 template<> inline
 unsigned int
 Mesh::num_sides<Entity_type::PARALLEL_OWNED>() const {
-  return sideids_owned_.size();
+  if (sides_requested)
+    build_once(side_info_cached, &Mesh::cache_side_info);
+  return nsides_owned_;
 }
 template<> inline
 unsigned int
 Mesh::num_sides<Entity_type::PARALLEL_GHOST>() const {
-  return sideids_ghost_.size();
+  if (sides_requested)
+    build_once(side_info_cached, &Mesh::cache_side_info);
+  return nsides_ghost_;
 }
 template<> inline
 unsigned int
 Mesh::num_sides<Entity_type::BOUNDARY_GHOST>() const {
-  return sideids_boundary_ghost_.size();
+  if (sides_requested)
+    build_once(side_info_cached, &Mesh::cache_side_info);
+  return nsides_boundary_ghost_;
 }
 template<> inline
 unsigned int Mesh::num_sides<Entity_type::ALL>() const {
@@ -1649,17 +2240,17 @@ unsigned int Mesh::num_wedges() const {
 template<> inline
 unsigned int
 Mesh::num_wedges<Entity_type::PARALLEL_OWNED>() const {
-  return wedgeids_owned_.size();
+  return wedges_requested ? 2*num_sides<Entity_type::PARALLEL_OWNED>() : 0;
 }
 template<> inline
 unsigned int
 Mesh::num_wedges<Entity_type::PARALLEL_GHOST>() const {
-return wedgeids_ghost_.size();
+  return wedges_requested ? 2*num_sides<Entity_type::PARALLEL_GHOST>() : 0;
 }
 template<> inline
 unsigned int
 Mesh::num_wedges<Entity_type::BOUNDARY_GHOST>() const {
-return wedgeids_boundary_ghost_.size();
+  return wedges_requested ? 2*num_sides<Entity_type::BOUNDARY_GHOST>() : 0;
 }
 template<> inline
 unsigned int Mesh::num_wedges<Entity_type::ALL>() const {
@@ -1676,15 +2267,21 @@ unsigned int Mesh::num_corners() const {
 template<> inline
 unsigned int
 Mesh::num_corners<Entity_type::PARALLEL_OWNED>() const {
+  if (corners_requested)
+    build_once(corner_info_cached, &Mesh::cache_corner_info);
   return cornerids_owned_.size();
 }
 template<> inline
 unsigned int
 Mesh::num_corners<Entity_type::PARALLEL_GHOST>() const {
+  if (corners_requested)
+    build_once(corner_info_cached, &Mesh::cache_corner_info);
   return cornerids_ghost_.size();
 }
 template<> inline
 unsigned int Mesh::num_corners<Entity_type::BOUNDARY_GHOST>() const {
+  if (corners_requested)
+    build_once(corner_info_cached, &Mesh::cache_corner_info);
   return cornerids_boundary_ghost_.size();
 }
 template<> inline
@@ -1890,20 +2487,28 @@ const std::vector<Entity_ID> & Mesh::sides() const {
 template<> inline
 const std::vector<Entity_ID>&
 Mesh::sides<Entity_type::PARALLEL_OWNED>() const {
+  if (sides_requested)
+    build_once(side_lists_cached, &Mesh::cache_side_lists);
   return sideids_owned_;
 }
 template<> inline
 const std::vector<Entity_ID>&
 Mesh::sides<Entity_type::PARALLEL_GHOST>() const {
+  if (sides_requested)
+    build_once(side_lists_cached, &Mesh::cache_side_lists);
   return sideids_ghost_;
 }
 template<> inline
 const std::vector<Entity_ID>&
 Mesh::sides<Entity_type::BOUNDARY_GHOST>() const {
+  if (sides_requested)
+    build_once(side_lists_cached, &Mesh::cache_side_lists);
   return sideids_boundary_ghost_;
 }
 template<> inline
 const std::vector<Entity_ID> & Mesh::sides<Entity_type::ALL>() const {
+  if (sides_requested)
+    build_once(side_info_cached, &Mesh::cache_side_info);
   return sideids_all_;
 }
 
@@ -1917,21 +2522,29 @@ const std::vector<Entity_ID> & Mesh::wedges() const {
 template<> inline
 const std::vector<Entity_ID>&
 Mesh::wedges<Entity_type::PARALLEL_OWNED>() const {
+  if (wedges_requested)
+    build_once(wedge_info_cached, &Mesh::cache_wedge_info);
   return wedgeids_owned_;
 }
 template<> inline
 const std::vector<Entity_ID>&
 Mesh::wedges<Entity_type::PARALLEL_GHOST>() const {
+  if (wedges_requested)
+    build_once(wedge_info_cached, &Mesh::cache_wedge_info);
   return wedgeids_ghost_;
 }
 template<> inline
 const std::vector<Entity_ID>&
 Mesh::wedges<Entity_type::BOUNDARY_GHOST>() const {
+  if (wedges_requested)
+    build_once(wedge_info_cached, &Mesh::cache_wedge_info);
   return wedgeids_boundary_ghost_;
 }
 template<> inline
 const std::vector<Entity_ID>&
 Mesh::wedges<Entity_type::ALL>() const {
+  if (wedges_requested)
+    build_once(wedge_info_cached, &Mesh::cache_wedge_info);
   return wedgeids_all_;
 }
 
@@ -1945,21 +2558,29 @@ const std::vector<Entity_ID> & Mesh::corners() const {
 template<> inline
 const std::vector<Entity_ID>&
 Mesh::corners<Entity_type::PARALLEL_OWNED>() const {
+  if (corners_requested)
+    build_once(corner_info_cached, &Mesh::cache_corner_info);
   return cornerids_owned_;
 }
 template<> inline
 const std::vector<Entity_ID>&
 Mesh::corners<Entity_type::PARALLEL_GHOST>() const {
+  if (corners_requested)
+    build_once(corner_info_cached, &Mesh::cache_corner_info);
   return cornerids_ghost_;
 }
 template<> inline
 const std::vector<Entity_ID>&
 Mesh::corners<Entity_type::BOUNDARY_GHOST>() const {
+  if (corners_requested)
+    build_once(corner_info_cached, &Mesh::cache_corner_info);
   return cornerids_boundary_ghost_;
 }
 template<> inline
 const std::vector<Entity_ID>&
 Mesh::corners<Entity_type::ALL>() const {
+  if (corners_requested)
+    build_once(corner_info_cached, &Mesh::cache_corner_info);
   return cornerids_all_;
 }
 
@@ -1995,16 +2616,165 @@ Mesh::cells<Entity_type::ALL>() const {
 
 // Inline functions of the Mesh class
 
+template<typename R> inline
+void Mesh::build_once(std::atomic<bool> const& done,
+                      R (Mesh::*build)() const) const {
+  if (done.load(std::memory_order_acquire)) return;  // common case
+
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex_);
+  if (!done.load(std::memory_order_relaxed))
+    (this->*build)();
+}
+
 inline
 void Mesh::cell_get_faces(const Entity_ID cellid, Entity_ID_List *faceids,
                           const bool ordered) const {
   cell_get_faces_and_dirs(cellid, faceids, NULL, ordered);
 }
 
+inline
+Entity_ID_View Mesh::cell_nodes(const Entity_ID cellid) const {
+  build_once(cell2node_info_cached, &Mesh::cache_cell2node_info);
+  return Entity_ID_View(cell_node_ids.data() + cell_node_offsets[cellid],
+                        cell_node_ids.data() + cell_node_offsets[cellid+1]);
+}
+
+inline
+Entity_ID_View Mesh::face_nodes(const Entity_ID faceid) const {
+  build_once(face2node_info_cached, &Mesh::cache_face2node_info);
+  return Entity_ID_View(face_node_ids.data() + face_node_offsets[faceid],
+                        face_node_ids.data() + face_node_offsets[faceid+1]);
+}
+
+inline
+Entity_ID_View Mesh::cell_faces(const Entity_ID cellid) const {
+  build_once(cell2face_info_cached, &Mesh::cache_cell2face_info);
+  return Entity_ID_View(cell_face_ids.data() + cell_face_offsets[cellid],
+                        cell_face_ids.data() + cell_face_offsets[cellid+1]);
+}
+
+inline
+Dir_View Mesh::cell_face_dirs(const Entity_ID cellid) const {
+  build_once(cell2face_info_cached, &Mesh::cache_cell2face_info);
+  return Dir_View(cell_face_dirs_.data() + cell_face_offsets[cellid],
+                  cell_face_dirs_.data() + cell_face_offsets[cellid+1]);
+}
+
+inline
+Entity_ID_View Mesh::face_cells(const Entity_ID faceid) const {
+  build_once(face2cell_info_cached, &Mesh::cache_face2cell_info);
+
+  // The two slots of a face are padded at the end with -1 when the
+  // face has only one (or no) cell
+
+  Entity_ID const * const fcells = face_cell_ids.data() + 2*faceid;
+  int nfcells = (fcells[0] == -1) ? 0 : ((fcells[1] == -1) ? 1 : 2);
+  return Entity_ID_View(fcells, fcells + nfcells);
+}
+
+inline
+Entity_ID_View Mesh::face_edges(const Entity_ID faceid) const {
+  build_once(face2edge_info_cached, &Mesh::cache_face2edge_info);
+  return Entity_ID_View(face_edge_ids.data() + face_edge_offsets[faceid],
+                        face_edge_ids.data() + face_edge_offsets[faceid+1]);
+}
+
+inline
+Dir_View Mesh::face_edge_dirs(const Entity_ID faceid) const {
+  build_once(face2edge_info_cached, &Mesh::cache_face2edge_info);
+  return Dir_View(face_edge_dirs_.data() + face_edge_offsets[faceid],
+                  face_edge_dirs_.data() + face_edge_offsets[faceid+1]);
+}
+
+inline
+Entity_ID_View Mesh::cell_edges(const Entity_ID cellid) const {
+  build_once(cell2edge_info_cached, &Mesh::cache_cell2edge_info);
+  return Entity_ID_View(cell_edge_ids.data() + cell_edge_offsets[cellid],
+                        cell_edge_ids.data() + cell_edge_offsets[cellid+1]);
+}
+
+inline
+Dir_View Mesh::cell_2D_edge_dirs(const Entity_ID cellid) const {
+  assert(space_dim_ == 2);
+  build_once(cell2edge_info_cached, &Mesh::cache_cell2edge_info);
+  return Dir_View(cell_2D_edge_dirs_.data() + cell_edge_offsets[cellid],
+                  cell_2D_edge_dirs_.data() + cell_edge_offsets[cellid+1]);
+}
+
+inline
+Entity_ID_View Mesh::cell_sides(const Entity_ID cellid) const {
+  assert(sides_requested);
+  build_once(side_info_cached, &Mesh::cache_side_info);
+  if (implicit_sides_)  // side IDs of a cell are consecutive
+    return Entity_ID_View(sideids_all_.data() + cell_side_offsets[cellid],
+                          sideids_all_.data() + cell_side_offsets[cellid+1]);
+  return Entity_ID_View(cell_side_ids.data() + cell_side_offsets[cellid],
+                        cell_side_ids.data() + cell_side_offsets[cellid+1]);
+}
+
+inline
+Entity_ID_View Mesh::cell_corners(const Entity_ID cellid) const {
+  assert(corners_requested);
+  build_once(corner_info_cached, &Mesh::cache_corner_info);
+  return Entity_ID_View(cell_corner_ids.data() + cell_corner_offsets[cellid],
+                        cell_corner_ids.data() +
+                        cell_corner_offsets[cellid+1]);
+}
+
+inline
+Entity_ID_View Mesh::node_corners(const Entity_ID nodeid) const {
+  assert(corners_requested);
+  build_once(corner_info_cached, &Mesh::cache_corner_info);
+  return Entity_ID_View(node_corner_ids.data() + node_corner_offsets[nodeid],
+                        node_corner_ids.data() +
+                        node_corner_offsets[nodeid+1]);
+}
+
+inline
+Entity_ID_View Mesh::corner_wedges(const Entity_ID cornerid) const {
+  assert(corners_requested);
+  build_once(corner_info_cached, &Mesh::cache_corner_info);
+  return Entity_ID_View(corner_wedge_ids.data() +
+                        corner_wedge_offsets[cornerid],
+                        corner_wedge_ids.data() +
+                        corner_wedge_offsets[cornerid+1]);
+}
+
+inline
+Entity_ID_View Mesh::node_cells(const Entity_ID nodeid) const {
+  build_once(node2cell_info_cached, &Mesh::cache_node2cell_info);
+  return Entity_ID_View(node_cell_ids.data() + node_cell_offsets[nodeid],
+                        node_cell_ids.data() + node_cell_offsets[nodeid+1]);
+}
+
+inline
+Entity_ID_View Mesh::node_faces(const Entity_ID nodeid) const {
+  assert(faces_requested);
+  build_once(node2face_info_cached, &Mesh::cache_node2face_info);
+  return Entity_ID_View(node_face_ids.data() + node_face_offsets[nodeid],
+                        node_face_ids.data() + node_face_offsets[nodeid+1]);
+}
+
+inline
+Entity_ID_View Mesh::cell_face_adj_cells(const Entity_ID cellid) const {
+  assert(faces_requested);
+  build_once(cell_fadj_info_cached, &Mesh::cache_cell_face_adj_info);
+  return Entity_ID_View(cell_fadj_ids.data() + cell_fadj_offsets[cellid],
+                        cell_fadj_ids.data() + cell_fadj_offsets[cellid+1]);
+}
+
+inline
+Entity_ID_View Mesh::cell_node_adj_cells(const Entity_ID cellid) const {
+  build_once(cell_nadj_info_cached, &Mesh::cache_cell_node_adj_info);
+  return Entity_ID_View(cell_nadj_ids.data() + cell_nadj_offsets[cellid],
+                        cell_nadj_ids.data() + cell_nadj_offsets[cellid+1]);
+}
+
 inline
 void Mesh::edge_get_nodes(const Entity_ID edgeid, Entity_ID *nodeid0,
                           Entity_ID *nodeid1) const {
 #ifdef JALI_CACHE_VARS
+  build_once(edge2node_info_cached, &Mesh::cache_edge2node_info);
   *nodeid0 = edge_node_ids[edgeid][0];
   *nodeid1 = edge_node_ids[edgeid][1];
 #else
@@ -2018,58 +2788,113 @@ Entity_ID Mesh::side_get_wedge(const Entity_ID sideid, int iwedge) const {
   return (iwedge ? 2*sideid + 1 : 2*sideid);
 }
 
+inline
+int Mesh::implicit_side_cell_face(const Entity_ID sideid) const {
+  return (nedges_per_face_ ? sideid/nedges_per_face_ :
+          side_cell_face_pos[sideid]);
+}
+
+inline
+int Mesh::implicit_side_face_edge(const Entity_ID sideid,
+                                  const int icface) const {
+  return (face_edge_offsets[cell_face_ids[icface]] + sideid -
+          cell_face_side_offsets[icface]);
+}
+
+inline
+int Mesh::implicit_side_edge_use(const int icface, const int ifedge) const {
+  // Same rule as in cache_side_info - in 3D the side uses the edge in
+  // the +ve direction only if exactly one of the cell's use of the
+  // face and the face's use of the edge is in the +ve direction
+
+  int fdir = cell_face_dirs_[icface];
+  if (manifold_dim_ == 2)
+    return (fdir == 1) ? 1 : 0;
+  int edir = face_edge_dirs_[ifedge];
+  return ((fdir+1)/2)^((edir+1)/2);
+}
+
 inline
 Entity_ID Mesh::side_get_face(const Entity_ID sideid) const {
   assert(sides_requested);
-  assert(side_info_cached);
+  build_once(side_info_cached, &Mesh::cache_side_info);
+  if (implicit_sides_)
+    return cell_face_ids[implicit_side_cell_face(sideid)];
   return side_face_id[sideid];
 }
 
 inline
 Entity_ID Mesh::side_get_edge(const Entity_ID sideid) const {
   assert(sides_requested);
-  assert(side_info_cached);
+  build_once(side_info_cached, &Mesh::cache_side_info);
+  if (implicit_sides_) {
+    int j = implicit_side_cell_face(sideid);
+    return face_edge_ids[implicit_side_face_edge(sideid, j)];
+  }
   return side_edge_id[sideid];
 }
 
 inline
 int Mesh::side_get_edge_use(const Entity_ID sideid) const {
   assert(sides_requested);
-  assert(side_info_cached);
+  build_once(side_info_cached, &Mesh::cache_side_info);
+  if (implicit_sides_) {
+    int j = implicit_side_cell_face(sideid);
+    return implicit_side_edge_use(j, implicit_side_face_edge(sideid, j));
+  }
   return static_cast<int>(side_edge_use[sideid]);
 }
 
 inline
 Entity_ID Mesh::side_get_cell(const Entity_ID sideid) const {
   assert(sides_requested);
-  assert(side_info_cached);
+  build_once(side_info_cached, &Mesh::cache_side_info);
+  if (implicit_sides_)
+    return cell_face_cell_ids[implicit_side_cell_face(sideid)];
   return side_cell_id[sideid];
 }
 
 inline
 Entity_ID Mesh::side_get_node(const Entity_ID sideid, const int inode) const {
   assert(sides_requested);
-  assert(side_info_cached && edge2node_info_cached);
+  build_once(side_info_cached, &Mesh::cache_side_info);
+  build_once(edge2node_info_cached, &Mesh::cache_edge2node_info);
   assert(inode == 0 || inode == 1);
 
-  Entity_ID edgeid = side_edge_id[sideid];
+  Entity_ID edgeid;
+  bool use;
+  if (implicit_sides_) {
+    int j = implicit_side_cell_face(sideid);
+    int k = implicit_side_face_edge(sideid, j);
+    edgeid = face_edge_ids[k];
+    use = implicit_side_edge_use(j, k);
+  } else {
+    edgeid = side_edge_id[sideid];
+    use = side_edge_use[sideid];
+  }
   Entity_ID enodes[2];
   edge_get_nodes(edgeid, &enodes[0], &enodes[1]);
-  bool use = side_edge_use[sideid];
   return (use ? enodes[inode] : enodes[!inode]);
 }
 
 inline
 Entity_ID Mesh::side_get_opposite_side(const Entity_ID sideid) const {
   assert(sides_requested);
-  assert(side_info_cached);
+  build_once(side_info_cached, &Mesh::cache_side_info);
+  if (implicit_sides_) {
+    // Same position among the sides of the face in the other cell
+    int j = implicit_side_cell_face(sideid);
+    int j2 = cell_face_opp_pos[j];
+    return (j2 < 0 ? -1 : cell_face_side_offsets[j2] + sideid -
+            cell_face_side_offsets[j]);
+  }
   return side_opp_side_id[sideid];
 }
 
 inline
 Entity_ID Mesh::wedge_get_cell(const Entity_ID wedgeid) const {
   assert(sides_requested && wedges_requested);
-  assert(side_info_cached);
+  build_once(side_info_cached, &Mesh::cache_side_info);
   int sideid = wedgeid/2;  // which side does wedge belong to
   return side_get_cell(sideid);
 }
@@ -2077,7 +2902,7 @@ Entity_ID Mesh::wedge_get_cell(const Entity_ID wedgeid) const {
 inline
 Entity_ID Mesh::wedge_get_face(const Entity_ID wedgeid) const {
   assert(sides_requested && wedges_requested);
-  assert(side_info_cached);
+  build_once(side_info_cached, &Mesh::cache_side_info);
   Entity_ID sideid = static_cast<Entity_ID>(wedgeid/2);
   return side_get_face(sideid);
 }
@@ -2085,7 +2910,7 @@ Entity_ID Mesh::wedge_get_face(const Entity_ID wedgeid) const {
 inline
 Entity_ID Mesh::wedge_get_edge(const Entity_ID wedgeid) const {
   assert(sides_requested && wedges_requested);
-  assert(side_info_cached);
+  build_once(side_info_cached, &Mesh::cache_side_info);
   Entity_ID sideid = static_cast<Entity_ID>(wedgeid/2);
   return side_get_edge(sideid);
 }
@@ -2093,7 +2918,7 @@ Entity_ID Mesh::wedge_get_edge(const Entity_ID wedgeid) const {
 inline
 Entity_ID Mesh::wedge_get_node(const Entity_ID wedgeid) const {
   assert(sides_requested && wedges_requested);
-  assert(side_info_cached);
+  build_once(side_info_cached, &Mesh::cache_side_info);
   Entity_ID sideid = static_cast<Entity_ID>(wedgeid/2);
   int iwedge = wedgeid%2;  // Is it wedge 0 or wedge 1 of side
   return side_get_node(sideid, iwedge);
@@ -2102,7 +2927,16 @@ Entity_ID Mesh::wedge_get_node(const Entity_ID wedgeid) const {
 inline
 Entity_ID Mesh::wedge_get_corner(const Entity_ID wedgeid) const {
   assert(sides_requested && wedges_requested);
-  assert(side_info_cached && wedge_info_cached);
+  build_once(side_info_cached, &Mesh::cache_side_info);
+  if (implicit_sides_) {  // corners of a cell are numbered by cell node
+    if (!corners_requested) return -1;
+    build_once(corner_info_cached, &Mesh::cache_corner_info);
+    return (cell_corner_offsets[wedge_get_cell(wedgeid)] +
+            wedge_cell_node_pos[wedgeid]);
+  }
+  build_once(wedge_info_cached, &Mesh::cache_wedge_info);
+  if (corners_requested)  // wedge_corner_id is filled in with corners
+    build_once(corner_info_cached, &Mesh::cache_corner_info);
   return wedge_corner_id[wedgeid];
 }
 
@@ -2121,12 +2955,12 @@ Entity_ID Mesh::wedge_get_adjacent_wedge(Entity_ID const wedgeid) const {
 inline
 Entity_ID Mesh::wedge_get_opposite_wedge(Entity_ID const wedgeid) const {
   assert(wedges_requested);
-  assert(side_info_cached);
+  build_once(side_info_cached, &Mesh::cache_side_info);
 
   Entity_ID sideid = static_cast<Entity_ID>(wedgeid/2);
   int iwedge = wedgeid%2;  // Is it wedge 0 or wedge 1 of side
 
-  Entity_ID oppsideid = side_opp_side_id[sideid];
+  Entity_ID oppsideid = side_get_opposite_side(sideid);
   if (oppsideid == -1)
     return -1;
   else {
@@ -2141,77 +2975,120 @@ inline
 void Mesh::corner_get_wedges(const Entity_ID cornerid,
                              Entity_ID_List *cwedges) const {
   assert(corners_requested);
-  assert(corner_info_cached);
+  build_once(corner_info_cached, &Mesh::cache_corner_info);
 
-  int nwedges = corner_wedge_ids[cornerid].size();
-  (*cwedges).resize(nwedges);
-  std::copy(corner_wedge_ids[cornerid].begin(),
-            corner_wedge_ids[cornerid].end(),
-            cwedges->begin());
+  Entity_ID_View wedges = corner_wedges(cornerid);
+  cwedges->assign(wedges.begin(), wedges.end());
 }
 
 inline
 Entity_ID Mesh::corner_get_node(const Entity_ID cornerid) const {
   assert(corners_requested);
-  assert(corner_info_cached && side_info_cached);
-  assert(corner_wedge_ids[cornerid].size());
+  build_once(corner_info_cached, &Mesh::cache_corner_info);
+  build_once(side_info_cached, &Mesh::cache_side_info);
+  assert(corner_wedge_offsets[cornerid+1] > corner_wedge_offsets[cornerid]);
 
   // Instead of calling corner_get_wedges which involves a list copy,
-  // we will directly access the first element of the corner_wedge_ids
-  // array
-  Entity_ID w0 = corner_wedge_ids[cornerid][0];
+  // we will directly access the first wedge of the corner
+  Entity_ID w0 = corner_wedges(cornerid)[0];
   return wedge_get_node(w0);
 }
 
 inline
 Entity_ID Mesh::corner_get_cell(const Entity_ID cornerid) const {
   assert(corners_requested);
-  assert(corner_info_cached && side_info_cached);
-  assert(corner_wedge_ids[cornerid].size());
+  build_once(corner_info_cached, &Mesh::cache_corner_info);
+  build_once(side_info_cached, &Mesh::cache_side_info);
+  assert(corner_wedge_offsets[cornerid+1] > corner_wedge_offsets[cornerid]);
 
   // Instead of calling corner_get_wedges which involves a list copy,
-  // we will directly access the first element of the corner_wedge_ids
-  // array
-  Entity_ID w0 = corner_wedge_ids[cornerid][0];
+  // we will directly access the first wedge of the corner
+  Entity_ID w0 = corner_wedges(cornerid)[0];
   return wedge_get_cell(w0);
 }
 
-// Inefficient fallback implementation - hopefully the derived class
-// has a more direct implementation
+inline
+double const * Mesh::node_coordinates(const int dir) const {
+  assert(dir >= 0 && dir < static_cast<int>(space_dim_));
+  build_once(node_coords_cached, &Mesh::cache_node_coordinates);
+  return node_coordinates_[dir];
+}
+
+inline
+void Mesh::node_get_coordinates(const Entity_ID nodeid,
+                                JaliGeometry::Point *ncoord) const {
+  build_once(node_coords_cached, &Mesh::cache_node_coordinates);
+  if (space_dim_ == 3)
+    ncoord->set(node_coordinates_[0][nodeid], node_coordinates_[1][nodeid],
+                node_coordinates_[2][nodeid]);
+  else if (space_dim_ == 2)
+    ncoord->set(node_coordinates_[0][nodeid], node_coordinates_[1][nodeid]);
+  else
+    ncoord->set(1, node_coordinates_[0] + nodeid);
+}
 
 inline
 void Mesh::node_get_coordinates(const Entity_ID nodeid,
                                 std::array<double, 3> *ncoord) const {
   assert(space_dim_ == 3);
-  JaliGeometry::Point p;
-  node_get_coordinates(nodeid, &p);
-  (*ncoord)[0] = p[0];
-  (*ncoord)[1] = p[1];
-  (*ncoord)[2] = p[2];
+  build_once(node_coords_cached, &Mesh::cache_node_coordinates);
+  (*ncoord)[0] = node_coordinates_[0][nodeid];
+  (*ncoord)[1] = node_coordinates_[1][nodeid];
+  (*ncoord)[2] = node_coordinates_[2][nodeid];
 }
 
-// Inefficient fallback implementation - hopefully the derived class
-// has a more direct implementation
-
 inline
 void Mesh::node_get_coordinates(const Entity_ID nodeid,
                                 std::array<double, 2> *ncoord) const {
   assert(space_dim_ == 2);
-  JaliGeometry::Point p;
-  node_get_coordinates(nodeid, &p);
-  (*ncoord)[0] = p[0];
-  (*ncoord)[1] = p[1];
+  build_once(node_coords_cached, &Mesh::cache_node_coordinates);
+  (*ncoord)[0] = node_coordinates_[0][nodeid];
+  (*ncoord)[1] = node_coordinates_[1][nodeid];
 }
-  
-// Inefficient fallback implementation - hopefully the derived class
-// has a more direct implementation
 
 inline
 void Mesh::node_get_coordinates(const Entity_ID nodeid, double *ncoord) const {
   assert(space_dim_ == 1);
-  JaliGeometry::Point p;
-  node_get_coordinates(nodeid, &p);
-  *ncoord = p[0];
+  build_once(node_coords_cached, &Mesh::cache_node_coordinates);
+  *ncoord = node_coordinates_[0][nodeid];
+}
+
+template<typename F>
+void Mesh::parallel_for_tiles(F const& f) const {
+  Thread_pool::instance().run(meshtiles.size(), [this, &f](int i) {
+      f(*(meshtiles[i]));
+    });
+}
+
+template<typename F>
+void Mesh::parallel_for_tiles_by_color(F const& f) const {
+  build_once(tile_colors_cached, &Mesh::cache_tile_colors);
+  for (int color = 0; color < num_tile_colors(); color++) {
+    int const *tileids = tile_color_ids_.data() + tile_color_offsets_[color];
+    int const ntiles = tile_color_offsets_[color+1] -
+        tile_color_offsets_[color];
+    Thread_pool::instance().run(ntiles, [this, &f, tileids](int i) {
+        f(*(meshtiles[tileids[i]]));
+      });
+  }
+}
+
+template<typename T, typename F, typename R>
+T Mesh::parallel_reduce_tiles(T const& init, F const& f,
+                              R const& reduce) const {
+  // Not a std::vector since std::vector<bool> cannot be written to
+  // concurrently
+
+  int const ntiles = meshtiles.size();
+  std::unique_ptr<T[]> values(new T[ntiles]);
+  Thread_pool::instance().run(ntiles, [this, &f, &values](int i) {
+      values[i] = f(*(meshtiles[i]));
+    });
+
+  T result = init;
+  for (int i = 0; i < ntiles; i++)
+    result = reduce(result, values[i]);
+  return result;
 }
 
 
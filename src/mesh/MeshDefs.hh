@@ -60,6 +60,7 @@
 #include <vector>
 #include <string>
 #include <cstdint>
+#include <cstddef>
 
 namespace Jali {
 
@@ -72,6 +73,37 @@ typedef std::vector<Entity_ID> Entity_ID_List;
 typedef std::vector<Set_ID> Set_ID_List;
 typedef std::int8_t dir_t;
 
+// Lightweight read-only view of a contiguous range of entries (entity
+// IDs or directions) owned by someone else, typically the adjacency
+// information cached in the mesh. It does not allocate or copy and is
+// only valid as long as the underlying storage is not modified
+
+template <typename T>
+class List_view {
+ public:
+  typedef T value_type;
+  typedef T const * const_iterator;
+  typedef const_iterator iterator;
+
+  List_view() : begin_(nullptr), end_(nullptr) {}
+  List_view(T const * const begin, T const * const end) :
+      begin_(begin), end_(end) {}
+
+  const_iterator begin() const { return begin_; }
+  const_iterator end() const { return end_; }
+  std::size_t size() const { return end_ - begin_; }
+  bool empty() const { return begin_ == end_; }
+  T const & operator[](std::size_t i) const { return begin_[i]; }
+  T const * data() const { return begin_; }
+
+ private:
+  T const * begin_;
+  T const * end_;
+};
+
+typedef List_view<Entity_ID> Entity_ID_View;
+typedef List_view<dir_t> Dir_View;
+
 // Mesh Type
 
 enum class Mesh_type {
@@ -277,6 +309,40 @@ std::ostream& operator<<(std::ostream& os,
   return os;
 }
 
+// Types of renumbering of the mesh entities at construction. Cells
+// are ordered along a Morton (Z-order) or Hilbert space filling curve
+// through their centroids or by reverse Cuthill-McKee on the graph of
+// face connected cells; nodes, edges and faces are then numbered in
+// the order they are first reached from the cells
+
+enum class Renumbering_type : std::uint8_t {
+    NONE,
+    MORTON,
+    HILBERT,
+    RCM
+};
+constexpr int NUM_RENUMBERING_TYPES = 4;
+
+// Return an string description for each renumbering type
+inline
+std::string Renumbering_type_string(const Renumbering_type renumbering_type) {
+  static std::string renumbering_type_str[NUM_RENUMBERING_TYPES] =
+      {"Renumbering_type::NONE", "Renumbering_type::MORTON",
+       "Renumbering_type::HILBERT", "Renumbering_type::RCM"};
+
+  int irtype = static_cast<int>(renumbering_type);
+  return (irtype >= 0 && irtype < NUM_RENUMBERING_TYPES) ?
+      renumbering_type_str[irtype] : "";
+}
+
+// Output operator for Renumbering_type
+inline
+std::ostream& operator<<(std::ostream& os,
+                         const Renumbering_type& renumbering_type) {
+  os << " " << Renumbering_type_string(renumbering_type) << " ";
+  return os;
+}
+
 }  // close namespace Jali
 
 
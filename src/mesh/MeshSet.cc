@@ -539,6 +539,17 @@ complement(std::vector<std::shared_ptr<MeshSet>> inpsets, bool temporary) {
 }
 
 
+// Memory held by the set
+
+Memory_report MeshSet::memory_report() const {
+  Memory_report report;
+  report.add("entity_lists", entityids_owned_);
+  report.add("entity_lists", entityids_ghost_);
+  report.add("entity_lists", entityids_all_);
+  report.add("reverse_maps", mesh2subset_);
+  return report;
+}
+
 
 }  // end namespace Jali
 
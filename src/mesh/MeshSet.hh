@@ -58,6 +58,7 @@
 #include "mpi.h"
 
 #include "MeshDefs.hh"
+#include "memory_report.hh"
 
 namespace Jali {
 
@@ -242,6 +243,11 @@ class MeshSet {
 
   void rem_entities(std::vector<Entity_ID> const& entities);
 
+  /// @brief Memory held by the set - entity lists and the reverse
+  /// map from mesh entities to set entities
+
+  Memory_report memory_report() const;
+
   void clear() {
     entityids_owned_.clear();
     entityids_ghost_.clear();
@@ -53,10 +53,14 @@
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <mutex>
+#include <utility>
+#include <cassert>
 
 
 #include "MeshDefs.hh"
 #include "Mesh.hh"
+#include "thread_pool.hh"
 
 namespace Jali {
 
@@ -79,6 +83,29 @@ namespace Jali {
 */
 
 
+namespace {
+
+// Marks for the entities of one kind. There is one array per thread
+// so that tiles can be built concurrently and the marks are all clear
+// between uses (whoever sets marks clears them when done) so that a
+// tile pays only for the entities it touches and not for the size of
+// the mesh
+
+std::vector<char>& entity_marks(int const nents) {
+  static thread_local std::vector<char> marks;
+  if (static_cast<int>(marks.size()) < nents)
+    marks.resize(nents, 0);
+  return marks;
+}
+
+void clear_marks(Entity_ID_List const& entids, std::vector<char> *marks) {
+  for (auto const& ent : entids)
+    (*marks)[ent] = 0;
+}
+
+}  // end anonymous namespace
+
+
 // Constructor - should we make this private and only allow Mesh to
 // call it as a friend? MeshTile can send a reference to itself to the
 // parent_mesh so that it can be added to the list of tiles
@@ -89,178 +116,172 @@ MeshTile::MeshTile(Mesh& parent_mesh,
                    bool const request_faces, bool const request_edges,
                    bool const request_sides, bool const request_wedges,
                    bool const request_corners) :
+    MeshTile(parent_mesh, parent_mesh.tiles().size(), meshcells_owned,
+             num_halo_layers, request_faces, request_edges, request_sides,
+             request_wedges, request_corners) {}
+
+
+// Constructor for a tile with a given ID. The owned entities of the
+// tile are those of its owned cells that were not claimed by a tile
+// with a lower ID - either because that tile was built before this
+// one or because make_meshtiles settled it beforehand
+
+MeshTile::MeshTile(Mesh& parent_mesh, int const tileid,
+                   std::vector<Entity_ID> const& meshcells_owned,
+                   int const num_halo_layers,
+                   bool const request_faces, bool const request_edges,
+                   bool const request_sides, bool const request_wedges,
+                   bool const request_corners) :
     mesh_(parent_mesh),
-    mytileid_(parent_mesh.tiles().size()) {
+    mytileid_(tileid) {
 
   cellids_owned_ = meshcells_owned;
   cellids_all_ = meshcells_owned;
 
-  // Build up halos if requested
+  // Build up halos if requested. Every halo layer is made of the
+  // unmarked neighbors of the previous layer (the owned cells for the
+  // first layer), which are marked as they are added
 
   if (num_halo_layers > 0) {
+    std::vector<char>& cellmarks = entity_marks(mesh_.num_cells());
+    for (auto const& c : cellids_all_)
+      cellmarks[c] = 1;
 
-    // Make a list of halo/ghost cells
-
+    int layer_begin = 0;
     for (int i = 0; i < num_halo_layers; ++i) {
-      Entity_ID_List next_halo_layer;
-
-      for (auto const& c : cellids_all_) {
-        Entity_ID_List nbrs;
-        mesh_.cell_get_node_adj_cells(c, Entity_type::ALL, &nbrs);
-        
-        for (auto const& cnbr : nbrs) {
-          // Check if the neighbor is already in the all cells list or
-          // in this halo
-
-          if (std::find(next_halo_layer.begin(), next_halo_layer.end(), cnbr)
-              != next_halo_layer.end()) continue;
-          if (std::find(cellids_all_.begin(), cellids_all_.end(), cnbr) !=
-              cellids_all_.end()) continue;
-
-          // Add neighbor to the next halo layer
-          next_halo_layer.push_back(cnbr);
+      int layer_end = cellids_all_.size();
+      for (int j = layer_begin; j < layer_end; ++j) {
+        for (auto const& cnbr : mesh_.cell_node_adj_cells(cellids_all_[j])) {
+          if (cellmarks[cnbr]) continue;
+          cellmarks[cnbr] = 1;
+          cellids_all_.push_back(cnbr);
         }
       }
-
-      cellids_all_.insert(cellids_all_.end(),
-                          next_halo_layer.begin(), next_halo_layer.end());
-      cellids_ghost_.insert(cellids_ghost_.end(),
-                            next_halo_layer.begin(), next_halo_layer.end());
+      layer_begin = layer_end;
     }
+
+    cellids_ghost_.assign(cellids_all_.begin() + cellids_owned_.size(),
+                          cellids_all_.end());
+    clear_marks(cellids_all_, &cellmarks);
   }
 
 
   for (auto const& c : cellids_owned_)
     mesh_.set_master_tile_ID_of_cell(c, mytileid_);
 
-  // Make a list of nodeids in the tile
+  // Make a list of nodeids in the tile. A node of an owned cell not
+  // yet in any tile is owned by this tile. All other nodes (of owned
+  // or ghost cells) are ghosts
 
+  std::vector<char>& nodemarks = entity_marks(mesh_.num_nodes());
   for (auto const& c : cellids_owned_) {
-    std::vector<int> cnodes;
-    mesh_.cell_get_nodes(c, &cnodes);
-    for (auto const& n : cnodes) {
+    for (auto const& n : mesh_.cell_nodes(c)) {
+      if (nodemarks[n]) continue;
+      nodemarks[n] = 1;
+
       int tileid = mesh_.master_tile_ID_of_node(n);
       if (tileid == -1) {
-        // Node not yet in any tile - so this tile owns it
-        nodeids_owned_.emplace_back(n);
+        tileid = mytileid_;
         mesh_.set_master_tile_ID_of_node(n, mytileid_);
-      } else {
-        // If node is owned by another tile put it in the ghost list
-        if (tileid != mytileid_ &&
-            std::find(nodeids_ghost_.begin(), nodeids_ghost_.end(), n) ==
-            nodeids_ghost_.end())
-          nodeids_ghost_.emplace_back(n);
       }
+      if (tileid == mytileid_)
+        nodeids_owned_.emplace_back(n);
+      else
+        nodeids_ghost_.emplace_back(n);
     }
   }
 
   for (auto const& c : cellids_ghost_) {
-    std::vector<int> cnodes;
-    mesh_.cell_get_nodes(c, &cnodes);
-    for (auto const& n : cnodes) {
-      int tileid = mesh_.master_tile_ID_of_node(n);  // may be -1 (unassigned)
-      if (tileid != mytileid_ &&
-          std::find(nodeids_ghost_.begin(), nodeids_ghost_.end(), n) ==
-          nodeids_ghost_.end())
-        nodeids_ghost_.emplace_back(n);
+    for (auto const& n : mesh_.cell_nodes(c)) {
+      if (nodemarks[n]) continue;
+      nodemarks[n] = 1;
+      nodeids_ghost_.emplace_back(n);
     }
   }
 
   nodeids_all_ = nodeids_owned_;
   nodeids_all_.insert(nodeids_all_.end(),
                       nodeids_ghost_.begin(), nodeids_ghost_.end());
+  clear_marks(nodeids_all_, &nodemarks);
 
   // Make a list of faces similarly if requested
 
   if (request_faces) {
-
+    std::vector<char>& facemarks = entity_marks(mesh_.num_faces());
     for (auto const& c : cellids_owned_) {
-      std::vector<int> cfaces;
-      mesh_.cell_get_faces(c, &cfaces);
-      for (auto const& f : cfaces) {
+      for (auto const& f : mesh_.cell_faces(c)) {
+        if (facemarks[f]) continue;
+        facemarks[f] = 1;
+
         int tileid = mesh_.master_tile_ID_of_face(f);
         if (tileid == -1) {
-          // face not yet in any tile - so this tile owns it
-          faceids_owned_.emplace_back(f);
+          tileid = mytileid_;
           mesh_.set_master_tile_ID_of_face(f, mytileid_);
-        } else {
-          // If face is owned by another tile put it in the ghost list
-          if (tileid != mytileid_ &&
-              std::find(faceids_ghost_.begin(), faceids_ghost_.end(), f) ==
-              faceids_ghost_.end())
-            faceids_ghost_.emplace_back(f);
         }
+        if (tileid == mytileid_)
+          faceids_owned_.emplace_back(f);
+        else
+          faceids_ghost_.emplace_back(f);
       }
     }
 
     for (auto const& c : cellids_ghost_) {
-      std::vector<int> cfaces;
-      mesh_.cell_get_faces(c, &cfaces);
-      for (auto const& f : cfaces) {
-        int tileid = mesh_.master_tile_ID_of_face(f);  // may be -1 (unassigned)
-        if (tileid != mytileid_ &&
-            std::find(faceids_ghost_.begin(), faceids_ghost_.end(), f) ==
-            faceids_ghost_.end())
-          faceids_ghost_.emplace_back(f);
+      for (auto const& f : mesh_.cell_faces(c)) {
+        if (facemarks[f]) continue;
+        facemarks[f] = 1;
+        faceids_ghost_.emplace_back(f);
       }
     }
 
     faceids_all_ = faceids_owned_;
     faceids_all_.insert(faceids_all_.end(),
                         faceids_ghost_.begin(), faceids_ghost_.end());
+    clear_marks(faceids_all_, &facemarks);
   }
 
   // Make a list of edges similarly if requested
 
   if (request_edges) {
+    std::vector<char>& edgemarks = entity_marks(mesh_.num_edges());
     for (auto const& c : cellids_owned_) {
-      std::vector<int> cedges;
-      mesh_.cell_get_edges(c, &cedges);
-      for (auto const& e : cedges) {
+      for (auto const& e : mesh_.cell_edges(c)) {
+        if (edgemarks[e]) continue;
+        edgemarks[e] = 1;
+
         int etileid = mesh_.master_tile_ID_of_edge(e);
         if (etileid == -1) {
-          // Edge not yet in any tile - so this tile owns it
-          edgeids_owned_.emplace_back(e);
+          etileid = mytileid_;
           mesh_.set_master_tile_ID_of_edge(e, mytileid_);
-        } else {
-          // If edge is owned by another tile put it in the ghost list
-          if (etileid != mytileid_ &&
-              std::find(edgeids_ghost_.begin(), edgeids_ghost_.end(), e) ==
-              edgeids_ghost_.end())
-            edgeids_ghost_.emplace_back(e);
         }
+        if (etileid == mytileid_)
+          edgeids_owned_.emplace_back(e);
+        else
+          edgeids_ghost_.emplace_back(e);
       }
     }
 
     for (auto const& c : cellids_ghost_) {
-      std::vector<int> cedges;
-      mesh_.cell_get_edges(c, &cedges);
-      for (auto const& e : cedges) {
-        int tileid = mesh_.master_tile_ID_of_edge(e);  // may be -1 (unassigned)
-        if (tileid != mytileid_ &&
-            std::find(edgeids_ghost_.begin(), edgeids_ghost_.end(), e) ==
-            edgeids_ghost_.end())
-          edgeids_ghost_.emplace_back(e);
+      for (auto const& e : mesh_.cell_edges(c)) {
+        if (edgemarks[e]) continue;
+        edgemarks[e] = 1;
+        edgeids_ghost_.emplace_back(e);
       }
     }
 
     edgeids_all_ = edgeids_owned_;
     edgeids_all_.insert(edgeids_all_.end(),
                         edgeids_ghost_.begin(), edgeids_ghost_.end());
+    clear_marks(edgeids_all_, &edgemarks);
   }
 
   if (request_wedges) {
     for (auto const& c : cellids_owned_) {
-      std::vector<int> csides;
-      mesh_.cell_get_sides(c, &csides);
-      for (auto const& s : csides)
+      for (auto const& s : mesh_.cell_sides(c))
         sideids_owned_.emplace_back(s);
     }
 
     for (auto const& c : cellids_ghost_) {
-      std::vector<int> csides;
-      mesh_.cell_get_sides(c, &csides);
-      for (auto const& s : csides)
+      for (auto const& s : mesh_.cell_sides(c))
         sideids_ghost_.emplace_back(s);
     }
 
@@ -291,16 +312,12 @@ MeshTile::MeshTile(Mesh& parent_mesh,
 
   if (request_corners) {
     for (auto const& c : cellids_owned_) {
-      std::vector<int> ccorners;
-      mesh_.cell_get_corners(c, &ccorners);
-      for (auto const& cn : ccorners)
+      for (auto const& cn : mesh_.cell_corners(c))
         cornerids_owned_.emplace_back(cn);
     }
 
     for (auto const& c : cellids_ghost_) {
-      std::vector<int> ccorners;
-      mesh_.cell_get_corners(c, &ccorners);
-      for (auto const& cn : ccorners)
+      for (auto const& cn : mesh_.cell_corners(c))
         cornerids_ghost_.emplace_back(cn);
     }
 
@@ -346,6 +363,62 @@ std::shared_ptr<MeshTile> make_meshtile(Mesh& parent_mesh,
 }
 
 
+// Standalone function to make several tiles at once. The result is
+// the same as calling make_meshtile for each list of cells in turn but
+// the tiles are built concurrently
+
+std::vector<std::shared_ptr<MeshTile>>
+make_meshtiles(Mesh& parent_mesh,
+               std::vector<std::vector<Entity_ID>> const& cells,
+               int const num_halo_layers,
+               bool const request_faces,
+               bool const request_edges,
+               bool const request_sides,
+               bool const request_wedges,
+               bool const request_corners) {
+  if (parent_mesh.num_tiles() == 0)
+    parent_mesh.init_tiles();
+
+  int const ntiles = cells.size();
+  int const first_tileid = parent_mesh.num_tiles();
+
+  // Settle the master tile of every node, face and edge of the owned
+  // cells as building the tiles one after the other would - it is the
+  // first tile with the entity in one of its owned cells - so that the
+  // tiles only read the master tile IDs of each other's entities
+
+  for (int t = 0; t < ntiles; t++) {
+    int const tileid = first_tileid + t;
+    for (auto const& c : cells[t]) {
+      for (auto const& n : parent_mesh.cell_nodes(c))
+        if (parent_mesh.master_tile_ID_of_node(n) == -1)
+          parent_mesh.set_master_tile_ID_of_node(n, tileid);
+      if (request_faces)
+        for (auto const& f : parent_mesh.cell_faces(c))
+          if (parent_mesh.master_tile_ID_of_face(f) == -1)
+            parent_mesh.set_master_tile_ID_of_face(f, tileid);
+      if (request_edges)
+        for (auto const& e : parent_mesh.cell_edges(c))
+          if (parent_mesh.master_tile_ID_of_edge(e) == -1)
+            parent_mesh.set_master_tile_ID_of_edge(e, tileid);
+    }
+  }
+
+  std::vector<std::shared_ptr<MeshTile>> tiles(ntiles);
+  Thread_pool::instance().run(ntiles, [&](int const t) {
+      tiles[t] = std::make_shared<MeshTile>(parent_mesh, first_tileid + t,
+                                            cells[t], num_halo_layers,
+                                            request_faces, request_edges,
+                                            request_sides, request_wedges,
+                                            request_corners);
+    });
+
+  for (auto const& tile : tiles)
+    parent_mesh.add_tile(tile);
+  return tiles;
+}
+
+
 //! Get list of tile entities of type 'kind' and 'type' in set ('setname')
 
 void MeshTile::get_set_entities(const Set_Name setname, const Entity_kind kind,
@@ -547,7 +620,121 @@ void MeshTile::get_cells_of_set(const Set_Name setname, const Entity_type type,
       entids->push_back(ent);
   }
 }
- 
+
+
+// Memory held by the tile
+
+// List of entities of a kind and parallel type
+
+std::vector<Entity_ID> const & MeshTile::entities(Entity_kind const kind,
+                                                  Entity_type const ptype)
+    const {
+  switch (kind) {
+    case Entity_kind::NODE:
+      switch (ptype) {
+        case Entity_type::PARALLEL_OWNED: return nodeids_owned_;
+        case Entity_type::PARALLEL_GHOST: return nodeids_ghost_;
+        case Entity_type::ALL: return nodeids_all_;
+        default: return dummy_list_;
+      }
+    case Entity_kind::EDGE:
+      switch (ptype) {
+        case Entity_type::PARALLEL_OWNED: return edgeids_owned_;
+        case Entity_type::PARALLEL_GHOST: return edgeids_ghost_;
+        case Entity_type::ALL: return edgeids_all_;
+        default: return dummy_list_;
+      }
+    case Entity_kind::FACE:
+      switch (ptype) {
+        case Entity_type::PARALLEL_OWNED: return faceids_owned_;
+        case Entity_type::PARALLEL_GHOST: return faceids_ghost_;
+        case Entity_type::ALL: return faceids_all_;
+        default: return dummy_list_;
+      }
+    case Entity_kind::SIDE:
+      switch (ptype) {
+        case Entity_type::PARALLEL_OWNED: return sideids_owned_;
+        case Entity_type::PARALLEL_GHOST: return sideids_ghost_;
+        case Entity_type::ALL: return sideids_all_;
+        default: return dummy_list_;
+      }
+    case Entity_kind::WEDGE:
+      switch (ptype) {
+        case Entity_type::PARALLEL_OWNED: return wedgeids_owned_;
+        case Entity_type::PARALLEL_GHOST: return wedgeids_ghost_;
+        case Entity_type::ALL: return wedgeids_all_;
+        default: return dummy_list_;
+      }
+    case Entity_kind::CORNER:
+      switch (ptype) {
+        case Entity_type::PARALLEL_OWNED: return cornerids_owned_;
+        case Entity_type::PARALLEL_GHOST: return cornerids_ghost_;
+        case Entity_type::ALL: return cornerids_all_;
+        default: return dummy_list_;
+      }
+    case Entity_kind::CELL:
+      switch (ptype) {
+        case Entity_type::PARALLEL_OWNED: return cellids_owned_;
+        case Entity_type::PARALLEL_GHOST: return cellids_ghost_;
+        case Entity_type::ALL: return cellids_all_;
+        default: return dummy_list_;
+      }
+    default:
+      return dummy_list_;
+  }
+}
+
+
+// Tile-local ID of an entity from its mesh ID by a binary search of
+// the mesh IDs of the tile's entities of that kind, sorted on first
+// use
+
+Entity_ID MeshTile::global_to_local(Entity_kind const kind,
+                                    Entity_ID const globalid) const {
+  int const k = static_cast<int>(kind);
+  assert(k >= 0 && k < NUM_ENTITY_KINDS);
+
+  std::call_once(sorted_ids_made_[k], [this, kind, k]() {
+      Entity_ID_List const& ids = entities(kind, Entity_type::ALL);
+      int nids = ids.size();
+      std::vector<std::pair<Entity_ID, Entity_ID>> pairs(nids);
+      for (int i = 0; i < nids; i++)
+        pairs[i] = {ids[i], i};
+      std::sort(pairs.begin(), pairs.end());
+
+      sorted_ids_[k].resize(nids);
+      sorted_local_ids_[k].resize(nids);
+      for (int i = 0; i < nids; i++) {
+        sorted_ids_[k][i] = pairs[i].first;
+        sorted_local_ids_[k][i] = pairs[i].second;
+      }
+    });
+
+  Entity_ID_List const& sorted = sorted_ids_[k];
+  auto it = std::lower_bound(sorted.begin(), sorted.end(), globalid);
+  if (it == sorted.end() || *it != globalid)
+    return -1;
+  return sorted_local_ids_[k][it - sorted.begin()];
+}
+
+
+Memory_report MeshTile::memory_report() const {
+  Memory_report report;
+  for (auto const *list : {&nodeids_owned_, &nodeids_ghost_, &nodeids_all_,
+          &edgeids_owned_, &edgeids_ghost_, &edgeids_all_,
+          &faceids_owned_, &faceids_ghost_, &faceids_all_,
+          &sideids_owned_, &sideids_ghost_, &sideids_all_,
+          &wedgeids_owned_, &wedgeids_ghost_, &wedgeids_all_,
+          &cornerids_owned_, &cornerids_ghost_, &cornerids_all_,
+          &cellids_owned_, &cellids_ghost_, &cellids_all_})
+    report.add("entity_lists", *list);
+  for (int k = 0; k < NUM_ENTITY_KINDS; k++) {
+    report.add("local_numbering", sorted_ids_[k]);
+    report.add("local_numbering", sorted_local_ids_[k]);
+  }
+  return report;
+}
+
 
 }  // end namespace Jali
 
@@ -54,10 +54,12 @@
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <mutex>
 
 #include "mpi.h"
 
 #include "MeshDefs.hh"
+#include "memory_report.hh"
 
 namespace Jali {
 
@@ -121,6 +123,22 @@ class MeshTile {
            bool const request_wedges = false,
            bool const request_corners = false);
 
+  /// @brief Constructor for a tile with a given ID
+  //
+  // The ID must be the position the tile will have in the list of
+  // tiles of the mesh. This lets make_meshtiles build several tiles
+  // before any of them is added to the mesh
+
+  MeshTile(Mesh& parent_mesh,
+           int const tileid,
+           std::vector<Entity_ID> const& meshcells_owned,
+           int const num_halo_layers = 0,
+           bool const request_faces = true,
+           bool const request_edges = false,
+           bool const request_sides = false,
+           bool const request_wedges = false,
+           bool const request_corners = false);
+
 
   /// @brief Copy Constructor - deleted
 
@@ -286,6 +304,44 @@ class MeshTile {
   template<Entity_type ptype = Entity_type::ALL> std::vector<Entity_ID>
   const & cells() const;
 
+  /*!
+    @brief List of entities of a kind and parallel type
+    @param kind   Entity_kind of the entities (CELL, NODE, WEDGE etc)
+    @param ptype  Parallel type (Entity_type::PARALLEL_OWNED,
+                                 Entity_type::PARALLEL_GHOST,
+                                 Entity_type::ALL)
+  */
+  std::vector<Entity_ID> const & entities(Entity_kind kind,
+                                          Entity_type ptype) const;
+
+
+  //
+  // Tile-local numbering
+  // --------------------
+  //
+  // The tile-local ID of an entity is its position in the list of ALL
+  // entities of its kind in the tile. So the owned entities are
+  // numbered from 0 to num_entities(kind, PARALLEL_OWNED)-1 and the
+  // halo entities come after them
+  //
+
+  //! Mesh ID of the entity with a tile-local ID
+
+  Entity_ID local_to_global(Entity_kind kind, Entity_ID localid) const {
+    return entities(kind, Entity_type::ALL)[localid];
+  }
+
+  //! Tile-local ID of the entity with a mesh ID or -1 if the entity
+  //! is not in the tile. The map for a kind of entity is made on
+  //! first use
+
+  Entity_ID global_to_local(Entity_kind kind, Entity_ID globalid) const;
+
+
+  //! Memory held by the tile (its entity lists)
+
+  Memory_report memory_report() const;
+
 
   //! Get list of tile entities of type 'kind' and 'ptype' in set ('setname')
 
@@ -326,6 +382,13 @@ class MeshTile {
   Entity_ID_List cellids_owned_, cellids_ghost_, cellids_all_;
   Entity_ID_List dummy_list_;
 
+  // Mesh IDs of the entities of each kind in increasing order and
+  // their tile-local IDs (made on first use by global_to_local)
+
+  mutable Entity_ID_List sorted_ids_[NUM_ENTITY_KINDS];
+  mutable Entity_ID_List sorted_local_ids_[NUM_ENTITY_KINDS];
+  mutable std::once_flag sorted_ids_made_[NUM_ENTITY_KINDS];
+
   
 
   // Make the State class a friend so that it can access protected
@@ -755,6 +818,23 @@ std::shared_ptr<MeshTile> make_meshtile(Mesh& parent_mesh,
                                         bool const request_wedges,
                                         bool const request_corners);
 
+// @brief Factory for several mesh tiles
+//
+// Makes a tile for each list of cells. The tiles are the same as
+// those made by calling make_meshtile for each list in order (same
+// IDs, same owned and ghost entities) but they are built concurrently
+// and in time proportional to the number of entities they contain
+
+std::vector<std::shared_ptr<MeshTile>>
+make_meshtiles(Mesh& parent_mesh,
+               std::vector<std::vector<Entity_ID>> const& cells,
+               int const num_halo_layers,
+               bool const request_faces,
+               bool const request_edges,
+               bool const request_sides,
+               bool const request_wedges,
+               bool const request_corners);
+
 
 }  // end namespace Jali
 
@@ -0,0 +1,186 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _JALI_MESHVIEW_H_
+#define _JALI_MESHVIEW_H_
+
+#include <type_traits>
+
+#include "MeshDefs.hh"
+#include "Point.hh"
+
+namespace Jali {
+
+/*!
+  @class MeshView "MeshView.hh"
+  @brief Flat, read-only view of the cached info of a mesh
+
+  A MeshView is a bundle of raw pointers to (and sizes of) the tables
+  a Mesh caches - the cell to node, face to node, cell to face and
+  face to cell adjacencies in CSR form, the node coordinates, the
+  cell types and the cell and face geometry - with inline accessors
+  named like the corresponding Mesh queries. It is obtained with
+  Mesh::view() and is trivially copyable, so compute kernels can take
+  it by value and query the mesh without virtual calls, locking or
+  shared_ptr traffic.
+
+  The view does not own anything. It is valid as long as the mesh it
+  was obtained from exists; moving nodes and updating the geometric
+  quantities change the values it sees but not its pointers. The
+  owned entities of each kind are numbered before the ghost
+  entities. The face tables are null if the mesh has no faces.
+*/
+
+struct MeshView {
+  int manifold_dim, space_dim;
+
+  //! Number of entities (owned and ghost) and of owned entities
+  int num_nodes, num_faces, num_cells;
+  int num_nodes_owned, num_faces_owned, num_cells_owned;
+
+  //! Coordinate d of node n is node_coords[d][n]
+  double const *node_coords[3];
+
+  //! Adjacencies - the entities adjacent to entity i are
+  //! xxx_ids[xxx_offsets[i]] ... xxx_ids[xxx_offsets[i+1]-1]. Face
+  //! f has cells face_cell_ids[2*f] and face_cell_ids[2*f+1], padded
+  //! with -1
+  int const *cell_node_offsets;
+  Entity_ID const *cell_node_ids;
+  int const *face_node_offsets;
+  Entity_ID const *face_node_ids;
+  int const *cell_face_offsets;
+  Entity_ID const *cell_face_ids;
+  dir_t const *cell_face_dirs_;
+  Entity_ID const *face_cell_ids;
+
+  //! Cell types (TRI, QUAD, HEX, ...)
+  Cell_type const *cell_types;
+
+  //! Geometric quantities - face_normal0s[f] is the normal of f
+  //! pointing out of the cell using it in the +ve direction and
+  //! face_normal1s[f] of the cell using it in the -ve direction
+  //! (zero if there is no such cell)
+  double const *cell_volumes;
+  JaliGeometry::Point const *cell_centroids;
+  double const *face_areas;
+  JaliGeometry::Point const *face_centroids;
+  JaliGeometry::Point const *face_normal0s;
+  JaliGeometry::Point const *face_normal1s;
+
+
+  //! Nodes of a cell (see Mesh::cell_get_nodes)
+  Entity_ID_View cell_nodes(Entity_ID const c) const {
+    return Entity_ID_View(cell_node_ids + cell_node_offsets[c],
+                          cell_node_ids + cell_node_offsets[c+1]);
+  }
+
+  //! Nodes of a face in the order consistent with the face normal
+  Entity_ID_View face_nodes(Entity_ID const f) const {
+    return Entity_ID_View(face_node_ids + face_node_offsets[f],
+                          face_node_ids + face_node_offsets[f+1]);
+  }
+
+  //! Faces of a cell
+  Entity_ID_View cell_faces(Entity_ID const c) const {
+    return Entity_ID_View(cell_face_ids + cell_face_offsets[c],
+                          cell_face_ids + cell_face_offsets[c+1]);
+  }
+
+  //! Directions in which a cell uses its faces
+  Dir_View cell_face_dirs(Entity_ID const c) const {
+    return Dir_View(cell_face_dirs_ + cell_face_offsets[c],
+                    cell_face_dirs_ + cell_face_offsets[c+1]);
+  }
+
+  //! Cells of a face (one or two)
+  Entity_ID_View face_cells(Entity_ID const f) const {
+    Entity_ID const * const fcells = face_cell_ids + 2*f;
+    int nfcells = (fcells[0] == -1) ? 0 : ((fcells[1] == -1) ? 1 : 2);
+    return Entity_ID_View(fcells, fcells + nfcells);
+  }
+
+  //! Coordinate d of a node
+  double node_coordinate(Entity_ID const n, int const d) const {
+    return node_coords[d][n];
+  }
+
+  //! Coordinates of a node (space_dim values)
+  void node_get_coordinates(Entity_ID const n, double *xyz) const {
+    for (int d = 0; d < space_dim; d++)
+      xyz[d] = node_coords[d][n];
+  }
+
+  //! Type of a cell
+  Cell_type cell_get_type(Entity_ID const c) const { return cell_types[c]; }
+
+  double cell_volume(Entity_ID const c) const { return cell_volumes[c]; }
+
+  JaliGeometry::Point const& cell_centroid(Entity_ID const c) const {
+    return cell_centroids[c];
+  }
+
+  double face_area(Entity_ID const f) const { return face_areas[f]; }
+
+  JaliGeometry::Point const& face_centroid(Entity_ID const f) const {
+    return face_centroids[f];
+  }
+
+  //! Natural normal of a face (see Mesh::face_normal)
+  JaliGeometry::Point face_normal(Entity_ID const f) const {
+    return (L22(face_normal0s[f]) != 0.0) ? face_normal0s[f] :
+        -face_normal1s[f];
+  }
+};
+
+static_assert(std::is_trivially_copyable<MeshView>::value,
+              "MeshView must be trivially copyable");
+
+}  // end namespace Jali
+
+#endif  // _JALI_MESHVIEW_H_
@@ -0,0 +1,554 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "batch_geometry.hh"
+
+#include <cmath>
+#include <algorithm>
+
+namespace Jali {
+
+namespace {
+
+int const B = geometry_batch_size;
+
+// Gather the coordinates of node k (of np per entity) of the entities
+// of a block into p[d][l]
+
+inline
+void gather_node(int const nb, int const dim, Entity_ID const *nodes,
+                 int const stride, int const k, double const * const *xyz,
+                 double (*p)[B]) {
+  for (int d = 0; d < dim; d++)
+    for (int l = 0; l < nb; l++)
+      p[d][l] = xyz[d][nodes[l*stride+k]];
+}
+
+// Gather the components of a list of points given per entity by id
+
+inline
+void gather_points(int const nb, int const dim, Entity_ID const *ids,
+                   int const stride, JaliGeometry::Point const *pts,
+                   double (*p)[B]) {
+  for (int d = 0; d < dim; d++)
+    for (int l = 0; l < nb; l++)
+      p[d][l] = pts[ids[l*stride]][d];
+}
+
+// Add six times the volume of the tet (c, p0, p1, q) and six times its
+// volume weighted centroid to v6 and mom; flag inverted tets
+
+inline
+void add_tet_moments(int const nb, double const (*c)[B],
+                     double const (*p0)[B], double const (*p1)[B],
+                     double const (*q)[B], double *v6, double (*mom)[B],
+                     int *neg) {
+  for (int l = 0; l < nb; l++) {
+    double ax = p0[0][l]-c[0][l], ay = p0[1][l]-c[1][l],
+        az = p0[2][l]-c[2][l];
+    double bx = p1[0][l]-c[0][l], by = p1[1][l]-c[1][l],
+        bz = p1[2][l]-c[2][l];
+    double qx = q[0][l]-c[0][l], qy = q[1][l]-c[1][l], qz = q[2][l]-c[2][l];
+
+    double tvol = (ay*bz - az*by)*qx + (az*bx - ax*bz)*qy +
+        (ax*by - ay*bx)*qz;
+    neg[l] |= (tvol <= 0.0);
+
+    v6[l] += tvol;
+    for (int d = 0; d < 3; d++)
+      mom[d][l] += tvol*((c[d][l]+q[d][l]+p0[d][l]+p1[d][l])/4.0);
+  }
+}
+
+// Volume and centroid of cells with NN nodes, NQ quadrilateral faces
+// and NT triangular faces by summing the moments of the tets formed by
+// the cell center, the face centers and the face edges
+
+template<int NN, int NQ, int NT>
+void polyhed_vol_centroid_batch(int const n, Entity_ID const *cellids,
+                                Entity_ID const *cnodes,
+                                Entity_ID const *cfnodes,
+                                double const * const *xyz,
+                                double *volumes,
+                                JaliGeometry::Point *centroids) {
+  int const nfn = 4*NQ + 3*NT;
+  double c[3][B], p[4][3][B], fc[3][B], v6[B], mom[3][B];
+  int neg[B];
+
+  for (int b = 0; b < n; b += B) {
+    int const nb = std::min(B, n-b);
+    Entity_ID const *cn = cnodes + b*NN;
+    Entity_ID const *fn = cfnodes + b*nfn;
+
+    // cell center - the mean of the nodes
+
+    for (int d = 0; d < 3; d++)
+      for (int l = 0; l < nb; l++)
+        c[d][l] = 0.0;
+    for (int k = 0; k < NN; k++) {
+      gather_node(nb, 3, cn, NN, k, xyz, p[0]);
+      for (int d = 0; d < 3; d++)
+        for (int l = 0; l < nb; l++)
+          c[d][l] += p[0][d][l];
+    }
+    for (int d = 0; d < 3; d++)
+      for (int l = 0; l < nb; l++)
+        c[d][l] /= NN;
+
+    for (int l = 0; l < nb; l++) {
+      v6[l] = 0.0;
+      mom[0][l] = mom[1][l] = mom[2][l] = 0.0;
+      neg[l] = 0;
+    }
+
+    // quadrilateral faces - four tets formed with the face center
+
+    for (int f = 0; f < NQ; f++) {
+      for (int j = 0; j < 4; j++)
+        gather_node(nb, 3, fn, nfn, 4*f+j, xyz, p[j]);
+      for (int d = 0; d < 3; d++)
+        for (int l = 0; l < nb; l++)
+          fc[d][l] = (p[0][d][l]+p[1][d][l]+p[2][d][l]+p[3][d][l])/4;
+      for (int j = 0; j < 4; j++)
+        add_tet_moments(nb, c, p[j], p[(j+1)%4], fc, v6, mom, neg);
+    }
+
+    // triangular faces - one tet
+
+    for (int f = 0; f < NT; f++) {
+      for (int j = 0; j < 3; j++)
+        gather_node(nb, 3, fn, nfn, 4*NQ+3*f+j, xyz, p[j]);
+      add_tet_moments(nb, c, p[0], p[1], p[2], v6, mom, neg);
+    }
+
+    for (int l = 0; l < nb; l++) {
+      double vol = v6[l]/6;
+      if (neg[l] && vol > 0.0) vol = -vol;
+
+      Entity_ID const cellid = cellids[b+l];
+      volumes[cellid] = vol;
+      centroids[cellid].set(mom[0][l]/v6[l], mom[1][l]/v6[l],
+                            mom[2][l]/v6[l]);
+    }
+  }
+}
+
+// Tets are computed directly from their nodes, as by the scalar tet
+// kernel and the general polyhedron routine. The signed volume is
+// the inverted cell flag - it is negative for an inverted tet, which
+// every tet of a face decomposition would flag as well
+
+void tet_vol_centroid_batch(int const n, Entity_ID const *cellids,
+                            Entity_ID const *cnodes,
+                            Entity_ID const *,
+                            double const * const *xyz,
+                            double *volumes,
+                            JaliGeometry::Point *centroids) {
+  double p[4][3][B], vol[B];
+
+  for (int b = 0; b < n; b += B) {
+    int const nb = std::min(B, n-b);
+    for (int k = 0; k < 4; k++)
+      gather_node(nb, 3, cnodes + b*4, 4, k, xyz, p[k]);
+
+    for (int l = 0; l < nb; l++) {
+      double ax = p[1][0][l]-p[0][0][l], ay = p[1][1][l]-p[0][1][l],
+          az = p[1][2][l]-p[0][2][l];
+      double bx = p[2][0][l]-p[0][0][l], by = p[2][1][l]-p[0][1][l],
+          bz = p[2][2][l]-p[0][2][l];
+      double qx = p[3][0][l]-p[0][0][l], qy = p[3][1][l]-p[0][1][l],
+          qz = p[3][2][l]-p[0][2][l];
+      vol[l] = ((ay*bz - az*by)*qx + (az*bx - ax*bz)*qy +
+                (ax*by - ay*bx)*qz)/6;
+    }
+
+    for (int l = 0; l < nb; l++) {
+      Entity_ID const cellid = cellids[b+l];
+      volumes[cellid] = vol[l];
+      centroids[cellid].set(
+          (p[0][0][l]+p[1][0][l]+p[2][0][l]+p[3][0][l])/4.0,
+          (p[0][1][l]+p[1][1][l]+p[2][1][l]+p[3][1][l])/4.0,
+          (p[0][2][l]+p[1][2][l]+p[2][2][l]+p[3][2][l])/4.0);
+    }
+  }
+}
+
+// 2D triangles - the area is from the cross product at one corner
+
+void tri_area_centroid_batch(int const n, Entity_ID const *cellids,
+                             Entity_ID const *cnodes,
+                             Entity_ID const *,
+                             double const * const *xyz,
+                             double *volumes,
+                             JaliGeometry::Point *centroids) {
+  double p[3][2][B];
+
+  for (int b = 0; b < n; b += B) {
+    int const nb = std::min(B, n-b);
+    for (int k = 0; k < 3; k++)
+      gather_node(nb, 2, cnodes + b*3, 3, k, xyz, p[k]);
+
+    for (int l = 0; l < nb; l++) {
+      double v1x = p[2][0][l]-p[1][0][l], v1y = p[2][1][l]-p[1][1][l];
+      double v2x = p[0][0][l]-p[1][0][l], v2y = p[0][1][l]-p[1][1][l];
+
+      Entity_ID const cellid = cellids[b+l];
+      volumes[cellid] = std::fabs(0.5*(v1x*v2y - v2x*v1y));
+      centroids[cellid].set((p[0][0][l]+p[1][0][l]+p[2][0][l])/3,
+                            (p[0][1][l]+p[1][1][l]+p[2][1][l])/3);
+    }
+  }
+}
+
+// 2D quadrilaterals - sum of the moments of the triangles formed by
+// the center and the edges. An inverted triangle makes the area
+// negative
+
+void quad_area_centroid_batch(int const n, Entity_ID const *cellids,
+                              Entity_ID const *cnodes,
+                              Entity_ID const *,
+                              double const * const *xyz,
+                              double *volumes,
+                              JaliGeometry::Point *centroids) {
+  double p[4][2][B], c[2][B], area[B], mom[2][B];
+  int neg[B];
+
+  for (int b = 0; b < n; b += B) {
+    int const nb = std::min(B, n-b);
+    for (int k = 0; k < 4; k++)
+      gather_node(nb, 2, cnodes + b*4, 4, k, xyz, p[k]);
+
+    for (int l = 0; l < nb; l++) {
+      c[0][l] = (p[0][0][l]+p[1][0][l]+p[2][0][l]+p[3][0][l])/4;
+      c[1][l] = (p[0][1][l]+p[1][1][l]+p[2][1][l]+p[3][1][l])/4;
+      area[l] = mom[0][l] = mom[1][l] = 0.0;
+      neg[l] = 0;
+    }
+
+    for (int i = 0; i < 4; i++) {
+      double const (*p0)[B] = p[i];
+      double const (*p1)[B] = p[(i+1)%4];
+      for (int l = 0; l < nb; l++) {
+        double v1x = p0[0][l]-c[0][l], v1y = p0[1][l]-c[1][l];
+        double v2x = p1[0][l]-c[0][l], v2y = p1[1][l]-c[1][l];
+        double tarea = 0.5*(v1x*v2y - v2x*v1y);
+        neg[l] |= (tarea <= 0.0);
+        tarea = std::fabs(tarea);
+
+        area[l] += tarea;
+        for (int d = 0; d < 2; d++)
+          mom[d][l] += tarea*(p0[d][l]+p1[d][l]+c[d][l])/3.0;
+      }
+    }
+
+    for (int l = 0; l < nb; l++) {
+      double a = area[l];
+      if (neg[l] && a > 0.0) a = -a;
+
+      Entity_ID const cellid = cellids[b+l];
+      volumes[cellid] = a;
+      centroids[cellid].set(mom[0][l]/area[l], mom[1][l]/area[l]);
+    }
+  }
+}
+
+}  // anonymous namespace
+
+
+// Dispatch table of the batched cell kernels (indexed by Cell_type)
+
+Cell_batch_kernel const * cell_batch_kernel(Cell_type const type,
+                                            int const manifold_dim,
+                                            int const space_dim) {
+  static Cell_batch_kernel const table[] = {
+    {0, 0, 0, nullptr},                                     // UNKNOWN
+    {3, 0, 0, tri_area_centroid_batch},
+    {4, 0, 0, quad_area_centroid_batch},
+    {0, 0, 0, nullptr},                                     // POLYGON
+    {4, 0, 4, tet_vol_centroid_batch},
+    {6, 3, 2, polyhed_vol_centroid_batch<6, 3, 2>},         // PRISM
+    {5, 1, 4, polyhed_vol_centroid_batch<5, 1, 4>},         // PYRAMID
+    {8, 6, 0, polyhed_vol_centroid_batch<8, 6, 0>},         // HEX
+    {0, 0, 0, nullptr}                                      // POLYHED
+  };
+
+  if (!cell_valid_type(type) || manifold_dim != space_dim)
+    return nullptr;
+  int const type_dim = (type >= Cell_type::TET) ? 3 : 2;
+  if (type_dim != manifold_dim)
+    return nullptr;
+
+  Cell_batch_kernel const *kernel = &(table[static_cast<int>(type)]);
+  return kernel->vol_centroid ? kernel : nullptr;
+}
+
+
+void face_area_centroid_normal_batch(int const np, int const n,
+                                     Entity_ID const *faceids,
+                                     Entity_ID const *fnodes,
+                                     double const * const *xyz,
+                                     double *areas,
+                                     JaliGeometry::Point *centroids,
+                                     JaliGeometry::Point *normals) {
+  double p[4][3][B], c[3][B], area[B], nrm[3][B], mom[3][B];
+
+  for (int b = 0; b < n; b += B) {
+    int const nb = std::min(B, n-b);
+    for (int k = 0; k < np; k++)
+      gather_node(nb, 3, fnodes + b*np, np, k, xyz, p[k]);
+
+    if (np == 3) {
+      // triangle - the normal is evaluated at one corner
+
+      for (int l = 0; l < nb; l++) {
+        double v1x = p[2][0][l]-p[1][0][l], v1y = p[2][1][l]-p[1][1][l],
+            v1z = p[2][2][l]-p[1][2][l];
+        double v2x = p[0][0][l]-p[1][0][l], v2y = p[0][1][l]-p[1][1][l],
+            v2z = p[0][2][l]-p[1][2][l];
+        nrm[0][l] = 0.5*(v1y*v2z - v1z*v2y);
+        nrm[1][l] = 0.5*(v1z*v2x - v1x*v2z);
+        nrm[2][l] = 0.5*(v1x*v2y - v1y*v2x);
+        area[l] = std::sqrt(nrm[0][l]*nrm[0][l] + nrm[1][l]*nrm[1][l] +
+                            nrm[2][l]*nrm[2][l]);
+        for (int d = 0; d < 3; d++)
+          mom[d][l] = (p[0][d][l]+p[1][d][l]+p[2][d][l])/3;
+      }
+    } else {
+      // quadrilateral - sum over the triangles formed by the center
+      // and each edge
+
+      for (int d = 0; d < 3; d++)
+        for (int l = 0; l < nb; l++) {
+          c[d][l] = (p[0][d][l]+p[1][d][l]+p[2][d][l]+p[3][d][l])/4;
+          nrm[d][l] = mom[d][l] = 0.0;
+        }
+      for (int l = 0; l < nb; l++)
+        area[l] = 0.0;
+
+      for (int i = 0; i < 4; i++) {
+        double const (*p0)[B] = p[i];
+        double const (*p1)[B] = p[(i+1)%4];
+        for (int l = 0; l < nb; l++) {
+          double v1x = p0[0][l]-c[0][l], v1y = p0[1][l]-c[1][l],
+              v1z = p0[2][l]-c[2][l];
+          double v2x = p1[0][l]-c[0][l], v2y = p1[1][l]-c[1][l],
+              v2z = p1[2][l]-c[2][l];
+          double nx = 0.5*(v1y*v2z - v1z*v2y);
+          double ny = 0.5*(v1z*v2x - v1x*v2z);
+          double nz = 0.5*(v1x*v2y - v1y*v2x);
+          double tarea = std::sqrt(nx*nx + ny*ny + nz*nz);
+
+          nrm[0][l] += nx;
+          nrm[1][l] += ny;
+          nrm[2][l] += nz;
+          area[l] += tarea;
+          for (int d = 0; d < 3; d++)
+            mom[d][l] += tarea*(p0[d][l]+p1[d][l]+c[d][l])/3.0;
+        }
+      }
+      for (int d = 0; d < 3; d++)
+        for (int l = 0; l < nb; l++)
+          mom[d][l] /= area[l];
+    }
+
+    for (int l = 0; l < nb; l++) {
+      Entity_ID const faceid = faceids[b+l];
+      areas[faceid] = area[l];
+      centroids[faceid].set(mom[0][l], mom[1][l], mom[2][l]);
+      normals[faceid].set(nrm[0][l], nrm[1][l], nrm[2][l]);
+    }
+  }
+}
+
+
+void face2d_area_centroid_normal_batch(int const n,
+                                       Entity_ID const *fnodes,
+                                       double const * const *xyz,
+                                       double *areas,
+                                       JaliGeometry::Point *centroids,
+                                       JaliGeometry::Point *normals) {
+  double p[2][2][B];
+
+  for (int b = 0; b < n; b += B) {
+    int const nb = std::min(B, n-b);
+    gather_node(nb, 2, fnodes + 2*b, 2, 0, xyz, p[0]);
+    gather_node(nb, 2, fnodes + 2*b, 2, 1, xyz, p[1]);
+
+    for (int l = 0; l < nb; l++) {
+      double ex = p[1][0][l]-p[0][0][l], ey = p[1][1][l]-p[0][1][l];
+      areas[b+l] = std::sqrt(ex*ex + ey*ey);
+      centroids[b+l].set(0.5*(p[0][0][l]+p[1][0][l]),
+                         0.5*(p[0][1][l]+p[1][1][l]));
+      normals[b+l].set(ey, -ex);
+    }
+  }
+}
+
+
+void edge_length_vector_batch(int const dim, int const n,
+                              Entity_ID const *enodes,
+                              double const * const *xyz,
+                              double *lengths,
+                              JaliGeometry::Point *vectors) {
+  double p[2][3][B], ev[3][B];
+
+  for (int b = 0; b < n; b += B) {
+    int const nb = std::min(B, n-b);
+    gather_node(nb, dim, enodes + 2*b, 2, 0, xyz, p[0]);
+    gather_node(nb, dim, enodes + 2*b, 2, 1, xyz, p[1]);
+
+    for (int d = 0; d < dim; d++)
+      for (int l = 0; l < nb; l++)
+        ev[d][l] = p[1][d][l]-p[0][d][l];
+
+    for (int l = 0; l < nb; l++) {
+      double len2 = 0.0;
+      for (int d = 0; d < dim; d++)
+        len2 += ev[d][l]*ev[d][l];
+      lengths[b+l] = std::sqrt(len2);
+
+      JaliGeometry::Point& evec = vectors[b+l];
+      if (dim == 3)
+        evec.set(ev[0][l], ev[1][l], ev[2][l]);
+      else if (dim == 2)
+        evec.set(ev[0][l], ev[1][l]);
+      else
+        evec.set(1, &(ev[0][l]));
+    }
+  }
+}
+
+
+void side_geometry_batch(int const dim, int const n,
+                         Entity_ID const *sideids,
+                         Entity_ID const *snodes,
+                         Entity_ID const *sfaces,
+                         Entity_ID const *scells,
+                         Entity_ID const *sedges,
+                         Entity_ID const *enodes,
+                         double const * const *xyz,
+                         JaliGeometry::Point const *face_centroids,
+                         JaliGeometry::Point const *cell_centroids,
+                         double *volumes,
+                         JaliGeometry::Point *outward_facet_normals,
+                         JaliGeometry::Point *mid_facet_normals) {
+  double p0[3][B], p1[3][B], fc[3][B], cc[3][B], e0[3][B], e1[3][B];
+  Entity_ID s2n[2][B], sfc[B], scl[B], se2n[2][B];
+
+  for (int b = 0; b < n; b += B) {
+    int const nb = std::min(B, n-b);
+
+    // Gather the points of the sides - the two nodes, the face center
+    // (3D) and the cell center
+
+    for (int l = 0; l < nb; l++) {
+      Entity_ID const s = sideids[b+l];
+      s2n[0][l] = snodes[2*s];
+      s2n[1][l] = snodes[2*s+1];
+      sfc[l] = sfaces[s];
+      scl[l] = scells[s];
+    }
+    gather_node(nb, dim, s2n[0], 1, 0, xyz, p0);
+    gather_node(nb, dim, s2n[1], 1, 0, xyz, p1);
+    gather_points(nb, dim, scl, 1, cell_centroids, cc);
+
+    if (dim == 3) {
+      for (int l = 0; l < nb; l++) {
+        Entity_ID const e = sedges[sideids[b+l]];
+        se2n[0][l] = enodes[2*e];
+        se2n[1][l] = enodes[2*e+1];
+      }
+      gather_node(nb, 3, se2n[0], 1, 0, xyz, e0);
+      gather_node(nb, 3, se2n[1], 1, 0, xyz, e1);
+      gather_points(nb, 3, sfc, 1, face_centroids, fc);
+
+      for (int l = 0; l < nb; l++) {
+        // vectors from node 0 to node 1, face center and cell center
+
+        double ax = p1[0][l]-p0[0][l], ay = p1[1][l]-p0[1][l],
+            az = p1[2][l]-p0[2][l];
+        double bx = fc[0][l]-p0[0][l], by = fc[1][l]-p0[1][l],
+            bz = fc[2][l]-p0[2][l];
+        double qx = cc[0][l]-p0[0][l], qy = cc[1][l]-p0[1][l],
+            qz = cc[2][l]-p0[2][l];
+
+        double cpx = ay*bz - az*by;
+        double cpy = az*bx - ax*bz;
+        double cpz = ax*by - ay*bx;
+
+        // facet formed by edge center, face center and zone center
+
+        double ecx = (e0[0][l]+e1[0][l])/2.0, ecy = (e0[1][l]+e1[1][l])/2.0,
+            ecz = (e0[2][l]+e1[2][l])/2.0;
+        double ux = fc[0][l]-ecx, uy = fc[1][l]-ecy, uz = fc[2][l]-ecz;
+        double vx = cc[0][l]-ecx, vy = cc[1][l]-ecy, vz = cc[2][l]-ecz;
+
+        Entity_ID const s = sideids[b+l];
+        volumes[s] = (cpx*qx + cpy*qy + cpz*qz)/6.0;
+        outward_facet_normals[s].set(-0.5*cpx, -0.5*cpy, -0.5*cpz);
+        mid_facet_normals[s].set(0.5*(uy*vz - uz*vy), 0.5*(uz*vx - ux*vz),
+                                 0.5*(ux*vy - uy*vx));
+      }
+    } else {
+      for (int l = 0; l < nb; l++) {
+        // vectors from node 0 to node 1 and cell center
+
+        double ax = p1[0][l]-p0[0][l], ay = p1[1][l]-p0[1][l];
+        double bx = cc[0][l]-p0[0][l], by = cc[1][l]-p0[1][l];
+
+        Entity_ID const s = sideids[b+l];
+        volumes[s] = std::fabs(ax*by - bx*ay)/2.0;
+        outward_facet_normals[s].set(ay, -ax);
+        mid_facet_normals[s].set(by, -bx);
+      }
+    }
+  }
+}
+
+}  // end namespace Jali
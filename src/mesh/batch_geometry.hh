@@ -0,0 +1,186 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef _JALI_BATCH_GEOMETRY_H_
+#define _JALI_BATCH_GEOMETRY_H_
+
+// Batched geometry kernels. The node coordinates are given as
+// separate contiguous x, y and z arrays and the entities are
+// processed in blocks of geometry_batch_size entities of the same
+// type. Within a block, the coordinates of the entities are gathered
+// into small structure-of-arrays buffers and every arithmetic step is
+// a simple loop over the entities of the block that the compiler can
+// vectorize, instead of a sequence of JaliGeometry::Point operations
+// that branch on the dimension of each point.
+//
+// The decompositions are the same as in cell_geometry.hh and in the
+// entity-at-a-time code of Mesh.cc so the results are the same up to
+// roundoff, including the negative volumes of inverted cells (see
+// cell_geometry.hh for tets). The results are written into the
+// caller's per-entity arrays at the positions given by the entity
+// IDs.
+
+#include <vector>
+
+#include "Point.hh"
+#include "MeshDefs.hh"
+
+namespace Jali {
+
+//! Number of entities processed together by a batched kernel
+
+int const geometry_batch_size = 64;
+
+//! Signature of a batched cell volume and centroid kernel. The n
+//! cells are cellids[i], with nodes cnodes[i*nnodes...] and (in 3D)
+//! face nodes cfnodes[i*nfnodes...], the quadrilateral faces listed
+//! before the triangular faces, each ordered so that its normal
+//! points out of the cell. xyz holds the node coordinate arrays
+
+typedef void (*Cell_batch_function)(int const n, Entity_ID const *cellids,
+                                    Entity_ID const *cnodes,
+                                    Entity_ID const *cfnodes,
+                                    double const * const *xyz,
+                                    double *volumes,
+                                    JaliGeometry::Point *centroids);
+
+//! Batched kernel for a cell type and the topology a cell of that
+//! type must have to be processed by it
+
+struct Cell_batch_kernel {
+  int nnodes;
+  int nquads;     // number of quadrilateral faces (3D)
+  int ntris;      // number of triangular faces (3D)
+  Cell_batch_function vol_centroid;
+};
+
+//! Batched kernel for cells of a type in a space of dimension
+//! dim. Returns nullptr if there is no batched kernel for the type
+//! (POLYGON, POLYHED, cells embedded in a higher dimensional space)
+
+Cell_batch_kernel const * cell_batch_kernel(Cell_type const type,
+                                            int const manifold_dim,
+                                            int const space_dim);
+
+
+//! Area, centroid and natural (area weighted) normal of the n 3D
+//! faces faceids[i] with np = 3 or 4 nodes each fnodes[i*np...]
+
+void face_area_centroid_normal_batch(int const np, int const n,
+                                     Entity_ID const *faceids,
+                                     Entity_ID const *fnodes,
+                                     double const * const *xyz,
+                                     double *areas,
+                                     JaliGeometry::Point *centroids,
+                                     JaliGeometry::Point *normals);
+
+//! Length, centroid and natural normal of the n faces (edges) 0..n-1
+//! of a 2D mesh with nodes fnodes[2*i], fnodes[2*i+1]
+
+void face2d_area_centroid_normal_batch(int const n,
+                                       Entity_ID const *fnodes,
+                                       double const * const *xyz,
+                                       double *areas,
+                                       JaliGeometry::Point *centroids,
+                                       JaliGeometry::Point *normals);
+
+//! Length and vector of the n edges 0..n-1 with nodes enodes[2*i],
+//! enodes[2*i+1] in a space of dimension dim
+
+void edge_length_vector_batch(int const dim, int const n,
+                              Entity_ID const *enodes,
+                              double const * const *xyz,
+                              double *lengths,
+                              JaliGeometry::Point *vectors);
+
+//! Volume, outward facet normal and mid facet normal of the n sides
+//! sideids[i] of a 2D or 3D mesh. snodes, sfaces, scells and sedges
+//! are the nodes (2 per side), face, cell and edge of every side
+//! indexed by side ID and enodes the nodes of every edge; the face
+//! and cell centroids must already be computed
+
+void side_geometry_batch(int const dim, int const n,
+                         Entity_ID const *sideids,
+                         Entity_ID const *snodes,
+                         Entity_ID const *sfaces,
+                         Entity_ID const *scells,
+                         Entity_ID const *sedges,
+                         Entity_ID const *enodes,
+                         double const * const *xyz,
+                         JaliGeometry::Point const *face_centroids,
+                         JaliGeometry::Point const *cell_centroids,
+                         double *volumes,
+                         JaliGeometry::Point *outward_facet_normals,
+                         JaliGeometry::Point *mid_facet_normals);
+
+
+//! Cells and faces of a mesh grouped for the batched kernels along
+//! with the node lists the kernels need
+
+struct Geometry_batches {
+  //! Cells of each type with a batched kernel (indexed by Cell_type),
+  //! their nodes and their outward ordered face nodes
+  std::vector<Entity_ID> cellids[9], cellnodes[9], cellfacenodes[9];
+
+  //! Cells that must be processed one at a time
+  std::vector<Entity_ID> other_cellids;
+
+  //! Triangular (index 0) and quadrilateral (index 1) faces and their
+  //! nodes; faces of other shapes are processed one at a time
+  std::vector<Entity_ID> faceids[2], facenodes[2];
+  std::vector<Entity_ID> other_faceids;
+
+  //! Which normals of a face are set - bit 0 for normal0 (face used
+  //! in the +ve direction by a cell) and bit 1 for normal1
+  std::vector<char> face_normal_dirs;
+};
+
+}  // end namespace Jali
+
+#endif  // _JALI_BATCH_GEOMETRY_H_
@@ -0,0 +1,429 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef _JALI_CELL_GEOMETRY_H_
+#define _JALI_CELL_GEOMETRY_H_
+
+// Volume/area, centroid and normal kernels specialized for the
+// standard cell types. They perform the same decomposition, in the
+// same order, as the general polygon and polyhedron routines of
+// JaliGeometry (triangles or tets formed by the cell center, the face
+// centers and the edges of the faces) and so give the same results
+// up to roundoff. However, they work on small fixed size coordinate
+// arrays and exploit the known topology of the cell instead of
+// requiring a generic face-by-face description of every cell.
+//
+// Inverted 3D cells get a negative volume, as in the general
+// routine: the volume of a cell with any inverted tet in its
+// decomposition is made negative. The one exception to the common
+// decomposition is the tet, which JaliGeometry::polyhed_get_vol_centroid
+// itself computes from the signed volume of its nodes rather than
+// from faces. The tet kernel does the same, so an inverted tet gets
+// the same negative volume from both and its centroid is the mean of
+// its nodes.
+//
+// The kernels are looked up through per-type dispatch tables
+// (cell_geometry_kernel, polygon_geometry_kernel). Only POLYGON and
+// POLYHED cells go through the general routines.
+
+#include <vector>
+
+#include "Point.hh"
+#include "Geometry.hh"
+#include "MeshDefs.hh"
+
+namespace Jali {
+
+//! Largest number of nodes and faces of the standard cell types and
+//! largest number of face nodes (counted over all faces) of a
+//! standard cell
+
+int const max_std_cell_nodes = 8;
+int const max_std_cell_faces = 6;
+int const max_std_cell_face_nodes = 24;
+
+//! Area, centroid and area weighted normal of a polygon with np
+//! ordered vertices (same conventions as
+//! JaliGeometry::polygon_get_area_centroid_normal)
+
+template<Cell_type type>
+void polygon_area_centroid_normal(int const np,
+                                  JaliGeometry::Point const *coords,
+                                  double *area,
+                                  JaliGeometry::Point *centroid,
+                                  JaliGeometry::Point *normal);
+
+//! Volume and centroid of a cell with np nodes. In 2D, ccoords are
+//! the ordered vertices of the cell and the face arguments are
+//! unused. In 3D, the nf faces of the cell have nfnodes[i] nodes each
+//! and their coordinates are listed one face after the other in
+//! fcoords, ordered so that the face normals point out of the cell
+//! (same conventions as JaliGeometry::polyhed_get_vol_centroid)
+
+template<Cell_type type>
+void cell_vol_centroid(int const np, JaliGeometry::Point const *ccoords,
+                       int const nf, int const *nfnodes,
+                       JaliGeometry::Point const *fcoords,
+                       double *volume, JaliGeometry::Point *centroid);
+
+
+// Polygon kernels
+
+template<> inline
+void polygon_area_centroid_normal<Cell_type::TRI>(
+    int const, JaliGeometry::Point const *coords, double *area,
+    JaliGeometry::Point *centroid, JaliGeometry::Point *normal) {
+  JaliGeometry::Point center(coords[0].dim());
+  center += coords[0];
+  center += coords[1];
+  center += coords[2];
+  center /= 3;
+
+  *normal = 0.5*(coords[2]-coords[1])^(coords[0]-coords[1]);
+  *area = norm(*normal);
+  *centroid = center;
+}
+
+template<> inline
+void polygon_area_centroid_normal<Cell_type::QUAD>(
+    int const, JaliGeometry::Point const *coords, double *area,
+    JaliGeometry::Point *centroid, JaliGeometry::Point *normal) {
+  int const dim = coords[0].dim();
+  JaliGeometry::Point center(dim);
+  center += coords[0];
+  center += coords[1];
+  center += coords[2];
+  center += coords[3];
+  center /= 4;
+
+  // Sum the moments of the triangles formed by the center and each
+  // edge. In 2D, an inverted triangle marks the quad as inverted
+
+  bool negvol = false;
+  *area = 0.0;
+  centroid->set(0.0);
+  normal->set(0.0);
+  for (int i = 0; i < 4; i++) {
+    JaliGeometry::Point const& p0 = coords[i];
+    JaliGeometry::Point const& p1 = coords[(i+1)%4];
+
+    JaliGeometry::Point v3 = 0.5*(p0-center)^(p1-center);
+    double area_temp = norm(v3);
+    if (dim == 2 && v3[0] <= 0.0)
+      negvol = true;
+
+    *normal += v3;
+    *area += area_temp;
+    *centroid += area_temp*(p0+p1+center)/3.0;
+  }
+  *centroid /= *area;
+
+  if (negvol && *area > 0.0)
+    *area = -(*area);
+}
+
+template<> inline
+void polygon_area_centroid_normal<Cell_type::POLYGON>(
+    int const np, JaliGeometry::Point const *coords, double *area,
+    JaliGeometry::Point *centroid, JaliGeometry::Point *normal) {
+  JaliGeometry::polygon_get_area_centroid_normal(np, coords, area, centroid,
+                                                 normal);
+}
+
+
+// Polyhedron helpers - add the moments (six times the volume and six
+// times the volume weighted centroid) of the tets formed by the cell
+// center and a triangular or quadrilateral face
+
+inline
+void add_tri_face_moments(JaliGeometry::Point const& center,
+                          JaliGeometry::Point const *fcoords,
+                          double *volume6, JaliGeometry::Point *moment,
+                          bool *negvol) {
+  JaliGeometry::Point tcentroid =
+      (center+fcoords[0]+fcoords[1]+fcoords[2])/4.0;
+  double tvolume = ((fcoords[0]-center)^(fcoords[1]-center))*
+      (fcoords[2]-center);
+  if (tvolume <= 0.0) *negvol = true;
+
+  *moment += tvolume*tcentroid;
+  *volume6 += tvolume;
+}
+
+inline
+void add_quad_face_moments(JaliGeometry::Point const& center,
+                           JaliGeometry::Point const *fcoords,
+                           double *volume6, JaliGeometry::Point *moment,
+                           bool *negvol) {
+  JaliGeometry::Point fcenter(0.0, 0.0, 0.0);
+  fcenter += fcoords[0];
+  fcenter += fcoords[1];
+  fcenter += fcoords[2];
+  fcenter += fcoords[3];
+  fcenter /= 4;
+
+  JaliGeometry::Point v3 = fcenter-center;
+  for (int j = 0; j < 4; j++) {
+    JaliGeometry::Point const& p0 = fcoords[j];
+    JaliGeometry::Point const& p1 = fcoords[(j+1)%4];
+
+    JaliGeometry::Point tcentroid = (center+fcenter+p0+p1)/4.0;
+    double tvolume = ((p0-center)^(p1-center))*v3;
+    if (tvolume <= 0.0) *negvol = true;
+
+    *moment += tvolume*tcentroid;
+    *volume6 += tvolume;
+  }
+}
+
+// Volume and centroid from the moments of a cell with NP nodes whose
+// faces are all triangles or quadrilaterals
+
+template<int NP>
+void std_polyhed_vol_centroid(JaliGeometry::Point const *ccoords,
+                              int const nf, int const *nfnodes,
+                              JaliGeometry::Point const *fcoords,
+                              double *volume, JaliGeometry::Point *centroid) {
+  JaliGeometry::Point center(0.0, 0.0, 0.0);
+  for (int i = 0; i < NP; i++)
+    center += ccoords[i];
+  center /= NP;
+
+  bool negvol = false;
+  centroid->set(0.0);
+  *volume = 0.0;
+
+  int offset = 0;
+  for (int i = 0; i < nf; i++) {
+    if (nfnodes[i] == 3)
+      add_tri_face_moments(center, fcoords+offset, volume, centroid, &negvol);
+    else
+      add_quad_face_moments(center, fcoords+offset, volume, centroid,
+                            &negvol);
+    offset += nfnodes[i];
+  }
+
+  *centroid /= *volume;
+  *volume /= 6;
+
+  if (negvol && *volume > 0.0)
+    *volume = -(*volume);
+}
+
+
+// Cell kernels
+
+template<> inline
+void cell_vol_centroid<Cell_type::TRI>(
+    int const, JaliGeometry::Point const *ccoords,
+    int const, int const *, JaliGeometry::Point const *,
+    double *volume, JaliGeometry::Point *centroid) {
+  JaliGeometry::Point normal(ccoords[0].dim());
+  polygon_area_centroid_normal<Cell_type::TRI>(3, ccoords, volume, centroid,
+                                               &normal);
+}
+
+template<> inline
+void cell_vol_centroid<Cell_type::QUAD>(
+    int const, JaliGeometry::Point const *ccoords,
+    int const, int const *, JaliGeometry::Point const *,
+    double *volume, JaliGeometry::Point *centroid) {
+  JaliGeometry::Point normal(ccoords[0].dim());
+  polygon_area_centroid_normal<Cell_type::QUAD>(4, ccoords, volume, centroid,
+                                                &normal);
+}
+
+template<> inline
+void cell_vol_centroid<Cell_type::POLYGON>(
+    int const np, JaliGeometry::Point const *ccoords,
+    int const, int const *, JaliGeometry::Point const *,
+    double *volume, JaliGeometry::Point *centroid) {
+  JaliGeometry::Point normal(ccoords[0].dim());
+  polygon_area_centroid_normal<Cell_type::POLYGON>(np, ccoords, volume,
+                                                   centroid, &normal);
+}
+
+// Tets are computed directly from the nodes, as in the general
+// routine - the faces are not needed. The signed volume is negative
+// for an inverted tet, which is what the face decomposition would
+// report too since each of its tets would have a quarter of this
+// volume
+
+template<> inline
+void cell_vol_centroid<Cell_type::TET>(
+    int const, JaliGeometry::Point const *ccoords,
+    int const, int const *, JaliGeometry::Point const *,
+    double *volume, JaliGeometry::Point *centroid) {
+  *centroid = (ccoords[0]+ccoords[1]+ccoords[2]+ccoords[3])/4.0;
+  *volume = ((ccoords[1]-ccoords[0])^(ccoords[2]-ccoords[0]))*
+      (ccoords[3]-ccoords[0]);
+  *volume /= 6;
+}
+
+template<> inline
+void cell_vol_centroid<Cell_type::PRISM>(
+    int const, JaliGeometry::Point const *ccoords,
+    int const, int const *nfnodes, JaliGeometry::Point const *fcoords,
+    double *volume, JaliGeometry::Point *centroid) {
+  std_polyhed_vol_centroid<6>(ccoords, 5, nfnodes, fcoords, volume, centroid);
+}
+
+template<> inline
+void cell_vol_centroid<Cell_type::PYRAMID>(
+    int const, JaliGeometry::Point const *ccoords,
+    int const, int const *nfnodes, JaliGeometry::Point const *fcoords,
+    double *volume, JaliGeometry::Point *centroid) {
+  std_polyhed_vol_centroid<5>(ccoords, 5, nfnodes, fcoords, volume, centroid);
+}
+
+// All six faces of a hex are quads
+
+template<> inline
+void cell_vol_centroid<Cell_type::HEX>(
+    int const, JaliGeometry::Point const *ccoords,
+    int const, int const *, JaliGeometry::Point const *fcoords,
+    double *volume, JaliGeometry::Point *centroid) {
+  JaliGeometry::Point center(0.0, 0.0, 0.0);
+  for (int i = 0; i < 8; i++)
+    center += ccoords[i];
+  center /= 8;
+
+  bool negvol = false;
+  centroid->set(0.0);
+  *volume = 0.0;
+  for (int i = 0; i < 6; i++)
+    add_quad_face_moments(center, fcoords+4*i, volume, centroid, &negvol);
+
+  *centroid /= *volume;
+  *volume /= 6;
+
+  if (negvol && *volume > 0.0)
+    *volume = -(*volume);
+}
+
+template<> inline
+void cell_vol_centroid<Cell_type::POLYHED>(
+    int const np, JaliGeometry::Point const *ccoords,
+    int const nf, int const *nfnodes, JaliGeometry::Point const *fcoords,
+    double *volume, JaliGeometry::Point *centroid) {
+  JaliGeometry::polyhed_get_vol_centroid(np, ccoords, nf, nfnodes, fcoords,
+                                         volume, centroid);
+}
+
+
+//! Dispatch table entry for a cell type - the number of nodes and
+//! faces a cell must have to use the kernel (-1 if any number is
+//! allowed) and the kernel itself
+
+struct Cell_geometry_kernel {
+  int nnodes;
+  int nfaces;
+  void (*vol_centroid)(int const np, JaliGeometry::Point const *ccoords,
+                       int const nf, int const *nfnodes,
+                       JaliGeometry::Point const *fcoords,
+                       double *volume, JaliGeometry::Point *centroid);
+};
+
+//! Volume and centroid kernel for a cell type. Returns the general
+//! polygon or polyhedron kernel (according to the manifold
+//! dimension) for unknown types and for cells whose number of nodes
+//! or faces does not match the standard type
+
+inline
+Cell_geometry_kernel const& cell_geometry_kernel(Cell_type const type,
+                                                 int const manifold_dim,
+                                                 int const nnodes,
+                                                 int const nfaces) {
+  static Cell_geometry_kernel const table[] = {
+    {-1, -1, nullptr},                                      // UNKNOWN
+    { 3,  3, cell_vol_centroid<Cell_type::TRI>},
+    { 4,  4, cell_vol_centroid<Cell_type::QUAD>},
+    {-1, -1, cell_vol_centroid<Cell_type::POLYGON>},
+    { 4,  4, cell_vol_centroid<Cell_type::TET>},
+    { 6,  5, cell_vol_centroid<Cell_type::PRISM>},
+    { 5,  5, cell_vol_centroid<Cell_type::PYRAMID>},
+    { 8,  6, cell_vol_centroid<Cell_type::HEX>},
+    {-1, -1, cell_vol_centroid<Cell_type::POLYHED>}
+  };
+
+  Cell_type const generic_type =
+      (manifold_dim == 3) ? Cell_type::POLYHED : Cell_type::POLYGON;
+  int const type_dim = (type >= Cell_type::TET) ? 3 : 2;
+  if (!cell_valid_type(type) || type_dim != manifold_dim)
+    return table[static_cast<int>(generic_type)];
+
+  Cell_geometry_kernel const& kernel = table[static_cast<int>(type)];
+  if ((kernel.nnodes != -1 && kernel.nnodes != nnodes) ||
+      (kernel.nfaces != -1 && kernel.nfaces != nfaces))
+    return table[static_cast<int>(generic_type)];
+  return kernel;
+}
+
+//! Area, centroid and normal kernel for a polygon (a 2D cell or a
+//! face of a 3D cell) with np vertices
+
+typedef void (*Polygon_geometry_kernel)(int const np,
+                                        JaliGeometry::Point const *coords,
+                                        double *area,
+                                        JaliGeometry::Point *centroid,
+                                        JaliGeometry::Point *normal);
+
+inline
+Polygon_geometry_kernel polygon_geometry_kernel(int const np) {
+  static Polygon_geometry_kernel const table[] = {
+    polygon_area_centroid_normal<Cell_type::POLYGON>,
+    polygon_area_centroid_normal<Cell_type::TRI>,
+    polygon_area_centroid_normal<Cell_type::QUAD>
+  };
+  return table[(np == 3 || np == 4) ? np-2 : 0];
+}
+
+}  // end namespace Jali
+
+#endif  // _JALI_CELL_GEOMETRY_H_
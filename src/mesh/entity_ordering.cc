@@ -0,0 +1,216 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "entity_ordering.hh"
+
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <utility>
+
+namespace Jali {
+
+namespace {
+
+// Hilbert index of a point with dim integer coordinates of nbits bits
+// each, using Skilling's transpose algorithm (AIP Conf. Proc. 707,
+// 381 (2004)). The coordinates are overwritten
+
+std::uint64_t hilbert_key(int const dim, int const nbits, std::uint32_t *x) {
+  std::uint32_t const M = 1u << (nbits-1);
+
+  // Inverse undo excess work
+
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1) {
+    std::uint32_t const P = Q - 1;
+    for (int i = 0; i < dim; i++) {
+      if (x[i] & Q) {
+        x[0] ^= P;
+      } else {
+        std::uint32_t const t = (x[0] ^ x[i]) & P;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+
+  for (int i = 1; i < dim; i++)
+    x[i] ^= x[i-1];
+  std::uint32_t t = 0;
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+    if (x[dim-1] & Q) t ^= Q - 1;
+  for (int i = 0; i < dim; i++)
+    x[i] ^= t;
+
+  // Interleave the bits of the transposed index, most significant first
+
+  std::uint64_t key = 0;
+  for (int b = nbits-1; b >= 0; b--)
+    for (int i = 0; i < dim; i++)
+      key = (key << 1) | ((x[i] >> b) & 1u);
+  return key;
+}
+
+// Morton index of a point with dim integer coordinates of nbits bits each
+
+std::uint64_t morton_key(int const dim, int const nbits,
+                         std::uint32_t const *x) {
+  std::uint64_t key = 0;
+  for (int b = nbits-1; b >= 0; b--)
+    for (int i = 0; i < dim; i++)
+      key = (key << 1) | ((x[i] >> b) & 1u);
+  return key;
+}
+
+}  // end anonymous namespace
+
+
+void space_filling_curve_order(Renumbering_type const type, int const dim,
+                               std::vector<double> const& xyz,
+                               std::vector<int> *order) {
+  assert(dim >= 1 && dim <= 3);
+  assert(type == Renumbering_type::MORTON ||
+         type == Renumbering_type::HILBERT);
+  assert(order != nullptr);
+
+  int const n = xyz.size()/dim;
+
+  // Bounding box of the points
+
+  double lo[3] = {0.0, 0.0, 0.0}, hi[3] = {0.0, 0.0, 0.0};
+  if (n) {
+    for (int d = 0; d < dim; d++)
+      lo[d] = hi[d] = xyz[d];
+    for (int i = 1; i < n; i++)
+      for (int d = 0; d < dim; d++) {
+        lo[d] = std::min(lo[d], xyz[dim*i+d]);
+        hi[d] = std::max(hi[d], xyz[dim*i+d]);
+      }
+  }
+
+  // As many bits per coordinate as fit in a 64 bit key. In 1D both
+  // curves just order the points by their coordinate
+
+  int const nbits = std::min(63/dim, 31);
+  double const maxcoord = static_cast<double>((1u << nbits) - 1);
+  double scale[3] = {0.0, 0.0, 0.0};
+  for (int d = 0; d < dim; d++)
+    if (hi[d] > lo[d]) scale[d] = maxcoord/(hi[d] - lo[d]);
+
+  std::vector<std::pair<std::uint64_t, int>> keys(n);
+  for (int i = 0; i < n; i++) {
+    std::uint32_t x[3];
+    for (int d = 0; d < dim; d++)
+      x[d] = static_cast<std::uint32_t>((xyz[dim*i+d] - lo[d])*scale[d]);
+    keys[i].first = (type == Renumbering_type::HILBERT && dim > 1) ?
+        hilbert_key(dim, nbits, x) : morton_key(dim, nbits, x);
+    keys[i].second = i;
+  }
+
+  std::sort(keys.begin(), keys.end());
+
+  order->resize(n);
+  for (int i = 0; i < n; i++)
+    (*order)[i] = keys[i].second;
+}
+
+
+void reverse_cuthill_mckee_order(std::vector<int> const& offsets,
+                                 std::vector<int> const& adjacency,
+                                 std::vector<int> *order) {
+  assert(order != nullptr);
+
+  int const n = offsets.empty() ? 0 : offsets.size()-1;
+
+  auto degree = [&](int i) { return offsets[i+1] - offsets[i]; };
+
+  // Vertices by increasing degree - candidate starting vertices for
+  // the connected components
+
+  std::vector<int> by_degree(n);
+  for (int i = 0; i < n; i++)
+    by_degree[i] = i;
+  std::stable_sort(by_degree.begin(), by_degree.end(),
+                   [&](int a, int b) { return degree(a) < degree(b); });
+
+  order->clear();
+  order->reserve(n);
+  std::vector<char> visited(n, 0);
+  std::vector<int> nbrs;
+
+  for (int start : by_degree) {
+    if (visited[start]) continue;
+
+    // Breadth first traversal of the component, visiting the
+    // unvisited neighbors of each vertex by increasing degree
+
+    std::size_t head = order->size();
+    order->push_back(start);
+    visited[start] = 1;
+    while (head < order->size()) {
+      int const v = (*order)[head++];
+      nbrs.clear();
+      for (int j = offsets[v]; j < offsets[v+1]; j++) {
+        int const w = adjacency[j];
+        if (!visited[w]) {
+          visited[w] = 1;
+          nbrs.push_back(w);
+        }
+      }
+      std::stable_sort(nbrs.begin(), nbrs.end(),
+                       [&](int a, int b) { return degree(a) < degree(b); });
+      order->insert(order->end(), nbrs.begin(), nbrs.end());
+    }
+  }
+
+  std::reverse(order->begin(), order->end());
+}
+
+}  // end namespace Jali
@@ -0,0 +1,85 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef _JALI_ENTITY_ORDERING_H_
+#define _JALI_ENTITY_ORDERING_H_
+
+// Orderings used to renumber mesh entities so that entities that are
+// close to each other in the mesh are also close to each other in
+// memory. These work on plain coordinate and graph arrays and know
+// nothing about the mesh frameworks.
+
+#include <vector>
+
+#include "MeshDefs.hh"
+
+namespace Jali {
+
+//! Order of n points along a Morton (type MORTON) or Hilbert (type
+//! HILBERT) space filling curve through the bounding box of the
+//! points. The coordinates of point i are xyz[dim*i...dim*i+dim-1]
+//! and on return order[k] is the point at position k along the curve.
+//! Points that fall in the same curve cell keep their relative order
+
+void space_filling_curve_order(Renumbering_type const type, int const dim,
+                               std::vector<double> const& xyz,
+                               std::vector<int> *order);
+
+//! Reverse Cuthill-McKee order of a graph given in compressed form -
+//! the neighbors of vertex i are adjacency[offsets[i]...offsets[i+1]-1].
+//! Every connected component is started from a vertex of smallest
+//! degree. On return order[k] is the vertex at position k
+
+void reverse_cuthill_mckee_order(std::vector<int> const& offsets,
+                                 std::vector<int> const& adjacency,
+                                 std::vector<int> *order);
+
+}  // end namespace Jali
+
+#endif  // _JALI_ENTITY_ORDERING_H_
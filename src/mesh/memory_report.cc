@@ -0,0 +1,220 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "memory_report.hh"
+
+#include <algorithm>
+#include <iomanip>
+#include <set>
+
+namespace Jali {
+
+void Memory_report::add(std::string const& category, std::size_t const used,
+                        std::size_t const allocated) {
+  Memory_usage& mem = categories_[category];
+  mem.used += used;
+  mem.allocated += allocated;
+}
+
+
+void Memory_report::merge(std::string const& prefix,
+                          Memory_report const& other) {
+  for (auto const& cat : other.categories_)
+    add(prefix + cat.first, cat.second.used, cat.second.allocated);
+}
+
+
+Memory_usage Memory_report::total() const {
+  Memory_usage tot;
+  for (auto const& cat : categories_) {
+    tot.used += cat.second.used;
+    tot.allocated += cat.second.allocated;
+  }
+  return tot;
+}
+
+
+std::map<std::string, Memory_statistics>
+Memory_report::summary(MPI_Comm comm) const {
+  int nproc;
+  MPI_Comm_size(comm, &nproc);
+
+  // Every rank needs the union of the category names of all ranks
+  // (in the same order) before the values can be reduced - gather
+  // the names as '\0' terminated strings
+
+  std::vector<char> mynames;
+  for (auto const& cat : categories_)
+    mynames.insert(mynames.end(), cat.first.c_str(),
+                   cat.first.c_str() + cat.first.size() + 1);
+
+  int mysize = mynames.size();
+  std::vector<int> sizes(nproc), offsets(nproc+1, 0);
+  MPI_Allgather(&mysize, 1, MPI_INT, sizes.data(), 1, MPI_INT, comm);
+  for (int p = 0; p < nproc; ++p)
+    offsets[p+1] = offsets[p] + sizes[p];
+
+  std::vector<char> allnames(std::max(offsets[nproc], 1));
+  MPI_Allgatherv(mynames.data(), mysize, MPI_CHAR, allnames.data(),
+                 sizes.data(), offsets.data(), MPI_CHAR, comm);
+
+  std::set<std::string> names;
+  int i = 0;
+  while (i < offsets[nproc]) {
+    std::string name(&allnames[i]);
+    names.insert(name);
+    i += name.size() + 1;
+  }
+
+  // Reduce used and allocated bytes of every category and of the
+  // total (last entry)
+
+  int ncat = names.size();
+  std::vector<unsigned long long> mine(2*(ncat+1), 0);
+  i = 0;
+  for (auto const& name : names) {
+    auto it = categories_.find(name);
+    if (it != categories_.end()) {
+      mine[2*i] = it->second.used;
+      mine[2*i+1] = it->second.allocated;
+    }
+    i++;
+  }
+  Memory_usage tot = total();
+  mine[2*ncat] = tot.used;
+  mine[2*ncat+1] = tot.allocated;
+
+  std::vector<unsigned long long> mins(mine.size()), maxs(mine.size()),
+      sums(mine.size());
+  MPI_Allreduce(mine.data(), mins.data(), mine.size(),
+                MPI_UNSIGNED_LONG_LONG, MPI_MIN, comm);
+  MPI_Allreduce(mine.data(), maxs.data(), mine.size(),
+                MPI_UNSIGNED_LONG_LONG, MPI_MAX, comm);
+  MPI_Allreduce(mine.data(), sums.data(), mine.size(),
+                MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+
+  auto stats = [&](int j) -> Memory_statistics {
+    Memory_statistics s;
+    s.min.used = mins[2*j];
+    s.min.allocated = mins[2*j+1];
+    s.max.used = maxs[2*j];
+    s.max.allocated = maxs[2*j+1];
+    s.sum.used = sums[2*j];
+    s.sum.allocated = sums[2*j+1];
+    return s;
+  };
+
+  std::map<std::string, Memory_statistics> result;
+  i = 0;
+  for (auto const& name : names)
+    result[name] = stats(i++);
+  result["total"] = stats(ncat);
+  return result;
+}
+
+
+namespace {
+
+double megabytes(std::size_t const bytes) {
+  return static_cast<double>(bytes)/(1024.0*1024.0);
+}
+
+}  // end anonymous namespace
+
+
+void Memory_report::print(std::ostream& os) const {
+  std::ios::fmtflags flags = os.flags();
+  os << std::fixed << std::setprecision(3);
+  os << std::left << std::setw(40) << "Category" << std::right <<
+      std::setw(14) << "Used (MB)" << std::setw(14) << "Alloc (MB)" <<
+      "\n";
+  for (auto const& cat : categories_)
+    os << std::left << std::setw(40) << cat.first << std::right <<
+        std::setw(14) << megabytes(cat.second.used) <<
+        std::setw(14) << megabytes(cat.second.allocated) << "\n";
+  Memory_usage tot = total();
+  os << std::left << std::setw(40) << "total" << std::right <<
+      std::setw(14) << megabytes(tot.used) <<
+      std::setw(14) << megabytes(tot.allocated) << "\n";
+  os.flags(flags);
+}
+
+
+void Memory_report::print_summary(std::ostream& os, MPI_Comm comm) const {
+  std::map<std::string, Memory_statistics> stats = summary(comm);
+
+  int rank, nproc;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &nproc);
+  if (rank != 0) return;
+
+  auto print_line = [&](std::string const& name,
+                        Memory_statistics const& s) {
+    double mean = static_cast<double>(s.sum.used)/nproc;
+    os << std::left << std::setw(40) << name << std::right <<
+        std::setw(12) << megabytes(s.min.used) <<
+        std::setw(12) << megabytes(s.max.used) <<
+        std::setw(12) << megabytes(s.sum.used) <<
+        std::setw(12) << megabytes(s.sum.allocated) <<
+        std::setw(10) << (mean > 0.0 ? s.max.used/mean : 1.0) << "\n";
+  };
+
+  std::ios::fmtflags flags = os.flags();
+  os << std::fixed << std::setprecision(3);
+  os << "Memory (MB) over " << nproc << " ranks\n";
+  os << std::left << std::setw(40) << "Category" << std::right <<
+      std::setw(12) << "Min used" << std::setw(12) << "Max used" <<
+      std::setw(12) << "Sum used" << std::setw(12) << "Sum alloc" <<
+      std::setw(10) << "Max/mean" << "\n";
+  for (auto const& s : stats)
+    if (s.first != "total") print_line(s.first, s.second);
+  print_line("total", stats["total"]);
+  os.flags(flags);
+}
+
+}  // end namespace Jali
@@ -0,0 +1,138 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef _JALI_MEMORY_REPORT_H_
+#define _JALI_MEMORY_REPORT_H_
+
+// Accounting of the memory held by the Jali data structures. Each
+// structure adds the arrays it owns to a Memory_report under a
+// category name ("adjacency/cell_face", "geometry/cells", ...) with
+// both the bytes in use (size of the arrays) and the bytes allocated
+// (their capacity) so that both the footprint and the slack of
+// over-allocated arrays are visible. Reports of nested structures are
+// merged under a prefix (e.g. "tiles/") and can be reduced over the
+// ranks of a communicator to look for imbalance.
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+#include <iostream>
+
+namespace Jali {
+
+//! Bytes in use and bytes allocated
+
+struct Memory_usage {
+  std::size_t used = 0;
+  std::size_t allocated = 0;
+};
+
+//! Minimum, maximum and sum over the ranks of a communicator of the
+//! memory of a category
+
+struct Memory_statistics {
+  Memory_usage min, max, sum;
+};
+
+class Memory_report {
+ public:
+
+  //! Add bytes used and allocated to a category
+
+  void add(std::string const& category, std::size_t const used,
+           std::size_t const allocated);
+
+  //! Add the contents of a vector (elements only - memory owned by
+  //! the elements themselves is not followed)
+
+  template<typename T>
+  void add(std::string const& category, std::vector<T> const& v) {
+    add(category, v.size()*sizeof(T), v.capacity()*sizeof(T));
+  }
+
+  //! Add every category of another report under a prefix
+
+  void merge(std::string const& prefix, Memory_report const& other);
+
+  //! Memory of every category
+
+  std::map<std::string, Memory_usage> const& categories() const {
+    return categories_;
+  }
+
+  //! Memory of all categories together
+
+  Memory_usage total() const;
+
+  //! Minimum, maximum and sum of every category over the ranks of
+  //! comm. Collective - categories missing on some ranks count as
+  //! zero there. The last entry, "total", is for all categories
+  //! together
+
+  std::map<std::string, Memory_statistics> summary(MPI_Comm comm) const;
+
+  //! Print the memory of every category and the total
+
+  void print(std::ostream& os) const;
+
+  //! Print the summary over the ranks of comm on rank 0 along with
+  //! the imbalance (max/mean) of the memory in use. Collective
+
+  void print_summary(std::ostream& os, MPI_Comm comm) const;
+
+ private:
+  std::map<std::string, Memory_usage> categories_;
+};
+
+}  // end namespace Jali
+
+#endif  // _JALI_MEMORY_REPORT_H_
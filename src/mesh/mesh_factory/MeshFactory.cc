@@ -169,6 +169,15 @@ void MeshFactory::reset_options(void) {
   /// Partitioner type
   partitioner_ = partitioner_default_;
 
+  /// Renumbering type
+  renumbering_ = renumbering_default_;
+
+  /// Implicit numbering of sides and wedges
+  implicit_subcells_ = implicit_subcells_default_;
+
+  /// Profiling of the mesh construction
+  profile_construction_ = profile_construction_default_;
+
   /// Geometry type
   geom_type_ = geom_type_default_;
 
@@ -205,7 +214,9 @@ MeshFactory::create(std::string const& filename) {
                                         num_ghost_layers_distmesh_,
                                         request_boundary_ghosts_,
                                         partitioner_, contiguous_gids_,
-                                        geom_type_);
+                                        geom_type_, renumbering_,
+                                        implicit_subcells_,
+                                        profile_construction_);
         if (geometric_model_ &&
             (geometric_model_->dimension() != result->space_dimension())) {
           errmsg.add_data("Geometric model and mesh dimension do not match");
@@ -318,7 +329,9 @@ MeshFactory::create(double const x0, double const y0, double const z0,
                                         num_tiles_, num_ghost_layers_tile_,
                                         num_ghost_layers_distmesh_,
                                         request_boundary_ghosts_,
-                                        partitioner_, contiguous_gids_);
+                                        partitioner_, contiguous_gids_,
+                                        renumbering_, implicit_subcells_,
+                                        profile_construction_);
         return result;
       }
 #endif
@@ -423,7 +436,9 @@ MeshFactory::create(double const x0, double const y0,
                                         num_ghost_layers_distmesh_,
                                         request_boundary_ghosts_,
                                         partitioner_, contiguous_gids_,
-                                        geom_type_);
+                                        geom_type_, renumbering_,
+                                        implicit_subcells_,
+                                        profile_construction_);
         return result;
       }
 #endif
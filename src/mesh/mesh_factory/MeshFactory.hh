@@ -151,6 +151,50 @@ class MeshFactory {
     partitioner_ = partitioner;
   }
 
+  /// Get the renumbering of entities for meshes to be created
+  /// (default NONE)
+  Renumbering_type renumbering(void) const {
+    return renumbering_;
+  }
+
+  /// Set the renumbering of entities for meshes to be created - cells
+  /// are ordered along a Morton or Hilbert curve or by reverse
+  /// Cuthill-McKee and nodes, edges and faces are then numbered by
+  /// first touch from the cells (only meshes created by MSTK are
+  /// renumbered)
+  void renumbering(Renumbering_type renumbering) {
+    renumbering_ = renumbering;
+  }
+
+  /// Get whether sides and wedges of meshes to be created are numbered
+  /// implicitly (default false)
+  bool implicit_subcells(void) const {
+    return implicit_subcells_;
+  }
+
+  /// Set whether sides and wedges of meshes to be created are
+  /// numbered implicitly - their cell, face, edge and nodes are then
+  /// looked up from the side ID instead of being stored per side
+  /// (see Mesh::implicit_subcells for what is still stored and when
+  /// the mesh falls back to storing them)
+  void implicit_subcells(bool implicit_subcells) {
+    implicit_subcells_ = implicit_subcells;
+  }
+
+  /// Get whether the construction of meshes to be created is profiled
+  /// (default false)
+  bool profile_construction(void) const {
+    return profile_construction_;
+  }
+
+  /// Set whether the construction of meshes to be created is profiled
+  /// - the time spent in each phase is then available from
+  /// Mesh::construction_profile() (only meshes created by MSTK are
+  /// profiled)
+  void profile_construction(bool profile_construction) {
+    profile_construction_ = profile_construction;
+  }
+
   /// Get the geometry type for the meshes to be created (default CARTESIAN)
   JaliGeometry::Geom_type mesh_geometry(void) const {
     return geom_type_;
@@ -432,6 +476,18 @@ class MeshFactory {
   Partitioner_type const partitioner_default_ = Partitioner_type::INDEX;
   Partitioner_type partitioner_ = partitioner_default_;
 
+  /// Renumbering of entities
+  Renumbering_type const renumbering_default_ = Renumbering_type::NONE;
+  Renumbering_type renumbering_ = renumbering_default_;
+
+  /// Implicit numbering of sides and wedges
+  bool const implicit_subcells_default_ = false;
+  bool implicit_subcells_ = implicit_subcells_default_;
+
+  /// Profiling of the mesh construction
+  bool const profile_construction_default_ = false;
+  bool profile_construction_ = profile_construction_default_;
+
   /// Geometry type
   JaliGeometry::Geom_type const geom_type_default_ =
       JaliGeometry::Geom_type::CARTESIAN;
@@ -57,6 +57,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <mpi.h>
 
 #include "errors.hh"
+#include "entity_ordering.hh"
 
 
 namespace Jali {
@@ -66,15 +67,23 @@ void Mesh_MSTK::init_mesh_from_file_(std::string const filename,
 
   int ok = 0;
 
+  Phase_profile *profiler = construction_profiler();
+
   mesh = MESH_New(F1);
 
   if (filename.find(".exo") != std::string::npos) {  // Exodus file
 
     // Read the mesh on processor 0
-    ok = MESH_ImportFromExodusII(mesh, filename.c_str(), NULL, mpicomm);
+    {
+      Phase_timer timer(profiler, "import");
+      ok = MESH_ImportFromExodusII(mesh, filename.c_str(), NULL, mpicomm);
+    }
 
     // Collapse any degenerate edges in the mesh
-    collapse_degen_edges();  // Assumes its operating on member var 'mesh'
+    {
+      Phase_timer timer(profiler, "collapse_degen_edges");
+      collapse_degen_edges();  // Assumes its operating on member var 'mesh'
+    }
 
     // Renumber local IDs to be contiguous
     MESH_Renumber(mesh, 0, MALLTYPE);
@@ -92,20 +101,31 @@ void Mesh_MSTK::init_mesh_from_file_(std::string const filename,
       Mesh_ptr globalmesh = mesh;
       mesh = MESH_New(F1);
       
-      ok &= MSTK_Mesh_Distribute(globalmesh, &mesh, &topo_dim,
-                                 num_ghost_layers_distmesh_, with_attr, method,
-                                 del_inmesh, mpicomm);
+      {
+        Phase_timer timer(profiler, "distribute");
+        ok &= MSTK_Mesh_Distribute(globalmesh, &mesh, &topo_dim,
+                                   num_ghost_layers_distmesh_, with_attr,
+                                   method, del_inmesh, mpicomm);
+      }
 
-      if (contiguous_gids_)
+      if (contiguous_gids_) {
+        Phase_timer timer(profiler, "renumber_global_ids");
         ok &= MESH_Renumber_GlobalIDs(mesh, MALLTYPE, 0, NULL, mpicomm);
+      }
     }
   } else if (filename.find(".par") != std::string::npos) {  // Nemesis file
 
     // Read the individual partitions on each processor
-    ok = MESH_ImportFromNemesisI(mesh, filename.c_str(), NULL, mpicomm);
+    {
+      Phase_timer timer(profiler, "import");
+      ok = MESH_ImportFromNemesisI(mesh, filename.c_str(), NULL, mpicomm);
+    }
 
     // Collapse any degenerate edges in the mesh
-    collapse_degen_edges();
+    {
+      Phase_timer timer(profiler, "collapse_degen_edges");
+      collapse_degen_edges();
+    }
 
     // Renumber local IDs to be contiguous
     MESH_Renumber(mesh, 0, MALLTYPE);
@@ -115,15 +135,20 @@ void Mesh_MSTK::init_mesh_from_file_(std::string const filename,
     //                   // unique global ID on each mesh vertex
     int topo_dim = MESH_Num_Regions(mesh) ? 3 : 2;
 
-    ok &= MSTK_Weave_DistributedMeshes(mesh, topo_dim,
-                                       num_ghost_layers_distmesh_,
-                                       input_type, mpicomm);
+    {
+      Phase_timer timer(profiler, "weave");
+      ok &= MSTK_Weave_DistributedMeshes(mesh, topo_dim,
+                                         num_ghost_layers_distmesh_,
+                                         input_type, mpicomm);
+    }
 
     // Global IDs are discontinuous due to elimination of degeneracies
     // but we cannot renumber global IDs (if requested) until
     // interprocessor connectivity has been established
-    if (contiguous_gids_)
+    if (contiguous_gids_) {
+      Phase_timer timer(profiler, "renumber_global_ids");
       ok &= MESH_Renumber_GlobalIDs(mesh, MALLTYPE, 0, NULL, mpicomm);
+    }
 
   } else {
     std::stringstream mesg_stream;
@@ -159,11 +184,15 @@ Mesh_MSTK::Mesh_MSTK(const std::string filename, const MPI_Comm& incomm,
                      const bool boundary_ghosts_requested,
                      const Partitioner_type partitioner,
                      const bool contiguous_gids,
-                     const JaliGeometry::Geom_type geom_type) :
+                     const JaliGeometry::Geom_type geom_type,
+                     const Renumbering_type renumbering,
+                     const bool implicit_subcells,
+                     const bool profile_construction) :
     Mesh(request_faces, request_edges, request_sides, request_wedges,
          request_corners, num_tiles_ini, num_ghost_layers_tile,
          num_ghost_layers_distmesh, boundary_ghosts_requested,
-         partitioner, geom_type, incomm),
+         partitioner, geom_type, incomm, renumbering, implicit_subcells,
+         profile_construction),
     mpicomm(incomm), meshxyz(NULL),
     faces_initialized(false), edges_initialized(false),
     target_cell_volumes(NULL), min_cell_volumes(NULL),
@@ -181,7 +210,10 @@ Mesh_MSTK::Mesh_MSTK(const std::string filename, const MPI_Comm& incomm,
   int space_dim = 3;
   pre_create_steps_(space_dim, gm);
 
-  init_mesh_from_file_(filename);
+  {
+    Phase_timer timer(construction_profiler(), "init_mesh_from_file");
+    init_mesh_from_file_(filename);
+  }
 
   int cell_dim = MESH_Num_Regions(mesh) ? 3 : 2;
 
@@ -252,11 +284,15 @@ Mesh_MSTK::Mesh_MSTK(const double x0, const double y0, const double z0,
                      const int num_ghost_layers_distmesh,
                      const bool boundary_ghosts_requested,
                      const Partitioner_type partitioner,
-                     const bool contiguous_gids) :
+                     const bool contiguous_gids,
+                     const Renumbering_type renumbering,
+                     const bool implicit_subcells,
+                     const bool profile_construction) :
     Mesh(request_faces, request_edges, request_sides, request_wedges,
          request_corners, num_tiles, num_ghost_layers_tile,
          num_ghost_layers_distmesh, boundary_ghosts_requested,
-         partitioner, JaliGeometry::Geom_type::CARTESIAN, incomm),
+         partitioner, JaliGeometry::Geom_type::CARTESIAN, incomm,
+         renumbering, implicit_subcells, profile_construction),
     mpicomm(incomm), meshxyz(NULL),
     faces_initialized(false), edges_initialized(false),
     target_cell_volumes(NULL), min_cell_volumes(NULL),
@@ -275,7 +311,10 @@ Mesh_MSTK::Mesh_MSTK(const double x0, const double y0, const double z0,
   if (serial_run) {
     // Generate serial mesh
 
-    ok = generate_regular_mesh(mesh, x0, y0, z0, x1, y1, z1, nx, ny, nz);
+    {
+      Phase_timer timer(construction_profiler(), "generate_mesh");
+      ok = generate_regular_mesh(mesh, x0, y0, z0, x1, y1, z1, nx, ny, nz);
+    }
 
     set_manifold_dimension(3);
 
@@ -327,18 +366,21 @@ Mesh_MSTK::Mesh_MSTK(const double x0, const double y0, const double z0,
     // Generate a regular mesh for part of the domain corresponding to this
     // processor
 
-    ok = generate_regular_mesh(mesh,
-			       domain[0], domain[2], domain[4],
-			       domain[1], domain[3], domain[5],
-			       num_cells_in_dir[0],
-			       num_cells_in_dir[1],
-			       num_cells_in_dir[2],
-                               block_start_index[myprocid][0],
-                               block_start_index[myprocid][1],
-                               block_start_index[myprocid][2],
-                               block_num_cells[myprocid][0],
-                               block_num_cells[myprocid][1],
-                               block_num_cells[myprocid][2]);
+    {
+      Phase_timer timer(construction_profiler(), "generate_mesh");
+      ok = generate_regular_mesh(mesh,
+                                 domain[0], domain[2], domain[4],
+                                 domain[1], domain[3], domain[5],
+                                 num_cells_in_dir[0],
+                                 num_cells_in_dir[1],
+                                 num_cells_in_dir[2],
+                                 block_start_index[myprocid][0],
+                                 block_start_index[myprocid][1],
+                                 block_start_index[myprocid][2],
+                                 block_num_cells[myprocid][0],
+                                 block_num_cells[myprocid][1],
+                                 block_num_cells[myprocid][2]);
+    }
 
     if (!ok) {
       std::stringstream mesg_stream;
@@ -352,8 +394,12 @@ Mesh_MSTK::Mesh_MSTK(const double x0, const double y0, const double z0,
 
     // Establish interprocessor connectivity and ghost layers
 
-    ok = MSTK_Weave_DistributedMeshes(mesh, topo_dim, num_ghost_layers_distmesh,
-                                      input_type, mpicomm);
+    {
+      Phase_timer timer(construction_profiler(), "weave");
+      ok = MSTK_Weave_DistributedMeshes(mesh, topo_dim,
+                                        num_ghost_layers_distmesh,
+                                        input_type, mpicomm);
+    }
 
     if (!ok) {
       std::stringstream mesg_stream;
@@ -397,11 +443,15 @@ Mesh_MSTK::Mesh_MSTK(const double x0, const double y0,
                      const bool boundary_ghosts_requested,
                      const Partitioner_type partitioner,
                      const bool contiguous_gids,
-                     const JaliGeometry::Geom_type geom_type) :
+                     const JaliGeometry::Geom_type geom_type,
+                     const Renumbering_type renumbering,
+                     const bool implicit_subcells,
+                     const bool profile_construction) :
     Mesh(request_faces, request_edges, request_sides, request_wedges,
          request_corners, num_tiles, num_ghost_layers_tile,
          num_ghost_layers_distmesh, boundary_ghosts_requested,
-         partitioner, geom_type, incomm),
+         partitioner, geom_type, incomm, renumbering, implicit_subcells,
+         profile_construction),
     mpicomm(incomm), meshxyz(NULL),
     faces_initialized(false), edges_initialized(false),
     target_cell_volumes(NULL), min_cell_volumes(NULL),
@@ -422,7 +472,10 @@ Mesh_MSTK::Mesh_MSTK(const double x0, const double y0,
   if (serial_run) {
     // Generate serial mesh
 
-    ok = generate_regular_mesh(mesh, x0, y0, x1, y1, nx, ny);
+    {
+      Phase_timer timer(construction_profiler(), "generate_mesh");
+      ok = generate_regular_mesh(mesh, x0, y0, x1, y1, nx, ny);
+    }
 
     myprocid = 0;
     assert(ok);
@@ -461,15 +514,18 @@ Mesh_MSTK::Mesh_MSTK(const double x0, const double y0,
     // Generate a regular mesh for part of the domain corresponding to this
     // processor
 
-    ok = generate_regular_mesh(mesh,
-			       domain[0], domain[2],
-			       domain[1], domain[3],
-			       num_cells_in_dir[0],
-			       num_cells_in_dir[1],
-                               block_start_index[myprocid][0],
-                               block_start_index[myprocid][1],
-                               block_num_cells[myprocid][0],
-                               block_num_cells[myprocid][1]);
+    {
+      Phase_timer timer(construction_profiler(), "generate_mesh");
+      ok = generate_regular_mesh(mesh,
+                                 domain[0], domain[2],
+                                 domain[1], domain[3],
+                                 num_cells_in_dir[0],
+                                 num_cells_in_dir[1],
+                                 block_start_index[myprocid][0],
+                                 block_start_index[myprocid][1],
+                                 block_num_cells[myprocid][0],
+                                 block_num_cells[myprocid][1]);
+    }
 
     if (!ok) {
       std::stringstream mesg_stream;
@@ -483,8 +539,12 @@ Mesh_MSTK::Mesh_MSTK(const double x0, const double y0,
 
     // Establish interprocessor connectivity and ghost layers
 
-    ok = MSTK_Weave_DistributedMeshes(mesh, topo_dim, num_ghost_layers_distmesh,
-                                      input_type, mpicomm);
+    {
+      Phase_timer timer(construction_profiler(), "weave");
+      ok = MSTK_Weave_DistributedMeshes(mesh, topo_dim,
+                                        num_ghost_layers_distmesh,
+                                        input_type, mpicomm);
+    }
 
     if (!ok) {
       std::stringstream mesg_stream;
@@ -713,6 +773,9 @@ void Mesh_MSTK::extract_mstk_mesh(const Mesh_MSTK& inmesh,
   double rval = 0., xyz[3];
   void *pval;
 
+  // The vertex coordinates are copied from the MSTK mesh of inmesh
+
+  inmesh.update_framework_node_coordinates();
   Mesh_ptr inmesh_mstk = inmesh.mesh;
 
   if (extrude) {
@@ -1675,8 +1738,8 @@ void Mesh_MSTK::cell_2D_get_edges_and_dirs_internal(const Entity_ID cellid,
 // In 2D, the nodes of the polygon will be returned in ccw order
 // consistent with the face normal
 
-void Mesh_MSTK::cell_get_nodes(const Entity_ID cellid,
-                               std::vector<Entity_ID> *nodeids) const {
+void Mesh_MSTK::cell_get_nodes_internal(const Entity_ID cellid,
+                                        std::vector<Entity_ID> *nodeids) const {
   MEntity_ptr cell;
   int nn, lid;
 
@@ -1727,7 +1790,7 @@ void Mesh_MSTK::cell_get_nodes(const Entity_ID cellid,
 
     List_Delete(fverts);
   }
-}  // Mesh_MSTK::cell_get_nodes
+}  // Mesh_MSTK::cell_get_nodes_internal
 
 
 
@@ -1812,8 +1875,8 @@ void Mesh_MSTK::face_get_edges_and_dirs_internal(const Entity_ID faceid,
 // with the face normal
 // In 2D, nfnodes is 2
 
-void Mesh_MSTK::face_get_nodes(const Entity_ID faceid,
-                               std::vector<Entity_ID> *nodeids) const {
+void Mesh_MSTK::face_get_nodes_internal(const Entity_ID faceid,
+                                        std::vector<Entity_ID> *nodeids) const {
   MEntity_ptr genface;
   int nn, lid;
 
@@ -1861,7 +1924,7 @@ void Mesh_MSTK::face_get_nodes(const Entity_ID faceid,
       (*nodeids)[1] = MEnt_ID(ME_Vertex(genface, 1))-1;
     }
   }
-}  // Mesh_MSTK::face_get_nodes
+}  // Mesh_MSTK::face_get_nodes_internal
 
 
 // Get nodes of an edge
@@ -1887,9 +1950,9 @@ void Mesh_MSTK::edge_get_nodes_internal(const Entity_ID edgeid,
 // push_back on or near the partition boundary since we cannot tell at
 // the outset how many entries will be put into the list
 
-void Mesh_MSTK::node_get_cells(const Entity_ID nodeid,
-                               const Entity_type ptype,
-                               std::vector<Entity_ID> *cellids) const {
+void Mesh_MSTK::node_get_cells_internal(const Entity_ID nodeid,
+                                        const Entity_type ptype,
+                                        std::vector<Entity_ID> *cellids) const {
   int idx, lid, nc;
   List_ptr cell_list;
   MEntity_ptr ment;
@@ -1969,7 +2032,7 @@ void Mesh_MSTK::node_get_cells(const Entity_ID nodeid,
   }
     */
 
-}  // Mesh_MSTK::node_get_cells
+}  // Mesh_MSTK::node_get_cells_internal
 
 
 
@@ -1977,9 +2040,9 @@ void Mesh_MSTK::node_get_cells(const Entity_ID nodeid,
 // push_back on or near the partition boundary since we cannot tell at
 // the outset how many entries will be put into the list
 
-void Mesh_MSTK::node_get_faces(const Entity_ID nodeid,
-                               const Entity_type ptype,
-                               std::vector<Entity_ID> *faceids) const {
+void Mesh_MSTK::node_get_faces_internal(const Entity_ID nodeid,
+                                        const Entity_type ptype,
+                                        std::vector<Entity_ID> *faceids) const {
   int idx, lid, n;
   List_ptr face_list;
   MEntity_ptr ment;
@@ -2057,7 +2120,7 @@ void Mesh_MSTK::node_get_faces(const Entity_ID nodeid,
   }
     */
 
-}  // Mesh_MSTK::node_get_faces
+}  // Mesh_MSTK::node_get_faces_internal
 
 
 
@@ -2215,10 +2278,10 @@ void Mesh_MSTK::face_get_cells_internal(const Entity_ID faceid,
 // push_back since we cannot tell at the outset how many entries will
 // be put into the list
 
-void Mesh_MSTK::cell_get_face_adj_cells(const Entity_ID cellid,
-                                        const Entity_type ptype,
-                                        std::vector<Entity_ID> *fadj_cellids)
-    const {
+void Mesh_MSTK::cell_get_face_adj_cells_internal(const Entity_ID cellid,
+                                                 const Entity_type ptype,
+                                                 std::vector<Entity_ID>
+                                                 *fadj_cellids) const {
 
   int lid;
 
@@ -2296,7 +2359,7 @@ void Mesh_MSTK::cell_get_face_adj_cells(const Entity_ID cellid,
 
   }
 
-}  // Mesh_MSTK::cell_get_face_adj_cells
+}  // Mesh_MSTK::cell_get_face_adj_cells_internal
 
 
 
@@ -2305,10 +2368,10 @@ void Mesh_MSTK::cell_get_face_adj_cells(const Entity_ID cellid,
 // push_back since we cannot tell at the outset how many entries will
 // be put into the list
 
-void Mesh_MSTK::cell_get_node_adj_cells(const Entity_ID cellid,
-                                        const Entity_type ptype,
-                                        std::vector<Entity_ID> *nadj_cellids)
-    const {
+void Mesh_MSTK::cell_get_node_adj_cells_internal(const Entity_ID cellid,
+                                                 const Entity_type ptype,
+                                                 std::vector<Entity_ID>
+                                                 *nadj_cellids) const {
 
   List_ptr cell_list;
 
@@ -2389,14 +2452,15 @@ void Mesh_MSTK::cell_get_node_adj_cells(const Entity_ID cellid,
 
   List_Delete(cell_list);
 
-}  // Mesh_MSTK::cell_get_node_adj_cells
+}  // Mesh_MSTK::cell_get_node_adj_cells_internal
 
 
 
 // Node coordinates - 3 in 3D and 2 in 2D
 
-void Mesh_MSTK::node_get_coordinates(const Entity_ID nodeid,
-                                     JaliGeometry::Point *ncoords) const {
+void Mesh_MSTK::node_get_coordinates_internal(const Entity_ID nodeid,
+                                              JaliGeometry::Point *ncoords)
+    const {
   MEntity_ptr vtx;
   double coords[3];
   int spdim = space_dimension();
@@ -2407,170 +2471,17 @@ void Mesh_MSTK::node_get_coordinates(const Entity_ID nodeid,
 
   MV_Coords(vtx, coords);
   ncoords->set(spdim, coords);
-}  // Mesh_MSTK::node_get_coordinates
+}  // Mesh_MSTK::node_get_coordinates_internal
 
-void Mesh_MSTK::node_get_coordinates(const Entity_ID nodeid,
-                                     std::array<double, 3> *ncoords) const {
-  MEntity_ptr vtx;
-  double coords[3];
-  int spdim = space_dimension();
-
-  assert(ncoords != NULL);
-  assert(spdim == 3);
-
-  vtx = vtx_id_to_handle[nodeid];
-
-  MV_Coords(vtx, coords);
-  (*ncoords)[0] = coords[0];
-  (*ncoords)[1] = coords[1];
-  (*ncoords)[2] = coords[2];
-}
-
-void Mesh_MSTK::node_get_coordinates(const Entity_ID nodeid,
-                                     std::array<double, 2> *ncoords) const {
-  MEntity_ptr vtx;
-  double coords[3];
-  int spdim = space_dimension();
 
-  assert(ncoords != NULL);
-  assert(spdim == 2);
-
-  vtx = vtx_id_to_handle[nodeid];
-
-  MV_Coords(vtx, coords);
-  (*ncoords)[0] = coords[0];
-  (*ncoords)[1] = coords[1];
-}
-
-
-// Coordinates of cells in standard order (Exodus II convention)
-// STANDARD CONVENTION WORKS ONLY FOR STANDARD Entity_kind::CELL TYPES IN 3D
-// For a general polyhedron this will return the node coordinates in
-// arbitrary order
-// Number of nodes is vector size divided by number of spatial dimensions
-
-void Mesh_MSTK::cell_get_coordinates(const Entity_ID cellid,
-                                     std::vector<JaliGeometry::Point> *ccoords)
-    const {
-  MEntity_ptr cell;
-  double coords[3];
-  int nn;
-  int spdim = space_dimension(), celldim = manifold_dimension();
-
-  assert(ccoords != NULL);
-
-  cell = cell_id_to_handle[cellid];
-
-  if (celldim == 3) {
-    List_ptr rverts = MR_Vertices(cell);
-
-    nn = List_Num_Entries(rverts);
-
-    ccoords->resize(nn);
-    std::vector<JaliGeometry::Point>::iterator it = ccoords->begin();
-
-    for (int i = 0; i < nn; ++i) {
-      MV_Coords(List_Entry(rverts, i), coords);
-      it->set(spdim, coords);  // same as (*it).set()
-      ++it;
-    }
-
-    List_Delete(rverts);
-  } else if (celldim == 2) {
-    List_ptr fverts = MF_Vertices(cell, 1, 0);
-
-    nn = List_Num_Entries(fverts);
-
-    ccoords->resize(nn);
-    std::vector<JaliGeometry::Point>::iterator it = ccoords->begin();
-
-    for (int i = 0; i < nn; ++i) {
-      MV_Coords(List_Entry(fverts, i), coords);
-      it->set(spdim, coords);  // same as (*it).set()
-      ++it;
-    }
-
-    List_Delete(fverts);
-  }
-
-}  // Mesh_MSTK::cell_get_coordinates
-
-
-
-
-// Face coordinates - conventions same as face_to_nodes call
-// Number of nodes is the vector size divided by number of spatial dimensions
-
-void Mesh_MSTK::face_get_coordinates(const Entity_ID faceid,
-                                     std::vector<JaliGeometry::Point> *fcoords)
-    const {
-  MEntity_ptr genface;
-  double coords[3];
-  int spdim = space_dimension(), celldim = manifold_dimension();
-
-  assert(faces_initialized);
-  assert(fcoords != NULL);
-
-  genface = face_id_to_handle[faceid];
-
-  if (celldim == 3) {
-    int dir = !faceflip[faceid];
-
-    List_ptr fverts = MF_Vertices((MFace_ptr) genface, dir, 0);
-
-    int nn = List_Num_Entries(fverts);
-    fcoords->resize(nn);
-    std::vector<JaliGeometry::Point>::iterator it = fcoords->begin();
-
-    for (int i = 0; i < nn; ++i) {
-      MV_Coords(List_Entry(fverts, i), coords);
-      it->set(spdim, coords);  // same as (*it).set()
-      ++it;
-    }
-
-    List_Delete(fverts);
-  } else {  // Planar mesh or Surface mesh embedded in 3D
-    MVertex_ptr ev[2];
-    if (!faceflip[faceid]) {
-      ev[0] = ME_Vertex((MEdge_ptr)genface, 0);
-      ev[1] = ME_Vertex((MEdge_ptr)genface, 1);
-    } else {
-      ev[1] = ME_Vertex((MEdge_ptr)genface, 0);
-      ev[0] = ME_Vertex((MEdge_ptr)genface, 1);
-    }
-
-    fcoords->resize(2);
-
-    MV_Coords(ev[0], coords);
-    ((*fcoords)[0]).set(spdim, coords);
-
-    MV_Coords(ev[1], coords);
-    ((*fcoords)[1]).set(spdim, coords);
-  }
+// Modify a node's coordinates in MSTK (always 3 values)
 
-}  // Mesh_MSTK::face_get_coordinates
-
-
-
-// Modify a node's coordinates
-
-void Mesh_MSTK::node_set_coordinates(const Jali::Entity_ID nodeid,
-                                      const double *coords) {
+void Mesh_MSTK::node_set_coordinates_internal(const Jali::Entity_ID nodeid,
+                                              const double *coords) const {
   MVertex_ptr v = vtx_id_to_handle[nodeid];
   MV_Set_Coords(v, (double *) coords);
 }
 
-void Mesh_MSTK::node_set_coordinates(const Jali::Entity_ID nodeid,
-                                     const JaliGeometry::Point coords) {
-  MVertex_ptr v = vtx_id_to_handle[nodeid];
-
-  double coordarray[3] = {0.0, 0.0, 0.0};
-  for (int i = 0; i < Mesh::space_dimension(); i++)
-    coordarray[i] = coords[i];
-
-  MV_Set_Coords(v, (double *) coordarray);
-}
-
 
 // std::shared_ptr<MeshSet>
 // Mesh_MSTK::build_set(const JaliGeometry::RegionPtr region,
@@ -3359,32 +3270,72 @@ Entity_ID Mesh_MSTK::GID(const Entity_ID lid, const Entity_kind kind) const {
 // Procedure to perform all the post-mesh creation steps in a constructor
 
 void Mesh_MSTK::post_create_steps_() {
+  // Every step is timed as a phase of the construction if requested
+
+  Phase_profile *profiler = construction_profiler();
+
   // Create boundary ghost elements (if requested). Regardless of what
   // the requested number of layers is, we will create only 1 layer
 
-  if (Mesh::boundary_ghosts_requested_)
+  if (Mesh::boundary_ghosts_requested_) {
+    Phase_timer timer(profiler, "create_boundary_ghosts");
     create_boundary_ghosts();
+  }
 
   // label cells to indicate if they are one of the standard element
   // types (tet, hex, prism) or if they are general polytopes
-  label_celltype();
+  {
+    Phase_timer timer(profiler, "label_celltype");
+    label_celltype();
+  }
+
+  // Order the entities if they are to be renumbered
+
+  if (Mesh::renumbering() != Renumbering_type::NONE) {
+    Phase_timer timer(profiler, "order_entities");
+    order_entities();
+  }
 
   // Initialize data structures for various entities - vertices/nodes
   // and cells are always initialized; edges and faces only if
   // requested
 
-  init_nodes();
-  if (Mesh::edges_requested) init_edges();
-  if (Mesh::faces_requested) init_faces();
-  init_cells();
+  {
+    Phase_timer timer(profiler, "init_nodes");
+    init_nodes();
+  }
+  if (Mesh::edges_requested) {
+    Phase_timer timer(profiler, "init_edges");
+    init_edges();
+  }
+  if (Mesh::faces_requested) {
+    Phase_timer timer(profiler, "init_faces");
+    init_faces();
+  }
+  {
+    Phase_timer timer(profiler, "init_cells");
+    init_cells();
+  }
 
-  if (Mesh::geometric_model() != NULL)
+  if (Mesh::renumbering() != Renumbering_type::NONE) {
+    Phase_timer timer(profiler, "init_entity_renumbering");
+    init_entity_renumbering();
+  }
+
+  if (Mesh::geometric_model() != NULL) {
+    Phase_timer timer(profiler, "init_set_info");
     init_set_info();
+  }
 
-  cache_extra_variables();
+  {
+    Phase_timer timer(profiler, "cache_extra_variables");
+    cache_extra_variables();
+  }
 
-  if (Mesh::num_tiles_ini_)
+  if (Mesh::num_tiles_ini_) {
+    Phase_timer timer(profiler, "build_tiles");
     Mesh::build_tiles();
+  }
 }
 
 
@@ -3732,6 +3683,241 @@ void Mesh_MSTK::init_cell_id2handle_maps() {
 }  // Mesh_MSTK::init_id_handle_maps
 
 
+// Next entity of a kind in the mesh (in 2D the faces are MSTK edges
+// and the cells are MSTK faces)
+
+MEntity_ptr Mesh_MSTK::mesh_next_entity(const Entity_kind kind,
+                                        int *idx) const {
+  bool const solid = (manifold_dimension() == 3);
+  switch (kind) {
+    case Entity_kind::NODE: return MESH_Next_Vertex(mesh, idx);
+    case Entity_kind::EDGE: return MESH_Next_Edge(mesh, idx);
+    case Entity_kind::FACE:
+      return solid ? MESH_Next_Face(mesh, idx) : MESH_Next_Edge(mesh, idx);
+    case Entity_kind::CELL:
+      return solid ? MESH_Next_Region(mesh, idx) : MESH_Next_Face(mesh, idx);
+    default: return NULL;
+  }
+}
+
+
+// Next entity of a kind in the order in which the entities are
+// numbered
+
+MEntity_ptr Mesh_MSTK::next_entity(const Entity_kind kind, int *idx) const {
+  std::vector<MEntity_ptr> const& order = entity_order_[static_cast<int>(kind)];
+  if (order.empty())
+    return mesh_next_entity(kind, idx);
+  return (*idx < static_cast<int>(order.size())) ? order[(*idx)++] : NULL;
+}
+
+
+// Order the entities as requested for renumbering. The cells are
+// ordered along a space filling curve through their centroids or by
+// reverse Cuthill-McKee on the graph of face connected cells and the
+// nodes, edges and faces in the order in which they are first
+// reached from the ordered cells. The MSTK IDs are used as scratch
+// space here - they are reset when the Jali IDs are assigned
+
+void Mesh_MSTK::order_entities() {
+  Renumbering_type const type = Mesh::renumbering();
+  if (type == Renumbering_type::NONE) return;
+
+  int const celldim = manifold_dimension();
+  int idx;
+  MEntity_ptr ent;
+
+  // Entities of a kind in the mesh order, numbered consecutively
+
+  auto mesh_entities = [&](const Entity_kind kind)
+      -> std::vector<MEntity_ptr> {
+    std::vector<MEntity_ptr> ents;
+    int jdx = 0;
+    MEntity_ptr e;
+    while ((e = mesh_next_entity(kind, &jdx))) {
+      ents.push_back(e);
+      MEnt_Set_ID(e, ents.size());
+    }
+    return ents;
+  };
+
+  // Nodes, edges or faces of a cell
+
+  auto cell_entities = [&](MEntity_ptr cell, const Entity_kind kind)
+      -> List_ptr {
+    if (celldim == 3) {
+      if (kind == Entity_kind::NODE) return MR_Vertices((MRegion_ptr) cell);
+      if (kind == Entity_kind::EDGE) return MR_Edges((MRegion_ptr) cell);
+      return MR_Faces((MRegion_ptr) cell);
+    } else {
+      if (kind == Entity_kind::NODE)
+        return MF_Vertices((MFace_ptr) cell, 1, 0);
+      return MF_Edges((MFace_ptr) cell, 1, 0);
+    }
+  };
+
+  std::vector<MEntity_ptr> cells = mesh_entities(Entity_kind::CELL);
+  int const nc = cells.size();
+  std::vector<int> order;
+
+  if (type == Renumbering_type::RCM) {
+    // Graph of cells connected through faces
+
+    std::vector<int> offsets(nc+1, 0), adjacency;
+    for (int c = 0; c < nc; c++) {
+      List_ptr cfaces = cell_entities(cells[c], Entity_kind::FACE);
+      idx = 0;
+      while ((ent = List_Next_Entry(cfaces, &idx))) {
+        List_ptr fcells = (celldim == 3) ? MF_Regions((MFace_ptr) ent) :
+            ME_Faces((MEdge_ptr) ent);
+        int idx2 = 0;
+        MEntity_ptr ent2;
+        while ((ent2 = List_Next_Entry(fcells, &idx2)))
+          if (ent2 != cells[c])
+            adjacency.push_back(MEnt_ID(ent2)-1);
+        List_Delete(fcells);
+      }
+      List_Delete(cfaces);
+      offsets[c+1] = adjacency.size();
+    }
+
+    reverse_cuthill_mckee_order(offsets, adjacency, &order);
+  } else {
+    // Cell centroids (average of the cell nodes)
+
+    int const dim = space_dimension();
+    std::vector<double> xyz(dim*nc, 0.0);
+    for (int c = 0; c < nc; c++) {
+      List_ptr cverts = cell_entities(cells[c], Entity_kind::NODE);
+      int const nv = List_Num_Entries(cverts);
+      idx = 0;
+      while ((ent = List_Next_Entry(cverts, &idx))) {
+        double vxyz[3];
+        MV_Coords((MVertex_ptr) ent, vxyz);
+        for (int d = 0; d < dim; d++)
+          xyz[dim*c+d] += vxyz[d]/nv;
+      }
+      List_Delete(cverts);
+    }
+
+    space_filling_curve_order(type, dim, xyz, &order);
+  }
+
+  std::vector<MEntity_ptr>& cell_order =
+      entity_order_[static_cast<int>(Entity_kind::CELL)];
+  cell_order.resize(nc);
+  for (int c = 0; c < nc; c++)
+    cell_order[c] = cells[order[c]];
+
+  // Nodes, edges and faces by first touch from the ordered cells
+  // followed by any entities not connected to a cell. In 2D the edges
+  // and faces are the same entities
+
+  Entity_kind const kinds[3] = {Entity_kind::NODE, Entity_kind::FACE,
+                                Entity_kind::EDGE};
+  for (Entity_kind const kind : kinds) {
+    std::vector<MEntity_ptr>& ent_order =
+        entity_order_[static_cast<int>(kind)];
+
+    if (kind == Entity_kind::EDGE) {
+      if (!Mesh::edges_requested) continue;
+      if (celldim == 2) {
+        ent_order = entity_order_[static_cast<int>(Entity_kind::FACE)];
+        continue;
+      }
+    }
+
+    std::vector<MEntity_ptr> ents = mesh_entities(kind);
+    std::vector<char> touched(ents.size(), 0);
+    ent_order.reserve(ents.size());
+
+    for (auto const& cell : cell_order) {
+      List_ptr centities = cell_entities(cell, kind);
+      idx = 0;
+      while ((ent = List_Next_Entry(centities, &idx))) {
+        int const i = MEnt_ID(ent)-1;
+        if (!touched[i]) {
+          touched[i] = 1;
+          ent_order.push_back(ent);
+        }
+      }
+      List_Delete(centities);
+    }
+    for (int i = 0; i < static_cast<int>(ents.size()); i++)
+      if (!touched[i]) ent_order.push_back(ents[i]);
+  }
+}
+
+
+// Record the old to new ID maps of the renumbered entities in the
+// base class. The old ID of an entity is the ID it would have had
+// without renumbering, i.e. its position among the owned (then
+// ghost, then boundary ghost) entities in the mesh order
+
+void Mesh_MSTK::init_entity_renumbering() {
+  if (Mesh::renumbering() == Renumbering_type::NONE) return;
+
+  Entity_kind const kinds[4] = {Entity_kind::NODE, Entity_kind::EDGE,
+                                Entity_kind::FACE, Entity_kind::CELL};
+  for (Entity_kind const kind : kinds) {
+    if ((kind == Entity_kind::EDGE && !edges_initialized) ||
+        (kind == Entity_kind::FACE && !faces_initialized))
+      continue;
+
+    auto group = [&](MEntity_ptr ent) -> int {
+      if (MEnt_PType(ent) == PGHOST) return 1;
+      if (kind == Entity_kind::CELL && Mesh::boundary_ghosts_requested_) {
+        int is_boundary_ghost = 0;
+        double rval;
+        void *pval;
+        MEnt_Get_AttVal(ent, boundary_ghost_att, &is_boundary_ghost,
+                        &rval, &pval);
+        if (is_boundary_ghost) return 2;
+      }
+      return 0;
+    };
+
+    int const n = entity_order_[static_cast<int>(kind)].size();
+    std::vector<Entity_ID> new_to_old(n);
+    int oldid = 0;
+    for (int g = 0; g < 3; g++) {
+      int idx = 0;
+      MEntity_ptr ent;
+      while ((ent = mesh_next_entity(kind, &idx)))
+        if (group(ent) == g)
+          new_to_old[MEnt_ID(ent)-1] = oldid++;
+    }
+
+    Mesh::set_entity_renumbering(kind, new_to_old);
+  }
+
+  for (auto& order : entity_order_)
+    std::vector<MEntity_ptr>().swap(order);
+}
+
+
+void Mesh_MSTK::framework_memory_report(Memory_report *report) const {
+  report->add("framework/id_to_handle", vtx_id_to_handle);
+  report->add("framework/id_to_handle", edge_id_to_handle);
+  report->add("framework/id_to_handle", face_id_to_handle);
+  report->add("framework/id_to_handle", cell_id_to_handle);
+  for (auto const& order : entity_order_)
+    report->add("framework/entity_order", order);
+
+  // The flip flags have one entry per face and per edge (as for the
+  // deletes in the destructor, they exist only if requested)
+
+  std::size_t nflags = 0;
+  if (Mesh::faces_requested)
+    nflags += (manifold_dimension() == 2) ?
+        MESH_Num_Edges(mesh) : MESH_Num_Faces(mesh);
+  if (Mesh::edges_requested)
+    nflags += MESH_Num_Edges(mesh);
+  report->add("framework/flip_flags", nflags*sizeof(bool),
+              nflags*sizeof(bool));
+}
+
+
 // create lists of owned and not owned vertices
 
 void Mesh_MSTK::init_pvert_lists() {
@@ -3744,7 +3930,7 @@ void Mesh_MSTK::init_pvert_lists() {
   OwnedVerts = MSet_New(mesh, "OwnedVerts", MVERTEX);
 
   idx = 0;
-  while ((vtx = MESH_Next_Vertex(mesh, &idx))) {
+  while ((vtx = next_entity(Entity_kind::NODE, &idx))) {
     if (MV_PType(vtx) == PGHOST)
       MSet_Add(NotOwnedVerts, vtx);
     else
@@ -3766,7 +3952,7 @@ void Mesh_MSTK::init_pedge_lists() {
   OwnedEdges = MSet_New(mesh, "OwnedEdges", MEDGE);
 
   idx = 0;
-  while ((edge = MESH_Next_Edge(mesh, &idx))) {
+  while ((edge = next_entity(Entity_kind::EDGE, &idx))) {
     if (ME_PType(edge) == PGHOST)
       MSet_Add(NotOwnedEdges, edge);
     else
@@ -3807,7 +3993,10 @@ void Mesh_MSTK::init_pedge_dirs() {
     }
 
 
-    MESH_UpdateAttributes(mesh, mpicomm);
+    {
+      Phase_timer timer(construction_profiler(), "update_attributes");
+      MESH_UpdateAttributes(mesh, mpicomm);
+    }
 
 
     edgeflip = new bool[ne];
@@ -3863,7 +4052,7 @@ void Mesh_MSTK::init_pface_lists() {
     OwnedFaces = MSet_New(mesh, "OwnedFaces", MFACE);
 
     idx = 0;
-    while ((face = MESH_Next_Face(mesh, &idx))) {
+    while ((face = next_entity(Entity_kind::FACE, &idx))) {
       if (MF_PType(face) == PGHOST)
         MSet_Add(NotOwnedFaces, face);
       else
@@ -3877,7 +4066,7 @@ void Mesh_MSTK::init_pface_lists() {
     OwnedFaces = MSet_New(mesh, "OwnedFaces", MEDGE);
 
     idx = 0;
-    while ((edge = MESH_Next_Edge(mesh, &idx))) {
+    while ((edge = next_entity(Entity_kind::FACE, &idx))) {
       if (ME_PType(edge) == PGHOST)
         MSet_Add(NotOwnedFaces, edge);
       else
@@ -3944,7 +4133,10 @@ void Mesh_MSTK::init_pface_dirs_3() {
     }
   }
 
-  MESH_UpdateAttributes(mesh, mpicomm);
+  {
+    Phase_timer timer(construction_profiler(), "update_attributes");
+    MESH_UpdateAttributes(mesh, mpicomm);
+  }
 
 
   faceflip = new bool[nf];
@@ -4014,7 +4206,10 @@ void Mesh_MSTK::init_pface_dirs_2() {
     }
   }
 
-  MESH_UpdateAttributes(mesh, mpicomm);
+  {
+    Phase_timer timer(construction_profiler(), "update_attributes");
+    MESH_UpdateAttributes(mesh, mpicomm);
+  }
 
   faceflip = new bool[ne];
   for (int i = 0; i < ne; ++i) faceflip[i] = false;
@@ -4060,7 +4255,7 @@ void Mesh_MSTK::init_pcell_lists() {
     BoundaryGhostCells = MSet_New(mesh, "BoundaryGhostCells", MREGION);
 
     idx = 0;
-    while ((region = MESH_Next_Region(mesh, &idx))) {
+    while ((region = next_entity(Entity_kind::CELL, &idx))) {
       if (MR_PType(region) == PGHOST)
         MSet_Add(GhostCells, region);
       else {
@@ -4082,7 +4277,7 @@ void Mesh_MSTK::init_pcell_lists() {
     BoundaryGhostCells = MSet_New(mesh, "BoundaryGhostCells", MFACE);
 
     idx = 0;
-    while ((face = MESH_Next_Face(mesh, &idx))) {
+    while ((face = next_entity(Entity_kind::CELL, &idx))) {
       if (MF_PType(face) == PGHOST)
         MSet_Add(GhostCells, face);
       else {
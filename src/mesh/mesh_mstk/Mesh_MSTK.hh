@@ -106,7 +106,10 @@ class Mesh_MSTK : public Mesh {
             const Partitioner_type partitioner = Partitioner_type::METIS,
             const bool contiguous_gids = false,
             const JaliGeometry::Geom_type geom_type =
-            JaliGeometry::Geom_type::CARTESIAN);
+            JaliGeometry::Geom_type::CARTESIAN,
+            const Renumbering_type renumbering = Renumbering_type::NONE,
+            const bool implicit_subcells = false,
+            const bool profile_construction = false);
   
   // Constructors that generate a mesh internally (regular hexahedral mesh only)
 
@@ -128,7 +131,10 @@ class Mesh_MSTK : public Mesh {
             const int num_ghost_layers_distmesh = 1,
             const bool request_boundary_ghosts = false,
             const Partitioner_type partitioner = Partitioner_type::METIS,
-            const bool contiguous_gids = false);
+            const bool contiguous_gids = false,
+            const Renumbering_type renumbering = Renumbering_type::NONE,
+            const bool implicit_subcells = false,
+            const bool profile_construction = false);
 
 
   // 2D
@@ -150,7 +156,10 @@ class Mesh_MSTK : public Mesh {
             const Partitioner_type partitioner = Partitioner_type::METIS,
             const bool contiguous_gids = false,
             const JaliGeometry::Geom_type geom_type =
-            JaliGeometry::Geom_type::CARTESIAN);
+            JaliGeometry::Geom_type::CARTESIAN,
+            const Renumbering_type renumbering = Renumbering_type::NONE,
+            const bool implicit_subcells = false,
+            const bool profile_construction = false);
 
   // Construct a mesh by extracting a subset of entities from another
   // mesh. The subset may be specified by a setname or a list of
@@ -258,8 +267,8 @@ class Mesh_MSTK : public Mesh {
   // In 2D, the nodes of the polygon will be returned in ccw order
   // consistent with the face normal
 
-  void cell_get_nodes(const Entity_ID cellid,
-                      Entity_ID_List *nodeids) const;
+  void cell_get_nodes_internal(const Entity_ID cellid,
+                               Entity_ID_List *nodeids) const;
 
 
   // Get nodes of face
@@ -269,8 +278,8 @@ class Mesh_MSTK : public Mesh {
   // with the face normal
   // In 2D, nfnodes is 2
 
-  void face_get_nodes(const Entity_ID faceid,
-                      Entity_ID_List *nodeids) const;
+  void face_get_nodes_internal(const Entity_ID faceid,
+                               Entity_ID_List *nodeids) const;
 
 
   // Get nodes of edge On a distributed mesh all nodes (Entity_type::PARALLEL_OWNED or
@@ -284,15 +293,15 @@ class Mesh_MSTK : public Mesh {
 
   // Cells of type 'ptype' connected to a node
 
-  void node_get_cells(const Entity_ID nodeid,
-                      const Entity_type ptype,
-                      Entity_ID_List *cellids) const;
+  void node_get_cells_internal(const Entity_ID nodeid,
+                               const Entity_type ptype,
+                               Entity_ID_List *cellids) const;
 
   // Faces of type 'ptype' connected to a node
 
-  void node_get_faces(const Entity_ID nodeid,
-                      const Entity_type ptype,
-                      Entity_ID_List *faceids) const;
+  void node_get_faces_internal(const Entity_ID nodeid,
+                               const Entity_type ptype,
+                               Entity_ID_List *faceids) const;
 
   // Get faces of ptype of a particular cell that are connected to the
   // given node
@@ -314,17 +323,17 @@ class Mesh_MSTK : public Mesh {
   // the cellids will correcpond to cells across the respective
   // faces given by cell_get_faces
 
-  void cell_get_face_adj_cells(const Entity_ID cellid,
-                               const Entity_type ptype,
-                               Entity_ID_List *fadj_cellids) const;
+  void cell_get_face_adj_cells_internal(const Entity_ID cellid,
+                                        const Entity_type ptype,
+                                        Entity_ID_List *fadj_cellids) const;
 
   // Node connected neighboring cells of given cell
   // (a hex in a structured mesh has 26 node connected neighbors)
   // The cells are returned in no particular order
 
-  void cell_get_node_adj_cells(const Entity_ID cellid,
-                               const Entity_type ptype,
-                               Entity_ID_List *nadj_cellids) const;
+  void cell_get_node_adj_cells_internal(const Entity_ID cellid,
+                                        const Entity_type ptype,
+                                        Entity_ID_List *nadj_cellids) const;
 
 
   //
@@ -332,38 +341,18 @@ class Mesh_MSTK : public Mesh {
   //--------------
   //
 
-  // Node coordinates - 3 in 3D and 2 in 2D
-
-  void node_get_coordinates(const Entity_ID nodeid,
-                            JaliGeometry::Point *ncoord) const;
-  void node_get_coordinates(const Entity_ID nodeid,
-                            std::array<double, 3> *ncoord) const;
-  void node_get_coordinates(const Entity_ID nodeid,
-                            std::array<double, 2> *ncoord) const;
-
+  // Node coordinates - 3 in 3D and 2 in 2D (cached in the base class)
 
+  void node_get_coordinates_internal(const Entity_ID nodeid,
+                                     JaliGeometry::Point *ncoord) const;
 
-  // Face coordinates - conventions same as face_to_nodes call
-  // Number of nodes is the vector size divided by number of spatial dimensions
 
-  void face_get_coordinates(const Entity_ID faceid,
-                            std::vector<JaliGeometry::Point> *fcoords) const;
 
-  // Coordinates of cells in standard order (Exodus  II convention)
-  // STANDARD CONVENTION WORKS ONLY FOR STANDARD Entity_kind::CELL TYPES IN 3D
-  // For a general polyhedron this will return the node coordinates in
-  // arbitrary order
-  // Number of nodes is vector size divided by number of spatial dimensions
-
-  void cell_get_coordinates(const Entity_ID cellid,
-                            std::vector<JaliGeometry::Point> *ccoords) const;
-
-  // Modify the coordinates of a node
+  // Modify the coordinates of a node in MSTK (see
+  // Mesh::node_set_coordinates)
 
-  void node_set_coordinates(const Entity_ID nodeid,
-                            const JaliGeometry::Point coords);
-
-  void node_set_coordinates(const Entity_ID nodeid, const double *coords);
+  void node_set_coordinates_internal(const Entity_ID nodeid,
+                                     const double *coords) const;
 
 
 
@@ -404,6 +393,7 @@ class Mesh_MSTK : public Mesh {
 
   void write_to_exodus_file(const std::string exodusfilename,
                             bool with_fields = true) const {
+    update_framework_node_coordinates();
     if (with_fields)
       MESH_ExportToFile(mesh, exodusfilename.c_str(), "exodusii", 0, NULL,
                         NULL, mpicomm);
@@ -419,6 +409,7 @@ class Mesh_MSTK : public Mesh {
 
   void write_to_gmv_file(const std::string gmvfilename,
                          bool with_fields = true) const {
+    update_framework_node_coordinates();
     if (with_fields)
       MESH_ExportToFile(mesh, gmvfilename.c_str(), "gmv", 0, NULL, NULL,
                         mpicomm);
@@ -576,6 +567,22 @@ class Mesh_MSTK : public Mesh {
   void init_edge_map();
   void init_node_map();
 
+  // Renumbering of entities - order the cells as requested and the
+  // nodes, edges and faces by first touch from the ordered cells
+  // before the IDs are assigned, and record the old/new ID maps in
+  // the base class after
+
+  void order_entities();
+  void init_entity_renumbering();
+  MEntity_ptr mesh_next_entity(const Entity_kind kind, int *idx) const;
+  MEntity_ptr next_entity(const Entity_kind kind, int *idx) const;
+
+  // Memory held by the Jali side of the framework - the ID to handle
+  // maps and the flip flags. The storage of the MSTK entities
+  // themselves is not visible from here
+
+  void framework_memory_report(Memory_report *report) const;
+
   void init_nodes();
   void init_edges();
   void init_faces();
@@ -800,6 +807,13 @@ class Mesh_MSTK : public Mesh {
   bool entities_deleted;
   List_ptr deleted_vertices, deleted_edges, deleted_faces, deleted_regions;
 
+  // Entities of each kind (NODE, EDGE, FACE, CELL) in the order in
+  // which they are numbered if the mesh is renumbered - owned and
+  // ghost entities are still numbered in separate ranges. Released
+  // once the IDs are assigned
+
+  std::vector<MEntity_ptr> entity_order_[4];
+
   // Local ID to MSTK handle map
 
   std::vector<MEntity_ptr> vtx_id_to_handle;
@@ -670,8 +670,8 @@ void Mesh_simple::cell_get_faces_and_dirs_internal(const Jali::Entity_ID cellid,
 
 
 
-void Mesh_simple::cell_get_nodes(Jali::Entity_ID cell,
-                                 Jali::Entity_ID_List *nodeids) const {
+void Mesh_simple::cell_get_nodes_internal(Jali::Entity_ID cell,
+                                          Jali::Entity_ID_List *nodeids) const {
   unsigned int offset = (unsigned int) nodes_per_cell_*cell;
 
   nodeids->clear();
@@ -683,8 +683,8 @@ void Mesh_simple::cell_get_nodes(Jali::Entity_ID cell,
 }
 
 
-void Mesh_simple::face_get_nodes(Jali::Entity_ID face,
-                                 Jali::Entity_ID_List *nodeids) const {
+void Mesh_simple::face_get_nodes_internal(Jali::Entity_ID face,
+                                          Jali::Entity_ID_List *nodeids) const {
   unsigned int offset = (unsigned int) nodes_per_face_*face;
 
   nodeids->clear();
@@ -699,65 +699,18 @@ void Mesh_simple::face_get_nodes(Jali::Entity_ID face,
 // Cooordinate Getters
 // -------------------
 
-void Mesh_simple::node_get_coordinates(const Jali::Entity_ID local_node_id,
-                                       JaliGeometry::Point *ncoords) const {
+void
+Mesh_simple::node_get_coordinates_internal(const Jali::Entity_ID local_node_id,
+                                           JaliGeometry::Point *ncoords) const {
   unsigned int offset = (unsigned int) Mesh::space_dimension()*local_node_id;
 
   ncoords->set(Mesh::space_dimension(), &(coordinates_[offset]));
 }
-void Mesh_simple::node_get_coordinates(const Jali::Entity_ID local_node_id,
-                                       std::array<double, 3> *ncoords) const {
-  assert(Mesh::space_dimension() == 3);
-  unsigned int offset = 3*local_node_id;
-  (*ncoords)[0] = coordinates_[offset];
-  (*ncoords)[1] = coordinates_[offset + 1];
-  (*ncoords)[2] = coordinates_[offset + 2];
-}
-void Mesh_simple::node_get_coordinates(const Jali::Entity_ID local_node_id,
-                                       double *ncoords) const {
-  assert(Mesh::space_dimension() == 1);
-  unsigned int offset = 1*local_node_id;
-  *ncoords = coordinates_[offset];
-}
-
-
-void Mesh_simple::face_get_coordinates(Jali::Entity_ID local_face_id,
-                                       std::vector<JaliGeometry::Point>
-                                       *fcoords) const {
-  Entity_ID_List node_indices(nodes_per_face_);
 
-  face_get_nodes(local_face_id, &node_indices);
-
-  fcoords->clear();
-
-  JaliGeometry::Point node_coords(Mesh::space_dimension());
-  for (std::vector<Entity_ID>::iterator it = node_indices.begin();
-       it != node_indices.end(); ++it) {
-    node_get_coordinates(*it, &node_coords);
-    fcoords->push_back(node_coords);
-  }
-}
 
-void Mesh_simple::cell_get_coordinates(Jali::Entity_ID local_cell_id,
-                                       std::vector<JaliGeometry::Point>
-                                       *ccoords) const {
-  std::vector<Entity_ID> node_indices(nodes_per_cell_);
-
-  cell_get_nodes(local_cell_id, &node_indices);
-
-  ccoords->clear();
-
-  JaliGeometry::Point node_coords(Mesh::space_dimension());
-  for (std::vector<Entity_ID>::iterator it = node_indices.begin();
-       it != node_indices.end(); ++it) {
-    node_get_coordinates(*it, &node_coords);
-    ccoords->push_back(node_coords);
-  }
-}
-
-
-void Mesh_simple::node_set_coordinates(const Jali::Entity_ID local_node_id,
-                                      const double *ncoord) {
+void
+Mesh_simple::node_set_coordinates_internal(const Jali::Entity_ID local_node_id,
+                                           const double *ncoord) const {
   int spdim = Mesh::space_dimension();
   unsigned int offset = (unsigned int) spdim*local_node_id;
 
@@ -772,23 +725,10 @@ void Mesh_simple::node_set_coordinates(const Jali::Entity_ID local_node_id,
   }
 }
 
-void Mesh_simple::node_set_coordinates(const Jali::Entity_ID local_node_id,
-                                       const JaliGeometry::Point ncoord) {
-  int spdim = Mesh::space_dimension();
-  unsigned int offset = (unsigned int) spdim*local_node_id;
-
-  std::vector<double>::iterator destination_begin = coordinates_.begin()
-      + offset;
-  for (int i = 0; i < spdim; i++) {
-    *destination_begin = ncoord[i];
-    destination_begin++;
-  }
-}
 
-
-void Mesh_simple::node_get_cells(const Jali::Entity_ID nodeid,
-                                 const Jali::Entity_type ptype,
-                                 Jali::Entity_ID_List *cellids) const {
+void Mesh_simple::node_get_cells_internal(const Jali::Entity_ID nodeid,
+                                          const Jali::Entity_type ptype,
+                                          Jali::Entity_ID_List *cellids) const {
   unsigned int offset = (unsigned int) cells_per_node_aug_*nodeid;
   unsigned int ncells = node_to_cell_[offset];
 
@@ -800,9 +740,9 @@ void Mesh_simple::node_get_cells(const Jali::Entity_ID nodeid,
 
 
 // Faces of type 'ptype' connected to a node
-void Mesh_simple::node_get_faces(const Jali::Entity_ID nodeid,
-                                 const Jali::Entity_type ptype,
-                                 Jali::Entity_ID_List *faceids) const {
+void Mesh_simple::node_get_faces_internal(const Jali::Entity_ID nodeid,
+                                          const Jali::Entity_type ptype,
+                                          Jali::Entity_ID_List *faceids) const {
   unsigned int offset = (unsigned int) faces_per_node_aug_*nodeid;
   unsigned int nfaces = node_to_face_[offset];
 
@@ -867,10 +807,9 @@ void Mesh_simple::face_get_cells_internal(const Jali::Entity_ID faceid,
 // the cellids will correcpond to cells across the respective
 // faces given by cell_get_faces
 
-void Mesh_simple::cell_get_face_adj_cells(const Jali::Entity_ID cellid,
-                                          const Jali::Entity_type ptype,
-                                          Jali::Entity_ID_List
-                                          *fadj_cellids) const {
+void Mesh_simple::cell_get_face_adj_cells_internal(
+    const Jali::Entity_ID cellid, const Jali::Entity_type ptype,
+    Jali::Entity_ID_List *fadj_cellids) const {
   unsigned int offset = (unsigned int) faces_per_cell_*cellid;
 
   fadj_cellids->clear();
@@ -897,10 +836,9 @@ void Mesh_simple::cell_get_face_adj_cells(const Jali::Entity_ID cellid,
 // (a hex in a structured mesh has 26 node connected neighbors)
 // The cells are returned in no particular order
 
-void Mesh_simple::cell_get_node_adj_cells(const Jali::Entity_ID cellid,
-                                          const Jali::Entity_type ptype,
-                                          Jali::Entity_ID_List
-                                          *nadj_cellids) const {
+void Mesh_simple::cell_get_node_adj_cells_internal(
+    const Jali::Entity_ID cellid, const Jali::Entity_type ptype,
+    Jali::Entity_ID_List *nadj_cellids) const {
   unsigned int offset = (unsigned int) nodes_per_cell_*cellid;
 
   nadj_cellids->clear();
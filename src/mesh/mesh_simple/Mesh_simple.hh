@@ -214,8 +214,8 @@ public:
   // arbitrary order
   // In 2D, the nodes of the polygon will be returned in ccw order
   // consistent with the face normal
-  void cell_get_nodes(const Entity_ID cellid,
-                      std::vector<Entity_ID> *nodeids) const;
+  void cell_get_nodes_internal(const Entity_ID cellid,
+                               std::vector<Entity_ID> *nodeids) const;
 
   // Get nodes of face
   // On a distributed mesh, all nodes (OWNED or GHOST) of the face
@@ -223,8 +223,8 @@ public:
   // In 3D, the nodes of the face are returned in ccw order consistent
   // with the face normal
   // In 2D, nfnodes is 2
-  void face_get_nodes(const Entity_ID faceid,
-                      std::vector<Entity_ID> *nodeids) const;
+  void face_get_nodes_internal(const Entity_ID faceid,
+                               std::vector<Entity_ID> *nodeids) const;
 
   // Get nodes of edge
 
@@ -246,14 +246,14 @@ public:
   //-------------------
 
   // Cells of type 'ptype' connected to a node
-  void node_get_cells(const Entity_ID nodeid,
-                      const Entity_type ptype,
-                      std::vector<Entity_ID> *cellids) const;
+  void node_get_cells_internal(const Entity_ID nodeid,
+                               const Entity_type ptype,
+                               std::vector<Entity_ID> *cellids) const;
 
   // Faces of type 'ptype' connected to a node
-  void node_get_faces(const Entity_ID nodeid,
-                      const Entity_type ptype,
-                      std::vector<Entity_ID> *faceids) const;
+  void node_get_faces_internal(const Entity_ID nodeid,
+                               const Entity_type ptype,
+                               std::vector<Entity_ID> *faceids) const;
 
   // Get faces of ptype of a particular cell that are connected to the
   // given node
@@ -273,53 +273,33 @@ public:
   // the cellids will correcpond to cells across the respective
   // faces given by cell_get_faces
 
-  void cell_get_face_adj_cells(const Entity_ID cellid,
-                               const Entity_type ptype,
-                               std::vector<Entity_ID> *fadj_cellids) const;
+  void cell_get_face_adj_cells_internal(const Entity_ID cellid,
+                                        const Entity_type ptype,
+                                        std::vector<Entity_ID>
+                                        *fadj_cellids) const;
 
   // Node connected neighboring cells of given cell
   // (a hex in a structured mesh has 26 node connected neighbors)
   // The cells are returned in no particular order
 
-  void cell_get_node_adj_cells(const Entity_ID cellid,
-                               const Entity_type ptype,
-                               std::vector<Entity_ID> *nadj_cellids) const;
+  void cell_get_node_adj_cells_internal(const Entity_ID cellid,
+                                        const Entity_type ptype,
+                                        std::vector<Entity_ID>
+                                        *nadj_cellids) const;
 
   //
   // Mesh entity geometry
   //--------------
   //
 
-  // Node coordinates - 3 in 3D and 2 in 2D
-  void node_get_coordinates(const Entity_ID nodeid,
-                            JaliGeometry::Point *ncoord) const;
-
-  // Node coordinates - 3D points
-  void node_get_coordinates(const Entity_ID nodeid,
-                            std::array<double, 3> *ncoord) const;
-  // Node coordinates - 1D points
-  void node_get_coordinates(const Entity_ID nodeid, double *ncoord) const;
-
-  // Face coordinates - conventions same as face_to_nodes call
-  // Number of nodes is the vector size divided by number of spatial dimensions
-  void face_get_coordinates(const Entity_ID faceid,
-                            std::vector<JaliGeometry::Point> *fcoords) const;
-
-  // Coordinates of cells in standard order (Exodus II convention)
-  // STANDARD CONVENTION WORKS ONLY FOR STANDARD Entity_kind::CELL TYPES IN 3D
-  // For a general polyhedron this will return the node coordinates in
-  // arbitrary order
-  // Number of nodes is vector size divided by number of spatial dimensions
-
-  void cell_get_coordinates(const Entity_ID cellid,
-                            std::vector<JaliGeometry::Point> *ccoords) const;
-
-  // Modify the coordinates of a node
+  // Node coordinates - 3 in 3D and 1 in 1D (cached in the base class)
+  void node_get_coordinates_internal(const Entity_ID nodeid,
+                                     JaliGeometry::Point *ncoord) const;
 
-  void node_set_coordinates(const Entity_ID nodeid,
-                            const JaliGeometry::Point coords);
+  // Modify the coordinates of a node (see Mesh::node_set_coordinates)
 
-  void node_set_coordinates(const Entity_ID nodeid, const double *coords);
+  void node_set_coordinates_internal(const Entity_ID nodeid,
+                                     const double *coords) const;
 
 
   // this should be used with extreme caution:
@@ -356,7 +336,9 @@ public:
   void clear_internals_3d_();
   void clear_internals_1d_();
 
-  std::vector<double> coordinates_;
+  // Initial node coordinates. The base class caches them and updates
+  // this copy only when it is needed (see node_set_coordinates_internal)
+  mutable std::vector<double> coordinates_;
 
   inline unsigned int node_index_(int i, int j, int k) const;
   inline unsigned int xyface_index_(int i, int j, int k) const;
@@ -0,0 +1,191 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _JALI_MESH_THREADS_H_
+#define _JALI_MESH_THREADS_H_
+
+// Minimal on-node threading support used to build the cached
+// connectivity and geometric info of a mesh. The threading backend
+// is chosen at configure time (Jali_THREADS=NONE, OPENMP or
+// STDTHREAD); without one, everything runs on the calling thread.
+// With STDTHREAD, the chunks are executed by the persistent
+// Thread_pool (thread_pool.hh) rather than by new threads.
+//
+// Work is split into contiguous chunks that depend only on the
+// number of items and the number of threads, so two loops over the
+// same range see the same chunks. This is what lets the per-thread
+// counts of one loop be turned into per-thread starting offsets
+// (prefix sum) for a second loop, making the results identical to a
+// serial run
+
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+
+#if defined(Jali_HAVE_OPENMP)
+#include <omp.h>
+#elif defined(Jali_HAVE_STDTHREAD)
+#include <thread>
+#endif
+
+#include "thread_pool.hh"
+
+namespace Jali {
+
+//! Smallest number of items worth handing to a separate thread
+
+int const min_items_per_thread = 2048;
+
+//! Number of threads available for building mesh info. The
+//! JALI_NUM_THREADS environment variable overrides the default
+//! (OMP_NUM_THREADS/max threads for OpenMP, hardware concurrency for
+//! std::thread)
+
+inline
+int num_mesh_threads() {
+  static int const nthreads = []() {
+    int nt = 1;
+#if defined(Jali_HAVE_OPENMP)
+    nt = omp_get_max_threads();
+#elif defined(Jali_HAVE_STDTHREAD)
+    nt = std::thread::hardware_concurrency();
+#endif
+    char const *envstr = std::getenv("JALI_NUM_THREADS");
+    if (envstr) nt = std::atoi(envstr);
+    return std::max(nt, 1);
+  }();
+  return nthreads;
+}
+
+//! Number of chunks [0, n) will be split into by parallel_for_chunks
+
+inline
+int num_chunks(int const n) {
+  return std::max(1, std::min(num_mesh_threads(), n/min_items_per_thread));
+}
+
+//! Call f(ibegin, iend, ichunk) for each of num_chunks(n) contiguous
+//! chunks [ibegin, iend) of [0, n), concurrently if threading is
+//! enabled. The function must not throw
+
+template<typename F>
+void parallel_for_chunks(int const n, F const& f) {
+  int const nchunks = num_chunks(n);
+  if (nchunks == 1) {
+    f(0, n, 0);
+    return;
+  }
+
+  auto chunk_begin = [n, nchunks](int ichunk) {
+    return static_cast<int>((static_cast<long long>(n)*ichunk)/nchunks);
+  };
+
+#if defined(Jali_HAVE_OPENMP)
+#pragma omp parallel for schedule(static, 1) num_threads(nchunks)
+  for (int ichunk = 0; ichunk < nchunks; ichunk++)
+    f(chunk_begin(ichunk), chunk_begin(ichunk+1), ichunk);
+#elif defined(Jali_HAVE_STDTHREAD)
+  Thread_pool::instance().run(nchunks, [&f, &chunk_begin](int ichunk) {
+      f(chunk_begin(ichunk), chunk_begin(ichunk+1), ichunk);
+    });
+#else
+  for (int ichunk = 0; ichunk < nchunks; ichunk++)
+    f(chunk_begin(ichunk), chunk_begin(ichunk+1), ichunk);
+#endif
+}
+
+//! Call f(i) for every i in [0, n), concurrently if threading is
+//! enabled. The function must not throw
+
+template<typename F>
+void parallel_for(int const n, F const& f) {
+  parallel_for_chunks(n, [&f](int ibegin, int iend, int) {
+      for (int i = ibegin; i < iend; i++)
+        f(i);
+    });
+}
+
+//! Turn counts stored in (*offsets)[1..n] into CSR offsets, i.e.
+//! replace each entry by the running sum of the entries up to it
+//! ((*offsets)[0] is expected to be 0). Each thread sums up its
+//! chunk, the chunk sums are scanned serially and then each thread
+//! scans its chunk starting from the sum of the chunks before it.
+//! Returns the total
+
+template<typename T>
+T parallel_partial_sum(std::vector<T> *offsets) {
+  int const n = offsets->size() - 1;
+  if (n <= 0) return 0;
+
+  T *counts = offsets->data() + 1;
+
+  std::vector<T> chunk_start(num_chunks(n)+1, 0);
+  parallel_for_chunks(n, [&](int ibegin, int iend, int ichunk) {
+      T sum = 0;
+      for (int i = ibegin; i < iend; i++)
+        sum += counts[i];
+      chunk_start[ichunk+1] = sum;
+    });
+
+  for (std::size_t ichunk = 1; ichunk < chunk_start.size(); ichunk++)
+    chunk_start[ichunk] += chunk_start[ichunk-1];
+
+  parallel_for_chunks(n, [&](int ibegin, int iend, int ichunk) {
+      T sum = chunk_start[ichunk];
+      for (int i = ibegin; i < iend; i++) {
+        sum += counts[i];
+        counts[i] = sum;
+      }
+    });
+
+  return chunk_start.back();
+}
+
+}  // end namespace Jali
+
+#endif /* _JALI_MESH_THREADS_H_ */
@@ -0,0 +1,183 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "phase_profile.hh"
+
+#include <cassert>
+#include <iomanip>
+
+namespace Jali {
+
+void Phase_profile::start(std::string const& name) {
+  std::string fullname = open_.empty() ? name :
+      phases_[open_.back().first].name + "/" + name;
+
+  int iphase = 0;
+  int const nphases = phases_.size();
+  while (iphase < nphases && phases_[iphase].name != fullname)
+    iphase++;
+  if (iphase == nphases) {
+    phases_.emplace_back();
+    phases_.back().name = fullname;
+  }
+
+  open_.emplace_back(iphase, std::chrono::steady_clock::now());
+}
+
+
+void Phase_profile::stop() {
+  assert(!open_.empty());
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - open_.back().second;
+  Phase_time& phase = phases_[open_.back().first];
+  phase.seconds += elapsed.count();
+  phase.calls++;
+  open_.pop_back();
+}
+
+
+std::vector<Phase_statistics>
+Phase_profile::summary(MPI_Comm comm) const {
+  int rank, nproc;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &nproc);
+
+  // Phases are reported in the order of rank 0 - send its phase names
+  // as '\0' terminated strings to the other ranks
+
+  std::vector<char> names;
+  if (rank == 0)
+    for (auto const& phase : phases_)
+      names.insert(names.end(), phase.name.c_str(),
+                   phase.name.c_str() + phase.name.size() + 1);
+  int nchars = names.size();
+  MPI_Bcast(&nchars, 1, MPI_INT, 0, comm);
+  names.resize(nchars);
+  MPI_Bcast(names.data(), nchars, MPI_CHAR, 0, comm);
+
+  std::vector<Phase_statistics> stats;
+  int i = 0;
+  while (i < nchars) {
+    stats.emplace_back();
+    stats.back().name = std::string(&names[i]);
+    i += stats.back().name.size() + 1;
+  }
+
+  // Times of the phases on this rank (zero for phases this rank did
+  // not go through)
+
+  int const nphases = stats.size();
+  std::vector<double> mytimes(nphases, 0.0);
+  std::vector<int> mycalls(nphases, 0);
+  for (int j = 0; j < nphases; j++)
+    for (auto const& phase : phases_)
+      if (phase.name == stats[j].name) {
+        mytimes[j] = phase.seconds;
+        mycalls[j] = phase.calls;
+        break;
+      }
+
+  std::vector<double> mins(nphases), maxs(nphases), sums(nphases);
+  std::vector<int> calls(nphases);
+  MPI_Allreduce(mytimes.data(), mins.data(), nphases, MPI_DOUBLE, MPI_MIN,
+                comm);
+  MPI_Allreduce(mytimes.data(), maxs.data(), nphases, MPI_DOUBLE, MPI_MAX,
+                comm);
+  MPI_Allreduce(mytimes.data(), sums.data(), nphases, MPI_DOUBLE, MPI_SUM,
+                comm);
+  MPI_Allreduce(mycalls.data(), calls.data(), nphases, MPI_INT, MPI_MAX,
+                comm);
+
+  for (int j = 0; j < nphases; j++) {
+    stats[j].calls = calls[j];
+    stats[j].min = mins[j];
+    stats[j].max = maxs[j];
+    stats[j].mean = sums[j]/nproc;
+    stats[j].imbalance = (stats[j].mean > 0.0) ?
+        stats[j].max/stats[j].mean : 1.0;
+  }
+  return stats;
+}
+
+
+void Phase_profile::write_json(std::ostream& os, MPI_Comm comm) const {
+  std::vector<Phase_statistics> stats = summary(comm);
+
+  int rank, nproc;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &nproc);
+  if (rank != 0) return;
+
+  auto quoted = [](std::string const& str) -> std::string {
+    std::string q = "\"";
+    for (auto const& ch : str) {
+      if (ch == '"' || ch == '\\') q += '\\';
+      q += ch;
+    }
+    return q + "\"";
+  };
+
+  std::ios::fmtflags flags = os.flags();
+  std::streamsize precision = os.precision();
+  os << std::scientific << std::setprecision(6);
+  os << "{\n  \"num_ranks\": " << nproc << ",\n  \"phases\": [";
+  for (int j = 0; j < static_cast<int>(stats.size()); j++) {
+    os << (j ? ",\n" : "\n") <<
+        "    {\"name\": " << quoted(stats[j].name) <<
+        ", \"calls\": " << stats[j].calls <<
+        ", \"min\": " << stats[j].min <<
+        ", \"max\": " << stats[j].max <<
+        ", \"mean\": " << stats[j].mean <<
+        ", \"imbalance\": " << stats[j].imbalance << "}";
+  }
+  os << "\n  ]\n}\n";
+  os.flags(flags);
+  os.precision(precision);
+}
+
+}  // end namespace Jali
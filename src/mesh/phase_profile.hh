@@ -0,0 +1,148 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef _JALI_PHASE_PROFILE_H_
+#define _JALI_PHASE_PROFILE_H_
+
+// Wall clock timing of the phases of a long operation such as the
+// construction of a mesh. A Phase_timer times the scope it lives in
+// and adds the time to a Phase_profile under the name of the phase;
+// phases timed while another one is running are recorded as
+// "outer/inner". The profile of every rank can be reduced to the min,
+// max and mean time of each phase over the ranks of a communicator,
+// and written out as JSON.
+//
+// Timers given a null profile do nothing so that the timing can be
+// switched on and off at run time.
+
+#include <mpi.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+
+namespace Jali {
+
+//! Time of a phase on this rank
+
+struct Phase_time {
+  std::string name;
+  int calls = 0;
+  double seconds = 0.0;
+};
+
+//! Time of a phase over the ranks of a communicator
+
+struct Phase_statistics {
+  std::string name;
+  int calls = 0;           // max over the ranks
+  double min = 0.0, max = 0.0, mean = 0.0;
+  double imbalance = 1.0;  // max/mean
+};
+
+class Phase_profile {
+ public:
+
+  //! Start and stop a phase (see Phase_timer). Phases must be stopped
+  //! in the reverse order in which they were started
+
+  void start(std::string const& name);
+  void stop();
+
+  //! Times of the phases on this rank in the order in which they
+  //! were first started
+
+  std::vector<Phase_time> const& phases() const { return phases_; }
+
+  //! Is the profile empty?
+
+  bool empty() const { return phases_.empty(); }
+
+  //! Min, max and mean time of every phase over the ranks of comm, in
+  //! the order of the phases on rank 0. Collective
+
+  std::vector<Phase_statistics> summary(MPI_Comm comm) const;
+
+  //! Write the summary over the ranks of comm as a JSON object on
+  //! rank 0. Collective
+
+  void write_json(std::ostream& os, MPI_Comm comm) const;
+
+ private:
+  std::vector<Phase_time> phases_;
+
+  // Running phases - index into phases_ and start time
+  std::vector<std::pair<int, std::chrono::steady_clock::time_point>> open_;
+};
+
+
+//! Times the scope it is declared in as a phase of a profile (does
+//! nothing if the profile is null)
+
+class Phase_timer {
+ public:
+  Phase_timer(Phase_profile *profile, std::string const& name) :
+      profile_(profile) {
+    if (profile_) profile_->start(name);
+  }
+  ~Phase_timer() {
+    if (profile_) profile_->stop();
+  }
+
+  Phase_timer(Phase_timer const&) = delete;
+  Phase_timer& operator=(Phase_timer const&) = delete;
+
+ private:
+  Phase_profile *profile_;
+};
+
+}  // end namespace Jali
+
+#endif  // _JALI_PHASE_PROFILE_H_
@@ -0,0 +1,128 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _JALI_SCRATCH_ARENA_H_
+#define _JALI_SCRATCH_ARENA_H_
+
+// Per-thread pools of reusable vectors for the temporary lists
+// (coordinates, IDs, directions) that the entity-at-a-time geometry
+// routines of Mesh need. A Scratch_vector takes a vector from the pool
+// of the calling thread and gives it back, emptied but with its
+// capacity intact, when it goes out of scope. Once every thread has
+// seen the largest lists it needs, no more heap allocation happens.
+//
+// The pools are thread_local so threads never contend for them. Any
+// number of Scratch_vectors of a type may be alive at once on a
+// thread (e.g. when one geometry routine calls another); they are
+// handed out and returned in stack order.
+
+#include <memory>
+#include <vector>
+
+namespace Jali {
+
+//! Pool of vectors of type T belonging to the calling thread
+
+template<typename T>
+class Scratch_arena {
+ public:
+  //! Pool of the calling thread
+
+  static Scratch_arena& local() {
+    static thread_local Scratch_arena arena;
+    return arena;
+  }
+
+  //! Take a vector from the pool (making a new one if it is empty)
+
+  std::vector<T> *acquire() {
+    if (free_.empty())
+      return new std::vector<T>;
+    std::vector<T> *v = free_.back().release();
+    free_.pop_back();
+    return v;
+  }
+
+  //! Return an emptied vector to the pool
+
+  void release(std::vector<T> *v) {
+    v->clear();
+    free_.emplace_back(v);
+  }
+
+ private:
+  std::vector<std::unique_ptr<std::vector<T>>> free_;
+};
+
+
+//! Vector borrowed from the scratch arena of the calling thread for
+//! the lifetime of this object. It starts out empty; use it like a
+//! pointer to std::vector<T>
+
+template<typename T>
+class Scratch_vector {
+ public:
+  Scratch_vector() : v_(Scratch_arena<T>::local().acquire()) {}
+  ~Scratch_vector() { Scratch_arena<T>::local().release(v_); }
+
+  Scratch_vector(Scratch_vector const&) = delete;
+  Scratch_vector& operator=(Scratch_vector const&) = delete;
+
+  std::vector<T>& operator*() const { return *v_; }
+  std::vector<T> *operator->() const { return v_; }
+  std::vector<T> *get() const { return v_; }
+
+  T& operator[](int const i) const { return (*v_)[i]; }
+
+ private:
+  std::vector<T> *v_;
+};
+
+}  // end namespace Jali
+
+#endif  // _JALI_SCRATCH_ARENA_H_
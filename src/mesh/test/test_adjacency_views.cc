@@ -0,0 +1,332 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*/
+
+/**
+ * @file   test_adjacency_views.cc
+ *
+ * @brief  Test that the non-copying views of cached adjacencies return
+ *         the same entities as the list based query functions and
+ *         that the lazily cached info can be built concurrently
+ *
+ */
+
+#include <UnitTest++.h>
+
+#include <mpi.h>
+#include <iostream>
+#include <algorithm>
+#include <thread>
+
+#include "Mesh.hh"
+#include "MeshFactory.hh"
+
+// Compare the views of a mesh with the output of the list based queries
+
+void check_views(std::shared_ptr<Jali::Mesh> mesh) {
+  int dim = mesh->manifold_dimension();
+
+  for (auto const& c : mesh->cells()) {
+    std::vector<Jali::Entity_ID> cfaces;
+    std::vector<Jali::dir_t> cfdirs;
+    mesh->cell_get_faces_and_dirs(c, &cfaces, &cfdirs);
+
+    Jali::Entity_ID_View cfaces_v = mesh->cell_faces(c);
+    Jali::Dir_View cfdirs_v = mesh->cell_face_dirs(c);
+    CHECK_EQUAL(cfaces.size(), cfaces_v.size());
+    CHECK_EQUAL(cfdirs.size(), cfdirs_v.size());
+    CHECK_ARRAY_EQUAL(cfaces, cfaces_v, cfaces.size());
+    CHECK_ARRAY_EQUAL(cfdirs, cfdirs_v, cfdirs.size());
+    CHECK_EQUAL(mesh->cell_get_num_faces(c), cfaces_v.size());
+
+    std::vector<Jali::Entity_ID> cedges;
+    mesh->cell_get_edges(c, &cedges);
+    Jali::Entity_ID_View cedges_v = mesh->cell_edges(c);
+    CHECK_EQUAL(cedges.size(), cedges_v.size());
+    CHECK_ARRAY_EQUAL(cedges, cedges_v, cedges.size());
+
+    if (dim == 2) {
+      std::vector<Jali::dir_t> cedirs;
+      mesh->cell_2D_get_edges_and_dirs(c, &cedges, &cedirs);
+      Jali::Dir_View cedirs_v = mesh->cell_2D_edge_dirs(c);
+      CHECK_EQUAL(cedirs.size(), cedirs_v.size());
+      CHECK_ARRAY_EQUAL(cedirs, cedirs_v, cedirs.size());
+    }
+
+    std::vector<Jali::Entity_ID> csides;
+    mesh->cell_get_sides(c, &csides);
+    Jali::Entity_ID_View csides_v = mesh->cell_sides(c);
+    CHECK_EQUAL(csides.size(), csides_v.size());
+    CHECK_ARRAY_EQUAL(csides, csides_v, csides.size());
+
+    std::vector<Jali::Entity_ID> ccorners;
+    mesh->cell_get_corners(c, &ccorners);
+    Jali::Entity_ID_View ccorners_v = mesh->cell_corners(c);
+    CHECK_EQUAL(ccorners.size(), ccorners_v.size());
+    CHECK_ARRAY_EQUAL(ccorners, ccorners_v, ccorners.size());
+  }
+
+  for (auto const& f : mesh->faces()) {
+    std::vector<Jali::Entity_ID> fcells;
+    mesh->face_get_cells(f, Jali::Entity_type::ALL, &fcells);
+    Jali::Entity_ID_View fcells_v = mesh->face_cells(f);
+    CHECK_EQUAL(fcells.size(), fcells_v.size());
+    CHECK_ARRAY_EQUAL(fcells, fcells_v, fcells.size());
+
+    std::vector<Jali::Entity_ID> fedges;
+    std::vector<Jali::dir_t> fedirs;
+    mesh->face_get_edges_and_dirs(f, &fedges, &fedirs);
+    Jali::Entity_ID_View fedges_v = mesh->face_edges(f);
+    Jali::Dir_View fedirs_v = mesh->face_edge_dirs(f);
+    CHECK_EQUAL(fedges.size(), fedges_v.size());
+    CHECK_ARRAY_EQUAL(fedges, fedges_v, fedges.size());
+    CHECK_ARRAY_EQUAL(fedirs, fedirs_v, fedirs.size());
+  }
+
+  for (auto const& n : mesh->nodes()) {
+    std::vector<Jali::Entity_ID> ncorners;
+    mesh->node_get_corners(n, Jali::Entity_type::ALL, &ncorners);
+    Jali::Entity_ID_View ncorners_v = mesh->node_corners(n);
+    CHECK_EQUAL(ncorners.size(), ncorners_v.size());
+    CHECK_ARRAY_EQUAL(ncorners, ncorners_v, ncorners.size());
+  }
+
+  // Cached nodes of faces must be nodes of the cells connected to the
+  // face and the coordinates of faces and cells must be those of
+  // their nodes
+
+  for (auto const& f : mesh->faces()) {
+    Jali::Entity_ID_View fnodes = mesh->face_nodes(f);
+    for (auto const& c : mesh->face_cells(f)) {
+      Jali::Entity_ID_View cnodes = mesh->cell_nodes(c);
+      for (auto const& n : fnodes)
+        CHECK(std::find(cnodes.begin(), cnodes.end(), n) != cnodes.end());
+    }
+
+    std::vector<JaliGeometry::Point> fcoords;
+    mesh->face_get_coordinates(f, &fcoords);
+    CHECK_EQUAL(fnodes.size(), fcoords.size());
+    for (std::size_t i = 0; i < fnodes.size(); i++) {
+      JaliGeometry::Point npnt;
+      mesh->node_get_coordinates(fnodes[i], &npnt);
+      CHECK_CLOSE(0.0, JaliGeometry::norm(npnt-fcoords[i]), 1.0e-12);
+    }
+  }
+
+  for (auto const& c : mesh->cells()) {
+    Jali::Entity_ID_View cnodes = mesh->cell_nodes(c);
+    std::vector<JaliGeometry::Point> ccoords;
+    mesh->cell_get_coordinates(c, &ccoords);
+    CHECK_EQUAL(cnodes.size(), ccoords.size());
+    for (std::size_t i = 0; i < cnodes.size(); i++) {
+      JaliGeometry::Point npnt;
+      mesh->node_get_coordinates(cnodes[i], &npnt);
+      CHECK_CLOSE(0.0, JaliGeometry::norm(npnt-ccoords[i]), 1.0e-12);
+    }
+  }
+
+  // Upward and same level adjacencies are checked against the
+  // downward cell to node and face to node relationships
+
+  for (auto const& c : mesh->cells()) {
+    std::vector<Jali::Entity_ID> cnodes;
+    mesh->cell_get_nodes(c, &cnodes);
+
+    std::vector<Jali::Entity_ID> exp_nbrs;
+    for (auto const& n : cnodes) {
+      Jali::Entity_ID_View ncells = mesh->node_cells(n);
+      CHECK(std::find(ncells.begin(), ncells.end(), c) != ncells.end());
+      for (auto const& nc : ncells)
+        if (nc != c) exp_nbrs.push_back(nc);
+    }
+    std::sort(exp_nbrs.begin(), exp_nbrs.end());
+    exp_nbrs.erase(std::unique(exp_nbrs.begin(), exp_nbrs.end()),
+                   exp_nbrs.end());
+
+    Jali::Entity_ID_View nbrs = mesh->cell_node_adj_cells(c);
+    CHECK_EQUAL(exp_nbrs.size(), nbrs.size());
+    CHECK_ARRAY_EQUAL(exp_nbrs, nbrs, exp_nbrs.size());
+
+    std::vector<Jali::Entity_ID> exp_fnbrs;
+    for (auto const& f : mesh->cell_faces(c))
+      for (auto const& fc : mesh->face_cells(f))
+        if (fc != c) exp_fnbrs.push_back(fc);
+
+    Jali::Entity_ID_View fnbrs = mesh->cell_face_adj_cells(c);
+    CHECK_EQUAL(exp_fnbrs.size(), fnbrs.size());
+    CHECK_ARRAY_EQUAL(exp_fnbrs, fnbrs, exp_fnbrs.size());
+
+    std::vector<Jali::Entity_ID> owned_fnbrs;
+    mesh->cell_get_face_adj_cells(c, Jali::Entity_type::PARALLEL_OWNED,
+                                  &owned_fnbrs);
+    for (auto const& fc : owned_fnbrs)
+      CHECK(mesh->entity_get_type(Jali::Entity_kind::CELL, fc) ==
+            Jali::Entity_type::PARALLEL_OWNED);
+  }
+
+  int nnodefaces = 0;
+  for (auto const& f : mesh->faces()) {
+    std::vector<Jali::Entity_ID> fnodes;
+    mesh->face_get_nodes(f, &fnodes);
+    for (auto const& n : fnodes) {
+      Jali::Entity_ID_View nfaces = mesh->node_faces(n);
+      CHECK(std::find(nfaces.begin(), nfaces.end(), f) != nfaces.end());
+    }
+    nnodefaces += fnodes.size();
+  }
+  for (auto const& n : mesh->nodes())
+    nnodefaces -= mesh->node_faces(n).size();
+  CHECK_EQUAL(0, nnodefaces);
+
+  for (auto const& cn : mesh->corners()) {
+    std::vector<Jali::Entity_ID> cwedges;
+    mesh->corner_get_wedges(cn, &cwedges);
+    Jali::Entity_ID_View cwedges_v = mesh->corner_wedges(cn);
+    CHECK_EQUAL(cwedges.size(), cwedges_v.size());
+    CHECK_ARRAY_EQUAL(cwedges, cwedges_v, cwedges.size());
+    for (auto const& w : cwedges_v)
+      CHECK_EQUAL(cn, mesh->wedge_get_corner(w));
+  }
+}
+
+
+TEST(MESH_ADJACENCY_VIEWS) {
+  const Jali::MeshFramework_t frameworks[] = {Jali::MSTK};
+  const char *framework_names[] = {"MSTK"};
+  const int numframeworks = sizeof(frameworks)/sizeof(Jali::MeshFramework_t);
+
+  for (int i = 0; i < numframeworks; i++) {
+    if (!Jali::framework_available(frameworks[i])) continue;
+    std::cerr << "Testing adjacency views with " << framework_names[i] << "\n";
+
+    for (int dim = 2; dim <= 3; dim++) {
+      Jali::MeshFactory factory(MPI_COMM_WORLD);
+      std::shared_ptr<Jali::Mesh> mesh;
+
+      int ierr = 0;
+      int aerr = 0;
+      try {
+        factory.framework(frameworks[i]);
+        factory.included_entities({Jali::Entity_kind::EDGE,
+                Jali::Entity_kind::FACE, Jali::Entity_kind::WEDGE,
+                Jali::Entity_kind::CORNER});
+        if (dim == 2)
+          mesh = factory(0.0, 0.0, 1.0, 1.0, 4, 3);
+        else
+          mesh = factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 3, 2, 2);
+      } catch (const Errors::Message& e) {
+        std::cerr << ": mesh error: " << e.what() << std::endl;
+        ierr++;
+      } catch (const std::exception& e) {
+        std::cerr << ": error: " << e.what() << std::endl;
+        ierr++;
+      }
+
+      MPI_Allreduce(&ierr, &aerr, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+      CHECK_EQUAL(aerr, 0);
+
+      check_views(mesh);
+    }
+  }
+}
+
+
+// Sum up some connectivity and geometric info of a mesh, triggering
+// the lazy build of the corresponding cached info
+
+double mesh_checksum(std::shared_ptr<Jali::Mesh> mesh) {
+  double sum = 0.0;
+  for (auto const& c : mesh->cells()) {
+    sum += mesh->cell_volume(c);
+    sum += mesh->cell_node_adj_cells(c).size();
+    sum += mesh->cell_face_adj_cells(c).size();
+  }
+  for (auto const& n : mesh->nodes())
+    sum += mesh->node_cells(n).size() + mesh->node_faces(n).size();
+  for (auto const& s : mesh->sides())
+    sum += mesh->side_volume(s) + mesh->side_get_cell(s);
+  for (auto const& cn : mesh->corners())
+    sum += mesh->corner_volume(cn) + mesh->corner_wedges(cn).size();
+  return sum;
+}
+
+
+TEST(MESH_LAZY_CACHE_CONCURRENT) {
+  if (!Jali::framework_available(Jali::MSTK)) return;
+
+  const int nthreads = 8;
+
+  for (int dim = 2; dim <= 3; dim++) {
+    Jali::MeshFactory factory(MPI_COMM_WORLD);
+    factory.framework(Jali::MSTK);
+    factory.included_entities({Jali::Entity_kind::EDGE,
+            Jali::Entity_kind::FACE, Jali::Entity_kind::WEDGE,
+            Jali::Entity_kind::CORNER});
+
+    std::shared_ptr<Jali::Mesh> mesh1, mesh2;
+    if (dim == 2) {
+      mesh1 = factory(0.0, 0.0, 1.0, 1.0, 8, 6);
+      mesh2 = factory(0.0, 0.0, 1.0, 1.0, 8, 6);
+    } else {
+      mesh1 = factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 5, 4, 3);
+      mesh2 = factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 5, 4, 3);
+    }
+
+    // Many threads querying a fresh mesh at once must see the same
+    // info as a single thread
+
+    double serial_sum = mesh_checksum(mesh1);
+
+    std::vector<double> sums(nthreads, 0.0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nthreads; t++)
+      threads.emplace_back([&, t]() { sums[t] = mesh_checksum(mesh2); });
+    for (auto& thr : threads)
+      thr.join();
+
+    for (int t = 0; t < nthreads; t++)
+      CHECK_EQUAL(serial_sum, sums[t]);
+  }
+}
@@ -330,8 +330,6 @@ TEST(MESH_CORNERS_3D) {
         Jali::Entity_ID wc = mesh->corner_get_cell(cn);
         CHECK_EQUAL(c, wc);
 
-        JaliGeometry::Point ccen = mesh->cell_centroid(c);
-
         // Make sure the corner knows which node its associated with
 
         Jali::Entity_ID n = mesh->corner_get_node(cn);
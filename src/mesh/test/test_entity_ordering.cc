@@ -0,0 +1,228 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <UnitTest++.h>
+
+#include <mpi.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#include "Mesh.hh"
+#include "MeshFactory.hh"
+#include "entity_ordering.hh"
+
+// Check that order is a permutation of 0..n-1
+
+bool is_permutation(std::vector<int> const& order, int const n) {
+  if (static_cast<int>(order.size()) != n) return false;
+  std::vector<int> sorted(order);
+  std::sort(sorted.begin(), sorted.end());
+  for (int i = 0; i < n; i++)
+    if (sorted[i] != i) return false;
+  return true;
+}
+
+TEST(SPACE_FILLING_CURVE_ORDER) {
+  // Morton order of the corners of a square (x is the most
+  // significant coordinate)
+
+  std::vector<double> xyz = {0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 1.0, 1.0};
+  std::vector<int> order;
+  Jali::space_filling_curve_order(Jali::Renumbering_type::MORTON, 2, xyz,
+                                  &order);
+  std::vector<int> expected = {0, 2, 1, 3};
+  CHECK(order == expected);
+
+  // Consecutive points along a Hilbert curve through a 8x8 or 4x4x4
+  // grid of points are neighbors in the grid
+
+  for (int dim = 2; dim <= 3; dim++) {
+    int const n1 = (dim == 2) ? 8 : 4;
+    int const n = (dim == 2) ? n1*n1 : n1*n1*n1;
+    xyz.resize(dim*n);
+    for (int i = 0; i < n; i++) {
+      xyz[dim*i] = i%n1;
+      xyz[dim*i+1] = (i/n1)%n1;
+      if (dim == 3) xyz[dim*i+2] = i/(n1*n1);
+    }
+
+    Jali::space_filling_curve_order(Jali::Renumbering_type::HILBERT, dim,
+                                    xyz, &order);
+    CHECK(is_permutation(order, n));
+
+    for (int k = 1; k < n; k++) {
+      double dist = 0.0;
+      for (int d = 0; d < dim; d++)
+        dist += std::abs(xyz[dim*order[k]+d] - xyz[dim*order[k-1]+d]);
+      CHECK_EQUAL(1.0, dist);
+    }
+  }
+}
+
+TEST(REVERSE_CUTHILL_MCKEE_ORDER) {
+  // A path through the vertices of a graph in scrambled order must
+  // be laid out with bandwidth 1
+
+  int const n = 10;
+  std::vector<int> path = {3, 7, 0, 9, 5, 1, 8, 2, 6, 4};
+  std::vector<std::vector<int>> nbrs(n);
+  for (int i = 1; i < n; i++) {
+    nbrs[path[i-1]].push_back(path[i]);
+    nbrs[path[i]].push_back(path[i-1]);
+  }
+
+  std::vector<int> offsets(n+1, 0), adjacency;
+  for (int i = 0; i < n; i++) {
+    adjacency.insert(adjacency.end(), nbrs[i].begin(), nbrs[i].end());
+    offsets[i+1] = adjacency.size();
+  }
+
+  std::vector<int> order;
+  Jali::reverse_cuthill_mckee_order(offsets, adjacency, &order);
+  CHECK(is_permutation(order, n));
+
+  std::vector<int> position(n);
+  for (int k = 0; k < n; k++)
+    position[order[k]] = k;
+  for (int i = 1; i < n; i++)
+    CHECK_EQUAL(1, std::abs(position[path[i]] - position[path[i-1]]));
+}
+
+TEST(MESH_RENUMBERING) {
+  if (!Jali::framework_available(Jali::MSTK)) return;
+
+  int nproc;
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+  if (nproc > 1) return;
+
+  Jali::Renumbering_type const types[3] = {Jali::Renumbering_type::MORTON,
+                                           Jali::Renumbering_type::HILBERT,
+                                           Jali::Renumbering_type::RCM};
+  Jali::Entity_kind const kinds[4] = {Jali::Entity_kind::NODE,
+                                      Jali::Entity_kind::EDGE,
+                                      Jali::Entity_kind::FACE,
+                                      Jali::Entity_kind::CELL};
+
+  for (int dim = 2; dim <= 3; dim++) {
+    Jali::MeshFactory mf(MPI_COMM_WORLD);
+    mf.framework(Jali::MSTK);
+    mf.included_entities({Jali::Entity_kind::EDGE, Jali::Entity_kind::FACE});
+    mf.num_tiles(4);
+
+    std::shared_ptr<Jali::Mesh> refmesh = (dim == 2) ?
+        mf(0.0, 0.0, 1.0, 1.0, 6, 6) :
+        mf(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 4, 4, 4);
+    for (auto const kind : kinds)
+      CHECK(refmesh->entity_new_to_old_ids(kind).empty());
+
+    for (auto const type : types) {
+      mf.renumbering(type);
+      std::shared_ptr<Jali::Mesh> mesh = (dim == 2) ?
+          mf(0.0, 0.0, 1.0, 1.0, 6, 6) :
+          mf(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 4, 4, 4);
+      CHECK(mesh->renumbering() == type);
+
+      // The maps are inverse permutations
+
+      for (auto const kind : kinds) {
+        std::vector<Jali::Entity_ID> const& new2old =
+            mesh->entity_new_to_old_ids(kind);
+        std::vector<Jali::Entity_ID> const& old2new =
+            mesh->entity_old_to_new_ids(kind);
+        int const n = mesh->num_entities(kind, Jali::Entity_type::ALL);
+        CHECK(is_permutation(new2old, n));
+        CHECK_EQUAL(n, static_cast<int>(old2new.size()));
+        for (int i = 0; i < n; i++)
+          CHECK_EQUAL(i, old2new[new2old[i]]);
+      }
+
+      // Entities are the same as the entities of the mesh that was
+      // not renumbered with the old IDs
+
+      std::vector<Jali::Entity_ID> const& node_new2old =
+          mesh->entity_new_to_old_ids(Jali::Entity_kind::NODE);
+      for (auto const n : mesh->nodes()) {
+        JaliGeometry::Point p, pref;
+        mesh->node_get_coordinates(n, &p);
+        refmesh->node_get_coordinates(node_new2old[n], &pref);
+        for (int d = 0; d < dim; d++)
+          CHECK_EQUAL(pref[d], p[d]);
+      }
+
+      std::vector<Jali::Entity_ID> const& face_new2old =
+          mesh->entity_new_to_old_ids(Jali::Entity_kind::FACE);
+      for (auto const f : mesh->faces()) {
+        JaliGeometry::Point p = mesh->face_centroid(f);
+        JaliGeometry::Point pref = refmesh->face_centroid(face_new2old[f]);
+        for (int d = 0; d < dim; d++)
+          CHECK_CLOSE(pref[d], p[d], 1.0e-12);
+      }
+
+      std::vector<Jali::Entity_ID> const& cell_new2old =
+          mesh->entity_new_to_old_ids(Jali::Entity_kind::CELL);
+      for (auto const c : mesh->cells()) {
+        JaliGeometry::Point p = mesh->cell_centroid(c);
+        JaliGeometry::Point pref = refmesh->cell_centroid(cell_new2old[c]);
+        for (int d = 0; d < dim; d++)
+          CHECK_CLOSE(pref[d], p[d], 1.0e-12);
+        CHECK_CLOSE(refmesh->cell_volume(cell_new2old[c]),
+                    mesh->cell_volume(c), 1.0e-12);
+      }
+
+      // Tiles are built from the renumbered cells
+
+      int ntilecells = 0;
+      for (auto const& tile : mesh->tiles())
+        ntilecells += tile->num_cells<Jali::Entity_type::PARALLEL_OWNED>();
+      CHECK_EQUAL(static_cast<int>(
+          mesh->num_cells<Jali::Entity_type::PARALLEL_OWNED>()), ntilecells);
+    }
+  }
+}
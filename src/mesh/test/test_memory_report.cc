@@ -0,0 +1,127 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <UnitTest++.h>
+
+#include <mpi.h>
+#include <memory>
+#include <vector>
+
+#include "Mesh.hh"
+#include "MeshFactory.hh"
+#include "memory_report.hh"
+
+// Categories of a report add up and are merged under a prefix; the
+// summary over ranks has the min, max and sum of every category
+
+TEST(MEMORY_REPORT) {
+  int nproc;
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  std::vector<double> v(10);
+  v.reserve(100);
+
+  Jali::Memory_report report;
+  report.add("a", v);
+  report.add("a", 8, 16);
+  CHECK_EQUAL(88u, report.categories().at("a").used);
+  CHECK_EQUAL(816u, report.categories().at("a").allocated);
+
+  Jali::Memory_report outer;
+  outer.add("b", 1, 2);
+  outer.merge("inner/", report);
+  CHECK_EQUAL(89u, outer.total().used);
+  CHECK_EQUAL(818u, outer.total().allocated);
+  CHECK(outer.categories().count("inner/a"));
+
+  std::map<std::string, Jali::Memory_statistics> stats =
+      outer.summary(MPI_COMM_WORLD);
+  CHECK_EQUAL(3u, stats.size());
+  CHECK_EQUAL(88u, stats["inner/a"].min.used);
+  CHECK_EQUAL(88u, stats["inner/a"].max.used);
+  CHECK_EQUAL(88u*nproc, stats["inner/a"].sum.used);
+  CHECK_EQUAL(818u*nproc, stats["total"].sum.allocated);
+}
+
+
+// The report of a mesh grows as cached info is built and includes
+// its tiles and sets
+
+TEST(MESH_MEMORY_REPORT) {
+  int nproc;
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+  if (nproc > 1) return;  // Simple meshes are serial
+
+  Jali::MeshFactory factory(MPI_COMM_WORLD);
+  factory.framework(Jali::Simple);
+  factory.num_tiles(2);
+  std::shared_ptr<Jali::Mesh> mesh = factory(0.0, 0.0, 0.0,
+                                             1.0, 1.0, 1.0, 4, 4, 4);
+
+  std::vector<Jali::Entity_ID> setcells = {0, 1, 2}, noghosts;
+  Jali::make_meshset("cellset", *mesh, Jali::Entity_kind::CELL, setcells,
+                     noghosts, true);
+
+  Jali::Memory_report before = mesh->memory_report();
+  for (auto const& c : mesh->cells())
+    mesh->cell_volume(c);
+  Jali::Memory_report after = mesh->memory_report();
+
+  auto const& cats = after.categories();
+  CHECK(cats.count("entity_lists"));
+  CHECK(cats.count("tiles/entity_lists"));
+  CHECK_EQUAL(3*sizeof(Jali::Entity_ID),
+              cats.at("sets/entity_lists").used/2);  // owned + all
+  CHECK(cats.count("sets/reverse_maps"));
+
+  CHECK(cats.at("geometry/cells").used >= 64*sizeof(double));
+  CHECK(after.total().used > before.total().used);
+
+  for (auto const& cat : cats)
+    CHECK(cat.second.allocated >= cat.second.used);
+}
@@ -63,10 +63,16 @@
 
 #include <mpi.h>
 #include <iostream>
+#include <cmath>
+#include <cstdint>
+#include <array>
 
 #include "Mesh.hh"
 #include "MeshFactory.hh"
 #include "Geometry.hh"
+#include "cell_geometry.hh"
+#include "batch_geometry.hh"
+#include "mesh_threads.hh"
 
 TEST(MESH_GEOMETRY_PLANAR)
 {
@@ -715,3 +721,388 @@ TEST(MESH_GEOMETRY_SOLID) {
 
 }
 
+
+
+// Geometric quantities updated incrementally after the nodes move
+// must match the ones computed from scratch - both when only a few
+// nodes move (only the entities around them are recomputed) and when
+// all of them move (everything is recomputed by the batched kernels)
+
+TEST(MESH_GEOMETRY_UPDATE) {
+  // Only MSTK provides the edges, sides and corners checked here
+
+  const Jali::MeshFramework_t frameworks[] = {Jali::MSTK};
+  const int numframeworks = sizeof(frameworks)/sizeof(Jali::MeshFramework_t);
+  for (int fr = 0; fr < numframeworks; fr++) {
+    if (!Jali::framework_available(frameworks[fr])) continue;
+
+    for (int dim = 2; dim <= 3; dim++) {
+      Jali::MeshFactory factory(MPI_COMM_WORLD);
+      factory.framework(frameworks[fr]);
+      factory.included_entities({Jali::Entity_kind::EDGE,
+              Jali::Entity_kind::FACE, Jali::Entity_kind::CORNER});
+
+      std::shared_ptr<Jali::Mesh> mesh;
+      if (dim == 2)
+        mesh = factory(0.0, 0.0, 1.0, 1.0, 10, 10);
+      else
+        mesh = factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 6, 6, 6);
+
+      // Compute everything once
+
+      for (auto const& c : mesh->cells()) mesh->cell_volume(c);
+      for (auto const& f : mesh->faces()) mesh->face_area(f);
+      for (auto const& e : mesh->edges()) mesh->edge_length(e);
+      for (auto const& s : mesh->sides()) mesh->side_volume(s);
+      for (auto const& cn : mesh->corners()) mesh->corner_volume(cn);
+
+      // First move only the nodes on the line x = y = 0.5, then all
+      // the nodes
+
+      for (int pass = 0; pass < 2; pass++) {
+        for (auto const& n : mesh->nodes()) {
+          JaliGeometry::Point xyz;
+          mesh->node_get_coordinates(n, &xyz);
+          if (pass == 0 &&
+              (fabs(xyz[0]-0.5) > 1.0e-8 || fabs(xyz[1]-0.5) > 1.0e-8))
+            continue;
+          JaliGeometry::Point newxyz = xyz;
+          newxyz[0] += 0.05*std::sin(7.0*xyz[1]);
+          newxyz[1] += 0.05*std::sin(5.0*xyz[0]+0.3);
+          mesh->node_set_coordinates(n, newxyz);
+        }
+        mesh->update_geometric_quantities(true);
+
+        for (auto const& c : mesh->cells()) {
+          CHECK_CLOSE(mesh->cell_volume(c, true), mesh->cell_volume(c),
+                      1.0e-12);
+          JaliGeometry::Point cen0 = mesh->cell_centroid(c, true);
+          JaliGeometry::Point cen1 = mesh->cell_centroid(c);
+          for (int d = 0; d < dim; d++)
+            CHECK_CLOSE(cen0[d], cen1[d], 1.0e-12);
+
+          Jali::Entity_ID_List csides, ccorners;
+          mesh->cell_get_sides(c, &csides);
+          double sidevol = 0.0;
+          for (auto const& s : csides)
+            sidevol += mesh->side_volume(s);
+          CHECK_CLOSE(mesh->cell_volume(c), sidevol, 1.0e-12);
+
+          mesh->cell_get_corners(c, &ccorners);
+          double cornervol = 0.0;
+          for (auto const& cn : ccorners)
+            cornervol += mesh->corner_volume(cn);
+          CHECK_CLOSE(mesh->cell_volume(c), cornervol, 1.0e-12);
+        }
+
+        for (auto const& f : mesh->faces()) {
+          CHECK_CLOSE(mesh->face_area(f, true), mesh->face_area(f),
+                      1.0e-12);
+          JaliGeometry::Point cen0 = mesh->face_centroid(f, true);
+          JaliGeometry::Point cen1 = mesh->face_centroid(f);
+          for (int d = 0; d < dim; d++)
+            CHECK_CLOSE(cen0[d], cen1[d], 1.0e-12);
+
+          Jali::Entity_ID_List fcells;
+          mesh->face_get_cells(f, Jali::Entity_type::ALL, &fcells);
+          for (auto const& c : fcells) {
+            int dir;
+            JaliGeometry::Point normal0 = mesh->face_normal(f, true, c, &dir);
+            JaliGeometry::Point normal1 = mesh->face_normal(f, false, c,
+                                                            &dir);
+            for (int d = 0; d < dim; d++)
+              CHECK_CLOSE(normal0[d], normal1[d], 1.0e-12);
+          }
+        }
+
+        for (auto const& e : mesh->edges())
+          CHECK_CLOSE(mesh->edge_length(e, true), mesh->edge_length(e),
+                      1.0e-12);
+      }
+    }
+  }
+}
+
+
+// Nodes may be moved concurrently, e.g. by the tiles that own them,
+// and a full update recomputes everything from the coordinates
+
+TEST(MESH_GEOMETRY_CONCURRENT_MOVES) {
+  if (!Jali::framework_available(Jali::Simple)) return;
+
+  Jali::MeshFactory factory(MPI_COMM_WORLD);
+  factory.framework(Jali::Simple);
+  factory.partitioner(Jali::Partitioner_type::BLOCK);
+  factory.included_entities({Jali::Entity_kind::FACE});
+  factory.num_tiles(8);
+  std::shared_ptr<Jali::Mesh> mesh =
+      factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 8, 8, 8);
+
+  for (auto const& c : mesh->cells()) mesh->cell_volume(c);
+  for (auto const& f : mesh->faces()) mesh->face_area(f);
+
+  // First move only the nodes near x = 0, then all the nodes
+
+  for (int pass = 0; pass < 2; pass++) {
+    mesh->parallel_for_tiles([&](Jali::MeshTile const& t) {
+        for (auto const& n : t.nodes<Jali::Entity_type::PARALLEL_OWNED>()) {
+          JaliGeometry::Point xyz;
+          mesh->node_get_coordinates(n, &xyz);
+          if (pass == 0 && xyz[0] > 0.2) continue;
+          JaliGeometry::Point newxyz = xyz;
+          newxyz[0] += 0.05*std::sin(7.0*xyz[1]);
+          newxyz[2] += 0.05*std::sin(5.0*xyz[0]+0.3);
+          mesh->node_set_coordinates(n, newxyz);
+        }
+      });
+    mesh->update_geometric_quantities(true);
+
+    for (auto const& c : mesh->cells())
+      CHECK_CLOSE(mesh->cell_volume(c, true), mesh->cell_volume(c), 1.0e-12);
+    for (auto const& f : mesh->faces())
+      CHECK_CLOSE(mesh->face_area(f, true), mesh->face_area(f), 1.0e-12);
+  }
+
+  mesh->update_geometric_quantities();
+  for (auto const& c : mesh->cells())
+    CHECK_CLOSE(mesh->cell_volume(c, true), mesh->cell_volume(c), 1.0e-12);
+}
+
+
+// The node coordinate arrays of the mesh must be aligned, agree with
+// node_get_coordinates and follow node_set_coordinates
+
+TEST(NODE_COORDINATE_ARRAYS) {
+  const Jali::MeshFramework_t frameworks[] = {Jali::MSTK, Jali::Simple};
+  const int numframeworks = sizeof(frameworks)/sizeof(Jali::MeshFramework_t);
+  for (int fr = 0; fr < numframeworks; fr++) {
+    if (!Jali::framework_available(frameworks[fr])) continue;
+
+    Jali::MeshFactory factory(MPI_COMM_WORLD);
+    factory.framework(frameworks[fr]);
+    std::shared_ptr<Jali::Mesh> mesh =
+        factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 3, 3, 3);
+
+    double const *x = mesh->node_coordinates(0);
+    double const *y = mesh->node_coordinates(1);
+    double const *z = mesh->node_coordinates(2);
+    CHECK_EQUAL(0, reinterpret_cast<std::uintptr_t>(x) % 64);
+    CHECK_EQUAL(0, reinterpret_cast<std::uintptr_t>(y) % 64);
+    CHECK_EQUAL(0, reinterpret_cast<std::uintptr_t>(z) % 64);
+
+    for (auto const& n : mesh->nodes()) {
+      JaliGeometry::Point xyz;
+      mesh->node_get_coordinates(n, &xyz);
+      CHECK_EQUAL(xyz[0], x[n]);
+      CHECK_EQUAL(xyz[1], y[n]);
+      CHECK_EQUAL(xyz[2], z[n]);
+
+      std::array<double, 3> xyz2;
+      mesh->node_get_coordinates(n, &xyz2);
+      CHECK_EQUAL(xyz[0], xyz2[0]);
+      CHECK_EQUAL(xyz[1], xyz2[1]);
+      CHECK_EQUAL(xyz[2], xyz2[2]);
+    }
+
+    JaliGeometry::Point newxyz(0.4, 0.3, 0.2);
+    mesh->node_set_coordinates(5, newxyz);
+    CHECK_EQUAL(x, mesh->node_coordinates(0));
+    CHECK_EQUAL(0.4, x[5]);
+    CHECK_EQUAL(0.3, y[5]);
+    CHECK_EQUAL(0.2, z[5]);
+  }
+}
+
+
+// The kernels for standard cell types must give the same answers as
+// the general polygon/polyhedron routines
+
+TEST(CELL_GEOMETRY_KERNELS) {
+  // Distorted hex in standard (Exodus II) node order and its faces
+  // with outward normals
+
+  std::vector<JaliGeometry::Point> hexcoords = {
+    {0.0, 0.0, 0.0}, {1.1, 0.1, 0.0}, {1.0, 1.2, 0.1}, {0.1, 0.9, 0.0},
+    {0.0, 0.1, 1.0}, {1.0, 0.0, 1.3}, {1.2, 1.0, 0.9}, {0.0, 1.1, 1.0}};
+  std::vector<std::vector<int>> hexfaces = {
+    {0, 1, 5, 4}, {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7},
+    {0, 3, 2, 1}, {4, 5, 6, 7}};
+
+  std::vector<JaliGeometry::Point> prismcoords = {
+    {0.0, 0.0, 0.0}, {1.0, 0.1, 0.0}, {0.1, 1.0, 0.1},
+    {0.1, 0.0, 1.0}, {1.1, 0.0, 1.2}, {0.0, 0.9, 1.0}};
+  std::vector<std::vector<int>> prismfaces = {
+    {0, 1, 4, 3}, {1, 2, 5, 4}, {2, 0, 3, 5}, {0, 2, 1}, {3, 4, 5}};
+
+  std::vector<JaliGeometry::Point> pyrcoords = {
+    {0.0, 0.0, 0.0}, {1.0, 0.1, 0.0}, {1.1, 1.0, 0.1}, {0.0, 1.0, 0.0},
+    {0.4, 0.6, 1.0}};
+  std::vector<std::vector<int>> pyrfaces = {
+    {0, 3, 2, 1}, {0, 1, 4}, {1, 2, 4}, {2, 3, 4}, {3, 0, 4}};
+
+  std::vector<JaliGeometry::Point> tetcoords = {
+    {0.0, 0.0, 0.0}, {1.0, 0.1, 0.0}, {0.1, 1.0, 0.1}, {0.2, 0.3, 1.0}};
+  std::vector<std::vector<int>> tetfaces = {
+    {0, 1, 3}, {1, 2, 3}, {2, 0, 3}, {0, 2, 1}};
+
+  auto check_cell = [](Jali::Cell_type ctype,
+                       std::vector<JaliGeometry::Point> const& ccoords,
+                       std::vector<std::vector<int>> const& cfaces) {
+    std::vector<JaliGeometry::Point> fcoords;
+    std::vector<unsigned int> nfnodes;
+    std::vector<int> nfnodes_int;
+    for (auto const& f : cfaces) {
+      for (auto const& n : f)
+        fcoords.push_back(ccoords[n]);
+      nfnodes.push_back(f.size());
+      nfnodes_int.push_back(f.size());
+    }
+    int nn = ccoords.size();
+    int nf = cfaces.size();
+
+    double expvol;
+    JaliGeometry::Point expcen(3);
+    JaliGeometry::polyhed_get_vol_centroid(ccoords, nf, nfnodes, fcoords,
+                                           &expvol, &expcen);
+
+    Jali::Cell_geometry_kernel const& kernel =
+        Jali::cell_geometry_kernel(ctype, 3, nn, nf);
+    CHECK(kernel.vol_centroid !=
+          Jali::cell_geometry_kernel(Jali::Cell_type::POLYHED, 3, nn,
+                                     nf).vol_centroid);
+
+    double vol;
+    JaliGeometry::Point cen(3);
+    kernel.vol_centroid(nn, &(ccoords[0]), nf, &(nfnodes_int[0]),
+                        &(fcoords[0]), &vol, &cen);
+    CHECK(vol > 0.0);
+    CHECK_CLOSE(expvol, vol, 1.0e-14);
+    for (int d = 0; d < 3; d++)
+      CHECK_CLOSE(expcen[d], cen[d], 1.0e-14);
+  };
+
+  check_cell(Jali::Cell_type::HEX, hexcoords, hexfaces);
+  check_cell(Jali::Cell_type::PRISM, prismcoords, prismfaces);
+  check_cell(Jali::Cell_type::PYRAMID, pyrcoords, pyrfaces);
+  check_cell(Jali::Cell_type::TET, tetcoords, tetfaces);
+
+  // An inverted tet (two nodes swapped) has the negative of the volume
+  // and the same centroid, as from the general routine
+
+  {
+    std::vector<JaliGeometry::Point> invcoords = {
+      tetcoords[0], tetcoords[2], tetcoords[1], tetcoords[3]};
+    std::vector<unsigned int> nfnodes = {3, 3, 3, 3};
+    std::vector<int> nfnodes_int = {3, 3, 3, 3};
+    std::vector<JaliGeometry::Point> fcoords;
+    for (auto const& f : tetfaces)
+      for (auto const& n : f)
+        fcoords.push_back(invcoords[n]);
+
+    double vol, invvol, expvol;
+    JaliGeometry::Point cen(3), invcen(3), expcen(3);
+    Jali::Cell_geometry_kernel const& kernel =
+        Jali::cell_geometry_kernel(Jali::Cell_type::TET, 3, 4, 4);
+    kernel.vol_centroid(4, &(tetcoords[0]), 4, &(nfnodes_int[0]),
+                        &(fcoords[0]), &vol, &cen);
+    kernel.vol_centroid(4, &(invcoords[0]), 4, &(nfnodes_int[0]),
+                        &(fcoords[0]), &invvol, &invcen);
+    JaliGeometry::polyhed_get_vol_centroid(invcoords, 4, nfnodes, fcoords,
+                                           &expvol, &expcen);
+
+    CHECK(invvol < 0.0);
+    CHECK_CLOSE(-vol, invvol, 1.0e-14);
+    CHECK_CLOSE(expvol, invvol, 1.0e-14);
+    for (int d = 0; d < 3; d++) {
+      CHECK_CLOSE(cen[d], invcen[d], 1.0e-14);
+      CHECK_CLOSE(expcen[d], invcen[d], 1.0e-14);
+    }
+
+    // The batched kernel agrees for both tets
+
+    std::vector<double> xyz[3];
+    for (auto const& p : tetcoords)
+      for (int d = 0; d < 3; d++)
+        xyz[d].push_back(p[d]);
+    double const *xyzptr[3] = {xyz[0].data(), xyz[1].data(), xyz[2].data()};
+
+    Jali::Entity_ID const cellids[2] = {0, 1};
+    Jali::Entity_ID const cnodes[8] = {0, 1, 2, 3, 0, 2, 1, 3};
+    double batchvol[2];
+    JaliGeometry::Point batchcen[2];
+    Jali::Cell_batch_kernel const *batchkernel =
+        Jali::cell_batch_kernel(Jali::Cell_type::TET, 3, 3);
+    CHECK(batchkernel != nullptr);
+    batchkernel->vol_centroid(2, cellids, cnodes, nullptr, xyzptr,
+                              batchvol, batchcen);
+
+    CHECK_CLOSE(vol, batchvol[0], 1.0e-14);
+    CHECK_CLOSE(invvol, batchvol[1], 1.0e-14);
+    for (int d = 0; d < 3; d++) {
+      CHECK_CLOSE(cen[d], batchcen[0][d], 1.0e-14);
+      CHECK_CLOSE(invcen[d], batchcen[1][d], 1.0e-14);
+    }
+  }
+
+  // A cell whose topology does not match its type falls back on the
+  // general polyhedron kernel
+
+  CHECK(Jali::cell_geometry_kernel(Jali::Cell_type::HEX, 3, 8, 7).vol_centroid
+        == Jali::cell_geometry_kernel(Jali::Cell_type::POLYHED, 3, 8,
+                                      7).vol_centroid);
+
+  // Polygons - 2D cells and (non-planar) faces of 3D cells
+
+  std::vector<std::vector<JaliGeometry::Point>> polygons = {
+    {{0.0, 0.0}, {1.0, 0.1}, {0.2, 0.9}},
+    {{0.0, 0.0}, {1.0, 0.1}, {1.1, 1.0}, {-0.1, 0.8}},
+    {{0.0, 0.0, 0.0}, {1.0, 0.1, 0.2}, {0.2, 0.9, 0.0}},
+    {{0.0, 0.0, 0.0}, {1.0, 0.1, 0.2}, {1.1, 1.0, 0.0}, {-0.1, 0.8, 0.3}}};
+
+  for (auto const& pcoords : polygons) {
+    int np = pcoords.size();
+    int dim = pcoords[0].dim();
+
+    double exparea;
+    JaliGeometry::Point expcen(dim), expnormal(dim);
+    JaliGeometry::polygon_get_area_centroid_normal(pcoords, &exparea,
+                                                   &expcen, &expnormal);
+
+    double area;
+    JaliGeometry::Point cen(dim), normal(dim);
+    Jali::polygon_geometry_kernel(np)(np, &(pcoords[0]), &area, &cen,
+                                      &normal);
+    CHECK_CLOSE(exparea, area, 1.0e-14);
+    for (int d = 0; d < dim; d++) {
+      CHECK_CLOSE(expcen[d], cen[d], 1.0e-14);
+      CHECK_CLOSE(expnormal[d], normal[d], 1.0e-14);
+    }
+  }
+}
+
+
+// Meshes without batched geometry kernels (here 1D) compute their
+// geometry through the general routines, concurrently when threading
+// is enabled. The node coordinates those routines read must be cached
+// before the threads start, or they would wait on the calling thread
+
+TEST(MESH_GEOMETRY_THREADED_1D) {
+  int const ncells = 4*Jali::min_items_per_thread;
+  double const dx = 1.0/ncells;
+  std::vector<double> x(ncells+1);
+  for (int i = 0; i <= ncells; i++)
+    x[i] = i*dx;
+
+  for (int rep = 0; rep < 5; rep++) {
+    Jali::MeshFactory factory(MPI_COMM_WORLD);
+    factory.framework(Jali::Simple);
+    std::shared_ptr<Jali::Mesh> mesh = factory(x);
+    CHECK(mesh);
+
+    CHECK_CLOSE(dx, mesh->cell_volume(3), 1.0e-12);
+    for (auto const& c : mesh->cells()) {
+      CHECK_CLOSE(dx, mesh->cell_volume(c), 1.0e-12);
+      CHECK_CLOSE((c+0.5)*dx, mesh->cell_centroid(c)[0], 1.0e-12);
+    }
+  }
+}
@@ -0,0 +1,177 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <UnitTest++.h>
+
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "mesh_threads.hh"
+#include "scratch_arena.hh"
+#include "thread_pool.hh"
+
+// Check that chunked loops cover every item exactly once and that the
+// parallel prefix sum gives the same offsets as a serial one
+
+TEST(PARALLEL_PARTIAL_SUM) {
+  int const nvals[] = {0, 1, 17, 10*Jali::min_items_per_thread + 3};
+
+  for (auto const& n : nvals) {
+    std::vector<int> nvisits(n, 0);
+    Jali::parallel_for_chunks(n, [&](int ibegin, int iend, int ichunk) {
+        CHECK(ichunk >= 0 && ichunk < Jali::num_chunks(n));
+        for (int i = ibegin; i < iend; i++)
+          nvisits[i]++;
+      });
+    for (int i = 0; i < n; i++)
+      CHECK_EQUAL(1, nvisits[i]);
+
+    std::vector<int> offsets(n+1, 0), expected(n+1, 0);
+    Jali::parallel_for(n, [&](int i) { offsets[i+1] = i%5; });
+    for (int i = 0; i < n; i++)
+      expected[i+1] = expected[i] + i%5;
+
+    int total = Jali::parallel_partial_sum(&offsets);
+    CHECK_EQUAL(expected[n], total);
+    CHECK_ARRAY_EQUAL(expected, offsets, n+1);
+  }
+}
+
+
+// Check that scratch vectors are recycled within a thread, keep their
+// capacity and are distinct when several are alive at once
+
+TEST(SCRATCH_ARENA) {
+  std::vector<double> *first;
+  {
+    Jali::Scratch_vector<double> v;
+    v->resize(1000, 1.0);
+    first = v.get();
+  }
+
+  {
+    Jali::Scratch_vector<double> v;
+    CHECK(v.get() == first);
+    CHECK(v->empty());
+    CHECK(v->capacity() >= 1000);
+
+    Jali::Scratch_vector<double> w;
+    CHECK(w.get() != v.get());
+  }
+
+  // Each thread has its own arena
+
+  int const n = 4*Jali::min_items_per_thread;
+  std::vector<int> sums(Jali::num_chunks(n), 0);
+  Jali::parallel_for_chunks(n, [&](int ibegin, int iend, int ichunk) {
+      Jali::Scratch_vector<int> ids;
+      for (int i = ibegin; i < iend; i++)
+        ids->push_back(i);
+      for (auto const& i : *ids)
+        sums[ichunk] += i;
+    });
+  int sum = 0;
+  for (auto const& s : sums) sum += s;
+  CHECK_EQUAL(n*(n-1)/2, sum);
+}
+
+
+// Check that the thread pool runs every task exactly once, including
+// when runs are nested, and that it can be rebound without leaving the
+// CPUs the process may use or changing the binding of the caller
+
+TEST(THREAD_POOL) {
+  Jali::Thread_pool& pool = Jali::Thread_pool::instance();
+  CHECK(pool.num_workers() >= 1);
+
+  int const ntasks = 100, nsubtasks = 10;
+  std::vector<int> nvisits(ntasks*nsubtasks, 0);
+  for (int rep = 0; rep < 3; rep++) {
+    pool.run(ntasks, [&](int i) {
+        pool.run(nsubtasks, [&](int j) { nvisits[i*nsubtasks+j]++; });
+      });
+  }
+  for (auto const& n : nvisits)
+    CHECK_EQUAL(3, n);
+
+#if defined(__linux__)
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  sched_getaffinity(0, sizeof(allowed), &allowed);
+#endif
+
+  Jali::Thread_affinity affinity = pool.affinity();
+  for (auto const a : {Jali::Thread_affinity::COMPACT,
+          Jali::Thread_affinity::SPREAD}) {
+    pool.affinity(a);
+    std::vector<int> squares(ntasks, 0), cpus(ntasks, 0);
+    pool.run(ntasks, [&](int i) {
+        squares[i] = i*i;
+#if defined(__linux__)
+        cpus[i] = sched_getcpu();
+#endif
+      });
+    for (int i = 0; i < ntasks; i++)
+      CHECK_EQUAL(i*i, squares[i]);
+
+#if defined(__linux__)
+    for (auto const cpu : cpus)
+      CHECK(CPU_ISSET(cpu, &allowed));
+    cpu_set_t caller;
+    CPU_ZERO(&caller);
+    sched_getaffinity(0, sizeof(caller), &caller);
+    CHECK(CPU_EQUAL(&allowed, &caller));
+#endif
+  }
+  pool.affinity(affinity);
+  std::vector<int> zeros(ntasks, 1);
+  pool.run(ntasks, [&](int i) { zeros[i] = 0; });
+}
@@ -0,0 +1,133 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <UnitTest++.h>
+
+#include <mpi.h>
+#include <memory>
+#include <vector>
+
+#include "Mesh.hh"
+#include "MeshFactory.hh"
+#include "MeshView.hh"
+
+// Sum of the x coordinates of the nodes of every cell through a view
+// passed by value to a templated kernel
+
+template<class View>
+double sum_cell_node_x(View const view) {
+  double sum = 0.0;
+  for (int c = 0; c < view.num_cells; c++)
+    for (auto const n : view.cell_nodes(c))
+      sum += view.node_coordinate(n, 0);
+  return sum;
+}
+
+
+// The view of a mesh gives the same topology, coordinates, types
+// and geometry as the mesh
+
+TEST(MESH_VIEW) {
+  int nproc;
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  const Jali::MeshFramework_t frameworks[] = {Jali::MSTK, Jali::Simple};
+  for (auto const framework : frameworks) {
+    if (!Jali::framework_available(framework) ||
+        !Jali::framework_generates(framework, nproc > 1, 3))
+      continue;
+
+    Jali::MeshFactory factory(MPI_COMM_WORLD);
+    factory.framework(framework);
+    factory.included_entities(Jali::Entity_kind::FACE);
+    std::shared_ptr<Jali::Mesh> mesh = factory(0.0, 0.0, 0.0,
+                                               1.0, 1.0, 1.0, 4, 4, 4);
+
+    Jali::MeshView const view = mesh->view();
+    CHECK_EQUAL(3, view.space_dim);
+    CHECK_EQUAL(static_cast<int>(mesh->num_cells<Jali::Entity_type::ALL>()),
+                view.num_cells);
+    CHECK_EQUAL(static_cast<int>(
+        mesh->num_faces<Jali::Entity_type::PARALLEL_OWNED>()),
+                view.num_faces_owned);
+
+    double sum = 0.0;
+    for (int c = 0; c < view.num_cells; c++) {
+      CHECK(mesh->cell_get_type(c) == view.cell_get_type(c));
+      CHECK_EQUAL(mesh->cell_volume(c), view.cell_volume(c));
+      CHECK_ARRAY_EQUAL(mesh->cell_nodes(c), view.cell_nodes(c), 8);
+      CHECK_ARRAY_EQUAL(mesh->cell_faces(c), view.cell_faces(c), 6);
+      CHECK_ARRAY_EQUAL(mesh->cell_face_dirs(c), view.cell_face_dirs(c), 6);
+
+      for (auto const n : mesh->cell_nodes(c)) {
+        JaliGeometry::Point p;
+        mesh->node_get_coordinates(n, &p);
+        double xyz[3];
+        view.node_get_coordinates(n, xyz);
+        CHECK_ARRAY_EQUAL(&p[0], xyz, 3);
+        sum += p[0];
+      }
+    }
+    CHECK_CLOSE(sum, sum_cell_node_x(view), 1.0e-12);
+
+    for (int f = 0; f < view.num_faces; f++) {
+      CHECK_EQUAL(mesh->face_area(f), view.face_area(f));
+      CHECK_ARRAY_EQUAL(mesh->face_nodes(f), view.face_nodes(f), 4);
+      CHECK_EQUAL(mesh->face_cells(f).size(), view.face_cells(f).size());
+      JaliGeometry::Point normal = mesh->face_normal(f);
+      CHECK_ARRAY_EQUAL(&normal[0], &view.face_normal(f)[0], 3);
+    }
+
+    // Moving a node changes what the view sees
+
+    JaliGeometry::Point p(0.0, 0.0, 0.0);
+    mesh->node_set_coordinates(0, p);
+    mesh->update_geometric_quantities();
+    CHECK_EQUAL(0.0, view.node_coordinate(0, 0));
+  }
+}
@@ -63,6 +63,8 @@
 
 #include <mpi.h>
 #include <iostream>
+#include <vector>
+#include <algorithm>
 
 #include "Mesh.hh"
 #include "MeshTile.hh"
@@ -494,6 +496,340 @@ TEST(MESH_TILES_MPI) {
 }
 
 
+//! Test execution of work on the tiles of a mesh by the thread pool
+
+TEST(MESH_TILES_PARALLEL_FOR) {
+  int nproc;
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  const Jali::MeshFramework_t frameworks[] = {Jali::MSTK, Jali::Simple};
+  const int numframeworks = sizeof(frameworks)/sizeof(Jali::MeshFramework_t);
+  for (int i = 0; i < numframeworks; i++) {
+    Jali::MeshFramework_t the_framework = frameworks[i];
+    if (!Jali::framework_available(the_framework)) continue;
+    if (!Jali::framework_generates(the_framework, nproc > 1, 3)) continue;
+
+    Jali::MeshFactory factory(MPI_COMM_WORLD);
+    factory.framework(the_framework);
+    factory.partitioner(Jali::Partitioner_type::BLOCK);
+    factory.included_entities({Jali::Entity_kind::FACE});
+    factory.num_tiles(23);
+    factory.num_ghost_layers_tile(1);
+    std::shared_ptr<Jali::Mesh> mesh =
+        factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 6, 6, 6);
+
+    // Every tile is visited once and can write to its owned cells
+    // without synchronization
+
+    std::vector<int> ntile_visits(mesh->num_tiles(), 0);
+    std::vector<int> ncell_visits(mesh->num_cells(), 0);
+    mesh->parallel_for_tiles([&](Jali::MeshTile& tile) {
+        ntile_visits[tile.ID()]++;
+        for (auto const c : tile.cells<Jali::Entity_type::PARALLEL_OWNED>())
+          ncell_visits[c]++;
+      });
+    for (auto const& n : ntile_visits)
+      CHECK_EQUAL(1, n);
+    for (auto const c : mesh->cells<Jali::Entity_type::PARALLEL_OWNED>())
+      CHECK_EQUAL(1, ncell_visits[c]);
+
+    // A reduction gives the same result as the serial loop over tiles
+
+    auto tile_volume = [&mesh](Jali::MeshTile const& tile) -> double {
+      double volume = 0.0;
+      for (auto const c : tile.cells<Jali::Entity_type::PARALLEL_OWNED>())
+        volume += mesh->cell_volume(c);
+      return volume;
+    };
+
+    double expected = 0.0;
+    for (auto const& t : mesh->tiles())
+      expected += tile_volume(*t);
+
+    double volume = mesh->parallel_reduce_tiles(
+        0.0, tile_volume, [](double a, double b) { return a+b; });
+    CHECK_EQUAL(expected, volume);
+    if (nproc == 1)
+      CHECK_CLOSE(1.0, volume, 1.0e-12);
+  }
+}
+
+TEST(MESH_TILES_COLORING) {
+  int nproc;
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  const Jali::MeshFramework_t frameworks[] = {Jali::MSTK, Jali::Simple};
+  const int numframeworks = sizeof(frameworks)/sizeof(Jali::MeshFramework_t);
+  for (int i = 0; i < numframeworks; i++) {
+    Jali::MeshFramework_t the_framework = frameworks[i];
+    if (!Jali::framework_available(the_framework)) continue;
+    if (!Jali::framework_generates(the_framework, nproc > 1, 3)) continue;
+
+    Jali::MeshFactory factory(MPI_COMM_WORLD);
+    factory.framework(the_framework);
+    factory.partitioner(Jali::Partitioner_type::BLOCK);
+    factory.included_entities({Jali::Entity_kind::FACE});
+    factory.num_tiles(23);
+    factory.num_ghost_layers_tile(1);
+    std::shared_ptr<Jali::Mesh> mesh =
+        factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 6, 6, 6);
+
+    // Every tile has exactly one color and is listed under that color
+
+    int ncolors = mesh->num_tile_colors();
+    CHECK(ncolors >= 1);
+    CHECK(ncolors <= mesh->num_tiles());
+
+    std::vector<int> ntile_listed(mesh->num_tiles(), 0);
+    for (int color = 0; color < ncolors; color++) {
+      CHECK(mesh->tiles_of_color(color).size() > 0);
+      for (auto const t : mesh->tiles_of_color(color)) {
+        CHECK_EQUAL(color, mesh->tile_color(t));
+        ntile_listed[t]++;
+      }
+    }
+    for (auto const& n : ntile_listed)
+      CHECK_EQUAL(1, n);
+
+    // No two tiles of the same color share a node of their owned cells
+
+    std::vector<int> node_color_tile(mesh->num_nodes(), -1);
+    for (int color = 0; color < ncolors; color++) {
+      std::fill(node_color_tile.begin(), node_color_tile.end(), -1);
+      for (auto const t : mesh->tiles_of_color(color)) {
+        auto const& tile = mesh->tiles()[t];
+        for (auto const c : tile->cells<Jali::Entity_type::PARALLEL_OWNED>())
+          for (auto const n : mesh->cell_nodes(c)) {
+            CHECK(node_color_tile[n] == -1 || node_color_tile[n] == t);
+            node_color_tile[n] = t;
+          }
+      }
+    }
+
+    // So a scatter from cells to nodes needs no synchronization
+
+    int const ncells = mesh->num_cells();
+    std::vector<double> cellval(ncells);
+    for (int c = 0; c < ncells; c++)
+      cellval[c] = 1.0 + c;
+
+    std::vector<double> expected(mesh->num_nodes(), 0.0);
+    for (auto const& t : mesh->tiles())
+      for (auto const c : t->cells<Jali::Entity_type::PARALLEL_OWNED>())
+        for (auto const n : mesh->cell_nodes(c))
+          expected[n] += cellval[c];
+
+    std::vector<double> nodeval(mesh->num_nodes(), 0.0);
+    mesh->parallel_for_tiles_by_color([&](Jali::MeshTile& tile) {
+        for (auto const c : tile.cells<Jali::Entity_type::PARALLEL_OWNED>())
+          for (auto const n : mesh->cell_nodes(c))
+            nodeval[n] += cellval[c];
+      });
+    int const nnodes = mesh->num_nodes();
+    for (int n = 0; n < nnodes; n++)
+      CHECK_CLOSE(expected[n], nodeval[n], 1.0e-12*expected[n]);
+  }
+}
+
+//! Tiles built together are the same as tiles built one at a time
+
+TEST(MESH_TILES_MAKE_MANY) {
+  int nproc;
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  const Jali::MeshFramework_t frameworks[] = {Jali::MSTK, Jali::Simple};
+  const int numframeworks = sizeof(frameworks)/sizeof(Jali::MeshFramework_t);
+  for (int i = 0; i < numframeworks; i++) {
+    Jali::MeshFramework_t the_framework = frameworks[i];
+    if (!Jali::framework_available(the_framework)) continue;
+    if (!Jali::framework_generates(the_framework, nproc > 1, 3)) continue;
+
+    Jali::MeshFactory factory(MPI_COMM_WORLD);
+    factory.framework(the_framework);
+    factory.included_entities({Jali::Entity_kind::FACE});
+    std::shared_ptr<Jali::Mesh> mesh1 =
+        factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 5, 6, 7);
+    std::shared_ptr<Jali::Mesh> mesh2 =
+        factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 5, 6, 7);
+
+    // Slabs of cells in index order
+
+    int const ntiles = 9;
+    int const ncells = mesh1->num_cells<Jali::Entity_type::PARALLEL_OWNED>();
+    std::vector<std::vector<Jali::Entity_ID>> cells(ntiles);
+    for (int c = 0; c < ncells; c++)
+      cells[c*ntiles/ncells].push_back(c);
+
+    int const num_halo_layers = 2;
+    for (int t = 0; t < ntiles; t++)
+      make_meshtile(*mesh1, cells[t], num_halo_layers, true, false, false,
+                    false, false);
+    auto tiles = make_meshtiles(*mesh2, cells, num_halo_layers, true, false,
+                                false, false, false);
+
+    CHECK_EQUAL(ntiles, tiles.size());
+    CHECK_EQUAL(ntiles, mesh2->num_tiles());
+    for (int t = 0; t < ntiles; t++) {
+      auto const& tile1 = mesh1->tiles()[t];
+      auto const& tile2 = mesh2->tiles()[t];
+      CHECK(tile2 == tiles[t]);
+      CHECK_EQUAL(t, tile2->ID());
+
+      CHECK(tile1->cells<Jali::Entity_type::PARALLEL_OWNED>() ==
+            tile2->cells<Jali::Entity_type::PARALLEL_OWNED>());
+      CHECK(tile1->cells<Jali::Entity_type::PARALLEL_GHOST>() ==
+            tile2->cells<Jali::Entity_type::PARALLEL_GHOST>());
+      CHECK(tile1->nodes<Jali::Entity_type::PARALLEL_OWNED>() ==
+            tile2->nodes<Jali::Entity_type::PARALLEL_OWNED>());
+      CHECK(tile1->nodes<Jali::Entity_type::PARALLEL_GHOST>() ==
+            tile2->nodes<Jali::Entity_type::PARALLEL_GHOST>());
+      CHECK(tile1->faces<Jali::Entity_type::PARALLEL_OWNED>() ==
+            tile2->faces<Jali::Entity_type::PARALLEL_OWNED>());
+      CHECK(tile1->faces<Jali::Entity_type::PARALLEL_GHOST>() ==
+            tile2->faces<Jali::Entity_type::PARALLEL_GHOST>());
+
+      // No entity is listed twice in a tile
+
+      std::vector<Jali::Entity_ID> ids(tile2->cells().begin(),
+                                       tile2->cells().end());
+      std::sort(ids.begin(), ids.end());
+      CHECK(std::adjacent_find(ids.begin(), ids.end()) == ids.end());
+      ids.assign(tile2->nodes().begin(), tile2->nodes().end());
+      std::sort(ids.begin(), ids.end());
+      CHECK(std::adjacent_find(ids.begin(), ids.end()) == ids.end());
+    }
+
+    int const nnodes = mesh1->num_nodes();
+    for (int n = 0; n < nnodes; n++)
+      CHECK_EQUAL(mesh1->master_tile_ID_of_node(n),
+                  mesh2->master_tile_ID_of_node(n));
+    int const nfaces = mesh1->num_faces();
+    for (int f = 0; f < nfaces; f++)
+      CHECK_EQUAL(mesh1->master_tile_ID_of_face(f),
+                  mesh2->master_tile_ID_of_face(f));
+  }
+}
+
+//! Tile-local numbering and the tile blocked layout of entity data
+
+TEST(MESH_TILES_LOCAL_NUMBERING) {
+  int nproc;
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  const Jali::MeshFramework_t frameworks[] = {Jali::MSTK, Jali::Simple};
+  const int numframeworks = sizeof(frameworks)/sizeof(Jali::MeshFramework_t);
+  for (int i = 0; i < numframeworks; i++) {
+    Jali::MeshFramework_t the_framework = frameworks[i];
+    if (!Jali::framework_available(the_framework)) continue;
+    if (!Jali::framework_generates(the_framework, nproc > 1, 3)) continue;
+
+    Jali::MeshFactory factory(MPI_COMM_WORLD);
+    factory.framework(the_framework);
+    factory.partitioner(Jali::Partitioner_type::BLOCK);
+    factory.included_entities({Jali::Entity_kind::FACE});
+    factory.num_tiles(8);
+    factory.num_ghost_layers_tile(1);
+    std::shared_ptr<Jali::Mesh> mesh =
+        factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 4, 4, 4);
+
+    for (auto const kind : {Jali::Entity_kind::NODE, Jali::Entity_kind::FACE,
+            Jali::Entity_kind::CELL}) {
+      Jali::Tile_layout const& layout = *mesh->tile_layout(kind);
+      int nents = mesh->num_entities(kind, Jali::Entity_type::ALL);
+      CHECK_EQUAL(mesh->num_tiles()+1, layout.num_blocks());
+      CHECK_EQUAL(nents, static_cast<int>(layout.entity_block.size()));
+
+      for (auto const& t : mesh->tiles()) {
+        // Owned entities are numbered first and the local numbering
+        // maps back and forth
+
+        auto const& owned = t->entities(kind,
+                                        Jali::Entity_type::PARALLEL_OWNED);
+        auto const& all = t->entities(kind, Jali::Entity_type::ALL);
+        CHECK_EQUAL(static_cast<int>(all.size()), layout.block_sizes[t->ID()]);
+        for (int j = 0; j < static_cast<int>(all.size()); j++) {
+          CHECK_EQUAL(all[j], t->local_to_global(kind, j));
+          CHECK_EQUAL(j, t->global_to_local(kind, all[j]));
+        }
+        for (int j = 0; j < static_cast<int>(owned.size()); j++) {
+          CHECK_EQUAL(owned[j], all[j]);
+          CHECK_EQUAL(t->ID(), layout.entity_block[owned[j]]);
+          CHECK_EQUAL(j, layout.entity_position[owned[j]]);
+        }
+
+        // Entities not in the tile have no local ID
+
+        std::vector<char> in_tile(nents, 0);
+        for (auto const e : all)
+          in_tile[e] = 1;
+        for (int e = 0; e < nents; e++)
+          if (!in_tile[e])
+            CHECK_EQUAL(-1, t->global_to_local(kind, e));
+      }
+    }
+  }
+}
+
+//! Test the plans for copying values of record into tile halos
+
+TEST(MESH_TILES_HALO_PLAN) {
+  int nproc;
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  const Jali::MeshFramework_t frameworks[] = {Jali::MSTK, Jali::Simple};
+  const int numframeworks = sizeof(frameworks)/sizeof(Jali::MeshFramework_t);
+  for (int i = 0; i < numframeworks; i++) {
+    Jali::MeshFramework_t the_framework = frameworks[i];
+    if (!Jali::framework_available(the_framework)) continue;
+    if (!Jali::framework_generates(the_framework, nproc > 1, 3)) continue;
+
+    Jali::MeshFactory factory(MPI_COMM_WORLD);
+    factory.framework(the_framework);
+    factory.partitioner(Jali::Partitioner_type::BLOCK);
+    factory.included_entities({Jali::Entity_kind::FACE});
+    factory.num_tiles(8);
+    factory.num_ghost_layers_tile(2);
+    std::shared_ptr<Jali::Mesh> mesh =
+        factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 6, 6, 6);
+
+    for (auto const kind : {Jali::Entity_kind::NODE, Jali::Entity_kind::FACE,
+            Jali::Entity_kind::CELL}) {
+      Jali::Tile_layout const& layout = *mesh->tile_layout(kind);
+      int ntiles = mesh->num_tiles();
+      CHECK_EQUAL(ntiles+1, static_cast<int>(layout.halo_copy_offsets.size()));
+
+      // Every halo entry of a tile is written exactly once, from the
+      // value of record of the same entity, and no copy reads from
+      // the tile itself
+
+      for (auto const& t : mesh->tiles()) {
+        int tid = t->ID();
+        int nall = t->num_entities(kind, Jali::Entity_type::ALL);
+        int nowned = t->num_entities(kind, Jali::Entity_type::PARALLEL_OWNED);
+        std::vector<int> written(nall, 0);
+        for (int c = layout.halo_copy_offsets[tid];
+             c < layout.halo_copy_offsets[tid+1]; c++) {
+          int src = layout.halo_copy_src_blocks[c];
+          CHECK(src != tid);
+          for (int j = layout.halo_copy_starts[c];
+               j < layout.halo_copy_starts[c+1]; j++) {
+            int dstpos = layout.halo_dst_positions[j];
+            CHECK(dstpos >= nowned && dstpos < nall);
+            written[dstpos]++;
+
+            Jali::Entity_ID gid = t->local_to_global(kind, dstpos);
+            CHECK_EQUAL(src, layout.entity_block[gid]);
+            CHECK_EQUAL(layout.halo_src_positions[j],
+                        layout.entity_position[gid]);
+          }
+        }
+        for (int j = 0; j < nall; j++)
+          CHECK_EQUAL(j < nowned ? 0 : 1, written[j]);
+      }
+    }
+  }
+}
+
 //! Test retrieval of set entities on tiles
 
 TEST(MESH_TILES_SETS) {
@@ -0,0 +1,125 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <UnitTest++.h>
+
+#include <mpi.h>
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Mesh.hh"
+#include "MeshFactory.hh"
+#include "phase_profile.hh"
+
+// Nested phases are named after their enclosing phase and repeated
+// phases accumulate; the summary over ranks has the min, max and
+// mean time of every phase
+
+TEST(PHASE_PROFILE) {
+  Jali::Phase_profile profile;
+  for (int i = 0; i < 2; i++) {
+    Jali::Phase_timer outer(&profile, "outer");
+    Jali::Phase_timer inner(&profile, "inner");
+  }
+  {
+    Jali::Phase_timer timer(nullptr, "ignored");
+  }
+
+  std::vector<Jali::Phase_time> const& phases = profile.phases();
+  CHECK_EQUAL(2, phases.size());
+  CHECK_EQUAL("outer", phases[0].name);
+  CHECK_EQUAL("outer/inner", phases[1].name);
+  CHECK_EQUAL(2, phases[0].calls);
+  CHECK_EQUAL(2, phases[1].calls);
+  CHECK(phases[0].seconds >= phases[1].seconds);
+
+  std::vector<Jali::Phase_statistics> stats = profile.summary(MPI_COMM_WORLD);
+  CHECK_EQUAL(2, stats.size());
+  for (auto const& s : stats) {
+    CHECK(s.min <= s.mean && s.mean <= s.max);
+    CHECK(s.imbalance >= 1.0 || s.max == 0.0);
+  }
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  std::ostringstream os;
+  profile.write_json(os, MPI_COMM_WORLD);
+  if (rank == 0) {
+    CHECK(os.str().find("\"outer/inner\"") != std::string::npos);
+    CHECK(os.str().find("\"imbalance\"") != std::string::npos);
+  }
+}
+
+
+// Meshes built by MSTK record the phases of their construction if
+// asked to
+
+TEST(MESH_CONSTRUCTION_PROFILE) {
+  Jali::MeshFactory factory(MPI_COMM_WORLD);
+  factory.framework(Jali::MSTK);
+  factory.included_entities(Jali::Entity_kind::ALL_KIND);
+  factory.profile_construction(true);
+  std::shared_ptr<Jali::Mesh> mesh = factory(0.0, 0.0, 0.0,
+                                             1.0, 1.0, 1.0, 3, 3, 3);
+
+  std::vector<Jali::Phase_statistics> stats =
+      mesh->construction_profile().summary(MPI_COMM_WORLD);
+  std::vector<std::string> names;
+  for (auto const& s : stats)
+    names.push_back(s.name);
+  for (std::string const name : {"generate_mesh", "init_nodes", "init_faces",
+          "init_cells", "cache_extra_variables"})
+    CHECK(std::find(names.begin(), names.end(), name) != names.end());
+
+  factory.profile_construction(false);
+  mesh = factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 3, 3, 3);
+  CHECK(mesh->construction_profile().empty());
+}
@@ -163,7 +163,6 @@ TEST(MESH_SIDES_2D) {
 
         Jali::Entity_ID f = mesh->side_get_face(s);
         CHECK(f >= 0);
-        JaliGeometry::Point fcen = mesh->face_centroid(f);
 
         // Make sure the side knows which nodes its associated with
 
@@ -341,8 +340,6 @@ TEST(MESH_SIDES_3D) {
         Jali::Entity_ID edg = mesh->side_get_edge(s);
         CHECK(edg >= 0);
 
-        JaliGeometry::Point ecen = mesh->edge_centroid(edg);
-
         // Make sure the side knows which face its associated with
 
         Jali::Entity_ID f = mesh->side_get_face(s);
@@ -454,3 +451,85 @@ TEST(MESH_SIDES_3D) {
 
 }
 
+
+
+// Sides and wedges numbered implicitly must have the same IDs,
+// adjacencies and geometry as when they are stored explicitly
+
+TEST(MESH_SIDES_IMPLICIT) {
+
+  const Jali::MeshFramework_t frameworks[] = {Jali::MSTK};
+  const char *framework_names[] = {"MSTK"};
+  const int numframeworks = sizeof(frameworks)/sizeof(Jali::MeshFramework_t);
+
+  for (int fr = 0; fr < numframeworks; fr++) {
+    if (!Jali::framework_available(frameworks[fr])) continue;
+
+    for (int dim = 2; dim <= 3; dim++) {
+      std::cerr << "Testing implicit sides with " << framework_names[fr] <<
+          " in " << dim << "D" << std::endl;
+
+      std::shared_ptr<Jali::Mesh> mesh[2];
+      for (int m = 0; m < 2; m++) {
+        Jali::MeshFactory factory(MPI_COMM_WORLD);
+        factory.framework(frameworks[fr]);
+        factory.included_entities({Jali::Entity_kind::EDGE,
+                Jali::Entity_kind::FACE, Jali::Entity_kind::SIDE,
+                Jali::Entity_kind::WEDGE, Jali::Entity_kind::CORNER});
+        factory.implicit_subcells(m == 1);
+        if (dim == 2)
+          mesh[m] = factory(0.0, 0.0, 1.0, 1.0, 3, 4);
+        else
+          mesh[m] = factory(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 3, 2, 2);
+      }
+      CHECK(!mesh[0]->implicit_subcells());
+      CHECK(mesh[1]->implicit_subcells());
+
+      CHECK_EQUAL(mesh[0]->num_sides(), mesh[1]->num_sides());
+      CHECK_EQUAL(mesh[0]->num_wedges(), mesh[1]->num_wedges());
+
+      // The lists of owned sides and wedges are built on request
+      // from the implicit numbering
+
+      auto const OWNED = Jali::Entity_type::PARALLEL_OWNED;
+      CHECK_EQUAL(mesh[0]->num_sides<OWNED>(),
+                  mesh[1]->sides<OWNED>().size());
+      CHECK_ARRAY_EQUAL(mesh[0]->sides<OWNED>(), mesh[1]->sides<OWNED>(),
+                        mesh[0]->num_sides<OWNED>());
+      CHECK_ARRAY_EQUAL(mesh[0]->wedges<OWNED>(), mesh[1]->wedges<OWNED>(),
+                        mesh[0]->num_wedges<OWNED>());
+
+      for (auto const& c : mesh[0]->cells()) {
+        Jali::Entity_ID_List csides0, csides1;
+        mesh[0]->cell_get_sides(c, &csides0);
+        mesh[1]->cell_get_sides(c, &csides1);
+        CHECK_ARRAY_EQUAL(csides0, csides1, csides0.size());
+      }
+
+      for (auto const& s : mesh[0]->sides()) {
+        CHECK_EQUAL(mesh[0]->side_get_cell(s), mesh[1]->side_get_cell(s));
+        CHECK_EQUAL(mesh[0]->side_get_face(s), mesh[1]->side_get_face(s));
+        CHECK_EQUAL(mesh[0]->side_get_edge(s), mesh[1]->side_get_edge(s));
+        CHECK_EQUAL(mesh[0]->side_get_edge_use(s),
+                    mesh[1]->side_get_edge_use(s));
+        CHECK_EQUAL(mesh[0]->side_get_node(s, 0),
+                    mesh[1]->side_get_node(s, 0));
+        CHECK_EQUAL(mesh[0]->side_get_node(s, 1),
+                    mesh[1]->side_get_node(s, 1));
+        CHECK_EQUAL(mesh[0]->side_get_opposite_side(s),
+                    mesh[1]->side_get_opposite_side(s));
+        CHECK_CLOSE(mesh[0]->side_volume(s), mesh[1]->side_volume(s),
+                    1.0e-12);
+      }
+
+      for (auto const& w : mesh[0]->wedges()) {
+        CHECK_EQUAL(mesh[0]->wedge_get_corner(w),
+                    mesh[1]->wedge_get_corner(w));
+        CHECK_EQUAL(mesh[0]->wedge_get_opposite_wedge(w),
+                    mesh[1]->wedge_get_opposite_wedge(w));
+        CHECK_CLOSE(mesh[0]->wedge_volume(w), mesh[1]->wedge_volume(w),
+                    1.0e-12);
+      }
+    }
+  }
+}
@@ -0,0 +1,289 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "thread_pool.hh"
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__linux__) && \
+    (defined(Jali_HAVE_OPENMP) || defined(Jali_HAVE_STDTHREAD))
+#define JALI_BIND_THREADS
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(Jali_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+#include "mesh_threads.hh"
+
+namespace Jali {
+
+namespace {
+
+// Set in the threads that are executing tasks of the pool so that
+// nested runs can be detected
+
+thread_local bool in_pool_task = false;
+
+// Affinity the calling thread was last bound to
+
+thread_local int bound_affinity = static_cast<int>(Thread_affinity::NONE);
+
+std::uint64_t pack_range(std::uint32_t const begin, std::uint32_t const end) {
+  return (static_cast<std::uint64_t>(end) << 32) | begin;
+}
+
+}  // end anonymous namespace
+
+
+Thread_pool& Thread_pool::instance() {
+  static Thread_pool pool;
+  return pool;
+}
+
+
+Thread_pool::Thread_pool() : nworkers_(num_mesh_threads()),
+                             affinity_(Thread_affinity::NONE),
+                             blocks_(num_mesh_threads()),
+                             busy_(false) {
+  char const *envstr = std::getenv("JALI_THREAD_AFFINITY");
+  if (envstr) {
+    if (!std::strcmp(envstr, "compact"))
+      affinity_ = Thread_affinity::COMPACT;
+    else if (!std::strcmp(envstr, "spread"))
+      affinity_ = Thread_affinity::SPREAD;
+  }
+
+  for (auto& b : blocks_)
+    b.range = pack_range(0, 0);
+
+#if defined(JALI_BIND_THREADS)
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  if (sched_getaffinity(0, sizeof(cpus), &cpus) == 0)
+    for (int i = 0; i < CPU_SETSIZE; i++)
+      if (CPU_ISSET(i, &cpus))
+        allowed_cpus_.push_back(i);
+#endif
+
+#if defined(Jali_HAVE_STDTHREAD)
+  threads_.reserve(nworkers_-1);
+  for (int i = 1; i < nworkers_; i++)
+    threads_.emplace_back(&Thread_pool::worker_loop, this, i);
+#endif
+}
+
+
+Thread_pool::~Thread_pool() {
+#if defined(Jali_HAVE_STDTHREAD)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_cv_.notify_all();
+  for (auto& t : threads_)
+    t.join();
+#endif
+}
+
+
+void Thread_pool::run(int const ntasks,
+                      std::function<void(int)> const& task) {
+  if (ntasks <= 0) return;
+
+  bool expected = false;
+  if (nworkers_ == 1 || ntasks == 1 || in_pool_task ||
+      !busy_.compare_exchange_strong(expected, true)) {
+    for (int i = 0; i < ntasks; i++)
+      task(i);
+    return;
+  }
+
+  // Deal out the tasks in contiguous blocks
+
+  task_ = &task;
+  for (int w = 0; w < nworkers_; w++) {
+    auto begin = static_cast<std::uint32_t>(
+        (static_cast<long long>(ntasks)*w)/nworkers_);
+    auto end = static_cast<std::uint32_t>(
+        (static_cast<long long>(ntasks)*(w+1))/nworkers_);
+    blocks_[w].range.store(pack_range(begin, end));
+  }
+
+#if defined(Jali_HAVE_OPENMP)
+#pragma omp parallel num_threads(nworkers_)
+  work(omp_get_thread_num());
+#elif defined(Jali_HAVE_STDTHREAD)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_++;
+    nrunning_ = nworkers_-1;
+  }
+  start_cv_.notify_all();
+
+  work(0);
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return nrunning_ == 0; });
+  }
+#else
+  work(0);
+#endif
+
+  task_ = nullptr;
+  busy_ = false;
+}
+
+
+void Thread_pool::work(int const iworker) {
+  bind_worker(iworker);
+
+  in_pool_task = true;
+
+  int itask;
+  while ((itask = pop_front(iworker)) >= 0)
+    (*task_)(itask);
+
+  // Steal from the other workers, starting with the next one, until
+  // all the blocks are empty. Since a task is taken before it is
+  // executed, an empty block means there is nothing left to steal
+
+  for (int k = 1; k < nworkers_; k++) {
+    int ivictim = (iworker+k)%nworkers_;
+    while ((itask = pop_back(ivictim)) >= 0)
+      (*task_)(itask);
+  }
+
+  in_pool_task = false;
+}
+
+
+int Thread_pool::pop_front(int const iworker) {
+  std::atomic<std::uint64_t>& range = blocks_[iworker].range;
+  std::uint64_t r = range.load();
+  while (true) {
+    auto begin = static_cast<std::uint32_t>(r);
+    auto end = static_cast<std::uint32_t>(r >> 32);
+    if (begin >= end) return -1;
+    if (range.compare_exchange_weak(r, pack_range(begin+1, end)))
+      return begin;
+  }
+}
+
+
+int Thread_pool::pop_back(int const ivictim) {
+  std::atomic<std::uint64_t>& range = blocks_[ivictim].range;
+  std::uint64_t r = range.load();
+  while (true) {
+    auto begin = static_cast<std::uint32_t>(r);
+    auto end = static_cast<std::uint32_t>(r >> 32);
+    if (begin >= end) return -1;
+    if (range.compare_exchange_weak(r, pack_range(begin, end-1)))
+      return end-1;
+  }
+}
+
+
+// Worker 0 is the thread that called run (the OpenMP master thread
+// with OPENMP) and belongs to the application, so it is left alone
+
+void Thread_pool::bind_worker(int const iworker) const {
+  if (iworker == 0) return;
+
+  Thread_affinity const affinity = affinity_;
+  if (static_cast<int>(affinity) == bound_affinity) return;
+  bound_affinity = static_cast<int>(affinity);
+
+#if defined(JALI_BIND_THREADS)
+  int ncpus = allowed_cpus_.size();
+  if (ncpus < 1) return;
+
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  if (affinity == Thread_affinity::COMPACT)
+    CPU_SET(allowed_cpus_[iworker % ncpus], &cpus);
+  else if (affinity == Thread_affinity::SPREAD)
+    CPU_SET(allowed_cpus_[(static_cast<long long>(iworker)*ncpus/nworkers_) %
+                          ncpus], &cpus);
+  else
+    for (auto const cpu : allowed_cpus_)
+      CPU_SET(cpu, &cpus);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#endif
+}
+
+
+#if defined(Jali_HAVE_STDTHREAD)
+void Thread_pool::worker_loop(int const iworker) {
+  std::uint64_t seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_cv_.wait(lock, [this, seen]() {
+          return stop_ || generation_ != seen;
+        });
+      if (stop_) return;
+      seen = generation_;
+    }
+
+    work(iworker);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--nrunning_ == 0)
+        done_cv_.notify_one();
+    }
+  }
+}
+#endif
+
+}  // end namespace Jali
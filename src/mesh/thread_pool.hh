@@ -0,0 +1,171 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _JALI_THREAD_POOL_H_
+#define _JALI_THREAD_POOL_H_
+
+// Persistent pool of threads that executes a set of independent
+// tasks (e.g. one per mesh tile) with work stealing. The tasks are
+// dealt out to the workers in contiguous blocks, so that a task goes
+// to the same worker from one run to the next when the load is
+// balanced; a worker that runs out of tasks steals from the back of
+// the block of another worker.
+//
+// The backend follows the threading chosen at configure time (see
+// mesh_threads.hh): with STDTHREAD the pool keeps num_mesh_threads()-1
+// threads waiting on a condition variable between runs and the
+// calling thread acts as worker 0; with OPENMP the workers are the
+// threads of an OpenMP parallel region; without threading the tasks
+// run on the calling thread.
+//
+// Runs started from inside a task, or while another thread is using
+// the pool, execute their tasks serially on the calling thread.
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#if defined(Jali_HAVE_STDTHREAD)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace Jali {
+
+//! Binding of the workers of the thread pool to CPUs (Linux only).
+//! The CPUs are those the process was allowed to run on when the pool
+//! was made (e.g. the CPUs an MPI launcher gave the rank). The calling
+//! thread, worker 0, is never bound
+//!
+//! NONE    - let the OS place the workers on the allowed CPUs
+//! COMPACT - bind worker i to allowed CPU i (modulo their number)
+//! SPREAD  - spread the workers evenly over the allowed CPUs
+
+enum class Thread_affinity {NONE, COMPACT, SPREAD};
+
+
+class Thread_pool {
+ public:
+  //! The pool of this process. Its number of workers is
+  //! num_mesh_threads(); its affinity is initially taken from the
+  //! JALI_THREAD_AFFINITY environment variable (none, compact or
+  //! spread; default none)
+
+  static Thread_pool& instance();
+
+  Thread_pool(Thread_pool const&) = delete;
+  Thread_pool& operator=(Thread_pool const&) = delete;
+
+  ~Thread_pool();
+
+  //! Number of workers (including the calling thread)
+
+  int num_workers() const { return nworkers_; }
+
+  //! Binding of workers to CPUs - a change takes effect at the start
+  //! of the next run
+
+  Thread_affinity affinity() const { return affinity_; }
+  void affinity(Thread_affinity const affinity) { affinity_ = affinity; }
+
+  //! Call task(i) for every i in [0, ntasks) and return when all the
+  //! calls are done. The task must not throw
+
+  void run(int const ntasks, std::function<void(int)> const& task);
+
+ private:
+  Thread_pool();
+
+  // Execute the tasks of worker iworker, then steal from the others
+
+  void work(int const iworker);
+
+  // Take the next task from the front of the block of worker iworker
+  // or from the back of the block of worker ivictim; -1 if it is empty
+
+  int pop_front(int const iworker);
+  int pop_back(int const ivictim);
+
+  // Bind the calling thread according to the affinity setting
+
+  void bind_worker(int const iworker) const;
+
+  // Remaining tasks [begin, end) of each worker, packed into one word
+  // (end in the upper 32 bits) so that both ends can be updated with
+  // a single compare-and-swap. Padded to keep the blocks of different
+  // workers on different cache lines
+
+  struct Task_block {
+    std::atomic<std::uint64_t> range;
+    char pad[64 - sizeof(std::atomic<std::uint64_t>)];
+  };
+
+  int nworkers_;
+  std::atomic<Thread_affinity> affinity_;
+  std::vector<int> allowed_cpus_;
+  std::vector<Task_block> blocks_;
+  std::function<void(int)> const *task_ = nullptr;
+  std::atomic<bool> busy_;
+
+#if defined(Jali_HAVE_STDTHREAD)
+  void worker_loop(int const iworker);
+
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable start_cv_, done_cv_;
+  std::uint64_t generation_ = 0;
+  int nrunning_ = 0;
+  bool stop_ = false;
+#endif
+};
+
+}  // end namespace Jali
+
+#endif  // _JALI_THREAD_POOL_H_
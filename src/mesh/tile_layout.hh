@@ -0,0 +1,103 @@
+/*
+ Copyright (c) 2019, Triad National Security, LLC
+ All rights reserved.
+
+ Copyright 2019. Triad National Security, LLC. This software was
+ produced under U.S. Government contract 89233218CNA000001 for Los
+ Alamos National Laboratory (LANL), which is operated by Triad
+ National Security, LLC for the U.S. Department of Energy. 
+ All rights in the program are reserved by Triad National Security,
+ LLC, and the U.S. Department of Energy/National Nuclear Security
+ Administration. The Government is granted for itself and others acting
+ on its behalf a nonexclusive, paid-up, irrevocable worldwide license
+ in this material to reproduce, prepare derivative works, distribute
+ copies to the public, perform publicly and display publicly, and to
+ permit others to do so
+
+ 
+ This is open source software distributed under the 3-clause BSD license.
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are
+ met:
+ 
+ 1. Redistributions of source code must retain the above copyright notice,
+    this list of conditions and the following disclaimer.
+ 2. Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+ 3. Neither the name of Triad National Security, LLC, Los Alamos
+    National Laboratory, LANL, the U.S. Government, nor the names of its
+    contributors may be used to endorse or promote products derived from this
+    software without specific prior written permission.
+
+ 
+ THIS SOFTWARE IS PROVIDED BY TRIAD NATIONAL SECURITY, LLC AND
+ CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ TRIAD NATIONAL SECURITY, LLC OR CONTRIBUTORS BE LIABLE FOR ANY
+ DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _JALI_TILE_LAYOUT_H_
+#define _JALI_TILE_LAYOUT_H_
+
+// Placement of per-entity data of one kind in storage made of one
+// block per tile. The block of a tile holds the tile's entities (owned
+// and halo) in tile-local order, so a kernel working on a tile only
+// touches its own block. A last block holds the entities owned by no
+// tile, e.g. parallel ghosts outside the halos of all tiles.
+//
+// An entity owned by a tile can appear in the blocks of other tiles
+// as a halo entity; its value of record is the one in its owner's
+// block. The layout includes a plan for copying the values of record
+// into the halo entries of the tiles, grouped by the tile (or block)
+// they are copied from.
+
+#include <vector>
+
+namespace Jali {
+
+struct Tile_layout {
+  //! Number of entries in each block (one per tile followed by one
+  //! for the entities owned by no tile)
+
+  std::vector<int> block_sizes;
+
+  //! Block holding the value of record of each entity (indexed by
+  //! mesh ID)
+
+  std::vector<int> entity_block;
+
+  //! Position of that value in the block, i.e. the tile-local ID of
+  //! the entity in its owner or its rank among the entities owned by
+  //! no tile
+
+  std::vector<int> entity_position;
+
+  //! Halo copy plan. The halo entries of tile t are refreshed by the
+  //! copies halo_copy_offsets[t] to halo_copy_offsets[t+1]-1. Copy i
+  //! takes the entries at halo_src_positions[j] in block
+  //! halo_copy_src_blocks[i] to the entries at halo_dst_positions[j]
+  //! in the block of tile t, for j from halo_copy_starts[i] to
+  //! halo_copy_starts[i+1]-1
+
+  std::vector<int> halo_copy_offsets;
+  std::vector<int> halo_copy_src_blocks, halo_copy_starts;
+  std::vector<int> halo_src_positions, halo_dst_positions;
+
+  //! Number of blocks
+
+  int num_blocks() const { return block_sizes.size(); }
+};
+
+}  // end namespace Jali
+
+#endif  // _JALI_TILE_LAYOUT_H_
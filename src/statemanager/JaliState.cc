@@ -48,6 +48,8 @@
 
 #include <cassert>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "JaliState.h"
 #include "JaliStateVector.h"
@@ -218,6 +220,28 @@ void State::init_from_mesh() {
 }  // init_from_mesh
 
 
+namespace {
+
+// Data of a univalued state vector indexed by entity, as the mesh
+// expects it. Vectors in the TILE_BLOCKED layout (whose storage is
+// ordered by tile and holds halo copies and padding) are gathered
+// into flatdata first
+
+template <typename T>
+T *entity_ordered_data(UniStateVector<T> *svec, std::vector<T> *flatdata) {
+  if (svec->layout() == StateVector_layout::FLAT)
+    return svec->get_raw_data();
+
+  int nents = svec->size();
+  flatdata->resize(nents);
+  for (int i = 0; i < nents; i++)
+    (*flatdata)[i] = (*svec)[i];
+  return flatdata->data();
+}
+
+}  // namespace
+
+
 //! \brief Export field data to mesh
 //! Export data from state vectors to mesh fields - Since the statevector is
 //! templated, we have to go through case by case to see if the type matches
@@ -237,22 +261,32 @@ void State::export_to_mesh() {
     if (vec->type() == StateVector_type::UNIVAL) {
       if (vec->data_type() == typeid(double)) {
         auto svec = std::dynamic_pointer_cast<UniStateVector<double>>(vec);
-        status = mymesh_->store_field(name, entity_kind, svec->get_raw_data());
+        std::vector<double> flat;
+        status = mymesh_->store_field(name, entity_kind,
+                                      entity_ordered_data(svec.get(), &flat));
       } else if (vec->data_type() == typeid(int)) {
         auto svec = std::dynamic_pointer_cast<UniStateVector<int>>(vec);
-        status = mymesh_->store_field(name, entity_kind, svec->get_raw_data());
+        std::vector<int> flat;
+        status = mymesh_->store_field(name, entity_kind,
+                                      entity_ordered_data(svec.get(), &flat));
       } else if (vec->data_type() == typeid(std::array<double, 2>)) {
         auto svec =
             std::dynamic_pointer_cast<UniStateVector<std::array<double, 2>>>(vec);
-        status = mymesh_->store_field(name, entity_kind, svec->get_raw_data());
+        std::vector<std::array<double, 2>> flat;
+        status = mymesh_->store_field(name, entity_kind,
+                                      entity_ordered_data(svec.get(), &flat));
       } else if (vec->data_type() == typeid(std::array<double, 3>)) {
         auto svec =
             std::dynamic_pointer_cast<UniStateVector<std::array<double, 3>>>(vec);
-        status = mymesh_->store_field(name, entity_kind, svec->get_raw_data());
+        std::vector<std::array<double, 3>> flat;
+        status = mymesh_->store_field(name, entity_kind,
+                                      entity_ordered_data(svec.get(), &flat));
       } else if (vec->data_type() == typeid(std::array<double, 6>)) {
         auto svec =
             std::dynamic_pointer_cast<UniStateVector<std::array<double, 6>>>(vec);
-        status = mymesh_->store_field(name, entity_kind, svec->get_raw_data());
+        std::vector<std::array<double, 6>> flat;
+        status = mymesh_->store_field(name, entity_kind,
+                                      entity_ordered_data(svec.get(), &flat));
       }
     }
 
@@ -264,6 +298,27 @@ void State::export_to_mesh() {
 }
 
 
+// Memory held by the state
+
+Memory_report State::memory_report() const {
+  Memory_report report;
+
+  for (auto const& vec : state_vectors_) {
+    Memory_usage mem = vec->memory_usage();
+    report.add("state_vectors/" + vec->name(), mem.used, mem.allocated);
+  }
+
+  for (auto const& mset : material_cellsets_)
+    report.merge("material_sets/", mset->memory_report());
+
+  report.add("cell_materials", cell_materials_);
+  for (auto const& cellmats : cell_materials_)
+    report.add("cell_materials", cellmats);
+
+  return report;
+}
+
+
 //! Print all state vectors
 
 std::ostream & operator<<(std::ostream & os, State const & s) {
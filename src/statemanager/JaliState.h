@@ -1413,6 +1413,13 @@ class State : public std::enable_shared_from_this<State> {
   /// @brief Export field data to mesh
   void export_to_mesh();
 
+
+  /// @brief Memory held by the state - the data of every state vector
+  /// (category "state_vectors/<name>"), the material sets
+  /// ("material_sets/...") and the lists of materials in cells. Data
+  /// shared by several state vectors is counted once per vector
+  Memory_report memory_report() const;
+
  protected:
 
   /// Constructor (Private - Use create_state)
@@ -56,6 +56,7 @@
 #include <algorithm>
 #include <typeinfo>
 #include <cassert>
+#include <cstdint>
 
 #include "Mesh.hh"    // jali mesh header
 
@@ -64,6 +65,13 @@ namespace Jali {
 enum class StateVector_type {UNIVAL, MULTIVAL};
 enum class Data_layout {CELL_CENTRIC, MATERIAL_CENTRIC};
 
+//! Storage of a UniStateVector on a mesh - FLAT (one entry per entity,
+//! indexed by entity ID) or TILE_BLOCKED (one block per tile of the
+//! mesh holding entries for the owned and halo entities of the tile,
+//! see Tile_layout)
+
+enum class StateVector_layout {FLAT, TILE_BLOCKED};
+
 // Forward declaration of State class and some functions to resolve
 // circular dependency (cannot include JaliState.h or use methods of
 // the State class). The functions are defined in JaliStateVector.cc
@@ -125,6 +133,11 @@ class StateVectorBase {
   virtual const std::type_info& data_type() = 0;
   virtual StateVector_type type() = 0;
 
+  //! Bytes of data in use and allocated (zero unless implemented by
+  //! the derived class)
+
+  virtual Memory_usage memory_usage() const { return Memory_usage(); }
+
   //! Query Metadata
 
   std::string name() const { return myname_; }
@@ -273,6 +286,17 @@ class UniStateVectorBase : public StateVectorBase {
   Provides some limited functionality of a std::vector while adding
   some additional meta-data like the mesh associated with this data.
 
+  A vector on all entities of a kind of a mesh can instead store its
+  data in blocks, one per tile of the mesh (StateVector_layout::
+  TILE_BLOCKED). The block of a tile holds an entry for each of its
+  entities (owned ones first, then halo ones) indexed by tile-local ID
+  and, when the size of T divides the cache line size and the entries
+  can be placed on cache line boundaries, starts on a cache line
+  boundary, so kernels on different tiles neither share cache lines
+  nor stray outside their own block.
+  Indexing the vector by entity ID then gives the entry in the block
+  of the tile owning the entity.
+
   @tparam T           Data type (int, double, some_custom_type)
   @tparam DomainType  Mesh, Mesh Tile or Mesh Subset
 */
@@ -335,6 +359,35 @@ class UniStateVector : public UniStateVectorBase<DomainType> {
   }
 
 
+  /*!
+    @brief Constructor for a vector on all entities of a kind of a mesh with a choice of storage layout
+    @param name            Name of vector
+    @param domain          Mesh (with all its tiles already made if the layout is TILE_BLOCKED)
+    @param state           State manager holding the vector (can be nullptr)
+    @param kind            What kind of entity in the Domain does data live on
+    @param layout          StateVector_layout::FLAT or TILE_BLOCKED
+    @param initval         Value to which all entries (including halo entries of tiles) are initialized
+  */
+
+  UniStateVector(std::string name,
+                 std::shared_ptr<DomainType> domain,
+                 std::shared_ptr<State> state,
+                 Entity_kind kind,
+                 StateVector_layout layout,
+                 T initval = T()) :
+      UniStateVectorBase<DomainType>(name, domain, state, kind,
+                                     Entity_type::ALL) {
+
+    if (layout == StateVector_layout::TILE_BLOCKED) {
+      tile_layout_ = domain->tile_layout(kind);
+      allocate_blocks(initval);
+    } else {
+      int num = domain->num_entities(kind, Entity_type::ALL);
+      mydata_ = std::make_shared<std::vector<T>>(num, initval);
+    }
+  }
+
+
   /*! 
     @brief Copy constructor - DEEP COPY OF DATA
 
@@ -352,10 +405,20 @@ class UniStateVector : public UniStateVectorBase<DomainType> {
                                      in_vector.mydomain_,
                                      in_vector.mystate_.lock(),
                                      in_vector.entity_kind_,
-                                     in_vector.entity_type_) {
-
-    mydata_ = std::make_shared<std::vector<T>>((in_vector.mydata_)->begin(),
-                                               (in_vector.mydata_)->end());
+                                     in_vector.entity_type_),
+      tile_layout_(in_vector.tile_layout_) {
+
+    if (tile_layout_) {
+      // The new data may be aligned differently, so copy block by block
+      allocate_blocks(T());
+      for (int b = 0; b < tile_layout_->num_blocks(); b++)
+        std::copy(in_vector.block_begin(b), in_vector.block_end(b),
+                  block_begin(b));
+    } else {
+      mydata_ =
+          std::make_shared<std::vector<T>>((in_vector.mydata_)->begin(),
+                                           (in_vector.mydata_)->end());
+    }
   }
 
   /*!
@@ -374,6 +437,8 @@ class UniStateVector : public UniStateVectorBase<DomainType> {
     UniStateVectorBase<DomainType>::mydomain_ = in_vector.mydomain_;
 
     mydata_ = in_vector.mydata_;  // shared_ptr counter will increment
+    tile_layout_ = in_vector.tile_layout_;
+    block_offsets_ = in_vector.block_offsets_;
 
     return *this;
   }
@@ -382,7 +447,8 @@ class UniStateVector : public UniStateVectorBase<DomainType> {
   
   ~UniStateVector() {}
 
-  /// Get the raw data
+  /// Get the raw data (for the TILE_BLOCKED layout, the start of the
+  /// storage holding the blocks)
 
   T *get_raw_data() { return &((*mydata_)[0]); }
 
@@ -401,7 +467,53 @@ class UniStateVector : public UniStateVectorBase<DomainType> {
     return ti;
   }
 
-  //! Subset of std::vector functionality. We can add others as needed
+  /// Storage layout of the vector
+
+  StateVector_layout layout() const {
+    return tile_layout_ ? StateVector_layout::TILE_BLOCKED :
+        StateVector_layout::FLAT;
+  }
+
+  /// Entries of a tile in the TILE_BLOCKED layout, indexed by
+  /// tile-local ID (see MeshTile::global_to_local)
+
+  T *tile_data(int const tileid) { return block_begin(tileid); }
+  T const *tile_data(int const tileid) const { return block_begin(tileid); }
+
+  /// Number of entries of a tile in the TILE_BLOCKED layout
+
+  int tile_size(int const tileid) const {
+    return tile_layout_->block_sizes[tileid];
+  }
+
+  /// Refresh the halo entries of every tile in the TILE_BLOCKED
+  /// layout from the values of record, following the copy plan of
+  /// the layout. This is the on-node analogue of a ghost update and
+  /// must be called after the owned values change and before the
+  /// halos are read. Tiles are updated concurrently; each one only
+  /// writes its own halo entries and only reads values of record
+
+  void update_tile_halos() {
+    assert(tile_layout_);
+    Tile_layout const& layout = *tile_layout_;
+    int ntiles = layout.num_blocks() - 1;
+    Thread_pool::instance().run(ntiles, [this, &layout](int t) {
+        T *dst = block_begin(t);
+        for (int c = layout.halo_copy_offsets[t];
+             c < layout.halo_copy_offsets[t+1]; c++) {
+          T const *src = block_begin(layout.halo_copy_src_blocks[c]);
+          for (int j = layout.halo_copy_starts[c];
+               j < layout.halo_copy_starts[c+1]; j++)
+            dst[layout.halo_dst_positions[j]] =
+                src[layout.halo_src_positions[j]];
+        }
+      });
+  }
+
+  //! Subset of std::vector functionality. We can add others as
+  //! needed. The iterators run over the storage of the vector, which
+  //! for the TILE_BLOCKED layout includes the halo entries of the
+  //! tiles and the padding between blocks
 
   typedef typename std::vector<T>::iterator iterator;
   typedef typename std::vector<T>::const_iterator const_iterator;
@@ -413,14 +525,41 @@ class UniStateVector : public UniStateVectorBase<DomainType> {
 
   typedef T& reference;
   typedef T const& const_reference;
-  reference operator[](int i) { return (*mydata_)[i]; }
-  const_reference operator[](int i) const { return (*mydata_)[i]; }
+  reference operator[](int i) { return (*mydata_)[position(i)]; }
+  const_reference operator[](int i) const {
+    return (*mydata_)[position(i)];
+  }
 
-  size_t size() const { return mydata_->size(); }
-  void resize(size_t newsize) { mydata_->resize(newsize); }
-  void resize(size_t newsize, T val) { mydata_->resize(newsize, val); }
+  /// Number of entries (entities) in the vector
+
+  size_t size() const {
+    return tile_layout_ ? tile_layout_->entity_block.size() : mydata_->size();
+  }
+
+  /// Resizing or clearing is only possible for the FLAT layout
+
+  void resize(size_t newsize) {
+    assert(!tile_layout_);
+    mydata_->resize(newsize);
+  }
+  void resize(size_t newsize, T val) {
+    assert(!tile_layout_);
+    mydata_->resize(newsize, val);
+  }
+
+  void clear() {
+    assert(!tile_layout_);
+    mydata_->clear();
+  }
+
+  //! Bytes of data in use and allocated
 
-  void clear() {mydata_->clear();}
+  Memory_usage memory_usage() const {
+    Memory_usage mem;
+    mem.used = mydata_->size()*sizeof(T);
+    mem.allocated = mydata_->capacity()*sizeof(T);
+    return mem;
+  }
 
   //! Output the data
 
@@ -430,8 +569,9 @@ class UniStateVector : public UniStateVectorBase<DomainType> {
         StateVectorBase::entity_kind_ << " :\n";
     os << size() << " elements\n";
 
-    for (const_iterator it = cbegin(); it != cend(); it++)
-      os << (*it) << "\n";
+    int num = size();
+    for (int i = 0; i < num; i++)
+      os << (*this)[i] << "\n";
     os << std::endl;  // flush the output
 
     return os;
@@ -439,6 +579,62 @@ class UniStateVector : public UniStateVectorBase<DomainType> {
 
  private:
   std::shared_ptr<std::vector<T>> mydata_;
+
+  // Layout of the blocks and offset of each block in the data
+  // (TILE_BLOCKED layout only)
+
+  std::shared_ptr<Tile_layout const> tile_layout_;
+  std::vector<int> block_offsets_;
+
+  // Position of the entry of an entity in the data
+
+  int position(int const i) const {
+    return tile_layout_ ?
+        block_offsets_[tile_layout_->entity_block[i]] +
+        tile_layout_->entity_position[i] : i;
+  }
+
+  T *block_begin(int const b) { return mydata_->data() + block_offsets_[b]; }
+  T const *block_begin(int const b) const {
+    return mydata_->data() + block_offsets_[b];
+  }
+  T const *block_end(int const b) const {
+    return block_begin(b) + tile_layout_->block_sizes[b];
+  }
+
+  // Allocate the data of the TILE_BLOCKED layout, starting every block
+  // on a cache line boundary if whole entries fit in a cache line and
+  // the allocated entries fall on cache line boundaries (they need
+  // not if sizeof(T) is larger than the alignment of the
+  // allocation). Otherwise the blocks are simply contiguous
+
+  void allocate_blocks(T const& initval) {
+    int const nblocks = tile_layout_->num_blocks();
+
+    auto set_offsets = [&](int const align) {
+      block_offsets_.resize(nblocks+1);
+      block_offsets_[0] = 0;
+      for (int b = 0; b < nblocks; b++)
+        block_offsets_[b+1] = block_offsets_[b] +
+            ((tile_layout_->block_sizes[b] + align - 1)/align)*align;
+    };
+
+    int const align = (64 % sizeof(T) == 0) ? 64/sizeof(T) : 1;
+    set_offsets(align);
+    mydata_ = std::make_shared<std::vector<T>>(block_offsets_[nblocks] +
+                                               align - 1, initval);
+    if (align == 1) return;
+
+    std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(mydata_->data());
+    int const leadbytes = (64 - addr % 64) % 64;
+    if (leadbytes % sizeof(T) == 0) {
+      for (auto& offset : block_offsets_)
+        offset += leadbytes/sizeof(T);
+    } else {
+      set_offsets(1);
+      mydata_->resize(block_offsets_[nblocks]);
+    }
+  }
 };  // UniStateVector
 
 //! Send UniStateVector to output stream
@@ -948,6 +1144,18 @@ class MultiStateVector : public MultiStateVectorBase<DomainType> {
   /// Clear out data for a material
   void clear(int m) { (*mydata_)[m].clear(); }
 
+  /// Bytes of data in use and allocated (all materials)
+  Memory_usage memory_usage() const {
+    Memory_usage mem;
+    mem.used = mydata_->size()*sizeof(std::vector<T>);
+    mem.allocated = mydata_->capacity()*sizeof(std::vector<T>);
+    for (auto const& matdata : *mydata_) {
+      mem.used += matdata.size()*sizeof(T);
+      mem.allocated += matdata.capacity()*sizeof(T);
+    }
+    return mem;
+  }
+
   /// Add a material and its entries to the vector
   void add_material(int ncells) {
     size_t nmats = mydata_->size();
@@ -1290,3 +1290,95 @@ TEST(State_Write_Read_With_Mesh) {
     CHECK(found);
   }
 }
+
+
+// Fields in the TILE_BLOCKED layout are exported by entity, not in
+// the order of their storage
+
+TEST(State_Write_Read_Tile_Blocked_With_Mesh) {
+  if (!Jali::framework_available(Jali::MSTK)) return;
+
+  Jali::MeshFactory mf(MPI_COMM_WORLD);
+  mf.framework(Jali::MSTK);
+  mf.num_tiles(4);
+  mf.num_ghost_layers_tile(1);
+  std::shared_ptr<Jali::Mesh> mesh1 = mf(0.0, 0.0, 1.0, 1.0, 4, 4);
+
+  CHECK(mesh1);
+
+  Jali::UniStateVector<double> blockedvec(
+      "blockedvars", mesh1, nullptr, Jali::Entity_kind::CELL,
+      Jali::StateVector_layout::TILE_BLOCKED);
+  int nc = mesh1->num_entities(Jali::Entity_kind::CELL, Jali::Entity_type::ALL);
+  for (int c = 0; c < nc; c++)
+    blockedvec[c] = 1.5*c;
+
+  std::shared_ptr<Jali::State> mystate1 = Jali::State::create(mesh1);
+  Jali::UniStateVector<double>& outvec = mystate1->add(blockedvec);
+  CHECK(outvec.layout() == Jali::StateVector_layout::TILE_BLOCKED);
+
+  mystate1->export_to_mesh();
+
+  bool with_fields = true;
+  mesh1->write_to_exodus_file("temp_blocked.exo", with_fields);
+
+  std::shared_ptr<Jali::Mesh> mesh2 = mf("temp_blocked.exo");
+  std::shared_ptr<Jali::State> mystate2 = Jali::State::create(mesh2);
+  mystate2->init_from_mesh();
+
+  Jali::UniStateVector<double, Jali::Mesh> invec;
+  bool status = mystate2->get("blockedvars", mesh2, Jali::Entity_kind::CELL,
+                              Jali::Entity_type::ALL, &invec);
+  CHECK(status);
+  CHECK_EQUAL(nc, static_cast<int>(invec.size()));
+
+  for (int i = 0; i < nc; i++) {
+    JaliGeometry::Point incen = mesh2->cell_centroid(i);
+    bool found = false;
+    for (int j = 0; j < nc; j++) {
+      JaliGeometry::Point vec = incen - mesh1->cell_centroid(j);
+      if (JaliGeometry::norm(vec) < 1.0e-12) {
+        found = true;
+        CHECK_EQUAL(outvec[j], invec[i]);
+        break;
+      }
+    }
+    CHECK(found);
+  }
+}
+
+
+// The memory report of a state has the data of each state vector
+
+TEST(Jali_State_Memory_Report) {
+  Jali::MeshFactory mf(MPI_COMM_WORLD);
+  std::shared_ptr<Jali::Mesh> mesh = mf(0.0, 0.0, 3.0, 3.0, 3, 3);
+
+  std::shared_ptr<Jali::State> mystate = Jali::State::create(mesh);
+
+  int ncells = mesh->num_entities(Jali::Entity_kind::CELL,
+                                  Jali::Entity_type::ALL);
+  mystate->add<double, Jali::Mesh, Jali::UniStateVector>("cell_density",
+               mesh, Jali::Entity_kind::CELL, Jali::Entity_type::ALL, 0.0);
+
+  std::vector<int> matcells;
+  for (int c = 0; c < ncells; c += 2)
+    matcells.push_back(c);
+  mystate->add_material("steel", matcells);
+  mystate->add<double, Jali::Mesh, Jali::MultiStateVector>("mat_density",
+               mesh, Jali::Entity_kind::CELL, Jali::Entity_type::ALL);
+
+  Jali::Memory_report report = mystate->memory_report();
+  auto const& cats = report.categories();
+
+  auto it = cats.find("state_vectors/cell_density");
+  CHECK(it != cats.end());
+  CHECK_EQUAL(ncells*sizeof(double), it->second.used);
+  CHECK(it->second.allocated >= it->second.used);
+
+  it = cats.find("state_vectors/mat_density");
+  CHECK(it != cats.end());
+  CHECK(it->second.used >= matcells.size()*sizeof(double));
+
+  CHECK(cats.find("material_sets/entity_lists") != cats.end());
+}
@@ -48,6 +48,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "mpi.h"
 
 #include <iostream>
+#include <cstdint>
+#include <array>
 
 #include "JaliStateVector.h"
 #include "Mesh.hh"
@@ -218,6 +220,119 @@ TEST(JaliUniStateVectorArray) {
 }
 
 
+TEST(JaliUniStateVectorTileBlocked) {
+
+  if (!Jali::framework_available(Jali::Simple)) return;
+
+  Jali::MeshFactory mf(MPI_COMM_WORLD);
+  mf.framework(Jali::Simple);
+  mf.partitioner(Jali::Partitioner_type::BLOCK);
+  mf.included_entities({Jali::Entity_kind::FACE});
+  mf.num_tiles(5);
+  mf.num_ghost_layers_tile(1);
+  std::shared_ptr<Jali::Mesh> mesh =
+      mf(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 5, 4, 3);
+
+  CHECK(mesh);
+
+  Jali::UniStateVector<double> myvec1("var1", mesh, nullptr,
+                                      Jali::Entity_kind::NODE,
+                                      Jali::StateVector_layout::TILE_BLOCKED,
+                                      -1.0);
+  CHECK(myvec1.layout() == Jali::StateVector_layout::TILE_BLOCKED);
+
+  int nnodes = mesh->num_entities(Jali::Entity_kind::NODE,
+                                  Jali::Entity_type::ALL);
+  CHECK_EQUAL(nnodes, static_cast<int>(myvec1.size()));
+
+  for (int n = 0; n < nnodes; n++)
+    myvec1[n] = 10.0 + n;
+
+  // Blocks start on cache lines and owned entries of a tile, by
+  // tile-local ID, are the values of the nodes. Halo entries are
+  // separate copies (still at their initial value)
+
+  for (auto const& t : mesh->tiles()) {
+    double const *tdata = myvec1.tile_data(t->ID());
+    CHECK_EQUAL(0, reinterpret_cast<std::uintptr_t>(tdata) % 64);
+    CHECK_EQUAL(static_cast<int>(t->num_nodes()), myvec1.tile_size(t->ID()));
+
+    int nowned = t->num_nodes<Jali::Entity_type::PARALLEL_OWNED>();
+    for (int j = 0; j < nowned; j++)
+      CHECK_EQUAL(10.0 + t->local_to_global(Jali::Entity_kind::NODE, j),
+                  tdata[j]);
+    for (int j = nowned; j < myvec1.tile_size(t->ID()); j++)
+      CHECK_EQUAL(-1.0, tdata[j]);
+  }
+
+  // Updating the halos copies the values of record into them
+
+  myvec1.update_tile_halos();
+  for (auto const& t : mesh->tiles()) {
+    double const *tdata = myvec1.tile_data(t->ID());
+    for (int j = 0; j < myvec1.tile_size(t->ID()); j++)
+      CHECK_EQUAL(10.0 + t->local_to_global(Jali::Entity_kind::NODE, j),
+                  tdata[j]);
+  }
+
+  // Entries larger than the alignment of the allocation may not fall
+  // on cache line boundaries. Then the blocks are simply contiguous
+
+  typedef std::array<double, 4> Quad;
+  Jali::UniStateVector<Quad> quadvec("quadvar", mesh, nullptr,
+                                     Jali::Entity_kind::NODE,
+                                     Jali::StateVector_layout::TILE_BLOCKED);
+  for (int n = 0; n < nnodes; n++)
+    quadvec[n] = {{1.0*n, 2.0*n, 3.0*n, 4.0*n}};
+  for (int n = 0; n < nnodes; n++)
+    CHECK_EQUAL(4.0*n, quadvec[n][3]);
+
+  bool aligned = true, contiguous = true;
+  for (int t = 0; t < mesh->num_tiles(); t++) {
+    if (reinterpret_cast<std::uintptr_t>(quadvec.tile_data(t)) % 64)
+      aligned = false;
+    if (t > 0 &&
+        quadvec.tile_data(t) != quadvec.tile_data(t-1) + quadvec.tile_size(t-1))
+      contiguous = false;
+  }
+  CHECK(aligned || contiguous);
+
+  // A copy has the same layout and values
+
+  Jali::UniStateVector<double> myvec2(myvec1);
+  CHECK(myvec2.layout() == Jali::StateVector_layout::TILE_BLOCKED);
+  for (int n = 0; n < nnodes; n++)
+    CHECK_EQUAL(myvec1[n], myvec2[n]);
+  for (auto const& t : mesh->tiles())
+    CHECK_EQUAL(0, reinterpret_cast<std::uintptr_t>(
+        myvec2.tile_data(t->ID())) % 64);
+
+  // Adding a tile gives the mesh a new layout but existing vectors
+  // keep the one they were made with
+
+  int ntiles = mesh->num_tiles();
+  std::vector<Jali::Entity_ID> newtilecells = {0, 1, 2};
+  Jali::make_meshtile(*mesh, newtilecells, 1, true, false, false, false,
+                      false);
+  CHECK_EQUAL(ntiles+2,
+              mesh->tile_layout(Jali::Entity_kind::NODE)->num_blocks());
+
+  for (int n = 0; n < nnodes; n++)
+    CHECK_EQUAL(10.0 + n, myvec1[n]);
+  myvec1.update_tile_halos();
+  for (int t = 0; t < ntiles; t++)
+    CHECK_EQUAL(static_cast<int>(mesh->tiles()[t]->num_nodes()),
+                myvec1.tile_size(t));
+
+  Jali::UniStateVector<double> myvec3("var3", mesh, nullptr,
+                                      Jali::Entity_kind::NODE,
+                                      Jali::StateVector_layout::TILE_BLOCKED);
+  CHECK_EQUAL(nnodes, static_cast<int>(myvec3.size()));
+  CHECK_EQUAL(static_cast<int>(mesh->tiles()[ntiles]->num_nodes()),
+              myvec3.tile_size(ntiles));
+}
+
+
 TEST(Jali_MultiStateVector_Cells_Mesh) {
 
   Jali::MeshFactory mf(MPI_COMM_WORLD);